@@ -242,6 +242,12 @@ void ParseCommandLine(int argc, const char* argv[],
             (*plainJsonPtr)["profile_log"] = name;
         });
 
+    parser.AddLongOption("trace-file", "file to write chromium trace (chrome://tracing JSON) of training")
+        .RequiredArgument("file")
+        .Handler1T<TString>([plainJsonPtr](const TString& name) {
+            (*plainJsonPtr)["trace_file"] = name;
+        });
+
     parser.AddLongOption("trace-log", "path for trace log")
         .RequiredArgument("file")
         .Handler1T<TString>([](const TString& name) {
@@ -348,6 +354,13 @@ void ParseCommandLine(int argc, const char* argv[],
         })
         .Help("Use full history to calculate approxes.");
 
+    parser.AddLongOption("materialize-permuted-features")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["materialize_permuted_features"] = true;
+        })
+        .Help("Keep per-fold permuted copies of features used in trees to make index building sequential (uses more RAM).");
+
     parser.AddLongOption("fold-permutation-block",
                          "Enables fold permutation by blocks of given length, preserving documents order inside each block.")
         .RequiredArgument("BLOCKSIZE")
@@ -702,6 +715,27 @@ void ParseCommandLine(int argc, const char* argv[],
             (*plainJsonPtr)["allow_const_label"] = true;
         });
 
+    parser.AddLongOption("sparse-features-default-bin-fraction")
+        .RequiredArgument("float")
+        .Handler1T<float>([plainJsonPtr](float fraction) {
+            (*plainJsonPtr)["sparse_features_default_bin_fraction"] = fraction;
+        })
+        .Help("Store float features sparsely if the fraction of objects in their most frequent bin is greater than this value (CPU only, 1.0 disables).");
+
+    parser.AddLongOption("exclusive-features-bundling")
+        .NoArgument()
+        .Handler0([plainJsonPtr]() {
+            (*plainJsonPtr)["exclusive_features_bundling"] = true;
+        })
+        .Help("Merge float features that do not have non-default values for the same objects into bundles scored as a single column (CPU only).");
+
+    parser.AddLongOption("quantized-features-compression-codec")
+        .RequiredArgument("CODEC")
+        .Handler1T<TString>([plainJsonPtr](const TString& codec) {
+            (*plainJsonPtr)["quantized_features_compression_codec"] = codec;
+        })
+        .Help("Keep quantized float features compressed in RAM with this block codec (lz4, zstd_1, etc.), decompress them on use (CPU only).");
+
     parser.AddLongOption("classes-count", "number of classes")
         .RequiredArgument("int")
         .Handler1T<int>([plainJsonPtr](const int classesCount) {
@@ -762,6 +796,12 @@ void ParseCommandLine(int argc, const char* argv[],
             (*plainJsonPtr).InsertValue("thread_count", count);
         });
 
+    parser.AddLongOption("metric-thread-count", "Evaluate metrics on this many additional threads, overlapped with the next iteration. CPU only. 0 evaluates metrics synchronously.")
+        .RequiredArgument("count")
+        .Handler1T<ui32>([plainJsonPtr](ui32 count) {
+            (*plainJsonPtr)["metric_thread_count"] = count;
+        });
+
     parser.AddLongOption("used-ram-limit", "Try to limit used memory. CPU only. WARNING: This option affects CTR memory usage only.\nAllowed suffixes: GB, MB, KB in different cases")
             .RequiredArgument("TARGET_RSS")
             .Handler1T<TString>([&plainJsonPtr](const TString& param) {
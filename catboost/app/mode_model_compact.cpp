@@ -0,0 +1,129 @@
+#include "modes.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+#include <catboost/libs/model/compact_leaf_values.h>
+#include <catboost/libs/model/model.h>
+#include <catboost/libs/model/model_compaction.h>
+
+#include <library/getopt/small/last_getopt.h>
+
+#include <util/datetime/base.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+#include <util/random/fast.h>
+#include <util/string/cast.h>
+
+// objects with random bins of used float features and random values of categorical features
+static TVector<TVector<float>> GenerateSampleObjects(const TFullModel& model, size_t objectCount) {
+    TFastRng64 rng(0);
+    const auto& trees = model.ObliviousTrees;
+    TVector<TVector<float>> objects(objectCount, TVector<float>(trees.GetFlatFeatureVectorExpectedSize(), 0.0f));
+    for (auto& object : objects) {
+        for (const auto& floatFeature : trees.FloatFeatures) {
+            const auto& borders = floatFeature.Borders;
+            if (borders.empty()) {
+                continue;
+            }
+            const size_t bin = rng.Uniform(borders.size() + 1);
+            const float lower = bin == 0 ? borders[0] - 1.0f : borders[bin - 1];
+            const float upper = bin == borders.size() ? borders.back() + 1.0f : borders[bin];
+            object[floatFeature.FlatFeatureIndex] = lower + (upper - lower) * rng.GenRandReal1();
+        }
+        for (const auto& catFeature : trees.CatFeatures) {
+            object[catFeature.FlatFeatureIndex] = rng.Uniform(100);
+        }
+    }
+    return objects;
+}
+
+static TDuration MeasureEvaluationTime(
+    const TFullModel& model,
+    TConstArrayRef<TConstArrayRef<float>> objects,
+    int iterationCount,
+    TVector<double>* predictions) {
+
+    predictions->resize(objects.size() * model.ObliviousTrees.ApproxDimension);
+    TDuration bestTime = TDuration::Max();
+    for (auto iteration : xrange(iterationCount)) {
+        Y_UNUSED(iteration);
+        const auto start = TInstant::Now();
+        model.CalcFlat(objects, *predictions);
+        bestTime = Min(bestTime, TInstant::Now() - start);
+    }
+    return bestTime;
+}
+
+int mode_model_compact(int argc, const char* argv[]) {
+    TString modelPath;
+    TString outputModelPath;
+    TString compactLeafValuesType;
+    size_t sampleSize = 10000;
+    int iterationCount = 5;
+
+    auto parser = NLastGetopt::TOpts();
+    parser.AddHelpOption();
+    parser.AddLongOption('m', "model-path")
+        .Required()
+        .RequiredArgument("PATH")
+        .StoreResult(&modelPath);
+    parser.AddLongOption('o', "output-path")
+        .Required()
+        .RequiredArgument("PATH")
+        .StoreResult(&outputModelPath);
+    parser.AddLongOption("compact-leaf-values", "Store reduced precision leaf values: None, Int16 or Float16")
+        .RequiredArgument("TYPE")
+        .StoreResult(&compactLeafValuesType);
+    parser.AddLongOption("benchmark-sample-size", "Number of generated objects to measure evaluation speed on")
+        .RequiredArgument("INT")
+        .StoreResult(&sampleSize);
+    parser.AddLongOption("benchmark-iterations", "Evaluation time is the best of this number of runs")
+        .RequiredArgument("INT")
+        .StoreResult(&iterationCount);
+    parser.SetFreeArgsNum(0);
+    NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
+    CB_ENSURE(iterationCount > 0, "Benchmark iterations count should be positive");
+
+    const TFullModel model = ReadModel(modelPath);
+    TModelCompactionReport report;
+    TFullModel result = CompactModel(model, &report);
+    if (compactLeafValuesType) {
+        const auto* typeNames = NCatBoostFbs::EnumNamesECompactLeafValuesType();
+        bool found = false;
+        for (auto type : NCatBoostFbs::EnumValuesECompactLeafValuesType()) {
+            if (compactLeafValuesType == typeNames[type]) {
+                const auto leafValuesReport = CompactLeafValues(type, {}, &result);
+                CATBOOST_NOTICE_LOG << "Leaf values: " << leafValuesReport.LeafValuesBytes << " -> "
+                    << leafValuesReport.CompactLeafValuesBytes << " bytes, max leaf value error "
+                    << leafValuesReport.MaxLeafValueError << ", prediction error bound "
+                    << leafValuesReport.PredictionErrorBound << Endl;
+                found = true;
+            }
+        }
+        CB_ENSURE(found, "Unknown compact leaf values type " << compactLeafValuesType);
+    }
+    CATBOOST_NOTICE_LOG << "Trees: " << report.TreeCountBefore << " -> " << report.TreeCountAfter << Endl;
+    CATBOOST_NOTICE_LOG << "Binary features: " << report.BinFeatureCountBefore << " -> "
+        << report.BinFeatureCountAfter << Endl;
+    CATBOOST_NOTICE_LOG << "Bins per object: " << report.BucketCountBefore << " -> "
+        << report.BucketCountAfter << Endl;
+
+    if (sampleSize > 0) {
+        const auto objects = GenerateSampleObjects(model, sampleSize);
+        const TVector<TConstArrayRef<float>> objectRefs(objects.begin(), objects.end());
+        TVector<double> sourcePredictions;
+        TVector<double> resultPredictions;
+        const auto sourceTime = MeasureEvaluationTime(model, objectRefs, iterationCount, &sourcePredictions);
+        const auto resultTime = MeasureEvaluationTime(result, objectRefs, iterationCount, &resultPredictions);
+        double maxDiff = 0.0;
+        for (auto i : xrange(sourcePredictions.size())) {
+            maxDiff = Max(maxDiff, Abs(sourcePredictions[i] - resultPredictions[i]));
+        }
+        CATBOOST_NOTICE_LOG << "Evaluation time on " << sampleSize << " objects: "
+            << sourceTime << " -> " << resultTime << Endl;
+        CATBOOST_NOTICE_LOG << "Max raw prediction difference: " << maxDiff << Endl;
+    }
+
+    OutputModel(result, outputModelPath);
+    return 0;
+}
@@ -1,15 +1,20 @@
 #include "modes.h"
 
+#include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/model/model.h>
 
 #include <library/getopt/small/last_getopt.h>
+#include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/serialized_enum.h>
+#include <util/generic/xrange.h>
+#include <util/system/info.h>
 
 int mode_model_sum(int argc, const char* argv[]) {
     TVector<std::pair<TString, double>> modelPathsWithWeights;
     TString outputModelPath;
     ECtrTableMergePolicy ctrMergePolicy = ECtrTableMergePolicy::IntersectingCountersAverage;
+    int threadCount = NSystemInfo::CachedNumberOfCpus();
 
     auto parser = NLastGetopt::TOpts();
     parser.AddHelpOption();
@@ -33,17 +38,32 @@ int mode_model_sum(int argc, const char* argv[]) {
             GetEnumAllNames<ECtrTableMergePolicy>()))
         .Optional()
         .StoreResult(&ctrMergePolicy);
+    parser.AddLongOption('T', "thread-count", "worker thread count (default: core count)")
+        .StoreResult(&threadCount)
+        .RequiredArgument("INT");
     parser.SetFreeArgsNum(0);
     NLastGetopt::TOptsParseResult parserResult{&parser, argc, argv};
-    TVector<THolder<TFullModel>> models;
+    CB_ENSURE(threadCount > 0, "Thread count should be positive");
+    TVector<THolder<TFullModel>> models(modelPathsWithWeights.size());
+    {
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(threadCount - 1);
+        localExecutor.ExecRangeWithThrow(
+            [&](int modelIdx) {
+                models[modelIdx] = MakeHolder<TFullModel>(ReadModel(modelPathsWithWeights[modelIdx].first));
+            },
+            0,
+            models.size(),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+    }
     TVector<const TFullModel*> modelPtrs;
     TVector<double> weights;
-    for (const auto& [path, weight] : modelPathsWithWeights) {
-        models.emplace_back(MakeHolder<TFullModel>(ReadModel(path)));
-        modelPtrs.emplace_back(models.back().Get());
-        weights.emplace_back(weight);
+    for (auto modelIdx : xrange(models.size())) {
+        modelPtrs.emplace_back(models[modelIdx].Get());
+        weights.emplace_back(modelPathsWithWeights[modelIdx].second);
     }
-    TFullModel result = SumModels(modelPtrs, weights, ctrMergePolicy);
+    TFullModel result = SumModels(modelPtrs, weights, ctrMergePolicy, threadCount);
     OutputModel(result, outputModelPath);
     return 0;
 }
@@ -15,6 +15,8 @@
 #include <catboost/libs/logging/profile_info.h>
 #include <catboost/libs/options/enum_helpers.h>
 
+#include <library/chromium_trace/interface.h>
+
 template <bool StoreExpApprox, int VectorWidth>
 inline void UpdateApproxKernel(const double* leafValues, const TIndexType* indices, double* resArr) {
     Y_ASSERT(VectorWidth == 4);
@@ -112,6 +114,95 @@ static void CalcShiftedApproxDers(
     }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
+// Calculates ders for block blockId of blockParams and accumulates them into per-leaf sums.
+static void CalcApproxDersBlock(
+    const NPar::TLocalExecutor::TExecRangeParams& blockParams,
+    int blockId,
+    const TIndexType* indicesData,
+    const float* targetsData,
+    const float* weightsData,
+    const double* approxesData,
+    const double* approxesDeltaData,
+    const IDerCalcer& error,
+    TDers* approxesDer, // scratch for APPROX_BLOCK_SIZE ders
+    TDers* bucketDers,
+    double* bucketSumWeights
+) {
+    constexpr int innerBlockSize = APPROX_BLOCK_SIZE;
+
+    const int blockStart = blockParams.FirstId + blockId * blockParams.GetBlockSize();
+    const int nextBlockStart = Min(blockParams.LastId, blockStart + blockParams.GetBlockSize());
+
+    for (int innerBlockStart = blockStart; innerBlockStart < nextBlockStart; innerBlockStart += innerBlockSize) {
+        const int nextInnerBlockStart = Min(nextBlockStart, innerBlockStart + innerBlockSize);
+        error.CalcDersRange(
+            innerBlockStart,
+            nextInnerBlockStart - innerBlockStart,
+            /*calcThirdDer=*/false,
+            approxesData,
+            approxesDeltaData,
+            targetsData,
+            weightsData,
+            approxesDer - innerBlockStart
+        );
+        if (weightsData != nullptr) {
+            for (int z = innerBlockStart; z < nextInnerBlockStart; ++z) {
+                TDers& ders = bucketDers[indicesData[z]];
+                ders.Der1 += approxesDer[z - innerBlockStart].Der1;
+                ders.Der2 += approxesDer[z - innerBlockStart].Der2;
+                bucketSumWeights[indicesData[z]] += weightsData[z];
+            }
+        } else {
+            for (int z = innerBlockStart; z < nextInnerBlockStart; ++z) {
+                TDers& ders = bucketDers[indicesData[z]];
+                ders.Der1 += approxesDer[z - innerBlockStart].Der1;
+                ders.Der2 += approxesDer[z - innerBlockStart].Der2;
+                bucketSumWeights[indicesData[z]] += 1;
+            }
+        }
+    }
+}
+
+// Adds per-block leaf sums to buckets in block order.
+static void UpdateBucketsFromBlocks(
+    const TVector<TVector<TDers>>& blockBucketDers,
+    const TVector<TVector<double>>& blockBucketSumWeights,
+    int iteration,
+    ELeavesEstimation estimationMethod,
+    TVector<TSum>* buckets
+) {
+    const int leafCount = buckets->ysize();
+    const int blockCount = blockBucketDers.ysize();
+    if (estimationMethod == ELeavesEstimation::Newton) {
+        for (int leafId = 0; leafId < leafCount; ++leafId) {
+            for (int blockId = 0; blockId < blockCount; ++blockId) {
+                if (blockBucketSumWeights[blockId][leafId] > FLT_EPSILON) {
+                    UpdateBucket<ELeavesEstimation::Newton>(
+                        blockBucketDers[blockId][leafId],
+                        blockBucketSumWeights[blockId][leafId],
+                        iteration,
+                        &(*buckets)[leafId]
+                    );
+                }
+            }
+        }
+    } else {
+        Y_ASSERT(estimationMethod == ELeavesEstimation::Gradient);
+        for (int leafId = 0; leafId < leafCount; ++leafId) {
+            for (int blockId = 0; blockId < blockCount; ++blockId) {
+                if (blockBucketSumWeights[blockId][leafId] > FLT_EPSILON) {
+                    UpdateBucket<ELeavesEstimation::Gradient>(
+                        blockBucketDers[blockId][leafId],
+                        blockBucketSumWeights[blockId][leafId],
+                        iteration,
+                        &(*buckets)[leafId]
+                    );
+                }
+            }
+        }
+    }
+}
+
 static void CalcApproxDersRange(
     const TVector<TIndexType>& indices,
     const TVector<float>& targets,
@@ -144,73 +235,22 @@ static void CalcApproxDersRange(
     const double* approxesDeltaData = approxesDelta.data();
     TDers* weightedDersData = weightedDers->data();
     localExecutor->ExecRange([=, &error](int blockId) {
-        constexpr int innerBlockSize = APPROX_BLOCK_SIZE;
-        TDers* approxesDer = weightedDersData + innerBlockSize * blockId;
-
-        const int blockStart = blockId * blockParams.GetBlockSize();
-        const int nextBlockStart = Min(sampleCount, blockStart + blockParams.GetBlockSize());
-
-        TDers* bucketDers = blockBucketDersData[blockId].data();
-        double* bucketSumWeights = blockBucketSumWeightsData[blockId].data();
-
-        for (int innerBlockStart = blockStart; innerBlockStart < nextBlockStart; innerBlockStart += innerBlockSize) {
-            const int nextInnerBlockStart = Min(nextBlockStart, innerBlockStart + innerBlockSize);
-            error.CalcDersRange(
-                innerBlockStart,
-                nextInnerBlockStart - innerBlockStart,
-                /*calcThirdDer=*/false,
-                approxesData,
-                approxesDeltaData,
-                targetsData,
-                weightsData,
-                approxesDer - innerBlockStart
-            );
-            if (weightsData != nullptr) {
-                for (int z = innerBlockStart; z < nextInnerBlockStart; ++z) {
-                    TDers& ders = bucketDers[indicesData[z]];
-                    ders.Der1 += approxesDer[z - innerBlockStart].Der1;
-                    ders.Der2 += approxesDer[z - innerBlockStart].Der2;
-                    bucketSumWeights[indicesData[z]] += weightsData[z];
-                }
-            } else {
-                for (int z = innerBlockStart; z < nextInnerBlockStart; ++z) {
-                    TDers& ders = bucketDers[indicesData[z]];
-                    ders.Der1 += approxesDer[z - innerBlockStart].Der1;
-                    ders.Der2 += approxesDer[z - innerBlockStart].Der2;
-                    bucketSumWeights[indicesData[z]] += 1;
-                }
-            }
-        }
+        CalcApproxDersBlock(
+            blockParams,
+            blockId,
+            indicesData,
+            targetsData,
+            weightsData,
+            approxesData,
+            approxesDeltaData,
+            error,
+            weightedDersData + APPROX_BLOCK_SIZE * blockId,
+            blockBucketDersData[blockId].data(),
+            blockBucketSumWeightsData[blockId].data()
+        );
     }, 0, blockParams.GetBlockCount(), NPar::TLocalExecutor::WAIT_COMPLETE);
 
-    if (estimationMethod == ELeavesEstimation::Newton) {
-        for (int leafId = 0; leafId < leafCount; ++leafId) {
-            for (int blockId = 0; blockId < blockParams.GetBlockCount(); ++blockId) {
-                if (blockBucketSumWeights[blockId][leafId] > FLT_EPSILON) {
-                    UpdateBucket<ELeavesEstimation::Newton>(
-                        blockBucketDers[blockId][leafId],
-                        blockBucketSumWeights[blockId][leafId],
-                        iteration,
-                        &(*buckets)[leafId]
-                    );
-                }
-            }
-        }
-    } else {
-        Y_ASSERT(estimationMethod == ELeavesEstimation::Gradient);
-        for (int leafId = 0; leafId < leafCount; ++leafId) {
-            for (int blockId = 0; blockId < blockParams.GetBlockCount(); ++blockId) {
-                if (blockBucketSumWeights[blockId][leafId] > FLT_EPSILON) {
-                    UpdateBucket<ELeavesEstimation::Gradient>(
-                        blockBucketDers[blockId][leafId],
-                        blockBucketSumWeights[blockId][leafId],
-                        iteration,
-                        &(*buckets)[leafId]
-                    );
-                }
-            }
-        }
-    }
+    UpdateBucketsFromBlocks(blockBucketDers, blockBucketSumWeights, iteration, estimationMethod, buckets);
 }
 
 void UpdateBucketsSimple(
@@ -473,6 +513,117 @@ static void CalcLeafValuesSimple(
     }
 }
 
+/* Ordered boosting with per-object errors and one approx dimension: leaf values of all body-tails
+ * are estimated together. Each leaf estimation iteration runs one flat parallel pass over
+ * (bodyTail, block) tasks to accumulate derivatives and one more to update approx deltas, instead of
+ * nested per-body-tail parallel loops with small uneven tasks.
+ * Block partition inside each body-tail is the same as in CalcApproxDersRange, so results do not change.
+ */
+static void CalcApproxDeltaSimpleForAllBodyTails(
+    const TFold& ff,
+    int leafCount,
+    const IDerCalcer& error,
+    const TVector<TIndexType>& indices,
+    TLearnContext* ctx,
+    TVector<TVector<TVector<double>>>* approxesDelta // [bodyTailId][approxDim][docIdxInPermuted]
+) {
+    const auto& treeLearnerOptions = ctx->Params.ObliviousTreeOptions.Get();
+    const int gradientIterations = static_cast<int>(treeLearnerOptions.LeavesEstimationIterations);
+    const auto estimationMethod = treeLearnerOptions.LeavesEstimationMethod;
+    const bool storeExpApprox = error.GetIsExpApprox();
+
+    struct TBodyTailBlock {
+        int BodyTailId;
+        int BlockId;
+    };
+
+    // biggest body-tails go first, so that they do not delay the end of the pass
+    const int bodyTailCount = ff.BodyTailArr.ysize();
+    TVector<NPar::TLocalExecutor::TExecRangeParams> dersBlockParams;
+    TVector<NPar::TLocalExecutor::TExecRangeParams> updateBlockParams;
+    TVector<TBodyTailBlock> dersTasks;
+    TVector<TBodyTailBlock> updateTasks;
+    for (int bodyTailId = 0; bodyTailId < bodyTailCount; ++bodyTailId) {
+        const TFold::TBodyTail& bt = ff.BodyTailArr[bodyTailId];
+        dersBlockParams.emplace_back(0, bt.BodyFinish);
+        dersBlockParams.back().SetBlockCount(CB_THREAD_LIMIT);
+        updateBlockParams.emplace_back(0, bt.TailFinish);
+        updateBlockParams.back().SetBlockSize(1000);
+    }
+    for (int bodyTailId = bodyTailCount - 1; bodyTailId >= 0; --bodyTailId) {
+        for (int blockId = 0; blockId < dersBlockParams[bodyTailId].GetBlockCount(); ++blockId) {
+            dersTasks.push_back({bodyTailId, blockId});
+        }
+        for (int blockId = 0; blockId < updateBlockParams[bodyTailId].GetBlockCount(); ++blockId) {
+            updateTasks.push_back({bodyTailId, blockId});
+        }
+    }
+
+    TVector<TDers> scratchDers; // iteration scratch space
+    scratchDers.yresize(dersTasks.size() * APPROX_BLOCK_SIZE);
+    TVector<TVector<TVector<TDers>>> blockBucketDers(bodyTailCount); // [bodyTailId][blockId][leafId]
+    TVector<TVector<TVector<double>>> blockBucketSumWeights(bodyTailCount); // [bodyTailId][blockId][leafId]
+    TVector<TVector<TSum>> buckets(bodyTailCount, TVector<TSum>(leafCount, TSum())); // [bodyTailId][leafId]
+    TVector<TVector<double>> curLeafValues(bodyTailCount); // [bodyTailId][leafId]
+    TArray2D<double> pairwiseBuckets; // unused for per-object errors
+
+    const float* targetsData = ff.LearnTarget.data();
+    const float* weightsData = ff.GetLearnWeights().data();
+    const TIndexType* indicesData = indices.data();
+
+    for (int it = 0; it < gradientIterations; ++it) {
+        for (int bodyTailId = 0; bodyTailId < bodyTailCount; ++bodyTailId) {
+            const int blockCount = dersBlockParams[bodyTailId].GetBlockCount();
+            blockBucketDers[bodyTailId].assign(blockCount, TVector<TDers>(leafCount, TDers{/*Der1*/0.0, /*Der2*/0.0, /*Der3*/0.0}));
+            blockBucketSumWeights[bodyTailId].assign(blockCount, TVector<double>(leafCount, 0));
+        }
+
+        ctx->LocalExecutor->ExecRange([&](int taskId) {
+            const auto [bodyTailId, blockId] = dersTasks[taskId];
+            CalcApproxDersBlock(
+                dersBlockParams[bodyTailId],
+                blockId,
+                indicesData,
+                targetsData,
+                weightsData,
+                ff.BodyTailArr[bodyTailId].Approx[0].data(),
+                (*approxesDelta)[bodyTailId][0].data(),
+                error,
+                scratchDers.data() + APPROX_BLOCK_SIZE * taskId,
+                blockBucketDers[bodyTailId][blockId].data(),
+                blockBucketSumWeights[bodyTailId][blockId].data()
+            );
+        }, 0, dersTasks.ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
+
+        for (int bodyTailId = 0; bodyTailId < bodyTailCount; ++bodyTailId) {
+            const TFold::TBodyTail& bt = ff.BodyTailArr[bodyTailId];
+            for (auto& bucket : buckets[bodyTailId]) {
+                bucket.SetZeroDers();
+            }
+            UpdateBucketsFromBlocks(
+                blockBucketDers[bodyTailId],
+                blockBucketSumWeights[bodyTailId],
+                it,
+                estimationMethod,
+                &buckets[bodyTailId]
+            );
+            CalcMixedModelSimple(buckets[bodyTailId], pairwiseBuckets, ctx->Params, bt.BodySumWeight, bt.BodyFinish, &curLeafValues[bodyTailId]);
+            ExpApproxIf(storeExpApprox, &curLeafValues[bodyTailId]);
+        }
+
+        ctx->LocalExecutor->ExecRange([&](int taskId) {
+            const auto [bodyTailId, blockId] = updateTasks[taskId];
+            const double* leafValuesData = curLeafValues[bodyTailId].data();
+            double* resArrData = (*approxesDelta)[bodyTailId][0].data();
+            if (storeExpApprox) {
+                UpdateApproxBlock</*StoreExpApprox*/ true>(updateBlockParams[bodyTailId], leafValuesData, indicesData, blockId, resArrData);
+            } else {
+                UpdateApproxBlock</*StoreExpApprox*/ false>(updateBlockParams[bodyTailId], leafValuesData, indicesData, blockId, resArrData);
+            }
+        }, 0, updateTasks.ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
+    }
+}
+
 void CalcLeafValues(
     const NCB::TTrainingForCPUDataProviders& data,
     const IDerCalcer& error,
@@ -503,6 +654,8 @@ void CalcApproxForLeafStruct(
     TLearnContext* ctx,
     TVector<TVector<TVector<double>>>* approxesDelta // [bodyTailId][approxDim][docIdxInPermuted]
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcApproxForLeafStruct");
+
     const TVector<TIndexType> indices = BuildIndices(fold, tree, data.Learn, data.Test, ctx->LocalExecutor);
     const int approxDimension = ctx->LearnProgress.ApproxDimension;
     const int leafCount = tree.GetLeafCount();
@@ -511,7 +664,7 @@ void CalcApproxForLeafStruct(
         randomSeeds = GenRandUI64Vector(fold.BodyTailArr.ysize(), randomSeed);
     }
     approxesDelta->resize(fold.BodyTailArr.ysize());
-    ctx->LocalExecutor->ExecRange([&](int bodyTailId) {
+    auto initApproxDelta = [&](int bodyTailId) {
         const TFold::TBodyTail& bt = fold.BodyTailArr[bodyTailId];
         TVector<TVector<double>>& approxDelta = (*approxesDelta)[bodyTailId];
         const double initValue = GetNeutralApprox(error.GetIsExpApprox());
@@ -522,6 +675,20 @@ void CalcApproxForLeafStruct(
                 Fill(deltaDimension.begin(), deltaDimension.end(), initValue);
             }
         }
+    };
+    const bool canProcessBodyTailsTogether = approxDimension == 1
+        && fold.BodyTailArr.ysize() > 1
+        && error.GetErrorType() == EErrorType::PerObjectError
+        && !ctx->Params.BoostingOptions->ApproxOnFullHistory;
+    if (canProcessBodyTailsTogether) {
+        ctx->LocalExecutor->ExecRange(initApproxDelta, 0, fold.BodyTailArr.ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
+        CalcApproxDeltaSimpleForAllBodyTails(fold, leafCount, error, indices, ctx, approxesDelta);
+        return;
+    }
+    ctx->LocalExecutor->ExecRange([&](int bodyTailId) {
+        const TFold::TBodyTail& bt = fold.BodyTailArr[bodyTailId];
+        TVector<TVector<double>>& approxDelta = (*approxesDelta)[bodyTailId];
+        initApproxDelta(bodyTailId);
         if (approxDimension == 1) {
             CalcApproxDeltaSimple(fold, bt, leafCount, error, indices, randomSeeds[bodyTailId], ctx, &approxDelta, /*sumLeafValues*/ nullptr);
         } else {
@@ -0,0 +1,77 @@
+#include "async_metrics.h"
+#include "helpers.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/chromium_trace/interface.h>
+
+
+using namespace NCB;
+
+
+TAsyncMetricEvaluator::TAsyncMetricEvaluator(
+    const TTrainingForCPUDataProviders& data,
+    const TVector<THolder<IMetric>>& metrics,
+    int threadCount,
+    TMetricsAndTimeLeftHistory* metricsAndTimeHistory
+)
+    : Data(data)
+    , Metrics(metrics)
+    , MetricsAndTimeHistory(metricsAndTimeHistory)
+{
+    CB_ENSURE(threadCount > 0, "Asynchronous metric evaluation needs at least one thread");
+    LocalExecutor.RunAdditionalThreads(threadCount);
+}
+
+TAsyncMetricEvaluator::~TAsyncMetricEvaluator() {
+    // evaluation refers to the snapshot buffers, they must outlive it
+    if (IsRunning()) {
+        Result.Wait();
+    }
+}
+
+void TAsyncMetricEvaluator::Start(
+    int iteration,
+    const TLearnProgress& progress,
+    bool calcAllMetrics,
+    bool calcErrorTrackerMetric
+) {
+    CB_ENSURE_INTERNAL(!IsRunning(), "Previous metric evaluation is not finished");
+    CHROMIUM_TRACE_FUNCTION();
+
+    // assignment reuses the buffers of the previous snapshot
+    LearnApprox = progress.AvrgApprox;
+    TestApprox = progress.TestApprox;
+
+    Iteration = iteration;
+    CalcAllMetrics = calcAllMetrics;
+    CalcErrorTrackerMetric = calcErrorTrackerMetric;
+    Result = LocalExecutor.ExecRangeWithFutures(
+        [this] (int /*id*/) {
+            CHROMIUM_TRACE_SCOPE("Async metrics");
+            CalcErrors(
+                Data,
+                Metrics,
+                LearnApprox,
+                TestApprox,
+                CalcAllMetrics,
+                CalcErrorTrackerMetric,
+                &LocalExecutor,
+                MetricsAndTimeHistory
+            );
+        },
+        0,
+        1,
+        NPar::TLocalExecutor::HIGH_PRIORITY
+    )[0];
+}
+
+int TAsyncMetricEvaluator::Finish() {
+    CB_ENSURE_INTERNAL(IsRunning(), "No metric evaluation to finish");
+    CHROMIUM_TRACE_FUNCTION();
+
+    const int iteration = *Iteration;
+    Iteration.Clear();
+    Result.GetValueSync();
+    return iteration;
+}
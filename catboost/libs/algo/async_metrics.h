@@ -0,0 +1,69 @@
+#pragma once
+
+#include "learn_context.h"
+
+#include <catboost/libs/data_new/data_provider.h>
+#include <catboost/libs/loggers/catboost_logger_helpers.h>
+#include <catboost/libs/metrics/metric.h>
+
+#include <library/threading/future/future.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/maybe.h>
+#include <util/generic/ptr.h>
+#include <util/generic/vector.h>
+
+
+/* Evaluates metrics of a training iteration on a dedicated local executor while the next iteration is trained.
+ * Start() copies approxes of the iteration to a snapshot buffer, so the live approxes can be updated by the next
+ * iteration right away. Only one evaluation can be in flight, so metrics lag training by at most one iteration.
+ * Results are appended to metricsAndTimeHistory, it must not be accessed by other threads until Finish() returns.
+ */
+class TAsyncMetricEvaluator {
+public:
+    TAsyncMetricEvaluator(
+        const NCB::TTrainingForCPUDataProviders& data,
+        const TVector<THolder<IMetric>>& metrics,
+        int threadCount,
+        TMetricsAndTimeLeftHistory* metricsAndTimeHistory
+    );
+    ~TAsyncMetricEvaluator();
+
+    // previous evaluation must be finished
+    void Start(int iteration, const TLearnProgress& progress, bool calcAllMetrics, bool calcErrorTrackerMetric);
+
+    // waits for the evaluation started last and returns its iteration, rethrows its exception
+    int Finish();
+
+    bool IsRunning() const {
+        return Iteration.Defined();
+    }
+    bool GetCalcAllMetrics() const {
+        return CalcAllMetrics;
+    }
+    bool GetCalcErrorTrackerMetric() const {
+        return CalcErrorTrackerMetric;
+    }
+
+    // approxes the last evaluation was started on
+    const TVector<TVector<double>>& GetLearnApprox() const {
+        return LearnApprox;
+    }
+    const TVector<TVector<TVector<double>>>& GetTestApprox() const {
+        return TestApprox;
+    }
+
+private:
+    const NCB::TTrainingForCPUDataProviders& Data;
+    const TVector<THolder<IMetric>>& Metrics;
+    TMetricsAndTimeLeftHistory* MetricsAndTimeHistory;
+    NPar::TLocalExecutor LocalExecutor;
+
+    TVector<TVector<double>> LearnApprox;         //       [dim][docIdx]
+    TVector<TVector<TVector<double>>> TestApprox; // [test][dim][docIdx]
+
+    TMaybe<int> Iteration;
+    bool CalcAllMetrics = false;
+    bool CalcErrorTrackerMetric = false;
+    NThreading::TFuture<void> Result;
+};
@@ -0,0 +1,486 @@
+/* Microbenchmarks of the CPU kernels training and inference time is spent in.
+ * All datasets are generated with fixed seeds (see synthetic_data.h), so results are comparable between runs.
+ * Use --format json (or csv) to get machine readable results.
+ */
+
+#include "synthetic_data.h"
+
+#include <catboost/libs/algo/helpers.h>
+#include <catboost/libs/algo/index_calcer.h>
+#include <catboost/libs/algo/learn_context.h>
+#include <catboost/libs/algo/online_ctr.h>
+#include <catboost/libs/algo/score_calcer.h>
+#include <catboost/libs/algo/tensor_search_helpers.h>
+#include <catboost/libs/data_new/load_data.h>
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/labels/label_converter.h>
+#include <catboost/libs/metrics/auc.h>
+#include <catboost/libs/metrics/sample.h>
+#include <catboost/libs/model/formula_evaluator.h>
+#include <catboost/libs/model/model.h>
+#include <catboost/libs/model/static_ctr_provider.h>
+#include <catboost/libs/options/catboost_options.h>
+#include <catboost/libs/options/load_options.h>
+#include <catboost/libs/options/output_file_options.h>
+#include <catboost/libs/options/plain_options_helper.h>
+#include <catboost/libs/train_lib/data.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/json/json_value.h>
+#include <library/testing/benchmark/bench.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/utility.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+
+
+using namespace NCB;
+using NBenchmark::TSyntheticPool;
+
+
+namespace {
+    constexpr ui32 OBJECT_COUNT = 100000;
+
+    struct TDensePool : public TSyntheticPool {
+        TDensePool()
+            : TSyntheticPool(NBenchmark::GenerateDensePool(OBJECT_COUNT, /*featureCount*/ 50, /*seed*/ 0))
+        {}
+    };
+
+    struct TSparsePool : public TSyntheticPool {
+        TSparsePool()
+            : TSyntheticPool(
+                NBenchmark::GenerateSparsePool(OBJECT_COUNT, /*featureCount*/ 200, /*density*/ 0.05f, /*seed*/ 0)
+            )
+        {}
+    };
+
+    struct TCategoricalPool : public TSyntheticPool {
+        TCategoricalPool()
+            : TSyntheticPool(
+                NBenchmark::GenerateCategoricalPool(
+                    OBJECT_COUNT,
+                    /*floatFeatureCount*/ 10,
+                    /*catFeatureCount*/ 20,
+                    /*maxCardinality*/ 10000,
+                    /*seed*/ 0
+                )
+            )
+        {}
+    };
+
+    struct TRankingPool : public TSyntheticPool {
+        TRankingPool()
+            : TSyntheticPool(
+                NBenchmark::GenerateRankingPool(
+                    OBJECT_COUNT,
+                    /*featureCount*/ 50,
+                    /*minGroupSize*/ 2,
+                    /*maxGroupSize*/ 100,
+                    /*seed*/ 0
+                )
+            )
+        {}
+    };
+
+
+    // Model trained on TPool and the pool binarized for it in blocks, the same way model evaluation does it
+    template <class TPool>
+    struct TAppliedModel {
+        static constexpr ui32 TREE_COUNT = 100;
+
+        const TPool& Pool = *Singleton<TPool>();
+        const size_t BlockSize = FORMULA_EVALUATION_BLOCK_SIZE;
+        TFullModel Model;
+        TVector<TVector<ui8>> BinFeatures; // [blockIdx]
+        TVector<TVector<ui32>> TransposedHashes; // [blockIdx]
+
+    public:
+        TAppliedModel() {
+            NJson::TJsonValue plainFitParams;
+            plainFitParams.InsertValue("iterations", TREE_COUNT);
+            plainFitParams.InsertValue("random_seed", 0);
+            plainFitParams.InsertValue("allow_writing_files", false);
+            plainFitParams.InsertValue("logging_level", "Silent");
+
+            TDataProviders dataProviders;
+            dataProviders.Learn = Pool.CreateDataProvider();
+            TrainModel(plainFitParams, nullptr, Nothing(), Nothing(), dataProviders, "", &Model, {});
+            CB_ENSURE(
+                !Model.HasCategoricalFeatures() || dynamic_cast<TStaticCtrProvider*>(Model.CtrProvider.Get()),
+                "Expected model with static ctr provider"
+            );
+
+            TVector<float> ctrs;
+            for (size_t blockStart = 0; blockStart < Pool.ObjectCount; blockStart += BlockSize) {
+                BinFeatures.emplace_back();
+                TransposedHashes.emplace_back();
+                BinarizeBlock(blockStart, &BinFeatures.back(), &TransposedHashes.back(), &ctrs);
+            }
+        }
+
+        size_t GetBlockCount() const {
+            return BinFeatures.size();
+        }
+
+        size_t GetBlockSize(size_t blockIdx) const {
+            return Min(BlockSize, Pool.ObjectCount - blockIdx * BlockSize);
+        }
+
+        void BinarizeBlock(
+            size_t blockStart,
+            TVector<ui8>* binFeatures,
+            TVector<ui32>* transposedHash,
+            TVector<float>* ctrs
+        ) const {
+            const size_t blockEnd = Min<size_t>(blockStart + BlockSize, Pool.ObjectCount);
+            const size_t docCount = blockEnd - blockStart;
+            binFeatures->yresize(docCount * Model.ObliviousTrees.GetEffectiveBinaryFeaturesBucketsCount());
+            transposedHash->yresize(docCount * Model.GetUsedCatFeaturesCount());
+            ctrs->yresize(docCount * Model.ObliviousTrees.GetUsedModelCtrs().size());
+            BinarizeFeatures(
+                Model,
+                [this] (const TFloatFeature& floatFeature, size_t objectIdx) -> float {
+                    return Pool.FloatFeatures[floatFeature.FeatureIndex][objectIdx];
+                },
+                [this] (const TCatFeature& catFeature, size_t objectIdx) -> ui32 {
+                    return Pool.HashedCatFeatures[catFeature.FeatureIndex][objectIdx];
+                },
+                blockStart,
+                blockEnd,
+                *binFeatures,
+                *transposedHash,
+                *ctrs
+            );
+        }
+    };
+
+
+    /* Learn context with initialized folds and sampled documents as they are before the split of level Depth is selected.
+     * Splits of the previous levels are median borders of the first Depth float features.
+     */
+    template <class TPool, int Depth = 0>
+    struct TTrainingContext {
+        NPar::TLocalExecutor LocalExecutor;
+        TTrainingForCPUDataProviders Data;
+        THolder<TLearnContext> Ctx;
+        TVector<int> SplitCounts;
+
+    public:
+        TTrainingContext() {
+            NJson::TJsonValue plainFitParams;
+            plainFitParams.InsertValue("boosting_type", "Plain");
+            plainFitParams.InsertValue("random_seed", 0);
+            plainFitParams.InsertValue("allow_writing_files", false);
+            plainFitParams.InsertValue("logging_level", "Silent");
+
+            NJson::TJsonValue trainOptionsJson;
+            NJson::TJsonValue outputOptionsJson;
+            NCatboostOptions::PlainJsonToOptions(plainFitParams, &trainOptionsJson, &outputOptionsJson);
+            auto params = NCatboostOptions::LoadOptions(trainOptionsJson);
+            NCatboostOptions::TOutputFilesOptions outputOptions;
+            outputOptions.Load(outputOptionsJson);
+
+            LocalExecutor.RunAdditionalThreads(params.SystemOptions->NumThreads - 1);
+
+            TDataProviders dataProviders;
+            dataProviders.Learn = Singleton<TPool>()->CreateDataProvider();
+            TRestorableFastRng64 rand(params.RandomSeed);
+            TLabelConverter labelConverter;
+            TTrainingDataProviders trainingData = GetTrainingData(
+                std::move(dataProviders),
+                /*bordersFile*/ Nothing(),
+                /*ensureConsecutiveLearnFeaturesDataForCpu*/ true,
+                /*allowWriteFiles*/ false,
+                /*quantizedFeaturesInfo*/ nullptr,
+                &params,
+                &labelConverter,
+                &LocalExecutor,
+                &rand
+            );
+            Data = trainingData.Cast<TQuantizedForCPUObjectsDataProvider>();
+
+            Ctx = MakeHolder<TLearnContext>(
+                params,
+                /*objectiveDescriptor*/ Nothing(),
+                /*evalMetricDescriptor*/ Nothing(),
+                outputOptions,
+                Data.Learn->MetaInfo.FeaturesLayout,
+                /*initRand*/ Nothing(),
+                &LocalExecutor
+            );
+            Ctx->LearnProgress.ApproxDimension = 1;
+            const auto& quantizedFeaturesInfo = *Data.Learn->ObjectsData->GetQuantizedFeaturesInfo();
+            Ctx->LearnProgress.FloatFeatures = CreateFloatFeatures(quantizedFeaturesInfo);
+            Ctx->LearnProgress.CatFeatures = CreateCatFeatures(quantizedFeaturesInfo);
+            Ctx->InitContext(Data);
+            SplitCounts = CountSplits(Ctx->LearnProgress.FloatFeatures);
+
+            TFold& fold = Ctx->LearnProgress.Folds[0];
+            const auto error = BuildError(Ctx->Params, Nothing());
+            CalcWeightedDerivatives(*error, /*bodyTailIdx*/ 0, Ctx->Params, /*randomSeed*/ 0, &fold, &LocalExecutor);
+            Ctx->SampledDocs.Create(
+                Ctx->LearnProgress.Folds,
+                /*isPairwiseScoring*/ false,
+                static_cast<int>(Ctx->Params.ObliviousTreeOptions->DevScoreCalcObjBlockSize)
+            );
+            TVector<TIndexType> indices(Data.Learn->GetObjectCount()); // all objects in the root
+            CB_ENSURE(Depth <= SplitCounts.ysize(), "Not enough float features for a tree of depth " << Depth);
+            for (auto curDepth : xrange(Depth)) {
+                CB_ENSURE(SplitCounts[curDepth] > 0, "Float feature " << curDepth << " has no borders");
+                TSplitCandidate splitCandidate;
+                splitCandidate.Type = ESplitType::FloatFeature;
+                splitCandidate.FeatureIdx = curDepth;
+                const TSplit split(splitCandidate, /*border*/ SplitCounts[curDepth] / 2);
+                SetPermutedIndices(split, *Data.Learn->ObjectsData, curDepth + 1, fold, &indices, &LocalExecutor);
+            }
+            Bootstrap(Ctx->Params, indices, &fold, &Ctx->SampledDocs, &LocalExecutor, &Ctx->Rand);
+        }
+    };
+
+
+    template <class TPool>
+    struct TDsvPoolFile {
+        TTempFile PoolFile;
+        TTempFile CdFile;
+
+    public:
+        TDsvPoolFile()
+            : PoolFile(MakeTempName())
+            , CdFile(MakeTempName())
+        {
+            Singleton<TPool>()->SaveAsDsv(PoolFile.Name(), CdFile.Name());
+        }
+    };
+
+
+    // binary target and predictions correlated with it
+    struct TAucSamples {
+        TVector<NMetrics::TSample> Samples;
+
+    public:
+        TAucSamples() {
+            const auto& pool = *Singleton<TDensePool>();
+            Samples.reserve(pool.ObjectCount);
+            for (auto objectIdx : xrange(pool.ObjectCount)) {
+                Samples.emplace_back(
+                    pool.Target[objectIdx] > 0.8f,
+                    pool.FloatFeatures[0][objectIdx] + pool.FloatFeatures[2][objectIdx]
+                );
+            }
+        }
+    };
+}
+
+
+template <class TPool>
+static void BinarizeFeaturesForModel() {
+    const auto& appliedModel = *Singleton<TAppliedModel<TPool>>();
+    TVector<ui8> binFeatures;
+    TVector<ui32> transposedHash;
+    TVector<float> ctrs;
+    for (auto blockIdx : xrange(appliedModel.GetBlockCount())) {
+        appliedModel.BinarizeBlock(blockIdx * appliedModel.BlockSize, &binFeatures, &transposedHash, &ctrs);
+        Y_DO_NOT_OPTIMIZE_AWAY(binFeatures.data());
+    }
+}
+
+template <class TPool>
+static void CalcTreesForModel() {
+    const auto& appliedModel = *Singleton<TAppliedModel<TPool>>();
+    const auto& model = appliedModel.Model;
+    const auto calcTrees = GetCalcTreesFunction(model, appliedModel.BlockSize);
+    TVector<TCalcerIndexType> indexesVec(appliedModel.BlockSize);
+    TVector<double> results(appliedModel.BlockSize * model.ObliviousTrees.ApproxDimension);
+    for (auto blockIdx : xrange(appliedModel.GetBlockCount())) {
+        Fill(results.begin(), results.end(), 0.0);
+        calcTrees(
+            model,
+            appliedModel.BinFeatures[blockIdx].data(),
+            appliedModel.GetBlockSize(blockIdx),
+            indexesVec.data(),
+            0,
+            model.GetTreeCount(),
+            results.data()
+        );
+        Y_DO_NOT_OPTIMIZE_AWAY(results.data());
+    }
+}
+
+static void CalcStaticCtrs() {
+    const auto& appliedModel = *Singleton<TAppliedModel<TCategoricalPool>>();
+    const auto& model = appliedModel.Model;
+    const auto& usedCtrs = model.ObliviousTrees.GetUsedModelCtrs();
+    TVector<float> ctrs;
+    for (auto blockIdx : xrange(appliedModel.GetBlockCount())) {
+        const size_t docCount = appliedModel.GetBlockSize(blockIdx);
+        ctrs.yresize(usedCtrs.size() * docCount);
+        model.CtrProvider->CalcCtrs(
+            usedCtrs,
+            appliedModel.BinFeatures[blockIdx],
+            appliedModel.TransposedHashes[blockIdx],
+            docCount,
+            ctrs
+        );
+        Y_DO_NOT_OPTIMIZE_AWAY(ctrs.data());
+    }
+}
+
+// scores of all float features splits for the level Depth of a tree (objects are split between 2^Depth leaves)
+template <class TPool, int Depth>
+static void CalcStatsAndScoresForFloatFeatures() {
+    auto& trainingContext = *Singleton<TTrainingContext<TPool, Depth>>();
+    auto& ctx = *trainingContext.Ctx;
+    TFold& fold = ctx.LearnProgress.Folds[0];
+    TVector<TScoreBin> scoreBins;
+    for (auto floatFeatureIdx : xrange(ctx.LearnProgress.FloatFeatures.size())) {
+        TSplitCandidate split;
+        split.Type = ESplitType::FloatFeature;
+        split.FeatureIdx = floatFeatureIdx;
+        CalcStatsAndScores(
+            *trainingContext.Data.Learn->ObjectsData,
+            trainingContext.SplitCounts,
+            fold.GetAllCtrs(),
+            ctx.SampledDocs,
+            ctx.SmallestSplitSideDocs,
+            &fold,
+            /*pairs*/ TFlatPairsInfo(),
+            ctx.Params,
+            split,
+            Depth,
+            /*useTreeLevelCaching*/ false,
+            &trainingContext.LocalExecutor,
+            &ctx.ScratchArena,
+            &ctx.PrevTreeLevelStats,
+            /*stats3d*/ nullptr,
+            /*pairwiseStats*/ nullptr,
+            &scoreBins
+        );
+        Y_DO_NOT_OPTIMIZE_AWAY(scoreBins.data());
+    }
+    ctx.ScratchArena.Reset();
+}
+
+static void ComputeOnlineCtrsForCatFeatures() {
+    auto& trainingContext = *Singleton<TTrainingContext<TCategoricalPool>>();
+    auto& ctx = *trainingContext.Ctx;
+    const TFold& fold = ctx.LearnProgress.Folds[0];
+    TOnlineCTR onlineCtr;
+    for (auto catFeatureIdx : xrange(ctx.LearnProgress.CatFeatures.size())) {
+        TProjection projection;
+        projection.AddCatFeature(catFeatureIdx);
+        ComputeOnlineCTRs(trainingContext.Data, fold, projection, &ctx, &onlineCtr);
+        Y_DO_NOT_OPTIMIZE_AWAY(onlineCtr.Feature.data());
+    }
+}
+
+template <class TPool>
+static void ReadDsvPool() {
+    const auto& poolFile = *Singleton<TDsvPoolFile<TPool>>();
+    NCatboostOptions::TDsvPoolFormatParams dsvPoolFormatParams;
+    dsvPoolFormatParams.CdFilePath = TPathWithScheme(poolFile.CdFile.Name(), "file");
+    auto dataProvider = ReadDataset(
+        TPathWithScheme(poolFile.PoolFile.Name(), "dsv"),
+        TPathWithScheme(),
+        TPathWithScheme(),
+        dsvPoolFormatParams,
+        /*ignoredFeatures*/ {},
+        EObjectsOrder::Undefined,
+        &NPar::LocalExecutor()
+    );
+    Y_DO_NOT_OPTIMIZE_AWAY(dataProvider.Get());
+}
+
+
+// Model application: binarization (includes ctr calculation for categorical features) and trees evaluation
+Y_CPU_BENCHMARK(BinarizeFeaturesDense, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        BinarizeFeaturesForModel<TDensePool>();
+    }
+}
+
+Y_CPU_BENCHMARK(BinarizeFeaturesSparse, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        BinarizeFeaturesForModel<TSparsePool>();
+    }
+}
+
+Y_CPU_BENCHMARK(BinarizeFeaturesCategorical, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        BinarizeFeaturesForModel<TCategoricalPool>();
+    }
+}
+
+Y_CPU_BENCHMARK(CalcTreesBlockedDense, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        CalcTreesForModel<TDensePool>();
+    }
+}
+
+Y_CPU_BENCHMARK(CalcTreesBlockedCategorical, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        CalcTreesForModel<TCategoricalPool>();
+    }
+}
+
+Y_CPU_BENCHMARK(StaticCtrProviderCalcCtrs, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        CalcStaticCtrs();
+    }
+}
+
+// Training: split scoring and online ctrs
+Y_CPU_BENCHMARK(CalcStatsAndScoresDenseDepth0, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        CalcStatsAndScoresForFloatFeatures<TDensePool, 0>();
+    }
+}
+
+Y_CPU_BENCHMARK(CalcStatsAndScoresDenseDepth5, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        CalcStatsAndScoresForFloatFeatures<TDensePool, 5>();
+    }
+}
+
+Y_CPU_BENCHMARK(CalcStatsAndScoresSparseDepth0, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        CalcStatsAndScoresForFloatFeatures<TSparsePool, 0>();
+    }
+}
+
+Y_CPU_BENCHMARK(ComputeOnlineCTRs, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        ComputeOnlineCtrsForCatFeatures();
+    }
+}
+
+// Metrics
+Y_CPU_BENCHMARK(CalcAUC, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        auto samples = Singleton<TAucSamples>()->Samples; // CalcAUC reorders samples
+        Y_DO_NOT_OPTIMIZE_AWAY(CalcAUC(&samples));
+    }
+}
+
+// Data loading
+Y_CPU_BENCHMARK(ReadDsvDense, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        ReadDsvPool<TDensePool>();
+    }
+}
+
+Y_CPU_BENCHMARK(ReadDsvCategorical, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        ReadDsvPool<TCategoricalPool>();
+    }
+}
+
+Y_CPU_BENCHMARK(ReadDsvRanking, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        ReadDsvPool<TRankingPool>();
+    }
+}
@@ -0,0 +1,239 @@
+#include "synthetic_data.h"
+
+#include <catboost/libs/algo/yetirank_helpers.h>
+#include <catboost/libs/labels/label_converter.h>
+#include <catboost/libs/options/catboost_options.h>
+#include <catboost/libs/options/load_options.h>
+#include <catboost/libs/options/plain_options_helper.h>
+#include <catboost/libs/train_lib/data.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/json/json_value.h>
+#include <library/testing/benchmark/bench.h>
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/singleton.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/stream/output.h>
+
+#include <cmath>
+
+
+using namespace NCB;
+
+
+namespace {
+    // Same synthetic regression dataset for all benchmarks, so Plain and Ordered costs are comparable
+    struct TSyntheticDataset {
+        static constexpr ui32 OBJECT_COUNT = 100000;
+        static constexpr ui32 FEATURE_COUNT = 20;
+
+        TDataProviders DataProviders;
+
+    public:
+        TSyntheticDataset() {
+            DataProviders.Learn = NBenchmark::GenerateDensePool(OBJECT_COUNT, FEATURE_COUNT, /*seed*/ 0)
+                .CreateDataProvider();
+        }
+    };
+
+    // Mostly zero features quantize to long runs of the default bin, so they are compressible unlike dense ones
+    struct TCompressibleSyntheticDataset {
+        static constexpr ui32 OBJECT_COUNT = 100000;
+        static constexpr ui32 FEATURE_COUNT = 20;
+
+        NBenchmark::TSyntheticPool Pool;
+        TDataProviders DataProviders;
+
+    public:
+        TCompressibleSyntheticDataset()
+            : Pool(NBenchmark::GenerateSparsePool(OBJECT_COUNT, FEATURE_COUNT, /*density*/ 0.05f, /*seed*/ 0))
+        {
+            DataProviders.Learn = Pool.CreateDataProvider();
+        }
+    };
+
+    // Quantized float features size of TCompressibleSyntheticDataset with and without lz4 compression
+    struct TLz4CompressedFeaturesSize {
+        size_t RawSize = 0;
+        size_t CompressedSize = 0;
+
+    public:
+        TLz4CompressedFeaturesSize() {
+            NJson::TJsonValue plainFitParams;
+            plainFitParams.InsertValue("quantized_features_compression_codec", "lz4");
+            plainFitParams.InsertValue("random_seed", 0);
+            NJson::TJsonValue trainOptionsJson;
+            NJson::TJsonValue outputOptionsJson;
+            NCatboostOptions::PlainJsonToOptions(plainFitParams, &trainOptionsJson, &outputOptionsJson);
+            auto params = NCatboostOptions::LoadOptions(trainOptionsJson);
+
+            NPar::TLocalExecutor localExecutor;
+            localExecutor.RunAdditionalThreads(params.SystemOptions->NumThreads - 1);
+
+            TDataProviders dataProviders;
+            dataProviders.Learn = Singleton<TCompressibleSyntheticDataset>()->Pool.CreateDataProvider();
+            TRestorableFastRng64 rand(params.RandomSeed);
+            TLabelConverter labelConverter;
+            const auto learnData = GetTrainingData(
+                std::move(dataProviders),
+                /*bordersFile*/ Nothing(),
+                /*ensureConsecutiveLearnFeaturesDataForCpu*/ true,
+                /*allowWriteFiles*/ false,
+                /*quantizedFeaturesInfo*/ nullptr,
+                &params,
+                &labelConverter,
+                &localExecutor,
+                &rand
+            ).Cast<TQuantizedForCPUObjectsDataProvider>().Learn;
+
+            const auto& objectsData = *learnData->ObjectsData;
+            for (auto floatFeatureIdx : xrange(objectsData.GetFeaturesLayout()->GetFloatFeatureCount())) {
+                const auto feature = objectsData.GetBlockCompressedFloatFeature(floatFeatureIdx);
+                if (feature) {
+                    RawSize += (*feature)->GetSrcData().GetSize();
+                    CompressedSize += (*feature)->GetSrcData().GetCompressedSize();
+                }
+            }
+        }
+    };
+
+    constexpr ui32 TREE_COUNT = 20;
+
+
+    // Random relevances and approxes for queries with sizes drawn from [minQuerySize, maxQuerySize]
+    struct TSyntheticQueries {
+        static constexpr ui32 DOC_COUNT = 200000;
+
+        TVector<float> Relevs;
+        TVector<double> ExpApproxes;
+        TVector<ui32> QueryBegins; // with DOC_COUNT at the end
+
+    public:
+        TSyntheticQueries(ui32 minQuerySize, ui32 maxQuerySize) {
+            TReallyFastRng32 rng(0);
+            Relevs.yresize(DOC_COUNT);
+            ExpApproxes.yresize(DOC_COUNT);
+            for (auto docIdx : xrange(DOC_COUNT)) {
+                Relevs[docIdx] = rng.Uniform(5);
+                ExpApproxes[docIdx] = exp(rng.GenRandReal2() - 0.5);
+            }
+            for (ui32 begin = 0; begin < DOC_COUNT; begin += minQuerySize + rng.Uniform(maxQuerySize - minQuerySize + 1)) {
+                QueryBegins.push_back(begin);
+            }
+            QueryBegins.push_back(DOC_COUNT);
+        }
+    };
+
+    template <ui32 MinQuerySize, ui32 MaxQuerySize>
+    struct TSyntheticQueriesOfSize : public TSyntheticQueries {
+        TSyntheticQueriesOfSize()
+            : TSyntheticQueries(MinQuerySize, MaxQuerySize)
+        {}
+    };
+}
+
+static void TrainSyntheticModel(
+    const TString& boostingType,
+    const TDataProviders& dataProviders,
+    const TString& compressionCodec = TString()
+) {
+    NJson::TJsonValue plainFitParams;
+    plainFitParams.InsertValue("iterations", TREE_COUNT);
+    plainFitParams.InsertValue("boosting_type", boostingType);
+    plainFitParams.InsertValue("random_seed", 0);
+    plainFitParams.InsertValue("allow_writing_files", false);
+    plainFitParams.InsertValue("logging_level", "Silent");
+    if (compressionCodec) {
+        plainFitParams.InsertValue("quantized_features_compression_codec", compressionCodec);
+    }
+
+    TFullModel model;
+    TrainModel(
+        plainFitParams,
+        nullptr,
+        Nothing(),
+        Nothing(),
+        dataProviders,
+        "",
+        &model,
+        {}
+    );
+    Y_DO_NOT_OPTIMIZE_AWAY(model.GetTreeCount());
+}
+
+template <ui32 MinQuerySize, ui32 MaxQuerySize>
+static void GenerateYetiRankPairs() {
+    const auto& queries = *Singleton<TSyntheticQueriesOfSize<MinQuerySize, MaxQuerySize>>();
+    TYetiRankPairsBuffers buffers;
+    TVector<TVector<TCompetitor>> competitors;
+    for (auto queryIdx : xrange(queries.QueryBegins.size() - 1)) {
+        const ui32 begin = queries.QueryBegins[queryIdx];
+        GenerateYetiRankPairsForQuery(
+            queries.Relevs.data() + begin,
+            queries.ExpApproxes.data() + begin,
+            /*queryWeight*/ 1.0f,
+            queries.QueryBegins[queryIdx + 1] - begin,
+            /*permutationCount*/ 10,
+            /*decaySpeed*/ 0.99,
+            /*randomSeed*/ queryIdx,
+            &buffers,
+            &competitors
+        );
+        Y_DO_NOT_OPTIMIZE_AWAY(competitors.data());
+    }
+}
+
+// Compare these two to get the extra per-iteration cost of ordered boosting (divide by TREE_COUNT)
+Y_CPU_BENCHMARK(TrainPlainBoosting, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        TrainSyntheticModel("Plain", Singleton<TSyntheticDataset>()->DataProviders);
+    }
+}
+
+Y_CPU_BENCHMARK(TrainOrderedBoosting, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        TrainSyntheticModel("Ordered", Singleton<TSyntheticDataset>()->DataProviders);
+    }
+}
+
+// Compare these two to get the cost of decompressing quantized features during training
+Y_CPU_BENCHMARK(TrainPlainBoostingCompressibleFeatures, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        TrainSyntheticModel("Plain", Singleton<TCompressibleSyntheticDataset>()->DataProviders);
+    }
+}
+
+Y_CPU_BENCHMARK(TrainPlainBoostingLz4CompressedFeatures, iface) {
+    const auto& featuresSize = *Singleton<TLz4CompressedFeaturesSize>();
+    static bool sizeReported = false;
+    if (!sizeReported) {
+        Cerr << "TrainPlainBoostingLz4CompressedFeatures: quantized float features take " << featuresSize.RawSize
+            << " bytes raw, " << featuresSize.CompressedSize << " bytes compressed with lz4" << Endl;
+        sizeReported = true;
+    }
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        TrainSyntheticModel("Plain", Singleton<TCompressibleSyntheticDataset>()->DataProviders, "lz4");
+    }
+}
+
+// YetiRank pairs generation for the same number of documents split into queries of different sizes
+Y_CPU_BENCHMARK(GenerateYetiRankPairsSmallQueries, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        GenerateYetiRankPairs<2, 50>();
+    }
+}
+
+Y_CPU_BENCHMARK(GenerateYetiRankPairsMediumQueries, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        GenerateYetiRankPairs<100, 1000>();
+    }
+}
+
+Y_CPU_BENCHMARK(GenerateYetiRankPairsLargeQueries, iface) {
+    for (size_t i = 0; i < iface.Iterations(); ++i) {
+        GenerateYetiRankPairs<1000, 5000>();
+    }
+}
@@ -0,0 +1,222 @@
+#include "synthetic_data.h"
+
+#include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/data_new/data_provider_builders.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/stream/file.h>
+#include <util/string/cast.h>
+
+#include <cmath>
+#include <numeric>
+
+
+namespace NCB {
+    namespace NBenchmark {
+
+        TDataProviderPtr TSyntheticPool::CreateDataProvider() const {
+            return NCB::CreateDataProvider(
+                [&] (IRawFeaturesOrderDataVisitor* visitor) {
+                    TVector<ui32> catFeatureIndices(CatFeatures.size());
+                    std::iota(catFeatureIndices.begin(), catFeatureIndices.end(), FloatFeatures.size());
+
+                    TDataMetaInfo metaInfo;
+                    metaInfo.HasTarget = true;
+                    metaInfo.HasGroupId = !GroupIds.empty();
+                    metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                        GetFeatureCount(),
+                        std::move(catFeatureIndices),
+                        TVector<TString>{}
+                    );
+
+                    visitor->Start(metaInfo, ObjectCount, EObjectsOrder::Undefined, {});
+                    for (auto objectIdx : xrange(GroupIds.size())) {
+                        visitor->AddGroupId(objectIdx, GroupIds[objectIdx]);
+                    }
+                    for (auto floatFeatureIdx : xrange(FloatFeatures.size())) {
+                        visitor->AddFloatFeature(
+                            floatFeatureIdx,
+                            TMaybeOwningConstArrayHolder<float>::CreateOwning(
+                                TVector<float>(FloatFeatures[floatFeatureIdx])
+                            )
+                        );
+                    }
+                    for (auto catFeatureIdx : xrange(CatFeatures.size())) {
+                        visitor->AddCatFeature(FloatFeatures.size() + catFeatureIdx, CatFeatures[catFeatureIdx]);
+                    }
+                    visitor->AddTarget(Target);
+                    visitor->Finish();
+                }
+            );
+        }
+
+        void TSyntheticPool::SaveAsDsv(const TString& poolPath, const TString& cdPath) const {
+            {
+                TOFStream cd(cdPath);
+                ui32 columnIdx = 0;
+                cd << columnIdx++ << "\tLabel\n";
+                if (!GroupIds.empty()) {
+                    cd << columnIdx++ << "\tGroupId\n";
+                }
+                for (auto floatFeatureIdx : xrange(FloatFeatures.size())) {
+                    Y_UNUSED(floatFeatureIdx);
+                    cd << columnIdx++ << "\tNum\n";
+                }
+                for (auto catFeatureIdx : xrange(CatFeatures.size())) {
+                    Y_UNUSED(catFeatureIdx);
+                    cd << columnIdx++ << "\tCateg\n";
+                }
+            }
+
+            TOFStream pool(poolPath);
+            for (auto objectIdx : xrange(ObjectCount)) {
+                pool << Target[objectIdx];
+                if (!GroupIds.empty()) {
+                    pool << '\t' << GroupIds[objectIdx];
+                }
+                for (const auto& floatFeature : FloatFeatures) {
+                    pool << '\t' << floatFeature[objectIdx];
+                }
+                for (const auto& catFeature : CatFeatures) {
+                    pool << '\t' << catFeature[objectIdx];
+                }
+                pool << '\n';
+            }
+        }
+
+
+        static TVector<TVector<float>> GenerateFloatFeatures(
+            ui32 objectCount,
+            ui32 featureCount,
+            float density,
+            TReallyFastRng32* rng
+        ) {
+            TVector<TVector<float>> features(featureCount);
+            for (auto& feature : features) {
+                feature.yresize(objectCount);
+                for (auto& value : feature) {
+                    if (density < 1.0f) {
+                        value = (rng->GenRandReal2() < density) ? rng->GenRandReal2() : 0.0f;
+                    } else {
+                        value = rng->GenRandReal2();
+                    }
+                }
+            }
+            return features;
+        }
+
+        static TVector<float> GenerateLinearTarget(
+            const TVector<TVector<float>>& features,
+            ui32 objectCount,
+            TReallyFastRng32* rng
+        ) {
+            CB_ENSURE(features.size() >= 2, "Synthetic target needs at least 2 float features");
+            TVector<float> target(objectCount);
+            for (auto objectIdx : xrange(objectCount)) {
+                target[objectIdx] = features[0][objectIdx] + 0.5f * features[1][objectIdx] + 0.1f * rng->GenRandReal2();
+            }
+            return target;
+        }
+
+        TSyntheticPool GenerateDensePool(ui32 objectCount, ui32 featureCount, ui64 seed) {
+            return GenerateSparsePool(objectCount, featureCount, /*density*/ 1.0f, seed);
+        }
+
+        TSyntheticPool GenerateSparsePool(ui32 objectCount, ui32 featureCount, float density, ui64 seed) {
+            TReallyFastRng32 rng(seed);
+
+            TSyntheticPool pool;
+            pool.ObjectCount = objectCount;
+            pool.FloatFeatures = GenerateFloatFeatures(objectCount, featureCount, density, &rng);
+            pool.Target = GenerateLinearTarget(pool.FloatFeatures, objectCount, &rng);
+            return pool;
+        }
+
+        TSyntheticPool GenerateCategoricalPool(
+            ui32 objectCount,
+            ui32 floatFeatureCount,
+            ui32 catFeatureCount,
+            ui32 maxCardinality,
+            ui64 seed
+        ) {
+            CB_ENSURE(floatFeatureCount > 0 && catFeatureCount > 0, "Need both float and categorical features");
+            CB_ENSURE(maxCardinality >= 2, "Max cardinality should be at least 2");
+            TReallyFastRng32 rng(seed);
+
+            TSyntheticPool pool;
+            pool.ObjectCount = objectCount;
+            pool.FloatFeatures = GenerateFloatFeatures(objectCount, floatFeatureCount, /*density*/ 1.0f, &rng);
+
+            TVector<ui32> firstCatFeatureValues(objectCount);
+            pool.CatFeatures.resize(catFeatureCount);
+            pool.HashedCatFeatures.resize(catFeatureCount);
+            for (auto catFeatureIdx : xrange(catFeatureCount)) {
+                const double cardinalityPower = (catFeatureCount > 1) ?
+                    double(catFeatureIdx) / (catFeatureCount - 1)
+                    : 1.0;
+                const ui32 cardinality = Max<ui32>(2, std::round(2 * std::pow(maxCardinality / 2.0, cardinalityPower)));
+
+                auto& values = pool.CatFeatures[catFeatureIdx];
+                auto& hashedValues = pool.HashedCatFeatures[catFeatureIdx];
+                values.resize(objectCount);
+                hashedValues.yresize(objectCount);
+                for (auto objectIdx : xrange(objectCount)) {
+                    const ui32 valueIdx = rng.Uniform(cardinality);
+                    if (catFeatureIdx == 0) {
+                        firstCatFeatureValues[objectIdx] = valueIdx;
+                    }
+                    values[objectIdx] = "v" + ToString(valueIdx);
+                    hashedValues[objectIdx] = CalcCatFeatureHash(values[objectIdx]);
+                }
+            }
+
+            pool.Target.yresize(objectCount);
+            for (auto objectIdx : xrange(objectCount)) {
+                pool.Target[objectIdx] = (firstCatFeatureValues[objectIdx] % 7) / 7.0f
+                    + 0.5f * pool.FloatFeatures[0][objectIdx]
+                    + 0.1f * rng.GenRandReal2();
+            }
+            return pool;
+        }
+
+        TSyntheticPool GenerateRankingPool(
+            ui32 objectCount,
+            ui32 featureCount,
+            ui32 minGroupSize,
+            ui32 maxGroupSize,
+            ui64 seed
+        ) {
+            CB_ENSURE(0 < minGroupSize && minGroupSize <= maxGroupSize, "Bad group size range");
+            TReallyFastRng32 rng(seed);
+
+            TSyntheticPool pool;
+            pool.ObjectCount = objectCount;
+            pool.FloatFeatures = GenerateFloatFeatures(objectCount, featureCount, /*density*/ 1.0f, &rng);
+            const TVector<float> score = GenerateLinearTarget(pool.FloatFeatures, objectCount, &rng);
+
+            pool.Target.yresize(objectCount);
+            for (auto objectIdx : xrange(objectCount)) {
+                pool.Target[objectIdx] = Min<float>(4, std::floor(score[objectIdx] * 3));
+            }
+
+            pool.GroupIds.yresize(objectCount);
+            ui32 groupIdx = 0;
+            for (ui32 groupBegin = 0; groupBegin < objectCount; ++groupIdx) {
+                const ui32 groupEnd = Min(
+                    objectCount,
+                    groupBegin + minGroupSize + rng.Uniform(maxGroupSize - minGroupSize + 1)
+                );
+                const TGroupId groupId = CalcGroupIdFor(ToString(groupIdx));
+                for (auto objectIdx : xrange(groupBegin, groupEnd)) {
+                    pool.GroupIds[objectIdx] = groupId;
+                }
+                groupBegin = groupEnd;
+            }
+            return pool;
+        }
+
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <catboost/libs/data_new/data_provider.h>
+#include <catboost/libs/data_types/groupid.h>
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+    namespace NBenchmark {
+
+        /* Raw columns of a generated dataset.
+         * Raw values are kept along with the data provider built from them because inference and
+         * parsing benchmarks need the data in the form it has before quantization.
+         * Flat features order is float features first, then categorical ones.
+         */
+        struct TSyntheticPool {
+            ui32 ObjectCount = 0;
+            TVector<TVector<float>> FloatFeatures; // [floatFeatureIdx][objectIdx]
+            TVector<TVector<TString>> CatFeatures; // [catFeatureIdx][objectIdx]
+            TVector<TVector<ui32>> HashedCatFeatures; // [catFeatureIdx][objectIdx]
+            TVector<float> Target;
+            TVector<TGroupId> GroupIds; // empty if the dataset has no groups
+
+        public:
+            ui32 GetFeatureCount() const {
+                return FloatFeatures.size() + CatFeatures.size();
+            }
+
+            TDataProviderPtr CreateDataProvider() const;
+
+            // group ids are written as strings, so they are hashed again when the file is parsed
+            void SaveAsDsv(const TString& poolPath, const TString& cdPath) const;
+        };
+
+        // Uniform float features, target is a noisy linear function of the first two features
+        TSyntheticPool GenerateDensePool(ui32 objectCount, ui32 featureCount, ui64 seed);
+
+        // Same as GenerateDensePool but each feature value is zero with probability 1 - density
+        TSyntheticPool GenerateSparsePool(ui32 objectCount, ui32 featureCount, float density, ui64 seed);
+
+        /* Categorical feature cardinalities grow geometrically from 2 to maxCardinality,
+         * target depends on the first categorical feature and the first float feature
+         */
+        TSyntheticPool GenerateCategoricalPool(
+            ui32 objectCount,
+            ui32 floatFeatureCount,
+            ui32 catFeatureCount,
+            ui32 maxCardinality,
+            ui64 seed
+        );
+
+        // Consecutive groups with sizes from [minGroupSize, maxGroupSize], target is a relevance from 0 to 4
+        TSyntheticPool GenerateRankingPool(
+            ui32 objectCount,
+            ui32 featureCount,
+            ui32 minGroupSize,
+            ui32 maxGroupSize,
+            ui64 seed
+        );
+
+    }
+}
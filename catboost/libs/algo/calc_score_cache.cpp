@@ -1,5 +1,7 @@
 #include "calc_score_cache.h"
 
+#include <catboost/libs/helpers/mem_usage.h>
+
 #include <util/generic/algorithm.h>
 #include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
@@ -251,6 +253,7 @@ void TCalcScoreFold::Create(const TVector<TFold>& folds, bool isPairwiseScoring,
         }
     }
     DefaultCalcStatsObjBlockSize = defaultCalcStatsObjBlockSize;
+    AtomicSet(HasLeafStats, false);
 }
 
 template <typename TSrcRef, typename TGetElementFunc, typename TDstRef>
@@ -353,8 +356,10 @@ void TCalcScoreFold::SelectSmallestSplitSide(int curDepth, const TCalcScoreFold&
 
     DocCount = dstBlocks.Total;
     LearnPermutationFeaturesSubset.Get<TIndexedSubset<ui32>>().yresize(DocCount);
+    AtomicSet(HasLeafStats, false);
     ClearBodyTail();
     BodyTailCount = fold.GetBodyTailCount();
+    PermutedSparseFloatFeatures = fold.PermutedSparseFloatFeatures;
     localExecutor->ExecRange([&](int blockIdx) {
         int ignored;
         const auto srcBlock = srcBlocks.Slices[blockIdx];
@@ -388,8 +393,10 @@ void TCalcScoreFold::Sample(const TFold& fold, const TVector<TIndexType>& indice
 
     DocCount = dstBlocks.Total;
     LearnPermutationFeaturesSubset.Get<TIndexedSubset<ui32>>().yresize(DocCount);
+    AtomicSet(HasLeafStats, false);
     ClearBodyTail();
     BodyTailCount = fold.BodyTailArr.ysize();
+    PermutedSparseFloatFeatures = &fold.PermutedSparseFloatFeatures;
     localExecutor->ExecRange([&](int blockIdx) {
         const auto srcBlock = srcBlocks.Slices[blockIdx];
         const auto srcControlRef = srcBlock.GetConstRef(Control);
@@ -420,6 +427,7 @@ void TCalcScoreFold::UpdateIndices(const TVector<TIndexType>& indices, NPar::TLo
     }
 
     DocCount = dstBlocks.Total;
+    AtomicSet(HasLeafStats, false);
     localExecutor->ExecRange([&](int blockIdx) {
         const auto srcBlock = srcBlocks.Slices[blockIdx];
         const auto dstBlock = dstBlocks.Slices[blockIdx];
@@ -445,6 +453,38 @@ bool TCalcScoreFold::HasQueryInfo() const {
     return LearnQueriesInfo.size() > 1;
 }
 
+ui64 TCalcScoreFold::GetMemoryUsage() const {
+    ui64 usage = GetVectorMemoryUsage(Indices)
+        + GetVectorMemoryUsage(IndexInFold)
+        + GetVectorMemoryUsage(LearnWeights)
+        + GetVectorMemoryUsage(SampleWeights)
+        + GetVectorMemoryUsage(Control)
+        + GetVectorMemoryUsage(LeafStats);
+    for (const auto& bodyTail : BodyTailArr) {
+        for (const auto& derivatives : bodyTail.WeightedDerivatives) {
+            usage += GetVectorMemoryUsage(derivatives);
+        }
+        for (const auto& derivatives : bodyTail.SampleWeightedDerivatives) {
+            usage += GetVectorMemoryUsage(derivatives);
+        }
+        usage += GetVectorMemoryUsage(bodyTail.PairwiseWeights);
+        usage += GetVectorMemoryUsage(bodyTail.SamplePairwiseWeights);
+    }
+    return usage;
+}
+
+void TCalcScoreFold::ReleaseMemory() {
+    Indices = TUnsizedVector<TIndexType>();
+    IndexInFold = TUnsizedVector<ui32>();
+    LearnWeights = TUnsizedVector<float>();
+    SampleWeights = TUnsizedVector<float>();
+    BodyTailArr = TUnsizedVector<TBodyTail>();
+    Control = TUnsizedVector<bool>();
+    LeafStats = TVector<TBucketStats>();
+    AtomicSet(HasLeafStats, false);
+    DocCount = 0;
+}
+
 const NCB::IIndexRangesGenerator<int>& TCalcScoreFold::GetCalcStatsIndexRanges() const {
     return *CalcStatsIndexRanges;
 }
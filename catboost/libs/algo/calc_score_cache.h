@@ -116,6 +116,13 @@ struct TBucketStatsCache {
     }
     TVector<TBucketStats, TPoolAllocator>& GetStats(const TSplitCandidate& split, int statsCount, bool* areStatsDirty);
     void GarbageCollect();
+    void Destroy() {
+        Stats.clear();
+        MemoryPool.Destroy();
+    }
+    size_t GetMemoryAllocated() const {
+        return MemoryPool ? MemoryPool->MemoryAllocated() : 0;
+    }
     static TVector<TBucketStats> GetStatsInUse(int segmentCount,
         int segmentSize,
         int statsCount,
@@ -223,9 +230,35 @@ struct TCalcScoreFold {
 
     bool HasQueryInfo() const;
 
+    // approximate, only per-document buffers are taken into account
+    ui64 GetMemoryUsage() const;
+
+    // frees per-document buffers, Create must be called before the next use
+    void ReleaseMemory();
+
     // for data with queries - query indices, object indices otherwise
     const NCB::IIndexRangesGenerator<int>& GetCalcStatsIndexRanges() const;
 
+    /* [bodyTail & approxDim][leaf] stats sums over all the documents of this fold
+     * calculated by calcFunc(TVector<TBucketStats>*) on the first request (thread-safe),
+     * valid until the documents or their Indices are changed
+     */
+    template <class TCalcFunc>
+    TConstArrayRef<TBucketStats> GetLeafStats(TCalcFunc&& calcFunc) const {
+        if (!AtomicGet(HasLeafStats)) {
+            with_lock(LeafStatsLock) {
+                if (!AtomicGet(HasLeafStats)) {
+                    calcFunc(&LeafStats);
+                    AtomicSet(HasLeafStats, true);
+                }
+            }
+        }
+        return LeafStats;
+    }
+
+    // non-default bins of sparse features of the TFold this fold has been sampled from
+    const THashMap<ui32, NCB::TSparseArray<ui8, ui32>>* PermutedSparseFloatFeatures = nullptr;
+
 private:
     inline void ClearBodyTail() {
         for (auto& bodyTail : BodyTailArr) {
@@ -260,6 +293,10 @@ private:
     int DefaultCalcStatsObjBlockSize;
 
     THolder<NCB::IIndexRangesGenerator<int>> CalcStatsIndexRanges;
+
+    mutable TVector<TBucketStats> LeafStats;
+    mutable TAtomic HasLeafStats = false;
+    mutable TAdaptiveLock LeafStatsLock;
 };
 
 struct TStats3D {
@@ -5,3 +5,52 @@ struct TDers {
     double Der2;
     double Der3;
 };
+
+/* Destination of querywise derivatives: either TDers array or first derivatives only array
+ * (second derivatives are dropped in the latter case)
+ */
+class TQueryDersRef {
+public:
+    explicit TQueryDersRef(TDers* ders)
+        : Ders(ders)
+        , FirstDers(nullptr)
+    {}
+
+    explicit TQueryDersRef(double* firstDers)
+        : Ders(nullptr)
+        , FirstDers(firstDers)
+    {}
+
+    double& Der1(int idx) const {
+        return Ders ? Ders[idx].Der1 : FirstDers[idx];
+    }
+
+    void SetDer2(int idx, double value) const {
+        if (Ders) {
+            Ders[idx].Der2 = value;
+        }
+    }
+
+    void AddDer2(int idx, double value) const {
+        if (Ders) {
+            Ders[idx].Der2 += value;
+        }
+    }
+
+    void SetZero(int idx) const {
+        if (Ders) {
+            Ders[idx] = TDers{/*Der1*/0.0, /*Der2*/0.0, /*Der3*/0.0};
+        } else {
+            FirstDers[idx] = 0.0;
+        }
+    }
+
+    // ders starting from offset
+    TQueryDersRef operator+(int offset) const {
+        return Ders ? TQueryDersRef(Ders + offset) : TQueryDersRef(FirstDers + offset);
+    }
+
+private:
+    TDers* Ders;
+    double* FirstDers;
+};
@@ -1,5 +1,7 @@
 #include "error_functions.h"
 
+#include <catboost/libs/helpers/query_info_helper.h>
+
 #include <util/generic/xrange.h>
 
 template <int MaxDerivativeOrder, bool UseTDers, bool UseExpApprox, bool HasDelta>
@@ -107,6 +109,41 @@ void IDerCalcer::CalcDersRange(
     }
 }
 
+void IDerCalcer::CalcDersForQueryBlocks(
+    int queryStartIndex,
+    int queryEndIndex,
+    const TVector<double>& approx,
+    const TVector<float>& target,
+    const TVector<float>& weight,
+    const TVector<TQueryInfo>& queriesInfo,
+    TQueryDersRef ders,
+    NPar::TLocalExecutor* localExecutor
+) const {
+    if (queryStartIndex == queryEndIndex) {
+        return;
+    }
+    const int start = queriesInfo[queryStartIndex].Begin;
+    // blocks with close document counts, so large queries don't make a single thread the bottleneck
+    const TVector<int> blockBounds = GetQueryBlockBoundsByDocCount(
+        queriesInfo,
+        queryStartIndex,
+        queryEndIndex,
+        localExecutor->GetThreadCount() + 1
+    );
+    NPar::ParallelFor(*localExecutor, 0, blockBounds.size() - 1, [&] (ui32 blockIdx) {
+        const int blockStart = queriesInfo[blockBounds[blockIdx]].Begin;
+        CalcDersForQueriesBlock(
+            blockBounds[blockIdx],
+            blockBounds[blockIdx + 1],
+            approx,
+            target,
+            weight,
+            queriesInfo,
+            ders + (blockStart - start)
+        );
+    });
+}
+
 namespace {
     template <int Capacity>
     class TExpForwardView {
@@ -257,16 +294,15 @@ void TCrossEntropyError::CalcDersRange(
 
 void TQuerySoftMaxError::CalcDersForSingleQuery(
     int start,
-    int offset,
     int count,
     TConstArrayRef<double> approxes,
     TConstArrayRef<float> targets,
     TConstArrayRef<float> weights,
-    TArrayRef<TDers> ders
+    TQueryDersRef ders
 ) const {
     double maxApprox = -std::numeric_limits<double>::max();
     float sumWeightedTargets = 0;
-    for (int dim = offset; dim < offset + count; ++dim) {
+    for (int dim = 0; dim < count; ++dim) {
         const float weight = weights.empty() ? 1.0f : weights[start + dim];
         if (weight > 0) {
             maxApprox = std::max(maxApprox, approxes[start + dim]);
@@ -276,34 +312,32 @@ void TQuerySoftMaxError::CalcDersForSingleQuery(
         }
     }
     if (sumWeightedTargets > 0) {
-        TExpForwardView</*Capacity*/16> expApproxes(MakeArrayRef(approxes.data(), offset + count), -maxApprox);
+        TExpForwardView</*Capacity*/16> expApproxes(MakeArrayRef(approxes.data() + start, count), -maxApprox);
         double sumExpApprox = 0;
-        for (int dim = offset; dim < offset + count; ++dim) {
+        for (int dim = 0; dim < count; ++dim) {
             const float weight = weights.empty() ? 1.0f : weights[start + dim];
             if (weight > 0) {
-                const double expApprox = expApproxes[start + dim] * weight;
-                ders[dim].Der1 = expApprox;
+                const double expApprox = expApproxes[dim] * weight;
+                ders.Der1(dim) = expApprox;
                 sumExpApprox += expApprox;
             }
         }
-        for (int dim = offset; dim < offset + count; ++dim) {
+        for (int dim = 0; dim < count; ++dim) {
             const float weight = weights.empty() ? 1.0f : weights[start + dim];
             if (weight > 0) {
-                const double p = ders[dim].Der1 / sumExpApprox;
-                ders[dim].Der2 = sumWeightedTargets * (p * (p - 1.0) - LambdaReg);
-                ders[dim].Der1 = -sumWeightedTargets * p;
+                const double p = ders.Der1(dim) / sumExpApprox;
+                ders.SetDer2(dim, sumWeightedTargets * (p * (p - 1.0) - LambdaReg));
+                ders.Der1(dim) = -sumWeightedTargets * p;
                 if (targets[start + dim] > 0) {
-                    ders[dim].Der1 += weight * targets[start + dim];
+                    ders.Der1(dim) += weight * targets[start + dim];
                 }
             } else {
-                ders[dim].Der2 = 0.0;
-                ders[dim].Der1 = 0.0;
+                ders.SetZero(dim);
             }
         }
     } else {
-        for (int dim = offset; dim < offset + count; ++dim) {
-            ders[dim].Der2 = 0.0;
-            ders[dim].Der1 = 0.0;
+        for (int dim = 0; dim < count; ++dim) {
+            ders.SetZero(dim);
         }
     }
 }
@@ -88,17 +88,53 @@ public:
         CB_ENSURE(false, "Not implemented");
     }
 
-    virtual void CalcDersForQueries(
-        int /*queryStartIndex*/,
-        int /*queryEndIndex*/,
-        const TVector<double>& /*approx*/,
-        const TVector<float>& /*target*/,
-        const TVector<float>& /*weight*/,
-        const TVector<TQueryInfo>& /*queriesInfo*/,
-        TVector<TDers>* /*ders*/,
-        NPar::TLocalExecutor* /*localExecutor*/
+    /* Calc derivatives for queries [queryStartIndex, queryEndIndex) in parallel, queries are split to blocks
+     * with close document counts.
+     * ders are indexed from queriesInfo[queryStartIndex].Begin
+     */
+    void CalcDersForQueries(
+        int queryStartIndex,
+        int queryEndIndex,
+        const TVector<double>& approx,
+        const TVector<float>& target,
+        const TVector<float>& weight,
+        const TVector<TQueryInfo>& queriesInfo,
+        TVector<TDers>* ders,
+        NPar::TLocalExecutor* localExecutor
     ) const {
-        CB_ENSURE(false, "Not implemented");
+        CalcDersForQueryBlocks(
+            queryStartIndex,
+            queryEndIndex,
+            approx,
+            target,
+            weight,
+            queriesInfo,
+            TQueryDersRef(ders->data()),
+            localExecutor
+        );
+    }
+
+    // Same as CalcDersForQueries but only first derivatives are written, directly to firstDers
+    void CalcFirstDersForQueries(
+        int queryStartIndex,
+        int queryEndIndex,
+        const TVector<double>& approx,
+        const TVector<float>& target,
+        const TVector<float>& weight,
+        const TVector<TQueryInfo>& queriesInfo,
+        TArrayRef<double> firstDers,
+        NPar::TLocalExecutor* localExecutor
+    ) const {
+        CalcDersForQueryBlocks(
+            queryStartIndex,
+            queryEndIndex,
+            approx,
+            target,
+            weight,
+            queriesInfo,
+            TQueryDersRef(firstDers.data()),
+            localExecutor
+        );
     }
 
 private:
@@ -111,6 +147,32 @@ private:
         CB_ENSURE(false, "Not implemented");
     }
 
+    void CalcDersForQueryBlocks(
+        int queryStartIndex,
+        int queryEndIndex,
+        const TVector<double>& approx,
+        const TVector<float>& target,
+        const TVector<float>& weight,
+        const TVector<TQueryInfo>& queriesInfo,
+        TQueryDersRef ders,
+        NPar::TLocalExecutor* localExecutor
+    ) const;
+
+    /* Calc derivatives for queries [queryStartIndex, queryEndIndex) sequentially,
+     * ders are indexed from queriesInfo[queryStartIndex].Begin
+     */
+    virtual void CalcDersForQueriesBlock(
+        int /*queryStartIndex*/,
+        int /*queryEndIndex*/,
+        const TVector<double>& /*approx*/,
+        const TVector<float>& /*target*/,
+        const TVector<float>& /*weight*/,
+        const TVector<TQueryInfo>& /*queriesInfo*/,
+        TQueryDersRef /*ders*/
+    ) const {
+        CB_ENSURE(false, "Not implemented");
+    }
+
     virtual double CalcDer2(double /*approx*/, float /*target*/) const {
         CB_ENSURE(false, "Not implemented");
     }
@@ -453,37 +515,38 @@ public:
         CB_ENSURE(isExpApprox == true, "Approx format does not match");
     }
 
-    void CalcDersForQueries(
+private:
+    void CalcDersForQueriesBlock(
         int queryStartIndex,
         int queryEndIndex,
         const TVector<double>& expApproxes,
         const TVector<float>& /*targets*/,
         const TVector<float>& /*weights*/,
         const TVector<TQueryInfo>& queriesInfo,
-        TVector<TDers>* ders,
-        NPar::TLocalExecutor* localExecutor
+        TQueryDersRef ders
     ) const override {
-        CB_ENSURE(queryStartIndex < queryEndIndex);
         const int start = queriesInfo[queryStartIndex].Begin;
-        NPar::ParallelFor(*localExecutor, queryStartIndex, queryEndIndex, [&] (ui32 queryIndex) {
+        for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
             const int begin = queriesInfo[queryIndex].Begin;
             const int end = queriesInfo[queryIndex].End;
-            TDers* dersData = ders->data() + begin - start;
-            Fill(dersData, dersData + end - begin, TDers{/*1st*/0.0, /*2nd*/0.0, /*3rd*/0.0});
+            const TQueryDersRef queryDers = ders + (begin - start);
+            for (int docId = 0; docId < end - begin; ++docId) {
+                queryDers.SetZero(docId);
+            }
             for (int docId = begin; docId < end; ++docId) {
                 double winnerDer = 0.0;
                 double winnerSecondDer = 0.0;
                 for (const auto& competitor : queriesInfo[queryIndex].Competitors[docId - begin]) {
                     const double p = expApproxes[competitor.Id + begin] / (expApproxes[competitor.Id + begin] + expApproxes[docId]);
                     winnerDer += competitor.Weight * p;
-                    dersData[competitor.Id].Der1 -= competitor.Weight * p;
+                    queryDers.Der1(competitor.Id) -= competitor.Weight * p;
                     winnerSecondDer += competitor.Weight * p * (p - 1);
-                    dersData[competitor.Id].Der2 += competitor.Weight * p * (p - 1);
+                    queryDers.AddDer2(competitor.Id, competitor.Weight * p * (p - 1));
                 }
-                dersData[docId - begin].Der1 += winnerDer;
-                dersData[docId - begin].Der2 += winnerSecondDer;
+                queryDers.Der1(docId - begin) += winnerDer;
+                queryDers.AddDer2(docId - begin, winnerSecondDer);
             }
-        });
+        }
     }
 };
 
@@ -495,34 +558,31 @@ public:
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-    void CalcDersForQueries(
+private:
+    void CalcDersForQueriesBlock(
         int queryStartIndex,
         int queryEndIndex,
         const TVector<double>& approxes,
         const TVector<float>& targets,
         const TVector<float>& weights,
         const TVector<TQueryInfo>& queriesInfo,
-        TVector<TDers>* ders,
-        NPar::TLocalExecutor* localExecutor
+        TQueryDersRef ders
     ) const override {
         const int start = queriesInfo[queryStartIndex].Begin;
-        NPar::ParallelFor(*localExecutor, queryStartIndex, queryEndIndex, [&] (ui32 queryIndex) {
+        for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
             const int begin = queriesInfo[queryIndex].Begin;
             const int end = queriesInfo[queryIndex].End;
             const int querySize = end - begin;
 
             const double queryAvrg = CalcQueryAvrg(begin, querySize, approxes, targets, weights);
             for (int docId = begin; docId < end; ++docId) {
-                (*ders)[docId - start].Der1 = targets[docId] - approxes[docId] - queryAvrg;
-                (*ders)[docId - start].Der2 = -1;
-                if (!weights.empty()) {
-                    (*ders)[docId - start].Der1 *= weights[docId];
-                    (*ders)[docId - start].Der2 *= weights[docId];
-                }
+                const double weight = weights.empty() ? 1.0 : weights[docId];
+                ders.Der1(docId - start) = (targets[docId] - approxes[docId] - queryAvrg) * weight;
+                ders.SetDer2(docId - start, -weight);
             }
-        });
+        }
     }
-private:
+
     double CalcQueryAvrg(
         int start,
         int count,
@@ -558,33 +618,32 @@ public:
         CB_ENSURE(isExpApprox == false, "Approx format does not match");
     }
 
-    void CalcDersForQueries(
+private:
+    void CalcDersForQueriesBlock(
         int queryStartIndex,
         int queryEndIndex,
         const TVector<double>& approxes,
         const TVector<float>& targets,
         const TVector<float>& weights,
         const TVector<TQueryInfo>& queriesInfo,
-        TVector<TDers>* ders,
-        NPar::TLocalExecutor* localExecutor
+        TQueryDersRef ders
     ) const override {
-        int start = queriesInfo[queryStartIndex].Begin;
-        NPar::ParallelFor(*localExecutor, queryStartIndex, queryEndIndex, [&](int queryIndex) {
-            int begin = queriesInfo[queryIndex].Begin;
-            int end = queriesInfo[queryIndex].End;
-            CalcDersForSingleQuery(start, begin - start, end - begin, approxes, targets, weights, *ders);
-        });
+        const int start = queriesInfo[queryStartIndex].Begin;
+        for (int queryIndex = queryStartIndex; queryIndex < queryEndIndex; ++queryIndex) {
+            const int begin = queriesInfo[queryIndex].Begin;
+            const int end = queriesInfo[queryIndex].End;
+            CalcDersForSingleQuery(begin, end - begin, approxes, targets, weights, ders + (begin - start));
+        }
     }
 
-private:
+    // ders are indexed from start
     void CalcDersForSingleQuery(
         int start,
-        int offset,
         int count,
         TConstArrayRef<double> approxes,
         TConstArrayRef<float> targets,
         TConstArrayRef<float> weights,
-        TArrayRef<TDers> ders
+        TQueryDersRef ders
     ) const;
 };
 
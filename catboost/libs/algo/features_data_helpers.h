@@ -3,6 +3,9 @@
 #include <catboost/libs/data_new/objects.h>
 #include <catboost/libs/helpers/exception.h>
 
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+
 
 namespace NCB {
 
@@ -22,6 +25,38 @@ namespace NCB {
         }
     }
 
+    /* returns data of objects [blockBegin, blockBegin + blockSize) of the consecutive subset,
+     * sparse float features are densified to sparseDataBuffer so it must outlive the result
+     */
+    inline TConstArrayRef<float> GetRawFeatureDataBlock(
+        const TRawObjectsDataProvider& rawObjectsData,
+        const TFeaturesLayout& featuresLayout,
+        ui32 consecutiveSubsetBegin,
+        ui32 flatFeatureIdx,
+        ui32 blockBegin,
+        ui32 blockSize,
+        TVector<float>* sparseDataBuffer) {
+
+        if (featuresLayout.GetExternalFeatureType(flatFeatureIdx) == EFeatureType::Float) {
+            const auto sparseFeature = rawObjectsData.GetSparseFloatFeature(
+                featuresLayout.GetInternalFeatureIdx(flatFeatureIdx)
+            );
+            if (sparseFeature) {
+                sparseDataBuffer->yresize(blockSize);
+                (**sparseFeature).GetSrcData().ExtractValues(
+                    consecutiveSubsetBegin + blockBegin,
+                    *sparseDataBuffer
+                );
+                return *sparseDataBuffer;
+            }
+        }
+        return MakeArrayRef(
+            GetRawFeatureDataBeginPtr(rawObjectsData, featuresLayout, consecutiveSubsetBegin, flatFeatureIdx)
+                + blockBegin,
+            blockSize
+        );
+    }
+
     inline ui32 GetConsecutiveSubsetBegin(const TRawObjectsDataProvider& rawObjectsData) {
         const auto maybeConsecutiveSubsetBegin =
             rawObjectsData.GetFeaturesArraySubsetIndexing().GetConsecutiveSubsetBegin();
@@ -3,11 +3,15 @@
 #include "approx_updater_helpers.h"
 
 #include <catboost/libs/data_types/groupid.h>
+#include <catboost/libs/helpers/mem_usage.h>
 #include <catboost/libs/helpers/permutation.h>
 #include <catboost/libs/helpers/query_info_helper.h>
 #include <catboost/libs/helpers/restorable_rng.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/cast.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ylimits.h>
 
 
 using namespace NCB;
@@ -109,6 +113,82 @@ static void InitPermutationData(
 }
 
 
+static void InitPermutedSparseFloatFeatures(
+    const NCB::TTrainingForCPUDataProvider& learnData,
+    NPar::TLocalExecutor* localExecutor,
+    TFold* fold
+) {
+    const auto& objectsData = *learnData.ObjectsData;
+
+    TVector<ui32> sparseFeatures; // [floatFeatureIdx]
+    objectsData.GetFeaturesLayout()->IterateOverAvailableFeatures<EFeatureType::Float>(
+        [&] (TFloatFeatureIdx floatFeatureIdx) {
+            if (objectsData.IsSparseFloatFeature(*floatFeatureIdx)) {
+                sparseFeatures.push_back(*floatFeatureIdx);
+            }
+        }
+    );
+    if (sparseFeatures.empty()) {
+        return;
+    }
+
+    // all features share the source objects space
+    const ui32 srcObjectCount = (**objectsData.GetSparseFloatFeature(sparseFeatures[0])).GetSrcData().GetSize();
+    const auto& foldSubset = fold->LearnPermutationFeaturesSubset.Get<TIndexedSubset<ui32>>();
+
+    constexpr ui32 NOT_IN_FOLD = Max<ui32>();
+    TVector<ui32> foldIdxBySrcObjectIdx(srcObjectCount, NOT_IN_FOLD);
+    for (auto foldIdx : xrange(foldSubset.size())) {
+        foldIdxBySrcObjectIdx[foldSubset[foldIdx]] = foldIdx;
+    }
+
+    TVector<TSparseArray<ui8, ui32>> permutedFeatures(sparseFeatures.size());
+    localExecutor->ExecRangeWithThrow(
+        [&] (int i) {
+            const auto& srcData = (**objectsData.GetSparseFloatFeature(sparseFeatures[i])).GetSrcData();
+            CB_ENSURE_INTERNAL(
+                srcData.GetSize() == srcObjectCount,
+                "Sparse float features have different source sizes"
+            );
+
+            TVector<std::pair<ui32, ui8>> nonDefaultBins;
+            nonDefaultBins.reserve(srcData.GetNonDefaultSize());
+            srcData.ForEachNonDefault(
+                [&] (ui32 srcObjectIdx, ui8 bin) {
+                    const ui32 foldIdx = foldIdxBySrcObjectIdx[srcObjectIdx];
+                    if (foldIdx != NOT_IN_FOLD) {
+                        nonDefaultBins.emplace_back(foldIdx, bin);
+                    }
+                }
+            );
+            Sort(nonDefaultBins);
+
+            TVector<ui32> indices;
+            indices.yresize(nonDefaultBins.size());
+            TVector<ui8> bins;
+            bins.yresize(nonDefaultBins.size());
+            for (auto j : xrange(nonDefaultBins.size())) {
+                indices[j] = nonDefaultBins[j].first;
+                bins[j] = nonDefaultBins[j].second;
+            }
+            permutedFeatures[i] = TSparseArray<ui8, ui32>(
+                SafeIntegerCast<ui32>(foldSubset.size()),
+                std::move(indices),
+                std::move(bins),
+                srcData.GetDefaultValue()
+            );
+        },
+        0,
+        SafeIntegerCast<int>(sparseFeatures.size()),
+        NPar::TLocalExecutor::WAIT_COMPLETE
+    );
+
+    for (auto i : xrange(sparseFeatures.size())) {
+        fold->PermutedSparseFloatFeatures.emplace(sparseFeatures[i], std::move(permutedFeatures[i]));
+    }
+}
+
+
 TFold TFold::BuildDynamicFold(
     const NCB::TTrainingForCPUDataProvider& learnData,
     const TVector<TTargetClassifier>& targetClassifiers,
@@ -127,6 +207,7 @@ TFold TFold::BuildDynamicFold(
     ff.SampleWeights.resize(learnSampleCount, 1);
 
     InitPermutationData(learnData, shuffle, permuteBlockSize, &rand, &ff);
+    InitPermutedSparseFloatFeatures(learnData, localExecutor, &ff);
 
     ff.AssignTarget(GetMaybeTarget(learnData.TargetData), targetClassifiers);
     ff.SetWeights(GetWeights(learnData.TargetData), learnSampleCount);
@@ -210,6 +291,7 @@ TFold TFold::BuildPlainFold(
     ff.SampleWeights.resize(learnSampleCount, 1);
 
     InitPermutationData(learnData, shuffle, permuteBlockSize, &rand, &ff);
+    InitPermutedSparseFloatFeatures(learnData, localExecutor, &ff);
 
     ff.AssignTarget(GetMaybeTarget(learnData.TargetData), targetClassifiers);
     ff.SetWeights(GetWeights(learnData.TargetData), learnSampleCount);
@@ -246,6 +328,55 @@ TFold TFold::BuildPlainFold(
 }
 
 
+ui64 TFold::GetMemoryUsage() const {
+    ui64 usage = 0;
+    for (const auto& bodyTail : BodyTailArr) {
+        usage += GetVectorMemoryUsage(bodyTail.Approx);
+        usage += GetVectorMemoryUsage(bodyTail.WeightedDerivatives);
+        usage += GetVectorMemoryUsage(bodyTail.SampleWeightedDerivatives);
+        usage += GetVectorMemoryUsage(bodyTail.PairwiseWeights);
+        usage += GetVectorMemoryUsage(bodyTail.SamplePairwiseWeights);
+    }
+    usage += GetVectorMemoryUsage(LearnTarget);
+    usage += GetVectorMemoryUsage(SampleWeights);
+    usage += GetVectorMemoryUsage(LearnWeights);
+    usage += GetVectorMemoryUsage(LearnTargetClass);
+    for (const auto& [featureIdx, bins] : PermutedFloatFeatures) {
+        Y_UNUSED(featureIdx);
+        usage += GetVectorMemoryUsage(bins);
+    }
+    for (const auto& [featureIdx, values] : PermutedOneHotFeatures) {
+        Y_UNUSED(featureIdx);
+        usage += GetVectorMemoryUsage(values);
+    }
+    for (const auto& [featureIdx, bins] : PermutedSparseFloatFeatures) {
+        Y_UNUSED(featureIdx);
+        usage += (sizeof(ui32) + sizeof(ui8)) * bins.GetNonDefaultSize();
+    }
+    if (LearnPermutation) {
+        // objects indexing and features subset indexing
+        usage += 2 * sizeof(ui32) * GetLearnSampleCount();
+    }
+    return usage;
+}
+
+ui64 TFold::GetOnlineCTRsMemoryUsage() const {
+    ui64 usage = 0;
+    for (const auto* ctrs : {&OnlineSingleCtrs, &OnlineCTR}) {
+        for (const auto& [projection, ctr] : *ctrs) {
+            Y_UNUSED(projection);
+            for (const auto& ctrValues : ctr.Feature) {
+                for (size_t classIdx = 0; classIdx < ctrValues.GetYSize(); ++classIdx) {
+                    for (size_t priorIdx = 0; priorIdx < ctrValues.GetXSize(); ++priorIdx) {
+                        usage += GetVectorMemoryUsage(ctrValues[classIdx][priorIdx]);
+                    }
+                }
+            }
+        }
+    }
+    return usage;
+}
+
 void TFold::DropEmptyCTRs() {
     TVector<TProjection> emptyProjections;
     for (auto& projCtr : OnlineSingleCtrs) {
@@ -10,12 +10,14 @@
 #include <catboost/libs/data_types/query.h>
 #include <catboost/libs/helpers/clear_array.h>
 #include <catboost/libs/helpers/array_subset.h>
+#include <catboost/libs/helpers/sparse_array.h>
 #include <catboost/libs/model/online_ctr.h>
 #include <catboost/libs/options/defaults_helper.h>
 
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/array_ref.h>
+#include <util/generic/hash.h>
 #include <util/generic/maybe.h>
 #include <util/generic/vector.h>
 #include <util/random/shuffle.h>
@@ -74,6 +76,18 @@ struct TFold {
      */
     ui32 FeaturesSubsetBegin;
 
+    /* Copies of learn features bins (or remapped one-hot values) gathered in LearnPermutationFeaturesSubset
+     * order, so that indices calculation can read them sequentially instead of through the permutation.
+     * Filled on demand for features used in trees if materialize_permuted_features is enabled.
+     */
+    THashMap<ui32, TVector<ui8>> PermutedFloatFeatures; // [featureIdx][docIdxInPermuted]
+    THashMap<ui32, TVector<ui32>> PermutedOneHotFeatures; // [featureIdx][docIdxInPermuted]
+
+    /* Non-default bins of sparse learn float features with indices in LearnPermutationFeaturesSubset order,
+     * so that stats calculation iterates only over them. Filled for all sparse features at fold creation.
+     */
+    THashMap<ui32, NCB::TSparseArray<ui8, ui32>> PermutedSparseFloatFeatures; // [featureIdx]
+
     TVector<TBodyTail> BodyTailArr;
     TVector<float> LearnTarget;
     TVector<float> SampleWeights; // Resulting bootstrapped weights of documents.
@@ -125,6 +139,22 @@ struct TFold {
         }
     }
 
+    // cached online ctrs are recalculated on demand, so they can be dropped to free memory
+    void ClearOnlineCTRs() {
+        OnlineSingleCtrs.clear();
+        OnlineCTR.clear();
+    }
+
+    // split calculation falls back to indexed access to the source features
+    void ClearPermutedFeatures() {
+        PermutedFloatFeatures.clear();
+        PermutedOneHotFeatures.clear();
+    }
+
+    // approximate, only the largest per-document buffers are taken into account
+    ui64 GetMemoryUsage() const;
+    ui64 GetOnlineCTRsMemoryUsage() const;
+
     const TVector<float>& GetLearnWeights() const { return LearnWeights; }
 
     void SaveApproxes(IOutputStream* s) const;
@@ -11,11 +11,14 @@
 #include <catboost/libs/helpers/interrupt.h>
 #include <catboost/libs/helpers/query_info_helper.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/dot_product/dot_product.h>
 #include <library/fast_log/fast_log.h>
 
+#include <util/generic/algorithm.h>
+#include <util/generic/maybe.h>
+#include <util/generic/xrange.h>
 #include <util/string/builder.h>
-#include <util/system/mem_info.h>
 
 
 using namespace NCB;
@@ -80,10 +83,29 @@ static double CalcDerivativesStDevFromZeroMultiplier(int learnSampleCount, doubl
     return modelLeft / (1.0 + modelLeft);
 }
 
+// returns Nothing() if the feature is not bundled or bundle columns are not available in learn data
+static TMaybe<ui32> GetExclusiveFeaturesBundleIdx(
+    const TQuantizedForCPUObjectsDataProvider& learnObjectsData,
+    TFloatFeatureIdx floatFeatureIdx
+) {
+    const auto bundleIdx = learnObjectsData.GetQuantizedFeaturesInfo()->GetExclusiveFeaturesBundleIdx(floatFeatureIdx);
+    if (bundleIdx && learnObjectsData.GetExclusiveFeaturesBundle(*bundleIdx)) {
+        return bundleIdx;
+    }
+    return Nothing();
+}
+
 static void AddFloatFeatures(const TQuantizedForCPUObjectsDataProvider& learnObjectsData,
                              TLearnContext* ctx,
                              TBucketStatsCache* statsFromPrevTree,
                              TCandidateList* candList) {
+    /* features from the same exclusive features bundle are put to the same list to be scored together,
+     * bundle scoring does not use stats from the previous tree level, so with tree level caching they are scored
+     * one by one
+     */
+    const bool groupBundledFeatures = !ctx->UseTreeLevelCaching();
+    THashMap<ui32, size_t> bundleIdxToCandListIdx;
+
     learnObjectsData.GetFeaturesLayout()->IterateOverAvailableFeatures<EFeatureType::Float>(
         [&](TFloatFeatureIdx floatFeatureIdx) {
             TCandidateInfo split;
@@ -96,6 +118,16 @@ static void AddFloatFeatures(const TQuantizedForCPUObjectsDataProvider& learnObj
                 }
                 return;
             }
+            const auto bundleIdx = groupBundledFeatures ?
+                GetExclusiveFeaturesBundleIdx(learnObjectsData, floatFeatureIdx)
+                : Nothing();
+            if (bundleIdx) {
+                if (const auto* candListIdx = bundleIdxToCandListIdx.FindPtr(*bundleIdx)) {
+                    (*candList)[*candListIdx].Candidates.push_back(split);
+                    return;
+                }
+                bundleIdxToCandListIdx.emplace(*bundleIdx, candList->size());
+            }
             candList->emplace_back(TCandidatesInfoList(split));
         }
     );
@@ -276,7 +308,8 @@ static void AddTreeCtrs(const TQuantizedForCPUObjectsDataProvider& learnObjectsD
     }
 }
 
-static void SelectCtrsToDropAfterCalc(size_t memoryLimit,
+// availableMemory is what is left of used_ram_limit after the buffers accounted in TMemoryAccountant
+static void SelectCtrsToDropAfterCalc(size_t availableMemory,
                                       int sampleCount,
                                       int threadCount,
                                       const std::function<bool(const TProjection&)>& IsInCache,
@@ -294,12 +327,11 @@ static void SelectCtrsToDropAfterCalc(size_t memoryLimit,
         fullNeededMemoryForCtrs += neededMem;
     }
 
-    auto currentMemoryUsage = NMemInfo::GetMemInfo().RSS;
-    if (fullNeededMemoryForCtrs + currentMemoryUsage > memoryLimit) {
+    if (fullNeededMemoryForCtrs > availableMemory) {
         CATBOOST_DEBUG_LOG << "Needed more memory then allowed, will drop some ctrs after score calculation" << Endl;
         const float GB = (ui64)1024 * 1024 * 1024;
-        CATBOOST_DEBUG_LOG << "current rss: " << currentMemoryUsage / GB << " full needed memory: " << fullNeededMemoryForCtrs / GB << Endl;
-        size_t currentNonDroppableMemory = currentMemoryUsage;
+        CATBOOST_DEBUG_LOG << "available memory: " << availableMemory / GB << " full needed memory: " << fullNeededMemoryForCtrs / GB << Endl;
+        size_t currentNonDroppableMemory = 0;
         size_t maxMemForOtherThreadsApprox = (ui64)(threadCount - 1) * maxMemoryForOneCtr;
         for (auto& candSubList : *candList) {
             const auto firstSubCandidate = candSubList.Candidates[0].SplitCandidate;
@@ -309,7 +341,7 @@ static void SelectCtrsToDropAfterCalc(size_t memoryLimit,
             }
             candSubList.ShouldDropCtrAfterCalc = true;
             const size_t neededMem = sampleCount * candSubList.Candidates.size();
-            if (currentNonDroppableMemory + neededMem + maxMemForOtherThreadsApprox <= memoryLimit) {
+            if (currentNonDroppableMemory + neededMem + maxMemForOtherThreadsApprox <= availableMemory) {
                 candSubList.ShouldDropCtrAfterCalc = false;
                 currentNonDroppableMemory += neededMem;
             }
@@ -317,6 +349,57 @@ static void SelectCtrsToDropAfterCalc(size_t memoryLimit,
     }
 }
 
+// relative to the cost of adding one object to bucket stats
+constexpr double CtrCalcCostPerObjectAndFeature = 4.0;
+
+// Cost of a pass over sampled documents to calculate bucket stats of split
+static double EstimateStatsCalcCost(
+    const TQuantizedForCPUObjectsDataProvider& objectsData,
+    const TSplitCandidate& split,
+    int sampledDocCount
+) {
+    if (split.Type == ESplitType::FloatFeature) {
+        if (auto sparseFeature = objectsData.GetSparseFloatFeature((ui32)split.FeatureIdx)) {
+            const auto& srcData = (**sparseFeature).GetSrcData();
+            return double(sampledDocCount) * srcData.GetNonDefaultSize() / Max<ui32>(srcData.GetSize(), 1);
+        }
+    }
+    return sampledDocCount;
+}
+
+// Cost of calculating scores from bucket stats of split
+static double EstimateScoresCalcCost(
+    const TQuantizedForCPUObjectsDataProvider& objectsData,
+    const TVector<int>& splitCounts,
+    const TSplitCandidate& split,
+    int depth
+) {
+    const int bucketCount = GetSplitCount(splitCounts, *objectsData.GetQuantizedFeaturesInfo(), split) + 1;
+    return double(bucketCount) * (1 << depth);
+}
+
+namespace {
+    /* Unit of work for candidates scoring: a single subcandidate, or all subcandidates of a candidate
+     * if they have to be processed together (exclusive features bundles, ctrs dropped after calculation)
+     */
+    struct TScoreCalcTask {
+        static constexpr int AllSubcandidates = -1;
+
+        int CandidateIdx = 0;
+        int SubcandidateIdx = AllSubcandidates;
+        TMaybe<ui32> BundleIdx;
+        double Cost = 0.0;
+    };
+}
+
+/* Candidates are scored in two flat passes over the local executor, most expensive tasks first, so threads
+ * that finish early pick up the remaining tasks (and document blocks of map-merge inside them) instead of
+ * idling while the last expensive ctr candidates are calculated:
+ *  1) online ctrs of candidates that are not in cache yet,
+ *  2) stats and scores of all subcandidates.
+ * Ctrs of candidates that are dropped after score calculation are calculated and scored in a single task
+ * so that at most one such ctr per thread is kept in memory (see SelectCtrsToDropAfterCalc).
+ */
 static void CalcBestScore(const TTrainingForCPUDataProviders& data,
         const TVector<int>& splitCounts,
         int currentDepth,
@@ -325,12 +408,138 @@ static void CalcBestScore(const TTrainingForCPUDataProviders& data,
         TCandidateList* candidateList,
         TFold* fold,
         TLearnContext* ctx) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcBestScore");
+
     CB_ENSURE(static_cast<ui32>(ctx->LocalExecutor->GetThreadCount()) == ctx->Params.SystemOptions->NumThreads - 1);
     const TFlatPairsInfo pairs = UnpackPairsFromQueries(fold->LearnQueriesInfo);
+    const bool isPairwiseScoring = IsPairwiseScoring(ctx->Params.LossFunctionDescription->GetLossFunction());
     TCandidateList& candList = *candidateList;
-    ctx->LocalExecutor->ExecRange([&](int id) {
-        auto& candidate = candList[id];
-        if (candidate.Candidates[0].SplitCandidate.Type == ESplitType::OnlineCtr) {
+    const auto& objectsData = *data.Learn->ObjectsData;
+
+    const int sampledDocCount = ctx->SampledDocs.GetDocCount();
+    const int statsPerDocCount = ctx->SampledDocs.GetBodyTailCount() * ctx->SampledDocs.GetApproxDimension();
+    const ui32 allObjectCount = data.Learn->GetObjectCount() + data.GetTestSampleCount();
+
+    TVector<std::pair<int, double>> ctrCalcTasks; // (candidateIdx, cost)
+    TVector<TScoreCalcTask> scoreCalcTasks;
+    for (int candidateIdx : xrange(candList.ysize())) {
+        const auto& candidate = candList[candidateIdx];
+        const auto& firstSplit = candidate.Candidates[0].SplitCandidate;
+
+        double ctrCalcCost = 0.0;
+        if (firstSplit.Type == ESplitType::OnlineCtr && fold->GetCtrRef(firstSplit.Ctr.Projection).Feature.empty()) {
+            ctrCalcCost = CtrCalcCostPerObjectAndFeature * allObjectCount
+                * firstSplit.Ctr.Projection.GetFullProjectionLength();
+            if (!candidate.ShouldDropCtrAfterCalc) {
+                ctrCalcTasks.emplace_back(candidateIdx, ctrCalcCost);
+                ctrCalcCost = 0.0;
+            }
+        }
+
+        const TMaybe<ui32> bundleIdx =
+            (!isPairwiseScoring && !ctx->UseTreeLevelCaching() && (candidate.Candidates.size() > 1)
+                && (firstSplit.Type == ESplitType::FloatFeature)) ?
+                GetExclusiveFeaturesBundleIdx(objectsData, TFloatFeatureIdx(firstSplit.FeatureIdx))
+                : Nothing();
+        if (bundleIdx || candidate.ShouldDropCtrAfterCalc) {
+            // bundle stats are calculated in one pass over documents for all its features
+            double cost = bundleIdx ? EstimateStatsCalcCost(objectsData, firstSplit, sampledDocCount) : 0.0;
+            for (const auto& subcandidate : candidate.Candidates) {
+                if (!bundleIdx) {
+                    cost += EstimateStatsCalcCost(objectsData, subcandidate.SplitCandidate, sampledDocCount);
+                }
+                cost += EstimateScoresCalcCost(objectsData, splitCounts, subcandidate.SplitCandidate, currentDepth);
+            }
+            scoreCalcTasks.push_back(
+                TScoreCalcTask{candidateIdx, TScoreCalcTask::AllSubcandidates, bundleIdx, ctrCalcCost + statsPerDocCount * cost}
+            );
+        } else {
+            for (int subcandidateIdx : xrange(candidate.Candidates.ysize())) {
+                const auto& split = candidate.Candidates[subcandidateIdx].SplitCandidate;
+                const double cost = EstimateStatsCalcCost(objectsData, split, sampledDocCount)
+                    + EstimateScoresCalcCost(objectsData, splitCounts, split, currentDepth);
+                scoreCalcTasks.push_back(TScoreCalcTask{candidateIdx, subcandidateIdx, Nothing(), statsPerDocCount * cost});
+            }
+        }
+    }
+
+    StableSortBy(ctrCalcTasks, [] (const auto& task) { return -task.second; });
+    ctx->LocalExecutor->ExecRange([&](int taskIdx) {
+        CHROMIUM_TRACE_SCOPE("Calc candidate ctrs");
+        const auto& proj = candList[ctrCalcTasks[taskIdx].first].Candidates[0].SplitCandidate.Ctr.Projection;
+        ComputeOnlineCTRs(data,
+                          *fold,
+                          proj,
+                          ctx,
+                          &fold->GetCtrRef(proj));
+    }, 0, ctrCalcTasks.ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    TVector<TVector<TVector<double>>> allScores(candList.size()); // [candidateIdx][subcandidateIdx]
+    for (int candidateIdx : xrange(candList.ysize())) {
+        allScores[candidateIdx].resize(candList[candidateIdx].Candidates.size());
+    }
+
+    const auto calcSubcandidateScores = [&] (const TCandidatesInfoList& candidate, int subcandidateIdx) {
+        CHROMIUM_TRACE_SCOPE("Score candidate");
+        const auto& split = candidate.Candidates[subcandidateIdx].SplitCandidate;
+        if (split.Type == ESplitType::OnlineCtr) {
+            Y_ASSERT(!fold->GetCtrRef(split.Ctr.Projection).Feature.empty());
+        }
+        TVector<TScoreBin> scoreBins;
+        CalcStatsAndScores(objectsData,
+                           splitCounts,
+                           fold->GetAllCtrs(),
+                           ctx->SampledDocs,
+                           ctx->SmallestSplitSideDocs,
+                           fold,
+                           pairs,
+                           ctx->Params,
+                           split,
+                           currentDepth,
+                           ctx->UseTreeLevelCaching(),
+                           ctx->LocalExecutor,
+                           &ctx->ScratchArena,
+                           &ctx->PrevTreeLevelStats,
+                           /*stats3d*/nullptr,
+                           /*pairwiseStats*/nullptr,
+                           &scoreBins);
+        return GetScores(scoreBins);
+    };
+
+    StableSortBy(scoreCalcTasks, [] (const TScoreCalcTask& task) { return -task.Cost; });
+    ctx->LocalExecutor->ExecRange([&](int taskIdx) {
+        const auto& task = scoreCalcTasks[taskIdx];
+        auto& candidate = candList[task.CandidateIdx];
+        auto& candidateScores = allScores[task.CandidateIdx];
+        if (task.SubcandidateIdx != TScoreCalcTask::AllSubcandidates) {
+            candidateScores[task.SubcandidateIdx] = calcSubcandidateScores(candidate, task.SubcandidateIdx);
+            return;
+        }
+
+        CHROMIUM_TRACE_SCOPE("Score candidates group");
+        if (task.BundleIdx) {
+            TVector<TSplitCandidate> splits;
+            for (const auto& oneCandidate : candidate.Candidates) {
+                splits.push_back(oneCandidate.SplitCandidate);
+            }
+            TVector<TVector<TScoreBin>> scoreBins;
+            CalcScoresForExclusiveFeaturesBundle(
+                objectsData,
+                ctx->SampledDocs,
+                *fold,
+                ctx->Params,
+                *task.BundleIdx,
+                splits,
+                currentDepth,
+                ctx->LocalExecutor,
+                &ctx->ScratchArena,
+                &scoreBins
+            );
+            for (auto oneCandidate : xrange(candidate.Candidates.size())) {
+                candidateScores[oneCandidate] = GetScores(scoreBins[oneCandidate]);
+            }
+        } else {
+            Y_ASSERT(candidate.ShouldDropCtrAfterCalc);
             const auto& proj = candidate.Candidates[0].SplitCandidate.Ctr.Projection;
             if (fold->GetCtrRef(proj).Feature.empty()) {
                 ComputeOnlineCTRs(data,
@@ -339,37 +548,16 @@ static void CalcBestScore(const TTrainingForCPUDataProviders& data,
                                   ctx,
                                   &fold->GetCtrRef(proj));
             }
+            ctx->LocalExecutor->ExecRange([&](int oneCandidate) {
+                candidateScores[oneCandidate] = calcSubcandidateScores(candidate, oneCandidate);
+            }, NPar::TLocalExecutor::TExecRangeParams(0, candidate.Candidates.ysize())
+             , NPar::TLocalExecutor::WAIT_COMPLETE);
+            fold->GetCtrRef(proj).Feature.clear();
         }
-        TVector<TVector<double>> allScores(candidate.Candidates.size());
-        ctx->LocalExecutor->ExecRange([&](int oneCandidate) {
-            if (candidate.Candidates[oneCandidate].SplitCandidate.Type == ESplitType::OnlineCtr) {
-                const auto& proj = candidate.Candidates[oneCandidate].SplitCandidate.Ctr.Projection;
-                Y_ASSERT(!fold->GetCtrRef(proj).Feature.empty());
-            }
-            TVector<TScoreBin> scoreBins;
-            CalcStatsAndScores(*data.Learn->ObjectsData,
-                               splitCounts,
-                               fold->GetAllCtrs(),
-                               ctx->SampledDocs,
-                               ctx->SmallestSplitSideDocs,
-                               fold,
-                               pairs,
-                               ctx->Params,
-                               candidate.Candidates[oneCandidate].SplitCandidate,
-                               currentDepth,
-                               ctx->UseTreeLevelCaching(),
-                               ctx->LocalExecutor,
-                               &ctx->PrevTreeLevelStats,
-                               /*stats3d*/nullptr,
-                               /*pairwiseStats*/nullptr,
-                               &scoreBins);
-            allScores[oneCandidate] = GetScores(scoreBins);
-        }, NPar::TLocalExecutor::TExecRangeParams(0, candidate.Candidates.ysize())
-         , NPar::TLocalExecutor::WAIT_COMPLETE);
-        if (candidate.Candidates[0].SplitCandidate.Type == ESplitType::OnlineCtr && candidate.ShouldDropCtrAfterCalc) {
-            fold->GetCtrRef(candidate.Candidates[0].SplitCandidate.Ctr.Projection).Feature.clear();
-        }
-        SetBestScore(randSeed + id, allScores, scoreStDev, &candidate.Candidates);
+    }, 0, scoreCalcTasks.ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
+
+    ctx->LocalExecutor->ExecRange([&](int candidateIdx) {
+        SetBestScore(randSeed + candidateIdx, allScores[candidateIdx], scoreStDev, &candList[candidateIdx].Candidates);
     }, 0, candList.ysize(), NPar::TLocalExecutor::WAIT_COMPLETE);
 }
 
@@ -413,8 +601,7 @@ void GreedyTensorSearch(const TTrainingForCPUDataProviders& data,
         AddTreeCtrs(*data.Learn->ObjectsData, currentSplitTree, fold, ctx, &ctx->PrevTreeLevelStats, &candList);
 
         auto IsInCache = [&fold](const TProjection& proj) -> bool {return fold->GetCtrRef(proj).Feature.empty();};
-        auto cpuUsedRamLimit = ParseMemorySizeDescription(ctx->Params.SystemOptions->CpuUsedRamLimit.Get());
-        SelectCtrsToDropAfterCalc(cpuUsedRamLimit, learnSampleCount + testSampleCount, ctx->Params.SystemOptions->NumThreads, IsInCache, &candList);
+        SelectCtrsToDropAfterCalc(ctx->MemoryAccountant.GetAvailable(), learnSampleCount + testSampleCount, ctx->Params.SystemOptions->NumThreads, IsInCache, &candList);
 
         CheckInterrupted(); // check after long-lasting operation
         if (!isSamplingPerTree) {
@@ -505,6 +692,9 @@ void GreedyTensorSearch(const TTrainingForCPUDataProviders& data,
         }
 
         if (ctx->Params.SystemOptions->IsSingleHost()) {
+            if (ctx->UseMaterializedPermutedFeatures()) {
+                MaterializePermutedFeatures({bestSplit}, *data.Learn->ObjectsData, ctx->LocalExecutor, fold);
+            }
             SetPermutedIndices(bestSplit, *data.Learn->ObjectsData, curDepth + 1, *fold, &indices, ctx->LocalExecutor);
             if (isSamplingPerTree) {
                 ctx->SampledDocs.UpdateIndices(indices, ctx->LocalExecutor);
@@ -3,6 +3,7 @@
 #include <catboost/libs/distributed/master.h>
 #include <catboost/libs/logging/logging.h>
 
+#include <library/chromium_trace/interface.h>
 #include <library/malloc/api/malloc.h>
 
 #include <functional>
@@ -79,6 +80,89 @@ void ConfigureMalloc() {
 #endif
 }
 
+static void CalcLearnErrors(
+    const TTrainingForCPUDataProviders& trainingDataProviders,
+    const TVector<THolder<IMetric>>& errors,
+    const TVector<TVector<double>>& learnApprox,
+    NPar::TLocalExecutor* localExecutor,
+    TMetricsAndTimeLeftHistory* metricsAndTimeHistory
+) {
+    const auto& targetData = trainingDataProviders.Learn->TargetData;
+
+    auto target = GetMaybeTarget(targetData).GetOrElse(TConstArrayRef<float>());
+    auto weights = GetWeights(targetData);
+    auto queryInfo = GetGroupInfo(targetData);
+
+    TVector<bool> skipMetricOnTrain = GetSkipMetricOnTrain(errors);
+    for (int i = 0; i < errors.ysize(); ++i) {
+        if (!skipMetricOnTrain[i]) {
+            const auto& additiveStats = EvalErrors(
+                learnApprox,
+                target,
+                weights,
+                queryInfo,
+                errors[i],
+                localExecutor
+            );
+            metricsAndTimeHistory->AddLearnError(*errors[i].Get(), errors[i]->GetFinalError(additiveStats));
+        }
+    }
+}
+
+static void CalcTestErrors(
+    const TTrainingForCPUDataProviders& trainingDataProviders,
+    const TVector<THolder<IMetric>>& errors,
+    const TVector<TVector<TVector<double>>>& testApprox,
+    bool calcAllMetrics,
+    bool calcErrorTrackerMetric,
+    NPar::TLocalExecutor* localExecutor,
+    TMetricsAndTimeLeftHistory* metricsAndTimeHistory
+) {
+    const int errorTrackerMetricIdx = calcErrorTrackerMetric ? 0 : -1;
+
+    metricsAndTimeHistory->TestMetricsHistory.emplace_back(); // new [iter]
+    for (size_t testIdx = 0; testIdx < trainingDataProviders.Test.size(); ++testIdx) {
+        const auto& testDataPtr = trainingDataProviders.Test[testIdx];
+
+        if (testDataPtr == nullptr || testDataPtr->GetObjectCount() == 0) {
+            continue;
+        }
+        // Use only last testset for eval metric
+        if (!calcAllMetrics && testIdx != trainingDataProviders.Test.size() - 1) {
+            continue;
+        }
+        const auto& targetData = testDataPtr->TargetData;
+
+        auto maybeTarget = GetMaybeTarget(targetData);
+        auto target = maybeTarget.GetOrElse(TConstArrayRef<float>());
+        auto weights = GetWeights(targetData);
+        auto queryInfo = GetGroupInfo(targetData);
+
+        for (int i = 0; i < errors.ysize(); ++i) {
+            if (!calcAllMetrics && (i != errorTrackerMetricIdx)) {
+                continue;
+            }
+            if (!maybeTarget && errors[i]->NeedTarget()) {
+                continue;
+            }
+
+            const auto& additiveStats = EvalErrors(
+                testApprox[testIdx],
+                target,
+                weights,
+                queryInfo,
+                errors[i],
+                localExecutor
+            );
+            bool updateBestIteration = (i == 0) && (testIdx == trainingDataProviders.Test.size() - 1);
+            metricsAndTimeHistory->AddTestError(testIdx,
+                                                *errors[i].Get(),
+                                                errors[i]->GetFinalError(additiveStats),
+                                                updateBestIteration);
+        }
+    }
+}
+
 void CalcErrors(
     const TTrainingForCPUDataProviders& trainingDataProviders,
     const TVector<THolder<IMetric>>& errors,
@@ -86,80 +170,68 @@ void CalcErrors(
     bool calcErrorTrackerMetric,
     TLearnContext* ctx
 ) {
+    if (ctx->Params.SystemOptions->IsSingleHost()) {
+        CalcErrors(
+            trainingDataProviders,
+            errors,
+            ctx->LearnProgress.AvrgApprox,
+            ctx->LearnProgress.TestApprox,
+            calcAllMetrics,
+            calcErrorTrackerMetric,
+            ctx->LocalExecutor,
+            &ctx->LearnProgress.MetricsAndTimeHistory
+        );
+        return;
+    }
+
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcErrors");
+
     if (trainingDataProviders.Learn->GetObjectCount() > 0) {
         ctx->LearnProgress.MetricsAndTimeHistory.LearnMetricsHistory.emplace_back();
         if (calcAllMetrics) {
-            if (ctx->Params.SystemOptions->IsSingleHost()) {
-                const auto& targetData = trainingDataProviders.Learn->TargetData;
-
-                auto target = GetMaybeTarget(targetData).GetOrElse(TConstArrayRef<float>());
-                auto weights = GetWeights(targetData);
-                auto queryInfo = GetGroupInfo(targetData);
-
-                TVector<bool> skipMetricOnTrain = GetSkipMetricOnTrain(errors);
-                for (int i = 0; i < errors.ysize(); ++i) {
-                    if (!skipMetricOnTrain[i]) {
-                        const auto& additiveStats = EvalErrors(
-                            ctx->LearnProgress.AvrgApprox,
-                            target,
-                            weights,
-                            queryInfo,
-                            errors[i],
-                            ctx->LocalExecutor
-                        );
-                        ctx->LearnProgress.MetricsAndTimeHistory.AddLearnError(*errors[i].Get(), errors[i]->GetFinalError(additiveStats));
-                    }
-                }
-            } else {
-                MapCalcErrors(ctx);
-            }
+            MapCalcErrors(ctx);
         }
     }
-
-    const int errorTrackerMetricIdx = calcErrorTrackerMetric ? 0 : -1;
-
     if (trainingDataProviders.GetTestSampleCount() > 0) {
-        ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory.emplace_back(); // new [iter]
-        for (size_t testIdx = 0; testIdx < trainingDataProviders.Test.size(); ++testIdx) {
-            const auto& testDataPtr = trainingDataProviders.Test[testIdx];
+        CalcTestErrors(
+            trainingDataProviders,
+            errors,
+            ctx->LearnProgress.TestApprox,
+            calcAllMetrics,
+            calcErrorTrackerMetric,
+            ctx->LocalExecutor,
+            &ctx->LearnProgress.MetricsAndTimeHistory
+        );
+    }
+}
 
-            if (testDataPtr == nullptr || testDataPtr->GetObjectCount() == 0) {
-                continue;
-            }
-            // Use only last testset for eval metric
-            if (!calcAllMetrics && testIdx != trainingDataProviders.Test.size() - 1) {
-                continue;
-            }
-            const auto& targetData = testDataPtr->TargetData;
-
-            auto maybeTarget = GetMaybeTarget(targetData);
-            auto target = maybeTarget.GetOrElse(TConstArrayRef<float>());
-            auto weights = GetWeights(targetData);
-            auto queryInfo = GetGroupInfo(targetData);
-
-            const auto& testApprox = ctx->LearnProgress.TestApprox[testIdx];
-            for (int i = 0; i < errors.ysize(); ++i) {
-                if (!calcAllMetrics && (i != errorTrackerMetricIdx)) {
-                    continue;
-                }
-                if (!maybeTarget && errors[i]->NeedTarget()) {
-                    continue;
-                }
-
-                const auto& additiveStats = EvalErrors(
-                    testApprox,
-                    target,
-                    weights,
-                    queryInfo,
-                    errors[i],
-                    ctx->LocalExecutor
-                );
-                bool updateBestIteration = (i == 0) && (testIdx == trainingDataProviders.Test.size() - 1);
-                ctx->LearnProgress.MetricsAndTimeHistory.AddTestError(testIdx,
-                                                                      *errors[i].Get(),
-                                                                      errors[i]->GetFinalError(additiveStats),
-                                                                      updateBestIteration);
-            }
+void CalcErrors(
+    const TTrainingForCPUDataProviders& trainingDataProviders,
+    const TVector<THolder<IMetric>>& errors,
+    const TVector<TVector<double>>& learnApprox,
+    const TVector<TVector<TVector<double>>>& testApprox,
+    bool calcAllMetrics,
+    bool calcErrorTrackerMetric,
+    NPar::TLocalExecutor* localExecutor,
+    TMetricsAndTimeLeftHistory* metricsAndTimeHistory
+) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcErrors");
+
+    if (trainingDataProviders.Learn->GetObjectCount() > 0) {
+        metricsAndTimeHistory->LearnMetricsHistory.emplace_back();
+        if (calcAllMetrics) {
+            CalcLearnErrors(trainingDataProviders, errors, learnApprox, localExecutor, metricsAndTimeHistory);
         }
     }
+    if (trainingDataProviders.GetTestSampleCount() > 0) {
+        CalcTestErrors(
+            trainingDataProviders,
+            errors,
+            testApprox,
+            calcAllMetrics,
+            calcErrorTrackerMetric,
+            localExecutor,
+            metricsAndTimeHistory
+        );
+    }
 }
@@ -24,3 +24,15 @@ void CalcErrors(
     bool calcErrorTrackerMetric,
     TLearnContext* ctx
 );
+
+// Single host only: evaluates metrics on given approxes and appends them to metricsAndTimeHistory
+void CalcErrors(
+    const NCB::TTrainingForCPUDataProviders& trainingDataProviders,
+    const TVector<THolder<IMetric>>& errors,
+    const TVector<TVector<double>>& learnApprox, // [dim][docIdx]
+    const TVector<TVector<TVector<double>>>& testApprox, // [test][dim][docIdx]
+    bool calcAllMetrics,
+    bool calcErrorTrackerMetric,
+    NPar::TLocalExecutor* localExecutor,
+    TMetricsAndTimeLeftHistory* metricsAndTimeHistory
+);
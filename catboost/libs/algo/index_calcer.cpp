@@ -11,6 +11,11 @@
 #include <catboost/libs/model/formula_evaluator.h>
 #include <catboost/libs/helpers/dense_hash.h>
 
+#include <library/chromium_trace/interface.h>
+
+#include <util/generic/mapfindptr.h>
+#include <util/system/compiler.h>
+
 
 using namespace NCB;
 
@@ -27,11 +32,12 @@ static inline ui8 GetFeatureSplitIdx(const TSplit& split) {
     return split.BinBorder;
 }
 
-static inline const ui8* GetFloatHistogram(
+// sparse and block compressed features are materialized in the result, so get it once per split, not per block
+static inline TMaybeOwningConstArrayHolder<ui8> GetFloatHistogram(
     const TSplit& split,
     const TQuantizedForCPUObjectsDataProvider& objectsDataProvider) {
 
-    return *(*objectsDataProvider.GetFloatFeature((ui32)split.FeatureIdx))->GetArrayData().GetSrc();
+    return objectsDataProvider.GetFloatFeatureSrcBins((ui32)split.FeatureIdx);
 }
 
 static inline const ui32* GetRemappedCatFeatures(
@@ -41,7 +47,10 @@ static inline const ui32* GetRemappedCatFeatures(
     return *(*objectsDataProvider.GetCatFeature((ui32)split.FeatureIdx))->GetArrayData().GetSrc();
 }
 
-template <typename TCount, bool (*CmpOp)(TCount, TCount), int vectorWidth>
+// distance (in documents) at which histogram values are prefetched while walking the permutation
+constexpr int PREFETCH_DISTANCE = 64;
+
+template <typename TCount, bool (*CmpOp)(TCount, TCount), int vectorWidth, bool prefetch>
 void BuildIndicesKernel(
     const ui32* permutation,
     const TCount* histogram,
@@ -50,6 +59,12 @@ void BuildIndicesKernel(
     TIndexType* indices) {
 
     Y_ASSERT(vectorWidth == 4);
+    if (prefetch) {
+        Y_PREFETCH_READ(histogram + permutation[PREFETCH_DISTANCE + 0], 3);
+        Y_PREFETCH_READ(histogram + permutation[PREFETCH_DISTANCE + 1], 3);
+        Y_PREFETCH_READ(histogram + permutation[PREFETCH_DISTANCE + 2], 3);
+        Y_PREFETCH_READ(histogram + permutation[PREFETCH_DISTANCE + 3], 3);
+    }
     const ui32 perm0 = permutation[0];
     const ui32 perm1 = permutation[1];
     const ui32 perm2 = permutation[2];
@@ -80,10 +95,20 @@ void OfflineCtrBlock(
 
     const int blockStart = blockIdx * params.GetBlockSize();
     const int nextBlockStart = Min<ui64>(blockStart + params.GetBlockSize(), params.LastId);
+    // permutation is read up to PREFETCH_DISTANCE elements ahead, so stop prefetching before its end
+    const int prefetchBlockEnd = Min<int>(nextBlockStart, params.LastId - PREFETCH_DISTANCE);
     constexpr int vectorWidth = 4;
     int doc;
-    for (doc = blockStart; doc + vectorWidth <= nextBlockStart; doc += vectorWidth) {
-        BuildIndicesKernel<TCount, CmpOp, vectorWidth>(
+    for (doc = blockStart; doc + vectorWidth <= prefetchBlockEnd; doc += vectorWidth) {
+        BuildIndicesKernel<TCount, CmpOp, vectorWidth, /*prefetch*/ true>(
+            permutation + doc,
+            histogram,
+            value,
+            level,
+            indices + doc);
+    }
+    for (; doc + vectorWidth <= nextBlockStart; doc += vectorWidth) {
+        BuildIndicesKernel<TCount, CmpOp, vectorWidth, /*prefetch*/ false>(
             permutation + doc,
             histogram,
             value,
@@ -96,6 +121,120 @@ void OfflineCtrBlock(
     }
 }
 
+// same as OfflineCtrBlock, but histogram is already in permuted order
+template <typename TCount, bool (*CmpOp)(TCount, TCount)>
+void PermutedHistogramBlock(
+    const NPar::TLocalExecutor::TExecRangeParams& params,
+    int blockIdx,
+    const TCount* permutedHistogram,
+    TCount value,
+    int level,
+    TIndexType* indices) {
+
+    const int blockStart = blockIdx * params.GetBlockSize();
+    const int nextBlockStart = Min<ui64>(blockStart + params.GetBlockSize(), params.LastId);
+    for (int doc = blockStart; doc < nextBlockStart; ++doc) {
+        indices[doc] += CmpOp(permutedHistogram[doc], value) * level;
+    }
+}
+
+template <typename TCount>
+static void GatherPermuted(
+    const TCount* histogram,
+    const ui32* permutation,
+    int docCount,
+    NPar::TLocalExecutor* localExecutor,
+    TVector<TCount>* permutedHistogram) {
+
+    permutedHistogram->yresize(docCount);
+    TCount* permutedHistogramData = permutedHistogram->data();
+
+    NPar::TLocalExecutor::TExecRangeParams blockParams(0, docCount);
+    blockParams.SetBlockSize(10000);
+    localExecutor->ExecRange(
+        [=] (int blockIdx) {
+            const int blockStart = blockIdx * blockParams.GetBlockSize();
+            const int nextBlockStart = Min(blockStart + blockParams.GetBlockSize(), blockParams.LastId);
+            const int prefetchBlockEnd = Min(nextBlockStart, blockParams.LastId - PREFETCH_DISTANCE);
+            int doc = blockStart;
+            for (; doc < prefetchBlockEnd; ++doc) {
+                Y_PREFETCH_READ(histogram + permutation[doc + PREFETCH_DISTANCE], 3);
+                permutedHistogramData[doc] = histogram[permutation[doc]];
+            }
+            for (; doc < nextBlockStart; ++doc) {
+                permutedHistogramData[doc] = histogram[permutation[doc]];
+            }
+        },
+        0,
+        blockParams.GetBlockCount(),
+        NPar::TLocalExecutor::WAIT_COMPLETE);
+}
+
+void MaterializePermutedFeatures(
+    TConstArrayRef<TSplit> splits,
+    const NCB::TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
+    NPar::TLocalExecutor* localExecutor,
+    TFold* fold) {
+
+    const ui32* permutation = fold->LearnPermutationFeaturesSubset.Get<TIndexedSubset<ui32>>().data();
+    const int docCount = fold->LearnPermutationFeaturesSubset.Size();
+    for (const auto& split : splits) {
+        const ui32 featureIdx = (ui32)split.FeatureIdx;
+        if (split.Type == ESplitType::FloatFeature) {
+            // sparse and block compressed features are kept as they are, copies would densify them
+            if (objectsDataProvider.IsSparseFloatFeature(featureIdx)
+                || objectsDataProvider.GetBlockCompressedFloatFeature(featureIdx))
+            {
+                continue;
+            }
+            if (!fold->PermutedFloatFeatures.contains(featureIdx)) {
+                GatherPermuted(
+                    (*GetFloatHistogram(split, objectsDataProvider)).data(),
+                    permutation,
+                    docCount,
+                    localExecutor,
+                    &fold->PermutedFloatFeatures[featureIdx]);
+            }
+        } else if (split.Type == ESplitType::OneHotFeature) {
+            if (!fold->PermutedOneHotFeatures.contains(featureIdx)) {
+                GatherPermuted(
+                    GetRemappedCatFeatures(split, objectsDataProvider),
+                    permutation,
+                    docCount,
+                    localExecutor,
+                    &fold->PermutedOneHotFeatures[featureIdx]);
+            }
+        }
+    }
+}
+
+template <typename TCount>
+static const TCount* GetPermutedHistogram(const THashMap<ui32, TVector<TCount>>* permutedFeatures, const TSplit& split) {
+    if (permutedFeatures == nullptr) {
+        return nullptr;
+    }
+    const auto* permutedHistogram = MapFindPtr(*permutedFeatures, (ui32)split.FeatureIdx);
+    return permutedHistogram ? permutedHistogram->data() : nullptr;
+}
+
+template <typename TCount, bool (*CmpOp)(TCount, TCount)>
+static void UpdateIndicesBlock(
+    const NPar::TLocalExecutor::TExecRangeParams& params,
+    int blockIdx,
+    const ui32* permutation,
+    const TCount* histogram,
+    const TCount* permutedHistogram, // can be nullptr
+    TCount value,
+    int level,
+    TIndexType* indices) {
+
+    if (permutedHistogram) {
+        PermutedHistogramBlock<TCount, CmpOp>(params, blockIdx, permutedHistogram, value, level, indices);
+    } else {
+        OfflineCtrBlock<TCount, CmpOp>(params, blockIdx, permutation, histogram, value, level, indices);
+    }
+}
+
 void SetPermutedIndices(
     const TSplit& split,
     const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
@@ -103,6 +242,7 @@ void SetPermutedIndices(
     const TFold& fold,
     TVector<TIndexType>* indices,
     NPar::TLocalExecutor* localExecutor) {
+    CHROMIUM_TRACE_FUNCTION_NAME("SetPermutedIndices");
 
     CB_ENSURE(curDepth > 0);
 
@@ -113,13 +253,15 @@ void SetPermutedIndices(
     const int splitWeight = 1 << (curDepth - 1);
     TIndexType* indicesData = indices->data();
     if (split.Type == ESplitType::FloatFeature) {
+        const auto histogram = GetFloatHistogram(split, objectsDataProvider);
         localExecutor->ExecRange(
             [&](int blockIdx) {
-                OfflineCtrBlock<ui8, IsTrueHistogram>(
+                UpdateIndicesBlock<ui8, IsTrueHistogram>(
                     blockParams,
                     blockIdx,
                     fold.LearnPermutationFeaturesSubset.Get<TIndexedSubset<ui32>>().data(),
-                    GetFloatHistogram(split, objectsDataProvider),
+                    (*histogram).data(),
+                    GetPermutedHistogram(&fold.PermutedFloatFeatures, split),
                     GetFeatureSplitIdx(split),
                     splitWeight,
                     indicesData);
@@ -139,11 +281,12 @@ void SetPermutedIndices(
         Y_ASSERT(split.Type == ESplitType::OneHotFeature);
         localExecutor->ExecRange(
             [&] (int blockIdx) {
-                OfflineCtrBlock<ui32, IsTrueOneHotFeature>(
+                UpdateIndicesBlock<ui32, IsTrueOneHotFeature>(
                     blockParams,
                     blockIdx,
                     fold.LearnPermutationFeaturesSubset.Get<TIndexedSubset<ui32>>().data(),
                     GetRemappedCatFeatures(split, objectsDataProvider),
+                    GetPermutedHistogram(&fold.PermutedOneHotFeatures, split),
                     (ui32)split.BinBorder,
                     splitWeight,
                     indicesData);
@@ -201,10 +344,14 @@ static void BuildIndicesForDataset(
     const NCB::TFeaturesArraySubsetIndexing& featuresArraySubsetIndexing,
     ui32 sampleCount,
     const TVector<const TOnlineCTR*>& onlineCtrs,
+    const TFold* permutedFeaturesFold, // can be nullptr, used only for learn
     int docOffset,
     NPar::TLocalExecutor* localExecutor,
     TIndexType* indices) {
 
+    const auto* permutedFloatFeatures = permutedFeaturesFold ? &permutedFeaturesFold->PermutedFloatFeatures : nullptr;
+    const auto* permutedOneHotFeatures = permutedFeaturesFold ? &permutedFeaturesFold->PermutedOneHotFeatures : nullptr;
+
     const ui32* permutation = nullptr;
     TVector<ui32> permutationStorage;
     if (HoldsAlternative<TIndexedSubset<ui32>>(featuresArraySubsetIndexing)) {
@@ -218,6 +365,15 @@ static void BuildIndicesForDataset(
         permutation = permutationStorage.data();
     }
 
+    TVector<TMaybeOwningConstArrayHolder<ui8>> floatHistogramHolders;
+    TVector<const ui8*> floatHistograms(tree.GetDepth(), nullptr); // [splitIdx]
+    for (int splitIdx = 0; splitIdx < tree.GetDepth(); ++splitIdx) {
+        if (tree.Splits[splitIdx].Type == ESplitType::FloatFeature) {
+            floatHistogramHolders.push_back(GetFloatHistogram(tree.Splits[splitIdx], objectsDataProvider));
+            floatHistograms[splitIdx] = (*floatHistogramHolders.back()).data();
+        }
+    }
+
     const int blockSize = 1000;
     NPar::TLocalExecutor::TExecRangeParams blockParams(0, (int)sampleCount);
     blockParams.SetBlockSize(blockSize);
@@ -227,11 +383,12 @@ static void BuildIndicesForDataset(
             const auto& split = tree.Splits[splitIdx];
             const int splitWeight = 1 << splitIdx;
             if (split.Type == ESplitType::FloatFeature) {
-                OfflineCtrBlock<ui8, IsTrueHistogram>(
+                UpdateIndicesBlock<ui8, IsTrueHistogram>(
                     blockParams,
                     blockIdx,
                     permutation,
-                    GetFloatHistogram(split, objectsDataProvider),
+                    floatHistograms[splitIdx],
+                    GetPermutedHistogram(permutedFloatFeatures, split),
                     GetFeatureSplitIdx(split),
                     splitWeight,
                     indices);
@@ -245,11 +402,12 @@ static void BuildIndicesForDataset(
                 )(blockIdx);
             } else {
                 Y_ASSERT(split.Type == ESplitType::OneHotFeature);
-                OfflineCtrBlock<ui32, IsTrueOneHotFeature>(
+                UpdateIndicesBlock<ui32, IsTrueOneHotFeature>(
                     blockParams,
                     blockIdx,
                     permutation,
                     GetRemappedCatFeatures(split, objectsDataProvider),
+                    GetPermutedHistogram(permutedOneHotFeatures, split),
                     (ui32)split.BinBorder,
                     splitWeight,
                     indices);
@@ -270,6 +428,7 @@ TVector<TIndexType> BuildIndices(
     NCB::TTrainingForCPUDataProviderPtr learnData, // can be nullptr
     TConstArrayRef<NCB::TTrainingForCPUDataProviderPtr> testData, // can be empty
     NPar::TLocalExecutor* localExecutor) {
+    CHROMIUM_TRACE_FUNCTION_NAME("BuildIndices");
 
     ui32 learnSampleCount = learnData ? learnData->GetObjectCount() : 0;
     ui32 tailSampleCount = 0;
@@ -288,6 +447,7 @@ TVector<TIndexType> BuildIndices(
             fold.LearnPermutationFeaturesSubset,
             learnSampleCount,
             onlineCtrs,
+            &fold,
             0,
             localExecutor,
             indices.begin());
@@ -301,6 +461,7 @@ TVector<TIndexType> BuildIndices(
             testSet.ObjectsData->GetFeaturesArraySubsetIndexing(),
             testSet.GetObjectCount(),
             onlineCtrs,
+            /*permutedFeaturesFold*/ nullptr,
             (int)docOffset,
             localExecutor,
             indices.begin() + docOffset);
@@ -327,22 +488,26 @@ void BinarizeFeatures(
     const auto& featuresLayout = *rawObjectsData.GetFeaturesLayout();
     const ui32 flatFeaturesCount = featuresLayout.GetExternalFeatureCount();
 
-    auto getFeatureDataBeginPtr = [&](ui32 flatFeatureIdx) -> const float* {
-        return GetRawFeatureDataBeginPtr(
+    TVector<TConstArrayRef<float>> repackedFeatures(model.ObliviousTrees.GetFlatFeatureVectorExpectedSize());
+    TVector<TVector<float>> sparseFeaturesBuffers(repackedFeatures.size());
+    auto getFeatureData = [&](ui32 flatFeatureIdx, ui32 repackedIdx) {
+        return GetRawFeatureDataBlock(
             rawObjectsData,
             featuresLayout,
             consecutiveSubsetBegin,
-            flatFeatureIdx);
+            flatFeatureIdx,
+            start,
+            docCount,
+            &sparseFeaturesBuffers[repackedIdx]);
     };
 
-    TVector<TConstArrayRef<float>> repackedFeatures(model.ObliviousTrees.GetFlatFeatureVectorExpectedSize());
     if (columnReorderMap.empty()) {
         for (ui32 i = 0; i < flatFeaturesCount; ++i) {
-            repackedFeatures[i] = MakeArrayRef(getFeatureDataBeginPtr(i) + start, docCount);
+            repackedFeatures[i] = getFeatureData(i, i);
         }
     } else {
         for (const auto& [origIdx, sourceIdx] : columnReorderMap) {
-            repackedFeatures[origIdx] = MakeArrayRef(getFeatureDataBeginPtr(sourceIdx) + start, docCount);
+            repackedFeatures[origIdx] = getFeatureData(sourceIdx, origIdx);
         }
     }
 
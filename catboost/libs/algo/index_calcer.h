@@ -9,6 +9,7 @@
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/array_ref.h>
 #include <util/generic/vector.h>
 
 
@@ -20,6 +21,16 @@ void SetPermutedIndices(
     TVector<TIndexType>* indices,
     NPar::TLocalExecutor* localExecutor);
 
+/* Gather permuted copies of float and one-hot features used in splits into fold->PermutedFloatFeatures
+ * and fold->PermutedOneHotFeatures (already materialized, sparse and block compressed features are skipped).
+ * SetPermutedIndices and BuildIndices use these copies for learn data when they are present.
+ */
+void MaterializePermutedFeatures(
+    TConstArrayRef<TSplit> splits,
+    const NCB::TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
+    NPar::TLocalExecutor* localExecutor,
+    TFold* fold);
+
 TVector<bool> GetIsLeafEmpty(int curDepth, const TVector<TIndexType>& indices);
 
 int GetRedundantSplitIdx(const TVector<bool>& isLeafEmpty);
@@ -57,10 +57,10 @@ inline void CalcHashes(const TProjection& proj,
     }
 
     for (const TBinFeature& feature : proj.BinFeatures) {
-        NCB::SubsetWithAlternativeIndexing(
-            objectsDataProvider.GetFloatFeature((ui32)feature.FloatFeature),
-            &featuresSubsetIndexing
-        ).ForEach(
+        // sparse features are materialized here
+        const auto srcBins = objectsDataProvider.GetFloatFeatureSrcBins((ui32)feature.FloatFeature);
+        const ui8* srcBinsData = (*srcBins).data();
+        NCB::TConstPtrArraySubset<ui8>(&srcBinsData, &featuresSubsetIndexing).ForEach(
             [feature, hashArr] (ui32 i, ui8 featureValue) {
                 const bool isTrueFeature = IsTrueHistogram(featureValue, (ui8)feature.SplitIdx);
                 hashArr[i] = CalcHash(hashArr[i], (ui64)isTrueFeature);
@@ -279,6 +279,63 @@ bool TLearnContext::UseTreeLevelCaching() const {
     return UseTreeLevelCachingFlag;
 }
 
+bool TLearnContext::UseMaterializedPermutedFeatures() const {
+    return UseMaterializedPermutedFeaturesFlag;
+}
+
+void TLearnContext::UpdateMemoryUsage() {
+    ui64 foldsUsage = LearnProgress.AveragingFold.GetMemoryUsage();
+    ui64 onlineCtrsUsage = LearnProgress.AveragingFold.GetOnlineCTRsMemoryUsage();
+    for (const auto& fold : LearnProgress.Folds) {
+        foldsUsage += fold.GetMemoryUsage();
+        onlineCtrsUsage += fold.GetOnlineCTRsMemoryUsage();
+    }
+    MemoryAccountant.SetUsage(ETrainingMemoryConsumer::Folds, foldsUsage);
+    MemoryAccountant.SetUsage(ETrainingMemoryConsumer::OnlineCtrs, onlineCtrsUsage);
+    MemoryAccountant.SetUsage(
+        ETrainingMemoryConsumer::CalcScoreFolds,
+        SampledDocs.GetMemoryUsage() + SmallestSplitSideDocs.GetMemoryUsage());
+    MemoryAccountant.SetUsage(ETrainingMemoryConsumer::BucketStatsCache, PrevTreeLevelStats.GetMemoryAllocated());
+    MemoryAccountant.SetUsage(ETrainingMemoryConsumer::ScratchArena, ScratchArena.GetReservedBytes());
+}
+
+void TLearnContext::EnforceMemoryBudget() {
+    UpdateMemoryUsage();
+    // workers keep their own caches in distributed mode
+    if (!MemoryAccountant.IsNearLimit() || !Params.SystemOptions->IsSingleHost()) {
+        return;
+    }
+    if (UseTreeLevelCachingFlag) {
+        CATBOOST_DEBUG_LOG << "Training buffers are close to the memory limit, disable tree level caching" << Endl;
+        UseTreeLevelCachingFlag = false;
+        PrevTreeLevelStats.Destroy();
+        SmallestSplitSideDocs.ReleaseMemory();
+        UpdateMemoryUsage();
+        if (!MemoryAccountant.IsNearLimit()) {
+            return;
+        }
+    }
+    if (UseMaterializedPermutedFeaturesFlag) {
+        CATBOOST_DEBUG_LOG << "Training buffers are close to the memory limit, drop materialized permuted features"
+            << Endl;
+        UseMaterializedPermutedFeaturesFlag = false;
+        LearnProgress.AveragingFold.ClearPermutedFeatures();
+        for (auto& fold : LearnProgress.Folds) {
+            fold.ClearPermutedFeatures();
+        }
+        UpdateMemoryUsage();
+        if (!MemoryAccountant.IsNearLimit()) {
+            return;
+        }
+    }
+    CATBOOST_DEBUG_LOG << "Training buffers are close to the memory limit, drop cached online ctrs" << Endl;
+    LearnProgress.AveragingFold.ClearOnlineCTRs();
+    for (auto& fold : LearnProgress.Folds) {
+        fold.ClearOnlineCTRs();
+    }
+    UpdateMemoryUsage();
+}
+
 bool NeedToUseTreeLevelCaching(
     const NCatboostOptions::TCatBoostOptions& params,
     ui32 maxBodyTailCount,
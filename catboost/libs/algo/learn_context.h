@@ -6,6 +6,8 @@
 #include "split.h"
 #include "calc_score_cache.h"
 #include "custom_objective_descriptor.h"
+#include "memory_accountant.h"
+#include "scratch_arena.h"
 
 #include <catboost/libs/data_new/data_provider.h>
 #include <catboost/libs/data_new/features_layout.h>
@@ -101,10 +103,12 @@ public:
         , Rand(Params.RandomSeed)
         , OutputOptions(outputOptions)
         , Files(outputOptions, fileNamesPrefix)
+        , MemoryAccountant(ParseMemorySizeDescription(Params.SystemOptions->CpuUsedRamLimit.Get()))
         , RootEnvironment(nullptr)
         , SharedTrainData(nullptr)
         , Profile((int)Params.BoostingOptions->IterationCount)
-        , UseTreeLevelCachingFlag(false) {
+        , UseTreeLevelCachingFlag(false)
+        , UseMaterializedPermutedFeaturesFlag(Params.BoostingOptions->MaterializePermutedFeatures) {
         LearnProgress.SerializedTrainParams = ToString(Params);
         ETaskType taskType = Params.GetTaskType();
         CB_ENSURE(taskType == ETaskType::CPU, "Error: expect learn on CPU task type, got " << taskType);
@@ -120,6 +124,17 @@ public:
     void SaveProgress();
     bool TryLoadProgress();
     bool UseTreeLevelCaching() const;
+    bool UseMaterializedPermutedFeatures() const;
+
+    // report current sizes of folds and caches to MemoryAccountant
+    void UpdateMemoryUsage();
+
+    /* Free memory if training buffers are close to used_ram_limit:
+     * tree-level caching is disabled first, then materialized permuted features copies of all folds are dropped,
+     * then cached online ctrs of all folds are dropped.
+     * Must be called between trees, when no ctrs of the current tree are in use.
+     */
+    void EnforceMemoryBudget();
 
 public:
     TRestorableFastRng64 Rand;
@@ -130,12 +145,15 @@ public:
     TCalcScoreFold SmallestSplitSideDocs;
     TCalcScoreFold SampledDocs;
     TBucketStatsCache PrevTreeLevelStats;
+    TIterationScratchArena ScratchArena;
+    TMemoryAccountant MemoryAccountant;
     TObj<NPar::IRootEnvironment> RootEnvironment;
     TObj<NPar::IEnvironment> SharedTrainData;
     TProfileInfo Profile;
 
 private:
     bool UseTreeLevelCachingFlag;
+    bool UseMaterializedPermutedFeaturesFlag;
 };
 
 bool NeedToUseTreeLevelCaching(
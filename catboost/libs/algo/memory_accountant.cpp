@@ -0,0 +1,112 @@
+#include "memory_accountant.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/logging/logging.h>
+
+#include <util/generic/xrange.h>
+#include <util/stream/format.h>
+
+
+TStringBuf GetTrainingMemoryConsumerName(ETrainingMemoryConsumer consumer) {
+    switch (consumer) {
+        case ETrainingMemoryConsumer::Dataset:
+            return "Dataset";
+        case ETrainingMemoryConsumer::Folds:
+            return "Folds";
+        case ETrainingMemoryConsumer::CalcScoreFolds:
+            return "CalcScoreFolds";
+        case ETrainingMemoryConsumer::BucketStatsCache:
+            return "BucketStatsCache";
+        case ETrainingMemoryConsumer::OnlineCtrs:
+            return "OnlineCtrs";
+        case ETrainingMemoryConsumer::ScratchArena:
+            return "ScratchArena";
+        default:
+            CB_ENSURE_INTERNAL(false, "Unexpected training memory consumer " << static_cast<int>(consumer));
+    }
+}
+
+
+TMemoryAccountant::TMemoryAccountant(ui64 limit)
+    : Limit(limit)
+    , PeakTotalUsage(0)
+{
+    Usage.fill(0);
+    PeakUsage.fill(0);
+}
+
+void TMemoryAccountant::SetUsage(ETrainingMemoryConsumer consumer, ui64 usage) {
+    const size_t consumerIdx = static_cast<size_t>(consumer);
+    CB_ENSURE_INTERNAL(consumerIdx < ConsumerCount, "Unexpected training memory consumer " << consumerIdx);
+
+    with_lock(Lock) {
+        Usage[consumerIdx] = usage;
+        PeakUsage[consumerIdx] = Max(PeakUsage[consumerIdx], usage);
+
+        ui64 totalUsage = 0;
+        for (auto consumerUsage : Usage) {
+            totalUsage += consumerUsage;
+        }
+        PeakTotalUsage = Max(PeakTotalUsage, totalUsage);
+    }
+}
+
+ui64 TMemoryAccountant::GetUsage(ETrainingMemoryConsumer consumer) const {
+    ui64 usage = 0;
+    with_lock(Lock) {
+        usage = Usage[static_cast<size_t>(consumer)];
+    }
+    return usage;
+}
+
+ui64 TMemoryAccountant::GetPeakUsage(ETrainingMemoryConsumer consumer) const {
+    ui64 peakUsage = 0;
+    with_lock(Lock) {
+        peakUsage = PeakUsage[static_cast<size_t>(consumer)];
+    }
+    return peakUsage;
+}
+
+ui64 TMemoryAccountant::GetTotalUsage() const {
+    ui64 totalUsage = 0;
+    with_lock(Lock) {
+        for (auto consumerUsage : Usage) {
+            totalUsage += consumerUsage;
+        }
+    }
+    return totalUsage;
+}
+
+ui64 TMemoryAccountant::GetPeakTotalUsage() const {
+    ui64 peakTotalUsage = 0;
+    with_lock(Lock) {
+        peakTotalUsage = PeakTotalUsage;
+    }
+    return peakTotalUsage;
+}
+
+ui64 TMemoryAccountant::GetAvailable() const {
+    const ui64 totalUsage = GetTotalUsage();
+    return totalUsage < Limit ? Limit - totalUsage : 0;
+}
+
+bool TMemoryAccountant::IsNearLimit() const {
+    if (Limit == Max<ui64>()) {
+        return false;
+    }
+    return GetTotalUsage() > NearLimitFraction * Limit;
+}
+
+void TMemoryAccountant::LogPeakUsage() const {
+    CATBOOST_INFO_LOG << "Peak memory usage by training buffers:";
+    for (auto consumerIdx : xrange(ConsumerCount)) {
+        const auto consumer = static_cast<ETrainingMemoryConsumer>(consumerIdx);
+        CATBOOST_INFO_LOG << ' ' << GetTrainingMemoryConsumerName(consumer)
+            << ' ' << HumanReadableSize(GetPeakUsage(consumer), SF_BYTES);
+    }
+    CATBOOST_INFO_LOG << ", total " << HumanReadableSize(GetPeakTotalUsage(), SF_BYTES);
+    if (Limit != Max<ui64>()) {
+        CATBOOST_INFO_LOG << " (limit " << HumanReadableSize(Limit, SF_BYTES) << ")";
+    }
+    CATBOOST_INFO_LOG << Endl;
+}
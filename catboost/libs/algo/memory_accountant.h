@@ -0,0 +1,64 @@
+#pragma once
+
+#include <util/generic/array_ref.h>
+#include <util/generic/string.h>
+#include <util/generic/ylimits.h>
+#include <util/system/spinlock.h>
+#include <util/system/types.h>
+
+#include <array>
+
+
+// Owners of the major CPU training buffers, each one is accounted separately
+enum class ETrainingMemoryConsumer {
+    Dataset,          // everything allocated before the first iteration: quantized data, options, etc.
+    Folds,            // approxes, derivatives, targets and permutations of learn and averaging folds
+    CalcScoreFolds,   // sampled documents and smallest split side documents used for score calculation
+    BucketStatsCache, // bucket statistics from the previous tree level
+    OnlineCtrs,       // online ctr values cached in folds
+    ScratchArena,     // per-iteration temporary buffers of score calculation
+    ConsumerCount
+};
+
+TStringBuf GetTrainingMemoryConsumerName(ETrainingMemoryConsumer consumer);
+
+
+/* Accounts memory held by training buffers against used_ram_limit.
+ * Consumers report their current usage (in bytes), the training loop checks IsNearLimit() and degrades
+ * (drops caches) to stay within the budget. Peak usage of every consumer is kept for the final report.
+ * Thread-safe.
+ */
+class TMemoryAccountant {
+public:
+    static constexpr double NearLimitFraction = 0.9;
+
+public:
+    explicit TMemoryAccountant(ui64 limit = Max<ui64>());
+
+    void SetUsage(ETrainingMemoryConsumer consumer, ui64 usage);
+
+    ui64 GetUsage(ETrainingMemoryConsumer consumer) const;
+    ui64 GetPeakUsage(ETrainingMemoryConsumer consumer) const;
+    ui64 GetTotalUsage() const;
+    ui64 GetPeakTotalUsage() const;
+    ui64 GetLimit() const {
+        return Limit;
+    }
+
+    // memory left until the limit is reached, 0 if it is already exceeded
+    ui64 GetAvailable() const;
+
+    // total usage exceeds NearLimitFraction of the limit
+    bool IsNearLimit() const;
+
+    void LogPeakUsage() const;
+
+private:
+    static constexpr size_t ConsumerCount = static_cast<size_t>(ETrainingMemoryConsumer::ConsumerCount);
+
+    const ui64 Limit;
+    std::array<ui64, ConsumerCount> Usage;
+    std::array<ui64, ConsumerCount> PeakUsage;
+    ui64 PeakTotalUsage;
+    mutable TAdaptiveLock Lock;
+};
@@ -9,6 +9,8 @@
 #include <catboost/libs/helpers/resource_constrained_executor.h>
 #include <catboost/libs/model/model.h>
 
+#include <library/chromium_trace/interface.h>
+
 #include <util/generic/bitops.h>
 #include <util/generic/utility.h>
 #include <util/stream/format.h>
@@ -342,6 +344,8 @@ void ComputeOnlineCTRs(const TTrainingForCPUDataProviders& data,
                        const TProjection& proj,
                        const TLearnContext* ctx,
                        TOnlineCTR* dst) {
+    CHROMIUM_TRACE_FUNCTION_NAME("ComputeOnlineCTRs");
+
     const TCtrHelper& ctrHelper = ctx->CtrsHelper;
     const auto& ctrInfo = ctrHelper.GetCtrInfo(proj);
     dst->Feature.resize(ctrInfo.size());
@@ -101,14 +101,14 @@ inline static void SetSingleIndex(
     const int bucketBeginOffset,
     const int permBlockSize,
     NCB::TIndexRange<int> docIndexRange, // aligned by permutation blocks in docPermutation
-    TVector<TFullIndexType>* singleIdx // already of proper size
+    TArrayRef<TFullIndexType> singleIdx // already of proper size
 ) {
     const int docCount = fold.GetDocCount();
     const TIndexType* indices = GetDataPtr(fold.Indices);
 
     if (bucketIndexing == nullptr) {
         for (int doc : docIndexRange.Iter()) {
-            (*singleIdx)[doc] = indexer.GetIndex(indices[doc], bucketIndex[bucketBeginOffset + doc]);
+            singleIdx[doc] = indexer.GetIndex(indices[doc], bucketIndex[bucketBeginOffset + doc]);
         }
     } else if (permBlockSize > 1) {
         const int blockCount = (docCount + permBlockSize - 1) / permBlockSize;
@@ -124,19 +124,48 @@ inline static void SetSingleIndex(
             const int originalBlockIdx = static_cast<int>(bucketIndexing[blockStart]);
             for (int doc = blockStart; doc < nextBlockStart; ++doc) {
                 const int originalDocIdx = originalBlockIdx + doc - blockStart;
-                (*singleIdx)[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
+                singleIdx[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
             }
             blockStart = nextBlockStart;
         }
     } else {
         for (int doc : docIndexRange.Iter()) {
             const ui32 originalDocIdx = bucketIndexing[doc];
-            (*singleIdx)[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
+            singleIdx[doc] = indexer.GetIndex(indices[doc], bucketIndex[originalDocIdx]);
         }
     }
 }
 
 
+// Calculate index of leaf for each document given bucket data of a feature in data provider objects' order.
+template <typename TBucketIndexType, typename TFullIndexType>
+inline static void SetSingleIndexForFeatureBuckets(
+    const TCalcScoreFold& fold,
+    const TStatsIndexer& indexer,
+    const TBucketIndexType* bucketSrcData,
+    NCB::TIndexRange<int> docIndexRange,
+    TArrayRef<TFullIndexType> singleIdx // already of proper size
+) {
+    const bool simpleIndexing = fold.NonCtrDataPermutationBlockSize == fold.GetDocCount();
+    const ui32* docInDataProviderIndexing =
+        simpleIndexing ?
+        nullptr
+        : fold.LearnPermutationFeaturesSubset.Get<TIndexedSubset<ui32>>().data();
+    const int docInDataProviderBeginOffset = simpleIndexing ? fold.FeaturesSubsetBegin : 0;
+
+    SetSingleIndex(
+        fold,
+        indexer,
+        bucketSrcData,
+        docInDataProviderIndexing,
+        docInDataProviderBeginOffset,
+        fold.NonCtrDataPermutationBlockSize,
+        docIndexRange,
+        singleIdx
+    );
+}
+
+
 // Calculate index of leaf for each document given a new split.
 template <typename TFullIndexType>
 inline static void BuildSingleIndex(
@@ -145,8 +174,10 @@ inline static void BuildSingleIndex(
     const std::tuple<const TOnlineCTRHash&, const TOnlineCTRHash&>& allCtrs,
     const TSplitCandidate& split,
     const TStatsIndexer& indexer,
+    // defined for float features only, obtained once per split candidate for all doc ranges
+    const TMaybe<TMaybeOwningConstArrayHolder<ui8>>& floatFeatureSrcBins,
     NCB::TIndexRange<int> docIndexRange,
-    TVector<TFullIndexType>* singleIdx // already of proper size
+    TArrayRef<TFullIndexType> singleIdx // already of proper size
 ) {
     if (split.Type == ESplitType::OnlineCtr) {
         const TCtr& ctr = split.Ctr;
@@ -162,38 +193,23 @@ inline static void BuildSingleIndex(
             docIndexRange,
             singleIdx
         );
+    } else if (split.Type == ESplitType::FloatFeature) {
+        SetSingleIndexForFeatureBuckets(
+            fold,
+            indexer,
+            (**floatFeatureSrcBins).data(),
+            docIndexRange,
+            singleIdx
+        );
     } else {
-        const bool simpleIndexing = fold.NonCtrDataPermutationBlockSize == fold.GetDocCount();
-        const ui32* docInDataProviderIndexing =
-            simpleIndexing ?
-            nullptr
-            : fold.LearnPermutationFeaturesSubset.Get<TIndexedSubset<ui32>>().data();
-        const int docInDataProviderBeginOffset = simpleIndexing ? fold.FeaturesSubsetBegin : 0;
-
-        if (split.Type == ESplitType::FloatFeature) {
-            SetSingleIndex(
-                fold,
-                indexer,
-                *((*objectsDataProvider.GetFloatFeature((ui32)split.FeatureIdx))->GetArrayData().GetSrc()),
-                docInDataProviderIndexing,
-                docInDataProviderBeginOffset,
-                fold.NonCtrDataPermutationBlockSize,
-                docIndexRange,
-                singleIdx
-            );
-        } else {
-            Y_ASSERT(split.Type == ESplitType::OneHotFeature);
-            SetSingleIndex(
-                fold,
-                indexer,
-                *((*objectsDataProvider.GetCatFeature((ui32)split.FeatureIdx))->GetArrayData().GetSrc()),
-                docInDataProviderIndexing,
-                docInDataProviderBeginOffset,
-                fold.NonCtrDataPermutationBlockSize,
-                docIndexRange,
-                singleIdx
-            );
-        }
+        Y_ASSERT(split.Type == ESplitType::OneHotFeature);
+        SetSingleIndexForFeatureBuckets(
+            fold,
+            indexer,
+            *((*objectsDataProvider.GetCatFeature((ui32)split.FeatureIdx))->GetArrayData().GetSrc()),
+            docIndexRange,
+            singleIdx
+        );
     }
 }
 
@@ -201,7 +217,7 @@ inline static void BuildSingleIndex(
 // Update bootstraped sums on docIndexRange in a bucket
 template <typename TFullIndexType>
 inline static void UpdateWeighted(
-    const TVector<TFullIndexType>& singleIdx,
+    TConstArrayRef<TFullIndexType> singleIdx,
     const double* weightedDer,
     const float* sampleWeights,
     NCB::TIndexRange<int> docIndexRange,
@@ -218,7 +234,7 @@ inline static void UpdateWeighted(
 // Update not bootstraped sums on docIndexRange in a bucket
 template <typename TFullIndexType>
 inline static void UpdateDeltaCount(
-    const TVector<TFullIndexType>& singleIdx,
+    TConstArrayRef<TFullIndexType> singleIdx,
     const double* derivatives,
     const float* learnWeights,
     NCB::TIndexRange<int> docIndexRange,
@@ -243,7 +259,7 @@ inline static void UpdateDeltaCount(
 template <typename TFullIndexType>
 inline static void CalcStatsKernel(
     bool isCaching,
-    const TVector<TFullIndexType>& singleIdx,
+    TConstArrayRef<TFullIndexType> singleIdx,
     const TCalcScoreFold& fold,
     bool isPlainMode,
     const TStatsIndexer& indexer,
@@ -337,6 +353,7 @@ static void CalcStatsImpl(
     int depth,
     int /*splitStatsCount*/,
     NPar::TLocalExecutor* localExecutor,
+    TIterationScratchArena* /*scratchArena*/,
     TPairwiseStats* stats
 ) {
     const int approxDimension = fold.GetApproxDimension();
@@ -355,6 +372,12 @@ static void CalcStatsImpl(
     const auto pairCount = pairs.ysize();
     const auto pairPart = CeilDiv(pairCount, blockCount);
 
+    // sparse features are materialized here once, not per block
+    const TMaybe<TMaybeOwningConstArrayHolder<ui8>> floatFeatureSrcBins =
+        (split.Type == ESplitType::FloatFeature) ?
+            MakeMaybe(objectsDataProvider.GetFloatFeatureSrcBins((ui32)split.FeatureIdx, localExecutor))
+            : Nothing();
+
     NCB::MapMerge(
         localExecutor,
         fold.GetCalcStatsIndexRanges(),
@@ -397,8 +420,7 @@ static void CalcStatsImpl(
                     GetCtr(allCtrs, ctr.Projection).Feature[ctr.CtrIdx][ctr.TargetBorderIdx][ctr.PriorIdx];
                 setOutput([buckets](ui32 docIdx) { return buckets[docIdx]; });
             } else if (split.Type == ESplitType::FloatFeature) {
-                const ui8* bucketSrcData =
-                    *((*objectsDataProvider.GetFloatFeature((ui32)split.FeatureIdx))->GetArrayData().GetSrc());
+                const ui8* bucketSrcData = (**floatFeatureSrcBins).data();
                 const ui32* bucketIndexing
                     = fold.LearnPermutationFeaturesSubset.Get<TIndexedSubset<ui32>>().data();
                 setOutput(
@@ -429,31 +451,225 @@ static void CalcStatsImpl(
 }
 
 
-template <typename TFullIndexType, typename TIsCaching>
-static void CalcStatsImpl(
+// for data with queries calc stats index ranges are query ranges
+static NCB::TIndexRange<int> GetCalcStatsDocIndexRange(
     const TCalcScoreFold& fold,
-    const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
-    const TFlatPairsInfo& /*pairs*/,
-    const std::tuple<const TOnlineCTRHash&, const TOnlineCTRHash&>& allCtrs,
-    const TSplitCandidate& split,
+    NCB::TIndexRange<int> indexRange
+) {
+    return fold.HasQueryInfo() ?
+        NCB::TIndexRange<int>(
+            fold.LearnQueriesInfo[indexRange.Begin].Begin,
+            (indexRange.End == 0) ? 0 : fold.LearnQueriesInfo[indexRange.End - 1].End
+        )
+        : indexRange;
+}
+
+
+/* Stats for a sparse float feature: only non-default bins of the fold's documents are iterated over.
+ * Leaf totals (calculated once per fold state) are added to the default bucket and the mass of
+ * each non-default document is moved from the default bucket to the document's bucket.
+ */
+static void CalcSparseFloatFeatureStats(
+    const TCalcScoreFold& fold,
+    const TSparseArray<ui8, ui32>& foldBins, // indices are positions in TFold
     const TStatsIndexer& indexer,
-    const TIsCaching& isCaching,
+    bool isCaching,
     bool isPlainMode,
     int depth,
     int splitStatsCount,
     NPar::TLocalExecutor* localExecutor,
+    TIterationScratchArena* scratchArena,
     TBucketStatsRefOptionalHolder* stats
 ) {
     Y_ASSERT(!isCaching || depth > 0);
 
+    const int docCount = fold.GetDocCount();
+    const int approxDimension = fold.GetApproxDimension();
+    const int bodyTailAndDimCount = fold.GetBodyTailCount() * approxDimension;
+    const int statsCount = bodyTailAndDimCount * splitStatsCount;
+    const int filledSplitStatsCount = indexer.CalcSize(depth);
+    const int leafCount = 1 << depth;
+
+    // isPlainMode does not change during the training so it does not invalidate leaf stats
+    const TConstArrayRef<TBucketStats> leafStats = fold.GetLeafStats(
+        [&] (TVector<TBucketStats>* leafStats) {
+            const TStatsIndexer leafIndexer(/*bucketCount*/ 1);
+            const TConstArrayRef<TIndexType> indices(GetDataPtr(fold.Indices), docCount);
+            leafStats->yresize(bodyTailAndDimCount * leafCount);
+            for (int bodyTailAndDimIdx : xrange(bodyTailAndDimCount)) {
+                CalcStatsKernel<TIndexType>(
+                    /*isCaching*/ false,
+                    indices,
+                    fold,
+                    isPlainMode,
+                    leafIndexer,
+                    depth,
+                    fold.BodyTailArr[bodyTailAndDimIdx / approxDimension],
+                    bodyTailAndDimIdx % approxDimension,
+                    NCB::TIndexRange<int>(0, docCount),
+                    leafStats->data() + bodyTailAndDimIdx * leafCount
+                );
+            }
+        }
+    );
+
+    const TConstArrayRef<ui32> foldIndices = foldBins.GetIndices();
+    const TConstArrayRef<ui8> foldBuckets = foldBins.GetValues();
+    const int defaultBucket = foldBins.GetDefaultValue();
+
+    const TIndexType* indices = GetDataPtr(fold.Indices);
+    const ui32* indexInFold = GetDataPtr(fold.IndexInFold);
+
+    // IndexInFold is increasing, so if no documents have been sampled out it is identity
+    const bool isIdentityIndexInFold = (docCount == 0) || (indexInFold[docCount - 1] == (ui32)(docCount - 1));
+
+    // stats of the first block are allocated in this thread's arena, other blocks are merged into them
+    if (stats->NonInited()) {
+        (*stats) = TBucketStatsRefOptionalHolder(
+            scratchArena->AllocateArray<TBucketStats>(statsCount, *localExecutor)
+        );
+    }
+
+    NCB::MapMerge(
+        localExecutor,
+        fold.GetCalcStatsIndexRanges(),
+        /*mapFunc*/[&](NCB::TIndexRange<int> indexRange, TBucketStatsRefOptionalHolder* output) {
+            const NCB::TIndexRange<int> docIndexRange = GetCalcStatsDocIndexRange(fold, indexRange);
+
+            if (output->NonInited()) {
+                (*output) = TBucketStatsRefOptionalHolder(statsCount);
+            } else {
+                Y_ASSERT(docIndexRange.Begin == 0);
+            }
+
+            // cached stats of the previous depth are kept in the first block's output
+            const int clearedStatsBegin = (isCaching && (indexRange.Begin == 0)) ? indexer.CalcSize(depth - 1) : 0;
+            for (int bodyTailAndDimIdx : xrange(bodyTailAndDimCount)) {
+                TBucketStats* btStats = output->GetData().Data() + bodyTailAndDimIdx * splitStatsCount;
+                Fill(btStats + clearedStatsBegin, btStats + filledSplitStatsCount, TBucketStats{0, 0, 0, 0});
+            }
+            if (docIndexRange.Empty()) {
+                return;
+            }
+
+            // (doc, bucket) for non-default documents of the range, docs are increasing
+            TVector<std::pair<int, ui8>> docBuckets;
+            {
+                const ui32* rangeIndexInFoldEnd = indexInFold + docIndexRange.End;
+                const ui32* docIndexInFold = indexInFold + docIndexRange.Begin;
+                const auto entriesBegin = LowerBound(foldIndices.begin(), foldIndices.end(), *docIndexInFold);
+                const auto entriesEnd = UpperBound(entriesBegin, foldIndices.end(), *(rangeIndexInFoldEnd - 1));
+                for (auto entry = entriesBegin; entry != entriesEnd; ++entry) {
+                    const ui32 foldIdx = *entry;
+                    const ui8 bucket = foldBuckets[entry - foldIndices.begin()];
+                    if (isIdentityIndexInFold) {
+                        docBuckets.emplace_back((int)foldIdx, bucket);
+                    } else {
+                        // entries are increasing so the search range is shrinking
+                        docIndexInFold = LowerBound(docIndexInFold, rangeIndexInFoldEnd, foldIdx);
+                        if (*docIndexInFold == foldIdx) {
+                            docBuckets.emplace_back((int)(docIndexInFold - indexInFold), bucket);
+                        }
+                    }
+                }
+            }
+
+            for (int bodyTailAndDimIdx : xrange(bodyTailAndDimCount)) {
+                const auto& bt = fold.BodyTailArr[bodyTailAndDimIdx / approxDimension];
+                const int dim = bodyTailAndDimIdx % approxDimension;
+                TBucketStats* btStats = output->GetData().Data() + bodyTailAndDimIdx * splitStatsCount;
+
+                const bool hasPairwiseWeights = !bt.PairwiseWeights.empty();
+                const float* weightsData =
+                    hasPairwiseWeights ? GetDataPtr(bt.PairwiseWeights) : GetDataPtr(fold.LearnWeights);
+                const float* sampleWeightsData =
+                    hasPairwiseWeights ? GetDataPtr(bt.SamplePairwiseWeights) : GetDataPtr(fold.SampleWeights);
+                const double* weightedDerivatives = GetDataPtr(bt.WeightedDerivatives[dim]);
+                const double* sampleWeightedDerivatives = GetDataPtr(bt.SampleWeightedDerivatives[dim]);
+                const int tailFinish = bt.TailFinish;
+                const int weightedBegin = isPlainMode ? 0 : Min((int)bt.BodyFinish, tailFinish);
+
+                // same sums as in UpdateDeltaCount and UpdateWeighted
+                auto updateStats = [=] (int doc, double sign, TBucketStats* bucketStats) {
+                    if (doc < weightedBegin) {
+                        bucketStats->SumDelta += sign * weightedDerivatives[doc];
+                        bucketStats->Count += sign * (weightsData ? weightsData[doc] : 1.0f);
+                    } else {
+                        bucketStats->SumWeightedDelta += sign * sampleWeightedDerivatives[doc];
+                        bucketStats->SumWeight += sign * sampleWeightsData[doc];
+                    }
+                };
+
+                for (const auto& [doc, bucket] : docBuckets) {
+                    if (doc >= tailFinish) {
+                        break;
+                    }
+                    updateStats(doc, 1.0, btStats + indexer.GetIndex(indices[doc], bucket));
+                    updateStats(doc, -1.0, btStats + indexer.GetIndex(indices[doc], defaultBucket));
+                }
+            }
+        },
+        /*mergeFunc*/[&](
+            TBucketStatsRefOptionalHolder* output,
+            TVector<TBucketStatsRefOptionalHolder>&& addVector
+        ) {
+            for (int bodyTailAndDimIdx : xrange(bodyTailAndDimCount)) {
+                TBucketStats* outputStats = output->GetData().Data() + bodyTailAndDimIdx * splitStatsCount;
+                for (const auto& addItem : addVector) {
+                    const TBucketStats* addStats = addItem.GetData().Data() + bodyTailAndDimIdx * splitStatsCount;
+                    for (int i : xrange(filledSplitStatsCount)) {
+                        outputStats[i].Add(addStats[i]);
+                    }
+                }
+            }
+        },
+        stats
+    );
+
+    for (int bodyTailAndDimIdx : xrange(bodyTailAndDimCount)) {
+        TBucketStats* btStats = stats->GetData().Data() + bodyTailAndDimIdx * splitStatsCount;
+        const TBucketStats* btLeafStats = leafStats.data() + bodyTailAndDimIdx * leafCount;
+
+        // with caching documents of this fold are only in the leaves of the second half of stats
+        for (int leaf : xrange(isCaching ? leafCount / 2 : 0, leafCount)) {
+            btStats[indexer.GetIndex(leaf, defaultBucket)].Add(btLeafStats[leaf]);
+        }
+        if (isCaching) {
+            FixUpStats(depth, indexer, fold.SmallestSplitSideValue, btStats);
+        }
+    }
+}
+
+
+// buildSingleIndex must accept (docIndexRange, singleIdx) params
+template <typename TFullIndexType, typename TBuildSingleIndexFunc>
+static void CalcStatsByBuckets(
+    const TCalcScoreFold& fold,
+    const TStatsIndexer& indexer,
+    bool isCaching,
+    bool isPlainMode,
+    int depth,
+    int splitStatsCount,
+    TBuildSingleIndexFunc&& buildSingleIndex,
+    NPar::TLocalExecutor* localExecutor,
+    TIterationScratchArena* scratchArena,
+    TBucketStatsRefOptionalHolder* stats
+) {
     const int docCount = fold.GetDocCount();
 
-    TVector<TFullIndexType> singleIdx;
-    singleIdx.yresize(docCount);
+    const TArrayRef<TFullIndexType> singleIdx =
+        scratchArena->AllocateArray<TFullIndexType>(docCount, *localExecutor);
 
     const int statsCount = fold.GetBodyTailCount() * fold.GetApproxDimension() * splitStatsCount;
     const int filledSplitStatsCount = indexer.CalcSize(depth);
 
+    // stats of the first block are allocated in this thread's arena, other blocks are merged into them
+    if (stats->NonInited()) {
+        (*stats) = TBucketStatsRefOptionalHolder(
+            scratchArena->AllocateArray<TBucketStats>(statsCount, *localExecutor)
+        );
+    }
+
     // bodyFunc must accept (bodyTailIdx, dim, bucketStatsArrayBegin) params
     auto forEachBodyTailAndApproxDimension = [&](auto bodyFunc) {
         const int approxDimension = fold.GetApproxDimension();
@@ -468,14 +684,9 @@ static void CalcStatsImpl(
         localExecutor,
         fold.GetCalcStatsIndexRanges(),
         /*mapFunc*/[&](NCB::TIndexRange<int> indexRange, TBucketStatsRefOptionalHolder* output) {
-            NCB::TIndexRange<int> docIndexRange = fold.HasQueryInfo() ?
-                NCB::TIndexRange<int>(
-                    fold.LearnQueriesInfo[indexRange.Begin].Begin,
-                    (indexRange.End == 0) ? 0 : fold.LearnQueriesInfo[indexRange.End - 1].End
-                )
-                : indexRange;
+            NCB::TIndexRange<int> docIndexRange = GetCalcStatsDocIndexRange(fold, indexRange);
 
-            BuildSingleIndex(fold, objectsDataProvider, allCtrs, split, indexer, docIndexRange, &singleIdx);
+            buildSingleIndex(docIndexRange, singleIdx);
 
             if (output->NonInited()) {
                 (*output) = TBucketStatsRefOptionalHolder(statsCount);
@@ -486,7 +697,7 @@ static void CalcStatsImpl(
             forEachBodyTailAndApproxDimension(
                 [&](int bodyTailIdx, int dim, int bucketStatsArrayBegin) {
                     TBucketStats* statsSubset = output->GetData().Data() + bucketStatsArrayBegin;
-                    CalcStatsKernel(
+                    CalcStatsKernel<TFullIndexType>(
                         isCaching && (indexRange.Begin == 0),
                         singleIdx,
                         fold,
@@ -534,6 +745,115 @@ static void CalcStatsImpl(
 }
 
 
+template <typename TFullIndexType, typename TIsCaching>
+static void CalcStatsImpl(
+    const TCalcScoreFold& fold,
+    const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
+    const TFlatPairsInfo& /*pairs*/,
+    const std::tuple<const TOnlineCTRHash&, const TOnlineCTRHash&>& allCtrs,
+    const TSplitCandidate& split,
+    const TStatsIndexer& indexer,
+    const TIsCaching& isCaching,
+    bool isPlainMode,
+    int depth,
+    int splitStatsCount,
+    NPar::TLocalExecutor* localExecutor,
+    TIterationScratchArena* scratchArena,
+    TBucketStatsRefOptionalHolder* stats
+) {
+    Y_ASSERT(!isCaching || depth > 0);
+
+    if ((split.Type == ESplitType::FloatFeature) && fold.PermutedSparseFloatFeatures) {
+        const auto foldBins = fold.PermutedSparseFloatFeatures->find((ui32)split.FeatureIdx);
+        if (foldBins != fold.PermutedSparseFloatFeatures->end()) {
+            CalcSparseFloatFeatureStats(
+                fold,
+                foldBins->second,
+                indexer,
+                isCaching,
+                isPlainMode,
+                depth,
+                splitStatsCount,
+                localExecutor,
+                scratchArena,
+                stats
+            );
+            return;
+        }
+    }
+
+    const auto blockCompressedFeature = (split.Type == ESplitType::FloatFeature) ?
+        objectsDataProvider.GetBlockCompressedFloatFeature((ui32)split.FeatureIdx)
+        : Nothing();
+    if (blockCompressedFeature && (fold.NonCtrDataPermutationBlockSize == fold.GetDocCount())) {
+        /* documents of the fold are consecutive in the source data, so each document range decompresses
+         * only the compressed blocks it covers to a scratch buffer
+         */
+        const auto& srcData = (*blockCompressedFeature)->GetSrcData();
+        CalcStatsByBuckets<TFullIndexType>(
+            fold,
+            indexer,
+            isCaching,
+            isPlainMode,
+            depth,
+            splitStatsCount,
+            [&] (NCB::TIndexRange<int> docIndexRange, TArrayRef<TFullIndexType> singleIdx) {
+                TIterationScratchArena::TFrame frame(scratchArena, *localExecutor);
+                const TArrayRef<ui8> rangeBins
+                    = scratchArena->AllocateArray<ui8>(docIndexRange.GetSize(), *localExecutor);
+                srcData.ExtractValues(fold.FeaturesSubsetBegin + docIndexRange.Begin, rangeBins);
+                SetSingleIndex(
+                    fold,
+                    indexer,
+                    rangeBins.data(),
+                    /*bucketIndexing*/ nullptr,
+                    /*bucketBeginOffset*/ -docIndexRange.Begin,
+                    fold.NonCtrDataPermutationBlockSize,
+                    docIndexRange,
+                    singleIdx
+                );
+            },
+            localExecutor,
+            scratchArena,
+            stats
+        );
+        return;
+    }
+
+    /* permuted documents read the whole column, so block compressed features are decompressed here once,
+     * not per document range
+     */
+    const TMaybe<TMaybeOwningConstArrayHolder<ui8>> floatFeatureSrcBins =
+        (split.Type == ESplitType::FloatFeature) ?
+            MakeMaybe(objectsDataProvider.GetFloatFeatureSrcBins((ui32)split.FeatureIdx, localExecutor))
+            : Nothing();
+
+    CalcStatsByBuckets<TFullIndexType>(
+        fold,
+        indexer,
+        isCaching,
+        isPlainMode,
+        depth,
+        splitStatsCount,
+        [&] (NCB::TIndexRange<int> docIndexRange, TArrayRef<TFullIndexType> singleIdx) {
+            BuildSingleIndex(
+                fold,
+                objectsDataProvider,
+                allCtrs,
+                split,
+                indexer,
+                floatFeatureSrcBins,
+                docIndexRange,
+                singleIdx
+            );
+        },
+        localExecutor,
+        scratchArena,
+        stats
+    );
+}
+
+
 // Calculate score numerator summand
 inline static double CountDp(double avrg, const TBucketStats& leafStats) {
     return avrg * leafStats.SumWeightedDelta;
@@ -710,6 +1030,138 @@ static void CalculateNonPairwiseScore(
 }
 
 
+/* Stats of a feature from stats of its exclusive features bundle: objects in bundle bin 0
+ * and in bins of other features of the bundle are in the default bin of the feature
+ */
+static void UnbundleStats(
+    const TExclusiveBundlePart& part,
+    const TStatsIndexer& bundleIndexer,
+    const TStatsIndexer& partIndexer,
+    int leafCount,
+    const TBucketStats* bundleStats,
+    TBucketStats* partStats
+) {
+    for (int leaf : xrange(leafCount)) {
+        TBucketStats defaultBinStats{0, 0, 0, 0};
+        for (int bundleBin : xrange(bundleIndexer.BucketCount)) {
+            defaultBinStats.Add(bundleStats[bundleIndexer.GetIndex(leaf, bundleBin)]);
+        }
+        for (ui32 bin : xrange(part.BinCount)) {
+            if (bin == part.DefaultBin) {
+                continue;
+            }
+            const TBucketStats& binStats = bundleStats[bundleIndexer.GetIndex(leaf, part.GetBundleBin(bin))];
+            partStats[partIndexer.GetIndex(leaf, bin)] = binStats;
+            defaultBinStats.Remove(binStats);
+        }
+        partStats[partIndexer.GetIndex(leaf, part.DefaultBin)] = defaultBinStats;
+    }
+}
+
+
+void CalcScoresForExclusiveFeaturesBundle(
+    const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
+    const TCalcScoreFold& fold,
+    const TFold& initialFold,
+    const NCatboostOptions::TCatBoostOptions& fitParams,
+    ui32 bundleIdx,
+    TConstArrayRef<TSplitCandidate> splits,
+    int depth,
+    NPar::TLocalExecutor* localExecutor,
+    TIterationScratchArena* scratchArena,
+    TVector<TVector<TScoreBin>>* scoreBins
+) {
+    const TIterationScratchArena::TFrame scratchFrame(scratchArena, *localExecutor);
+
+    CB_ENSURE_INTERNAL(
+        !IsPairwiseScoring(fitParams.LossFunctionDescription->GetLossFunction()),
+        "Exclusive features bundles are not supported for pairwise scoring"
+    );
+
+    const auto& quantizedFeaturesInfo = *objectsDataProvider.GetQuantizedFeaturesInfo();
+    const auto& bundle = quantizedFeaturesInfo.GetExclusiveFeaturesBundles()[bundleIdx];
+    const ui8* bundleBins =
+        *((*objectsDataProvider.GetExclusiveFeaturesBundle(bundleIdx))->GetArrayData().GetSrc());
+
+    const TStatsIndexer indexer(bundle.GetBinCount());
+    const int bucketIndexBits = GetValueBitCount(indexer.BucketCount) + depth + 1;
+    const bool isPlainMode = IsPlainMode(fitParams.BoostingOptions->BoostingType);
+    const int splitStatsCount = indexer.CalcSize(depth);
+
+    TBucketStatsRefOptionalHolder bundleStats;
+
+    auto calcStats = [&] (auto fullIndexTypeTag) {
+        using TFullIndexType = decltype(fullIndexTypeTag);
+        CalcStatsByBuckets<TFullIndexType>(
+            fold,
+            indexer,
+            /*isCaching*/ false,
+            isPlainMode,
+            depth,
+            splitStatsCount,
+            [&] (NCB::TIndexRange<int> docIndexRange, TArrayRef<TFullIndexType> singleIdx) {
+                SetSingleIndexForFeatureBuckets(fold, indexer, bundleBins, docIndexRange, singleIdx);
+            },
+            localExecutor,
+            scratchArena,
+            &bundleStats
+        );
+    };
+    if (bucketIndexBits <= 8) {
+        calcStats(ui8());
+    } else if (bucketIndexBits <= 16) {
+        calcStats(ui16());
+    } else {
+        calcStats(ui32());
+    }
+
+    const int leafCount = 1 << depth;
+    const int bodyTailAndDimCount = fold.GetBodyTailCount() * fold.GetApproxDimension();
+    const float l2Regularizer = static_cast<const float>(fitParams.ObliviousTreeOptions->L2Reg);
+
+    scoreBins->resize(splits.size());
+    int maxPartSplitStatsCount = 0;
+    for (const auto& split : splits) {
+        const auto& part = quantizedFeaturesInfo.GetExclusiveBundlePart(TFloatFeatureIdx(split.FeatureIdx));
+        maxPartSplitStatsCount = Max(maxPartSplitStatsCount, TStatsIndexer(part.BinCount).CalcSize(depth));
+    }
+    const TArrayRef<TBucketStats> partStats =
+        scratchArena->AllocateArray<TBucketStats>(bodyTailAndDimCount * maxPartSplitStatsCount, *localExecutor);
+    for (auto splitIdx : xrange(splits.size())) {
+        const auto& split = splits[splitIdx];
+        Y_ASSERT(split.Type == ESplitType::FloatFeature);
+
+        const auto& part = quantizedFeaturesInfo.GetExclusiveBundlePart(TFloatFeatureIdx(split.FeatureIdx));
+        const TStatsIndexer partIndexer(part.BinCount);
+        const int partSplitStatsCount = partIndexer.CalcSize(depth);
+
+        for (int bodyTailAndDimIdx : xrange(bodyTailAndDimCount)) {
+            UnbundleStats(
+                part,
+                indexer,
+                partIndexer,
+                leafCount,
+                bundleStats.GetData().Data() + bodyTailAndDimIdx * splitStatsCount,
+                partStats.data() + bodyTailAndDimIdx * partSplitStatsCount
+            );
+        }
+
+        CalculateNonPairwiseScore(
+            fold,
+            initialFold,
+            split,
+            isPlainMode,
+            leafCount,
+            l2Regularizer,
+            partIndexer,
+            partStats.data(),
+            partSplitStatsCount,
+            &(*scoreBins)[splitIdx]
+        );
+    }
+}
+
+
 void CalcStatsAndScores(
     const TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
     const TVector<int>& splitsCount,
@@ -723,6 +1175,7 @@ void CalcStatsAndScores(
     int depth,
     bool useTreeLevelCaching,
     NPar::TLocalExecutor* localExecutor,
+    TIterationScratchArena* scratchArena,
     TBucketStatsCache* statsFromPrevTree,
     TStats3D* stats3d,
     TPairwiseStats* pairwiseStats,
@@ -731,6 +1184,8 @@ void CalcStatsAndScores(
     CB_ENSURE(stats3d || pairwiseStats || scoreBins, "stats3d, pairwiseStats, and scoreBins are empty - nothing to calculate");
     CB_ENSURE(!scoreBins || initialFold, "initialFold must be non-nullptr for scoreBins calculation");
 
+    const TIterationScratchArena::TFrame scratchFrame(scratchArena, *localExecutor);
+
     const int bucketCount = GetSplitCount(splitsCount, *objectsDataProvider.GetQuantizedFeaturesInfo(), split) + 1;
     const TStatsIndexer indexer(bucketCount);
     const int bucketIndexBits = GetValueBitCount(bucketCount) + depth + 1;
@@ -758,6 +1213,7 @@ void CalcStatsAndScores(
                 depth,
                 splitStatsCount,
                 localExecutor,
+                scratchArena,
                 stats
             );
         } else if (bucketIndexBits <= 16) {
@@ -773,6 +1229,7 @@ void CalcStatsAndScores(
                 depth,
                 splitStatsCount,
                 localExecutor,
+                scratchArena,
                 stats
             );
         } else if (bucketIndexBits <= 32) {
@@ -788,6 +1245,7 @@ void CalcStatsAndScores(
                 depth,
                 splitStatsCount,
                 localExecutor,
+                scratchArena,
                 stats
             );
         }
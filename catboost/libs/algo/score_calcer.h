@@ -4,6 +4,7 @@
 #include "fold.h"
 #include "online_ctr.h"
 #include "pairwise_scoring.h"
+#include "scratch_arena.h"
 #include "score_bin.h"
 #include "split.h"
 
@@ -12,6 +13,7 @@
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/array_ref.h>
 #include <util/generic/vector.h>
 
 #include <tuple>
@@ -32,12 +34,30 @@ void CalcStatsAndScores(
     int depth,
     bool useTreeLevelCaching,
     NPar::TLocalExecutor* localExecutor,
+    TIterationScratchArena* scratchArena, // for temporary buffers, used with localExecutor threads
     TBucketStatsCache* statsFromPrevTree,
     TStats3D* stats3d, // can be nullptr (and if PairwiseScoring must be), if so - don't return this data
     TPairwiseStats* pairwiseStats, // can be nullptr (and if not PairwiseScoring must be), if so - don't return this data
     TVector<TScoreBin>* scoreBins // can be nullptr, if so - don't calc and return this data (used in dictributed mode now)
 );
 
+/* Scores for splits of float features from the same exclusive features bundle (see TExclusiveFeaturesBundle)
+ * with a single pass over the fold: bucket sums are calculated for bundle bins and then unbundled for each feature.
+ * Bundle columns must be present in objectsDataProvider. Pairwise scoring and tree level caching are not used.
+ */
+void CalcScoresForExclusiveFeaturesBundle(
+    const NCB::TQuantizedForCPUObjectsDataProvider& objectsDataProvider,
+    const TCalcScoreFold& fold,
+    const TFold& initialFold,
+    const NCatboostOptions::TCatBoostOptions& fitParams,
+    ui32 bundleIdx,
+    TConstArrayRef<TSplitCandidate> splits, // float features from the bundle
+    int depth,
+    NPar::TLocalExecutor* localExecutor,
+    TIterationScratchArena* scratchArena,
+    TVector<TVector<TScoreBin>>* scoreBins // [splitIdx]
+);
+
 TVector<TScoreBin> GetScoreBins(
     const TStats3D& stats,
     ESplitType splitType,
@@ -0,0 +1,92 @@
+#include "scratch_arena.h"
+
+#include <catboost/libs/helpers/exception.h>
+#include <catboost/libs/options/restrictions.h>
+
+#include <util/generic/utility.h>
+#include <util/system/align.h>
+
+
+static constexpr size_t MinChunkSize = 1 << 16;
+
+
+void* TIterationScratchArena::TThreadArena::Allocate(size_t size, size_t align) {
+    Y_ASSERT(align <= alignof(std::max_align_t));
+    ArenaBytes += size;
+
+    size_t alignedOffset = AlignUp(Offset, align);
+    while ((ChunkIdx < Chunks.size()) && (alignedOffset + size > Chunks[ChunkIdx].Size)) {
+        ++ChunkIdx;
+        alignedOffset = 0;
+    }
+    if (ChunkIdx == Chunks.size()) {
+        const size_t chunkSize = Max(size, MinChunkSize, Chunks.empty() ? size_t(0) : 2 * Chunks.back().Size);
+        Chunks.push_back(TChunk{TArrayHolder<char>(new char[chunkSize]), chunkSize});
+        HeapBytes += chunkSize;
+        alignedOffset = 0;
+    }
+    Offset = alignedOffset + size;
+    return Chunks[ChunkIdx].Data.Get() + alignedOffset;
+}
+
+
+TIterationScratchArena::TFrame::TFrame(TIterationScratchArena* arena, const NPar::TLocalExecutor& localExecutor)
+    : ThreadArena(&arena->GetThreadArena(localExecutor))
+    , ChunkIdx(ThreadArena->ChunkIdx)
+    , Offset(ThreadArena->Offset)
+{
+}
+
+TIterationScratchArena::TFrame::~TFrame() {
+    ThreadArena->ChunkIdx = ChunkIdx;
+    ThreadArena->Offset = Offset;
+}
+
+
+TIterationScratchArena::TIterationScratchArena()
+    : ThreadArenas(CB_THREAD_LIMIT)
+{
+}
+
+TIterationScratchArena::TIterationStats TIterationScratchArena::Reset() {
+    TIterationStats stats;
+    for (auto& threadArena : ThreadArenas) {
+        Y_ASSERT(threadArena.ChunkIdx == 0 && threadArena.Offset == 0);
+        if (threadArena.Chunks.size() > 1) {
+            size_t totalSize = 0;
+            for (const auto& chunk : threadArena.Chunks) {
+                totalSize += chunk.Size;
+            }
+            threadArena.Chunks.clear();
+            threadArena.Chunks.push_back(TThreadArena::TChunk{TArrayHolder<char>(new char[totalSize]), totalSize});
+            threadArena.HeapBytes += totalSize;
+        }
+        threadArena.ChunkIdx = 0;
+        threadArena.Offset = 0;
+
+        stats.ArenaBytes += threadArena.ArenaBytes;
+        stats.HeapBytes += threadArena.HeapBytes;
+        threadArena.ArenaBytes = 0;
+        threadArena.HeapBytes = 0;
+    }
+    stats.ReservedBytes = GetReservedBytes();
+    return stats;
+}
+
+ui64 TIterationScratchArena::GetReservedBytes() const {
+    ui64 reservedBytes = 0;
+    for (const auto& threadArena : ThreadArenas) {
+        for (const auto& chunk : threadArena.Chunks) {
+            reservedBytes += chunk.Size;
+        }
+    }
+    return reservedBytes;
+}
+
+TIterationScratchArena::TThreadArena& TIterationScratchArena::GetThreadArena(
+    const NPar::TLocalExecutor& localExecutor
+) {
+    const int threadId = localExecutor.GetWorkerThreadId();
+    CB_ENSURE_INTERNAL(threadId < ThreadArenas.ysize(), "Thread ID exceeds CB_THREAD_LIMIT");
+    return ThreadArenas[threadId];
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/ptr.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+#include <type_traits>
+
+
+/* Per-thread bump allocator for short-lived buffers of a training iteration (score calculation scratch data).
+ * Memory allocated by a thread is given back when the innermost TFrame of this thread is destroyed.
+ * Reset() at the end of the iteration merges the chunks of each thread into one, so after the first iterations
+ * scratch data does not touch the heap at all.
+ * Threads are identified by their local executor worker thread ids, so all allocations must be made from
+ * the threads of a single TLocalExecutor.
+ */
+class TIterationScratchArena {
+private:
+    class TThreadArena {
+    public:
+        void* Allocate(size_t size, size_t align);
+
+    public:
+        struct TChunk {
+            TArrayHolder<char> Data;
+            size_t Size = 0;
+        };
+
+        TVector<TChunk> Chunks;
+        size_t ChunkIdx = 0;
+        size_t Offset = 0;
+
+        ui64 ArenaBytes = 0;
+        ui64 HeapBytes = 0;
+    };
+
+public:
+    struct TIterationStats {
+        ui64 ArenaBytes = 0; // requested from the arena, this would have been allocated from the heap otherwise
+        ui64 HeapBytes = 0; // allocated from the heap for arena chunks
+        ui64 ReservedBytes = 0; // kept by the arena for the next iteration
+    };
+
+    // Memory allocated by the current thread while the frame is alive is freed in the frame destructor
+    class TFrame {
+    public:
+        TFrame(TIterationScratchArena* arena, const NPar::TLocalExecutor& localExecutor);
+        ~TFrame();
+
+    private:
+        TThreadArena* ThreadArena;
+        size_t ChunkIdx;
+        size_t Offset;
+    };
+
+public:
+    TIterationScratchArena();
+
+    // returned data is not initialized
+    template <class T>
+    TArrayRef<T> AllocateArray(size_t count, const NPar::TLocalExecutor& localExecutor) {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena does not call destructors");
+        void* data = GetThreadArena(localExecutor).Allocate(count * sizeof(T), alignof(T));
+        return TArrayRef<T>(static_cast<T*>(data), count);
+    }
+
+    // not thread-safe, no frames must be alive
+    TIterationStats Reset();
+
+    ui64 GetReservedBytes() const;
+
+private:
+    TThreadArena& GetThreadArena(const NPar::TLocalExecutor& localExecutor);
+
+private:
+    TVector<TThreadArena> ThreadArenas; // [workerThreadId]
+};
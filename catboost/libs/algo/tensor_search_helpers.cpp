@@ -2,6 +2,8 @@
 
 #include <catboost/libs/helpers/restorable_rng.h>
 
+#include <library/chromium_trace/interface.h>
+
 THolder<IDerCalcer> BuildError(
     const NCatboostOptions::TCatBoostOptions& params,
     const TMaybe<TCustomObjectiveDescriptor>& descriptor
@@ -204,6 +206,8 @@ void Bootstrap(
     NPar::TLocalExecutor* localExecutor,
     TRestorableFastRng64* rand
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("Bootstrap");
+
     const int learnSampleCount = indices.ysize();
     const EBootstrapType bootstrapType = params.ObliviousTreeOptions->BootstrapConfig->GetBootstrapType();
     const float baggingTemperature = params.ObliviousTreeOptions->BootstrapConfig->GetBaggingTemperature();
@@ -247,6 +251,8 @@ void CalcWeightedDerivatives(
     TFold* takenFold,
     NPar::TLocalExecutor* localExecutor
 ) {
+    CHROMIUM_TRACE_FUNCTION_NAME("CalcWeightedDerivatives");
+
     TFold::TBodyTail& bt = takenFold->BodyTailArr[bodyTailIdx];
     const TVector<TVector<double>>& approx = bt.Approx;
     const TVector<float>& target = takenFold->LearnTarget;
@@ -262,11 +268,16 @@ void CalcWeightedDerivatives(
         const TVector<TQueryInfo>& queriesInfo = shouldGenerateYetiRankPairs ? recalculatedQueriesInfo : takenFold->LearnQueriesInfo;
 
         const int tailQueryFinish = bt.TailQueryFinish;
-        TVector<TDers> ders((*weightedDerivatives)[0].ysize());
-        error.CalcDersForQueries(0, tailQueryFinish, approx[0], target, weight, queriesInfo, &ders, localExecutor);
-        for (int docId = 0; docId < ders.ysize(); ++docId) {
-            (*weightedDerivatives)[0][docId] = ders[docId].Der1;
-        }
+        error.CalcFirstDersForQueries(
+            0,
+            tailQueryFinish,
+            approx[0],
+            target,
+            weight,
+            queriesInfo,
+            (*weightedDerivatives)[0],
+            localExecutor
+        );
         if (params.LossFunctionDescription->GetLossFunction() == ELossFunction::YetiRankPairwise) {
             // In case of YetiRankPairwise loss function we need to store generated pairs for tree structure building.
             Y_ASSERT(takenFold->BodyTailArr.size() == 1);
@@ -4,6 +4,7 @@
 #include "error_functions.h"
 #include "fold.h"
 #include "greedy_tensor_search.h"
+#include "index_calcer.h"
 #include "online_ctr.h"
 #include "tensor_search_helpers.h"
 
@@ -29,6 +30,10 @@ static void UpdateLearningFold(
 ) {
     TVector<TVector<TVector<double>>> approxDelta;
 
+    if (ctx->UseMaterializedPermutedFeatures()) {
+        MaterializePermutedFeatures(bestSplitTree.Splits, *data.Learn->ObjectsData, ctx->LocalExecutor, fold);
+    }
+
     CalcApproxForLeafStruct(
         data,
         error,
@@ -96,6 +101,7 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
 
         TrimOnlineCTRcache(trainFolds);
         TrimOnlineCTRcache({ &ctx->LearnProgress.AveragingFold });
+        ctx->EnforceMemoryBudget();
         {
             TVector<TFold*> allFolds = trainFolds;
             allFolds.push_back(&ctx->LearnProgress.AveragingFold);
@@ -149,6 +155,14 @@ void TrainOneIteration(const NCB::TTrainingForCPUDataProviders& data, TLearnCont
             profile.AddOperation("CalcApprox tree struct and update tree structure approx");
             CheckInterrupted(); // check after long-lasting operation
 
+            if (ctx->UseMaterializedPermutedFeatures()) {
+                MaterializePermutedFeatures(
+                    bestSplitTree.Splits,
+                    *data.Learn->ObjectsData,
+                    ctx->LocalExecutor,
+                    &ctx->LearnProgress.AveragingFold);
+            }
+
             TVector<TIndexType> indices;
             CalcLeafValues(
                 data,
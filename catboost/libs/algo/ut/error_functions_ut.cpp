@@ -0,0 +1,141 @@
+#include <catboost/libs/algo/error_functions.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+
+Y_UNIT_TEST_SUITE(TErrorFunctionsTest) {
+    Y_UNIT_TEST(QuerySoftMaxDersDoNotDependOnQueryPosition) {
+        // the last query is longer than exp calculation batch
+        const TVector<ui32> querySizes = {3, 5, 20};
+
+        TVector<TQueryInfo> queriesInfo;
+        ui32 docCount = 0;
+        for (auto querySize : querySizes) {
+            queriesInfo.emplace_back(docCount, docCount + querySize);
+            docCount += querySize;
+        }
+
+        TFastRng64 rng(0);
+        TVector<double> approxes(docCount);
+        TVector<float> targets(docCount);
+        for (auto docIdx : xrange(docCount)) {
+            approxes[docIdx] = 10 * rng.GenRandReal1() - 5;
+            targets[docIdx] = (rng.GenRand() % 3 == 0) ? 1.0f : 0.0f;
+        }
+        for (const auto& queryInfo : queriesInfo) {
+            targets[queryInfo.Begin] = 1.0f;
+        }
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        const TQuerySoftMaxError error(/*lambdaReg*/ 0.01, /*isExpApprox*/ false);
+
+        // each query alone, starting at index 0
+        TVector<TDers> expectedDers;
+        for (const auto& queryInfo : queriesInfo) {
+            const TVector<double> queryApproxes(approxes.begin() + queryInfo.Begin, approxes.begin() + queryInfo.End);
+            const TVector<float> queryTargets(targets.begin() + queryInfo.Begin, targets.begin() + queryInfo.End);
+            TVector<TDers> queryDers(queryInfo.End - queryInfo.Begin);
+            error.CalcDersForQueries(
+                0,
+                1,
+                queryApproxes,
+                queryTargets,
+                /*weights*/ {},
+                {TQueryInfo(0, queryInfo.End - queryInfo.Begin)},
+                &queryDers,
+                &localExecutor
+            );
+            expectedDers.insert(expectedDers.end(), queryDers.begin(), queryDers.end());
+        }
+
+        for (int queryStartIndex : {0, 1}) {
+            const ui32 docBegin = queriesInfo[queryStartIndex].Begin;
+            TVector<TDers> ders(docCount - docBegin);
+            error.CalcDersForQueries(
+                queryStartIndex,
+                queriesInfo.ysize(),
+                approxes,
+                targets,
+                /*weights*/ {},
+                queriesInfo,
+                &ders,
+                &localExecutor
+            );
+            for (auto docIdx : xrange(docBegin, docCount)) {
+                UNIT_ASSERT_DOUBLES_EQUAL(ders[docIdx - docBegin].Der1, expectedDers[docIdx].Der1, 1e-12);
+                UNIT_ASSERT_DOUBLES_EQUAL(ders[docIdx - docBegin].Der2, expectedDers[docIdx].Der2, 1e-12);
+            }
+        }
+    }
+
+    static void CheckFirstDersForQueriesMatchDers(const IDerCalcer& error) {
+        TFastRng64 rng(0);
+        TVector<TQueryInfo> queriesInfo;
+        ui32 docCount = 0;
+        for (auto queryIdx : xrange(200)) {
+            Y_UNUSED(queryIdx);
+            const ui32 querySize = 1 + rng.GenRand() % 30;
+            queriesInfo.emplace_back(docCount, docCount + querySize);
+            docCount += querySize;
+        }
+
+        TVector<double> approxes(docCount);
+        TVector<float> targets(docCount);
+        TVector<float> weights(docCount);
+        for (auto docIdx : xrange(docCount)) {
+            approxes[docIdx] = 10 * rng.GenRandReal1() - 5;
+            targets[docIdx] = (rng.GenRand() % 3 == 0) ? 1.0f : 0.0f;
+            weights[docIdx] = 0.5f + rng.GenRandReal1();
+        }
+        for (const auto& queryInfo : queriesInfo) {
+            targets[queryInfo.Begin] = 1.0f;
+        }
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        for (int queryStartIndex : {0, 7}) {
+            const ui32 docBegin = queriesInfo[queryStartIndex].Begin;
+            TVector<TDers> ders(docCount - docBegin);
+            error.CalcDersForQueries(
+                queryStartIndex,
+                queriesInfo.ysize(),
+                approxes,
+                targets,
+                weights,
+                queriesInfo,
+                &ders,
+                &localExecutor
+            );
+            TVector<double> firstDers(docCount - docBegin);
+            error.CalcFirstDersForQueries(
+                queryStartIndex,
+                queriesInfo.ysize(),
+                approxes,
+                targets,
+                weights,
+                queriesInfo,
+                firstDers,
+                &localExecutor
+            );
+            for (auto docIdx : xrange(ders.size())) {
+                UNIT_ASSERT_DOUBLES_EQUAL(firstDers[docIdx], ders[docIdx].Der1, 1e-12);
+            }
+        }
+    }
+
+    Y_UNIT_TEST(QuerySoftMaxFirstDersMatchDers) {
+        CheckFirstDersForQueriesMatchDers(TQuerySoftMaxError(/*lambdaReg*/ 0.01, /*isExpApprox*/ false));
+    }
+
+    Y_UNIT_TEST(QueryRmseFirstDersMatchDers) {
+        CheckFirstDersForQueriesMatchDers(TQueryRmseError(/*isExpApprox*/ false));
+    }
+}
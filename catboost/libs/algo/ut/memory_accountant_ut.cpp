@@ -0,0 +1,31 @@
+#include <library/unittest/registar.h>
+#include <catboost/libs/algo/memory_accountant.h>
+
+Y_UNIT_TEST_SUITE(TMemoryAccountantTest) {
+    Y_UNIT_TEST(UsageAndPeaks) {
+        TMemoryAccountant accountant(1000);
+        accountant.SetUsage(ETrainingMemoryConsumer::Folds, 300);
+        accountant.SetUsage(ETrainingMemoryConsumer::OnlineCtrs, 500);
+        UNIT_ASSERT_VALUES_EQUAL(accountant.GetTotalUsage(), 800);
+        UNIT_ASSERT_VALUES_EQUAL(accountant.GetAvailable(), 200);
+        UNIT_ASSERT(!accountant.IsNearLimit());
+
+        accountant.SetUsage(ETrainingMemoryConsumer::BucketStatsCache, 150);
+        UNIT_ASSERT(accountant.IsNearLimit());
+
+        accountant.SetUsage(ETrainingMemoryConsumer::OnlineCtrs, 0);
+        UNIT_ASSERT_VALUES_EQUAL(accountant.GetUsage(ETrainingMemoryConsumer::OnlineCtrs), 0);
+        UNIT_ASSERT_VALUES_EQUAL(accountant.GetPeakUsage(ETrainingMemoryConsumer::OnlineCtrs), 500);
+        UNIT_ASSERT_VALUES_EQUAL(accountant.GetPeakTotalUsage(), 950);
+        UNIT_ASSERT(!accountant.IsNearLimit());
+
+        accountant.SetUsage(ETrainingMemoryConsumer::Dataset, 2000);
+        UNIT_ASSERT_VALUES_EQUAL(accountant.GetAvailable(), 0);
+    }
+
+    Y_UNIT_TEST(Unlimited) {
+        TMemoryAccountant accountant;
+        accountant.SetUsage(ETrainingMemoryConsumer::Dataset, Max<ui64>() / 2);
+        UNIT_ASSERT(!accountant.IsNearLimit());
+    }
+}
@@ -0,0 +1,53 @@
+#include <library/unittest/registar.h>
+#include <catboost/libs/algo/scratch_arena.h>
+
+#include <util/generic/xrange.h>
+
+Y_UNIT_TEST_SUITE(TIterationScratchArenaTest) {
+    Y_UNIT_TEST(FramesReuseMemory) {
+        NPar::TLocalExecutor localExecutor;
+        TIterationScratchArena arena;
+
+        double* firstData = nullptr;
+        {
+            const TIterationScratchArena::TFrame frame(&arena, localExecutor);
+            auto first = arena.AllocateArray<double>(1000, localExecutor);
+            auto second = arena.AllocateArray<ui8>(3, localExecutor);
+            auto third = arena.AllocateArray<double>(10, localExecutor);
+            UNIT_ASSERT_VALUES_EQUAL(first.size(), 1000);
+            UNIT_ASSERT(second.data() >= reinterpret_cast<ui8*>(first.data() + first.size()));
+            UNIT_ASSERT_VALUES_EQUAL(reinterpret_cast<uintptr_t>(third.data()) % alignof(double), 0);
+            firstData = first.data();
+        }
+        {
+            const TIterationScratchArena::TFrame frame(&arena, localExecutor);
+            UNIT_ASSERT_VALUES_EQUAL(arena.AllocateArray<double>(1000, localExecutor).data(), firstData);
+        }
+
+        const auto stats = arena.Reset();
+        UNIT_ASSERT_VALUES_EQUAL(stats.ArenaBytes, 2 * 1000 * sizeof(double) + 3 + 10 * sizeof(double));
+        UNIT_ASSERT_VALUES_EQUAL(stats.HeapBytes, stats.ReservedBytes);
+    }
+
+    Y_UNIT_TEST(ResetMergesChunks) {
+        NPar::TLocalExecutor localExecutor;
+        TIterationScratchArena arena;
+
+        const size_t bigCount = 1 << 20;
+        for (auto iteration : xrange(3)) {
+            {
+                const TIterationScratchArena::TFrame frame(&arena, localExecutor);
+                for (auto allocationIdx : xrange(4)) {
+                    Y_UNUSED(allocationIdx);
+                    arena.AllocateArray<ui8>(bigCount, localExecutor);
+                }
+            }
+            const auto stats = arena.Reset();
+            UNIT_ASSERT_VALUES_EQUAL(stats.ArenaBytes, 4 * bigCount);
+            if (iteration > 0) {
+                UNIT_ASSERT_VALUES_EQUAL(stats.HeapBytes, 0);
+            }
+            UNIT_ASSERT(stats.ReservedBytes >= 4 * bigCount);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#include <library/unittest/registar.h>
+#include <catboost/libs/algo/yetirank_helpers.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+#include <numeric>
+
+// straightforward implementation with dense querySize x querySize weights matrix
+static void GenerateYetiRankPairsForQueryDense(
+    const float* relevs,
+    const double* expApproxes,
+    float queryWeight,
+    ui32 querySize,
+    int permutationCount,
+    double decaySpeed,
+    ui64 randomSeed,
+    TVector<TVector<TCompetitor>>* competitors
+) {
+    TFastRng64 rand(randomSeed);
+    competitors->clear();
+    competitors->resize(querySize);
+
+    TVector<int> indices(querySize);
+    TVector<TVector<float>> competitorsWeights(querySize, TVector<float>(querySize));
+    for (int permutationIndex = 0; permutationIndex < permutationCount; ++permutationIndex) {
+        std::iota(indices.begin(), indices.end(), 0);
+        TVector<double> bootstrappedApprox(expApproxes, expApproxes + querySize);
+        for (ui32 docId = 0; docId < querySize; ++docId) {
+            const float uniformValue = rand.GenRandReal1();
+            bootstrappedApprox[docId] *= uniformValue / (1.000001f - uniformValue);
+        }
+        Sort(indices, [&](int i, int j) {
+            return bootstrappedApprox[i] > bootstrappedApprox[j];
+        });
+        double decayCoefficient = 1;
+        for (ui32 docId = 1; docId < querySize; ++docId) {
+            const int firstCandidate = indices[docId - 1];
+            const int secondCandidate = indices[docId];
+            const float pairWeight = 0.15 * decayCoefficient * Abs(relevs[firstCandidate] - relevs[secondCandidate]);
+            if (relevs[firstCandidate] > relevs[secondCandidate]) {
+                competitorsWeights[firstCandidate][secondCandidate] += pairWeight;
+            } else if (relevs[firstCandidate] < relevs[secondCandidate]) {
+                competitorsWeights[secondCandidate][firstCandidate] += pairWeight;
+            }
+            decayCoefficient *= decaySpeed;
+        }
+    }
+    for (ui32 winnerIndex = 0; winnerIndex < querySize; ++winnerIndex) {
+        for (ui32 loserIndex = 0; loserIndex < querySize; ++loserIndex) {
+            const float competitorsWeight = queryWeight * competitorsWeights[winnerIndex][loserIndex] / permutationCount;
+            if (competitorsWeight != 0) {
+                (*competitors)[winnerIndex].push_back({loserIndex, competitorsWeight});
+            }
+        }
+    }
+}
+
+Y_UNIT_TEST_SUITE(YetiRankHelpers) {
+    Y_UNIT_TEST(SameAsDensePairsGeneration) {
+        TReallyFastRng32 rng(0);
+        // buffers are shared between queries of different sizes
+        TYetiRankPairsBuffers buffers;
+        for (ui32 querySize : {1, 2, 3, 10, 57, 200, 31}) {
+            TVector<float> relevs(querySize);
+            TVector<double> expApproxes(querySize);
+            for (auto docId : xrange(querySize)) {
+                relevs[docId] = rng.Uniform(4);
+                expApproxes[docId] = 0.5 + rng.GenRandReal2();
+            }
+
+            TVector<TVector<TCompetitor>> expected;
+            GenerateYetiRankPairsForQueryDense(
+                relevs.data(), expApproxes.data(), 2.0f, querySize, 10, 0.9, querySize, &expected
+            );
+            TVector<TVector<TCompetitor>> competitors;
+            GenerateYetiRankPairsForQuery(
+                relevs.data(), expApproxes.data(), 2.0f, querySize, 10, 0.9, querySize, &buffers, &competitors
+            );
+
+            UNIT_ASSERT_VALUES_EQUAL(competitors.size(), expected.size());
+            for (auto winnerIndex : xrange(querySize)) {
+                UNIT_ASSERT_VALUES_EQUAL(competitors[winnerIndex].size(), expected[winnerIndex].size());
+                for (auto i : xrange(expected[winnerIndex].size())) {
+                    UNIT_ASSERT_VALUES_EQUAL(competitors[winnerIndex][i].Id, expected[winnerIndex][i].Id);
+                    UNIT_ASSERT_VALUES_EQUAL(competitors[winnerIndex][i].Weight, expected[winnerIndex][i].Weight);
+                }
+            }
+        }
+    }
+}
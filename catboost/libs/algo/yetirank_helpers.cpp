@@ -3,9 +3,33 @@
 
 #include <catboost/libs/data_types/pair.h>
 
+#include <util/generic/array_ref.h>
 #include <util/generic/vector.h>
 
-static void GenerateYetiRankPairsForQuery(
+// counting sort, order of pairs with the same key is preserved
+template <class TGetKey>
+static void StableSortByKey(
+    TConstArrayRef<TYetiRankPairWeight> src,
+    ui32 keyCount,
+    TGetKey getKey,
+    TVector<ui32>* offsets,
+    TVector<TYetiRankPairWeight>* dst
+) {
+    TVector<ui32>& offsetsRef = *offsets;
+    offsetsRef.assign(keyCount + 1, 0);
+    for (const auto& pairWeight : src) {
+        ++offsetsRef[getKey(pairWeight) + 1];
+    }
+    for (ui32 key = 0; key < keyCount; ++key) {
+        offsetsRef[key + 1] += offsetsRef[key];
+    }
+    dst->yresize(src.size());
+    for (const auto& pairWeight : src) {
+        (*dst)[offsetsRef[getKey(pairWeight)]++] = pairWeight;
+    }
+}
+
+void GenerateYetiRankPairsForQuery(
     const float* relevs,
     const double* expApproxes,
     float queryWeight,
@@ -13,6 +37,7 @@ static void GenerateYetiRankPairsForQuery(
     int permutationCount,
     double decaySpeed,
     ui64 randomSeed,
+    TYetiRankPairsBuffers* buffers,
     TVector<TVector<TCompetitor>>* competitors
 ) {
     TFastRng64 rand(randomSeed);
@@ -20,15 +45,18 @@ static void GenerateYetiRankPairsForQuery(
     competitorsRef.clear();
     competitorsRef.resize(querySize);
 
-    TVector<int> indices(querySize);
-    TVector<TVector<float>> competitorsWeights(querySize, TVector<float>(querySize));
+    TVector<int>& indices = buffers->Indices;
+    indices.yresize(querySize);
+    TVector<double>& bootstrappedApprox = buffers->BootstrappedApprox;
+    bootstrappedApprox.yresize(querySize);
+    TVector<TYetiRankPairWeight>& pairWeights = buffers->PairWeights;
+    pairWeights.clear();
     for (int permutationIndex = 0; permutationIndex < permutationCount; ++permutationIndex) {
         std::iota(indices.begin(), indices.end(), 0);
-        TVector<double> bootstrappedApprox(expApproxes, expApproxes + querySize);
         for (ui32 docId = 0; docId < querySize; ++docId) {
             const float uniformValue = rand.GenRandReal1();
             // TODO(nikitxskv): try to experiment with different bootstraps.
-            bootstrappedApprox[docId] *= uniformValue / (1.000001f - uniformValue);
+            bootstrappedApprox[docId] = expApproxes[docId] * (uniformValue / (1.000001f - uniformValue));
         }
 
         Sort(indices, [&](int i, int j) {
@@ -43,22 +71,46 @@ static void GenerateYetiRankPairsForQuery(
 
             const float pairWeight = magicConst * decayCoefficient * Abs(relevs[firstCandidate] - relevs[secondCandidate]);
             if (relevs[firstCandidate] > relevs[secondCandidate]) {
-                competitorsWeights[firstCandidate][secondCandidate] += pairWeight;
+                pairWeights.push_back({(ui32)firstCandidate, (ui32)secondCandidate, pairWeight});
             } else if (relevs[firstCandidate] < relevs[secondCandidate]) {
-                competitorsWeights[secondCandidate][firstCandidate] += pairWeight;
+                pairWeights.push_back({(ui32)secondCandidate, (ui32)firstCandidate, pairWeight});
             }
             decayCoefficient *= decaySpeed;
         }
     }
 
-    // TODO(nikitxskv): Can be optimized
-    for (ui32 winnerIndex = 0; winnerIndex < querySize; ++winnerIndex) {
-        for (ui32 loserIndex = 0; loserIndex < querySize; ++loserIndex) {
-            const float competitorsWeight = queryWeight * competitorsWeights[winnerIndex][loserIndex] / permutationCount;
-            if (competitorsWeight != 0) {
-                competitorsRef[winnerIndex].push_back({loserIndex, competitorsWeight});
-            }
+    // order by (winner, loser), contributions of the same pair stay in permutations order
+    TVector<TYetiRankPairWeight>& sortedPairWeights = buffers->SortedPairWeights;
+    StableSortByKey(
+        pairWeights,
+        querySize,
+        [] (const TYetiRankPairWeight& pairWeight) { return pairWeight.Loser; },
+        &buffers->Offsets,
+        &sortedPairWeights
+    );
+    StableSortByKey(
+        sortedPairWeights,
+        querySize,
+        [] (const TYetiRankPairWeight& pairWeight) { return pairWeight.Winner; },
+        &buffers->Offsets,
+        &pairWeights
+    );
+
+    for (size_t begin = 0; begin < pairWeights.size();) {
+        const ui32 winnerIndex = pairWeights[begin].Winner;
+        const ui32 loserIndex = pairWeights[begin].Loser;
+        float competitorsWeightSum = 0;
+        size_t end = begin;
+        for (; (end < pairWeights.size()) && (pairWeights[end].Winner == winnerIndex)
+               && (pairWeights[end].Loser == loserIndex); ++end)
+        {
+            competitorsWeightSum += pairWeights[end].Weight;
+        }
+        const float competitorsWeight = queryWeight * competitorsWeightSum / permutationCount;
+        if (competitorsWeight != 0) {
+            competitorsRef[winnerIndex].push_back({loserIndex, competitorsWeight});
         }
+        begin = end;
     }
 }
 
@@ -81,6 +133,7 @@ static void UpdatePairsForYetiRank(
     const TVector<ui64> randomSeeds = GenRandUI64Vector(blockCount, randomSeed);
     NPar::ParallelFor(*localExecutor, 0, blockCount, [&](int blockId) {
         TFastRng64 rand(randomSeeds[blockId]);
+        TYetiRankPairsBuffers buffers;
         const int from = blockId * blockSize;
         const int to = Min<int>((blockId + 1) * blockSize, queryInfoSize);
         for (int queryIndex = from; queryIndex < to; ++queryIndex) {
@@ -93,6 +146,7 @@ static void UpdatePairsForYetiRank(
                 permutationCount,
                 decaySpeed,
                 rand.GenRand(),
+                &buffers,
                 &queryInfoRef.Competitors
             );
         }
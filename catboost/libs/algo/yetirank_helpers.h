@@ -2,6 +2,44 @@
 
 #include "learn_context.h"
 
+#include <catboost/libs/data_types/pair.h>
+
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+struct TYetiRankPairWeight {
+    ui32 Winner;
+    ui32 Loser;
+    float Weight;
+};
+
+// buffers reused between GenerateYetiRankPairsForQuery calls to avoid allocations for each query
+struct TYetiRankPairsBuffers {
+    TVector<int> Indices;
+    TVector<double> BootstrappedApprox;
+    // contributions of adjacent documents of all permutations, only they can have nonzero weights
+    TVector<TYetiRankPairWeight> PairWeights;
+    TVector<TYetiRankPairWeight> SortedPairWeights;
+    TVector<ui32> Offsets;
+};
+
+/* Competitors are ordered by winner and loser indices, weights are summed in permutations order,
+ * so results don't depend on buffers reuse.
+ * Memory and time are O(permutationCount * querySize), not O(querySize^2).
+ */
+void GenerateYetiRankPairsForQuery(
+    const float* relevs,
+    const double* expApproxes,
+    float queryWeight,
+    ui32 querySize,
+    int permutationCount,
+    double decaySpeed,
+    ui64 randomSeed,
+    TYetiRankPairsBuffers* buffers,
+    TVector<TVector<TCompetitor>>* competitors
+);
+
 void YetiRankRecalculation(
     const TFold& ff,
     const TFold::TBodyTail& bt,
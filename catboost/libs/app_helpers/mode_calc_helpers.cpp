@@ -5,15 +5,27 @@
 #include <catboost/libs/algo/apply.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/vector_helpers.h>
+#include <catboost/libs/eval_result/binary_eval_result.h>
 #include <catboost/libs/eval_result/eval_result.h>
 #include <catboost/libs/labels/label_helper_builder.h>
 #include <catboost/libs/logging/logging.h>
 
+#include <library/threading/future/async.h>
+#include <library/threading/future/future.h>
+
 #include <util/string/cast.h>
 #include <util/string/iterator.h>
 
+#include <util/generic/deque.h>
+#include <util/generic/scope.h>
 #include <util/generic/utility.h>
 #include <util/generic/xrange.h>
+#include <util/stream/file.h>
+#include <util/thread/queue.h>
+
+
+// blocks that are parsed but not written yet
+static constexpr size_t CALC_MAX_BLOCKS_IN_FLIGHT = 4;
 
 
 void NCB::PrepareCalcModeParamsParser(
@@ -52,6 +64,9 @@ void NCB::PrepareCalcModeParamsParser(
         });
     parser.AddLongOption("eval-period", "predictions are evaluated every <eval-period> trees")
         .StoreResult(&evalPeriod);
+    parser.AddLongOption("binary-output-float64", "use float64 values for binary output (binary:// output path scheme), float32 by default")
+        .NoArgument()
+        .SetFlag(&params.BinaryOutputWithDoublePrecision);
     parser.SetFreeArgsNum(0);
 }
 
@@ -128,49 +143,140 @@ static NCB::TEvalResult Apply(
     return resultApprox;
 }
 
+static void LogToStdErr(const char* str, size_t len) {
+    Cerr.Write(str, len);
+}
+
 void NCB::CalcModelSingleHost(
     const NCB::TAnalyticalModeCommonParams& params,
     size_t iterationsLimit,
     size_t evalPeriod,
     const TFullModel& model ) {
 
-    CB_ENSURE(params.OutputPath.Scheme == "dsv", "Local model evaluation supports only \"dsv\" output file schema.");
-    TOFStream outputStream(params.OutputPath.Path);
+    const bool isBinaryOutput = (params.OutputPath.Scheme == "binary");
+    CB_ENSURE(
+        (params.OutputPath.Scheme == "dsv") || isBinaryOutput,
+        "Local model evaluation supports only \"dsv\" and \"binary\" output file schemas."
+    );
+
+    const bool isStdOutput = (params.OutputPath.Path == "-");
+    THolder<IOutputStream> outputFileStream;
+    if (!isStdOutput) {
+        outputFileStream = MakeHolder<TOFStream>(params.OutputPath.Path);
+    }
+    IOutputStream* outputStream = isStdOutput ? &Cout : outputFileStream.Get();
+    if (isStdOutput) {
+        // standard output is used for predictions
+        SetCustomLoggingFunction(LogToStdErr, LogToStdErr);
+    }
+    Y_SCOPE_EXIT(isStdOutput) {
+        if (isStdOutput) {
+            RestoreOriginalLogger();
+        }
+    };
+
     NPar::TLocalExecutor executor;
     executor.RunAdditionalThreads(params.ThreadCount - 1);
 
     TSetLoggingVerbose inThisScope;
-    bool IsFirstBlock = true;
+    const auto visibleLabelsHelper = BuildLabelsHelper<TExternalLabelsHelper>(model);
+
+    // standard input can't be reread so src file columns are not available for it
+    TIntrusivePtr<IPoolColumnsPrinter> poolColumnsPrinter;
+    if (!isBinaryOutput && (params.InputPath.Path != "-")) {
+        poolColumnsPrinter = CreatePoolColumnPrinter(params.InputPath, params.DsvPoolFormatParams.Format);
+    }
+
+    THolder<TBinaryEvalResultWriter> binaryWriter;
+    if (isBinaryOutput) {
+        binaryWriter = MakeHolder<TBinaryEvalResultWriter>(
+            outputStream,
+            params.OutputColumnsIds,
+            visibleLabelsHelper,
+            visibleLabelsHelper.IsInitialized() ?
+                visibleLabelsHelper.GetExternalApproxDimension()
+                : model.ObliviousTrees.ApproxDimension,
+            params.BinaryOutputWithDoublePrecision,
+            std::make_pair(evalPeriod, iterationsLimit)
+        );
+    }
+
+    /* Blocks are parsed in this thread while previous blocks are evaluated and written
+     * in separate single-threaded lanes (so the order of blocks is preserved).
+     * Evaluation and output use executor for parallel work inside a block.
+     * Lanes must be destroyed (and their tasks finished) before anything they use.
+     */
+    TMtpQueue applyLane;
+    applyLane.Start(1);
+    TMtpQueue outputLane;
+    outputLane.Start(1);
+
+    // limits memory used by parsed blocks and their predictions
+    TDeque<NThreading::TFuture<void>> blocksInFlight;
+    auto waitForOldestBlock = [&] () {
+        blocksInFlight.front().GetValueSync(); // rethrows exceptions from lanes
+        blocksInFlight.pop_front();
+    };
+
+    bool isFirstBlock = true;
     ui64 docIdOffset = 0;
-    auto poolColumnsPrinter = CreatePoolColumnPrinter(params.InputPath, params.DsvPoolFormatParams.Format);
     const int blockSize = Max<int>(32, static_cast<int>(10000. / (static_cast<double>(iterationsLimit) / evalPeriod) / model.ObliviousTrees.ApproxDimension));
     ReadAndProceedPoolInBlocks(params, blockSize, [&](const NCB::TDataProviderPtr datasetPart) {
-        if (IsFirstBlock) {
+        if (isFirstBlock) {
             ValidateColumnOutput(params.OutputColumnsIds, *datasetPart, true);
+
+            // columns info is the same for all blocks, update it before any output starts
+            if (poolColumnsPrinter) {
+                poolColumnsPrinter->UpdateColumnTypeInfo(datasetPart->MetaInfo.ColumnsInfo);
+            }
         }
-        auto approx = Apply(model, *datasetPart, 0, iterationsLimit, evalPeriod, &executor);
-        auto visibleLabelsHelper = BuildLabelsHelper<TExternalLabelsHelper>(model);
 
-        poolColumnsPrinter->UpdateColumnTypeInfo(datasetPart->MetaInfo.ColumnsInfo);
+        while (blocksInFlight.size() >= CALC_MAX_BLOCKS_IN_FLIGHT) {
+            waitForOldestBlock();
+        }
 
-        TSetLoggingSilent inThisScope;
-        OutputEvalResultToFile(
-            approx,
-            &executor,
-            params.OutputColumnsIds,
-            visibleLabelsHelper,
-            *datasetPart,
-            true,
-            &outputStream,
-            // TODO: src file columns output is incompatible with block processing
-            poolColumnsPrinter,
-            /*testFileWhichOf*/ {0, 0},
-            IsFirstBlock,
-            docIdOffset,
-            std::make_pair(evalPeriod, iterationsLimit)
+        auto approxFuture = NThreading::Async(
+            [&model, &executor, datasetPart, iterationsLimit, evalPeriod] () {
+                return Apply(model, *datasetPart, 0, iterationsLimit, evalPeriod, &executor);
+            },
+            applyLane
+        );
+        blocksInFlight.push_back(
+            NThreading::Async(
+                [&, approxFuture, datasetPart, writeHeader = isFirstBlock, blockDocIdOffset = docIdOffset] () {
+                    const auto& approx = approxFuture.GetValueSync();
+                    if (binaryWriter) {
+                        binaryWriter->WriteBlock(approx, blockDocIdOffset, &executor);
+                        return;
+                    }
+                    OutputEvalResultToFile(
+                        approx,
+                        &executor,
+                        params.OutputColumnsIds,
+                        visibleLabelsHelper,
+                        *datasetPart,
+                        true,
+                        outputStream,
+                        // TODO: src file columns output is incompatible with block processing
+                        poolColumnsPrinter,
+                        /*testFileWhichOf*/ {0, 0},
+                        writeHeader,
+                        blockDocIdOffset,
+                        std::make_pair(evalPeriod, iterationsLimit)
+                    );
+                },
+                outputLane
+            )
         );
         docIdOffset += datasetPart->ObjectsGrouping->GetObjectCount();
-        IsFirstBlock = false;
+        isFirstBlock = false;
     }, &executor);
-}
 
+    while (!blocksInFlight.empty()) {
+        waitForOldestBlock();
+    }
+    if (binaryWriter) {
+        binaryWriter->Finish();
+    }
+    outputStream->Flush();
+}
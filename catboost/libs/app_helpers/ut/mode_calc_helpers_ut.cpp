@@ -0,0 +1,179 @@
+#include <catboost/libs/app_helpers/mode_calc_helpers.h>
+
+#include <catboost/libs/algo/apply.h>
+#include <catboost/libs/data_new/load_data.h>
+#include <catboost/libs/data_new/ut/lib/for_loader.h>
+#include <catboost/libs/train_lib/train_model.h>
+
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+#include <util/stream/file.h>
+#include <util/string/builder.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+#include <util/ysaveload.h>
+
+
+using namespace NCB;
+using namespace NCB::NDataNewUT;
+
+
+namespace {
+    struct TBinaryEvalResult {
+        ui32 ValueSize = 0;
+        TVector<TString> ColumnNames;
+        TVector<ui64> DocIds;
+        TVector<TVector<double>> Columns; // [columnIdx][docIdx]
+        ui32 BlockCount = 0;
+    };
+}
+
+static TBinaryEvalResult ReadBinaryEvalResult(const TString& path) {
+    TIFStream input(path);
+
+    char magic[4];
+    input.LoadOrFail(magic, sizeof(magic));
+    UNIT_ASSERT_VALUES_EQUAL(TStringBuf(magic, sizeof(magic)), "CBEV");
+    ui32 version = 0;
+    ::Load(&input, version);
+    UNIT_ASSERT_VALUES_EQUAL(version, 1);
+
+    TBinaryEvalResult result;
+    ::Load(&input, result.ValueSize);
+    ui32 columnCount = 0;
+    ::Load(&input, columnCount);
+    for (auto columnIdx : xrange(columnCount)) {
+        Y_UNUSED(columnIdx);
+        ui32 nameSize = 0;
+        ::Load(&input, nameSize);
+        TString name;
+        name.resize(nameSize);
+        input.LoadOrFail(name.begin(), nameSize);
+        result.ColumnNames.push_back(name);
+    }
+    result.Columns.resize(columnCount);
+
+    while (true) {
+        ui32 objectCount = 0;
+        ::Load(&input, objectCount);
+        if (!objectCount) {
+            break;
+        }
+        ++result.BlockCount;
+
+        TVector<ui64> docIds(objectCount);
+        ::LoadArray(&input, docIds.data(), objectCount);
+        result.DocIds.insert(result.DocIds.end(), docIds.begin(), docIds.end());
+
+        for (auto& column : result.Columns) {
+            if (result.ValueSize == sizeof(double)) {
+                TVector<double> values(objectCount);
+                ::LoadArray(&input, values.data(), objectCount);
+                column.insert(column.end(), values.begin(), values.end());
+            } else {
+                UNIT_ASSERT_VALUES_EQUAL(result.ValueSize, sizeof(float));
+                TVector<float> values(objectCount);
+                ::LoadArray(&input, values.data(), objectCount);
+                column.insert(column.end(), values.begin(), values.end());
+            }
+        }
+    }
+    return result;
+}
+
+
+Y_UNIT_TEST_SUITE(TCalcModelSingleHost) {
+    Y_UNIT_TEST(BlockPipelineMatchesWholePoolApply) {
+        const ui32 docCount = 12000;
+        const ui32 factorCount = 3;
+        const int iterations = 10;
+        const size_t evalPeriod = 5;
+
+        TFastRng64 rng(0);
+        TStringBuilder dsvData;
+        for (auto docIdx : xrange(docCount)) {
+            Y_UNUSED(docIdx);
+            dsvData << rng.GenRandReal1();
+            for (auto factorIdx : xrange(factorCount)) {
+                Y_UNUSED(factorIdx);
+                dsvData << '\t' << rng.GenRandReal1();
+            }
+            dsvData << '\n';
+        }
+
+        TSrcData srcData;
+        srcData.CdFileData = AsStringBuf("0\tTarget\n");
+        srcData.DsvFileData = dsvData;
+
+        TReadDatasetMainParams readDatasetMainParams;
+        TVector<THolder<TTempFile>> srcDataFiles;
+        SaveSrcData(srcData, &readDatasetMainParams, &srcDataFiles);
+
+        TDataProviderPtr pool = ReadDataset(
+            readDatasetMainParams.PoolPath,
+            TPathWithScheme(),
+            TPathWithScheme(),
+            readDatasetMainParams.DsvPoolFormatParams,
+            /*ignoredFeatures*/ {},
+            EObjectsOrder::Undefined,
+            /*threadCount*/ 4,
+            /*verbose*/ false
+        );
+
+        NJson::TJsonValue params;
+        params.InsertValue("iterations", iterations);
+        params.InsertValue("random_seed", 0);
+        TFullModel model;
+        TEvalResult evalResult;
+        TrainModel(
+            params,
+            nullptr,
+            Nothing(),
+            Nothing(),
+            TDataProviders{pool, {}},
+            "",
+            &model,
+            {&evalResult}
+        );
+
+        TTempFile outputFile(MakeTempName());
+
+        TAnalyticalModeCommonParams calcParams;
+        calcParams.InputPath = readDatasetMainParams.PoolPath;
+        calcParams.DsvPoolFormatParams = readDatasetMainParams.DsvPoolFormatParams;
+        calcParams.OutputPath = TPathWithScheme("binary://" + outputFile.Name());
+        calcParams.BinaryOutputWithDoublePrecision = true;
+        calcParams.ThreadCount = 4;
+
+        // 2 prediction columns make the blocks 5000 objects long
+        CalcModelSingleHost(calcParams, iterations, evalPeriod, model);
+
+        const auto result = ReadBinaryEvalResult(outputFile.Name());
+        UNIT_ASSERT_VALUES_EQUAL(result.ValueSize, sizeof(double));
+        UNIT_ASSERT_VALUES_EQUAL(result.BlockCount, 3);
+        UNIT_ASSERT_VALUES_EQUAL(result.ColumnNames.size(), 2);
+        UNIT_ASSERT_VALUES_EQUAL(result.DocIds.size(), docCount);
+        for (auto docIdx : xrange(docCount)) {
+            UNIT_ASSERT_VALUES_EQUAL(result.DocIds[docIdx], docIdx);
+        }
+
+        for (auto columnIdx : xrange(result.Columns.size())) {
+            const auto expected = ApplyModelMulti(
+                model,
+                *pool,
+                /*verbose*/ false,
+                EPredictionType::RawFormulaVal,
+                /*begin*/ 0,
+                /*end*/ (columnIdx + 1) * evalPeriod,
+                /*threadCount*/ 4
+            );
+            const auto& column = result.Columns[columnIdx];
+            UNIT_ASSERT_VALUES_EQUAL(column.size(), docCount);
+            for (auto docIdx : xrange(docCount)) {
+                UNIT_ASSERT_DOUBLES_EQUAL(column[docIdx], expected[0][docIdx], 1e-9);
+            }
+        }
+    }
+}
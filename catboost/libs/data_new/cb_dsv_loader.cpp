@@ -9,7 +9,10 @@
 
 #include <util/generic/maybe.h>
 #include <util/generic/strbuf.h>
+#include <util/generic/utility.h>
 #include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ylimits.h>
 #include <util/stream/file.h>
 #include <util/string/iterator.h>
 #include <util/string/split.h>
@@ -58,11 +61,17 @@ namespace NCB {
             &featureIds
         );
 
+        if (dynamic_cast<TMappedFileLineDataReader*>(LineDataReader.Get())) {
+            MappedDataFirstLine = firstLine;
+        }
         AsyncRowProcessor.AddFirstLine(std::move(firstLine));
 
         ProcessIgnoredFeaturesList(Args.IgnoredFeatures, &DataMetaInfo, &FeatureIgnored);
 
-        AsyncRowProcessor.ReadBlockAsync(GetReadFunc());
+        // memory mapped data is read and parsed in DoMapped without async row processing
+        if (!dynamic_cast<TMappedFileLineDataReader*>(LineDataReader.Get())) {
+            StartAsyncRead();
+        }
     }
 
     TVector<TColumn> TCBDsvDataLoader::CreateColumnsDescription(ui32 columnsCount) {
@@ -78,6 +87,29 @@ namespace NCB {
     }
 
 
+    void TCBDsvDataLoader::ParseLine(
+        TStringBuf line,
+        ui32 localObjectIdx,
+        ui64 lineIdx,
+        TArrayRef<float> floatFeaturesBuffer,
+        TArrayRef<ui32> catFeaturesBuffer,
+        IRawObjectsOrderDataVisitor* visitor
+    ) const {
+        TDsvLineParser parser(
+            FieldDelimiter,
+            DataMetaInfo.ColumnsInfo->Columns,
+            FeatureIgnored,
+            DataMetaInfo.FeaturesLayout.Get(),
+            floatFeaturesBuffer,
+            catFeaturesBuffer,
+            visitor);
+
+        if (const auto errCtx = parser.Parse(line, localObjectIdx)) {
+            ythrow TDsvLineParser::MakeException(errCtx.GetRef()) << "; " << LabeledOutput(lineIdx);
+        }
+    }
+
+
     void TCBDsvDataLoader::ProcessBlock(IRawObjectsOrderDataVisitor* visitor) {
         visitor->StartNextBlock(AsyncRowProcessor.GetParseBufferSize());
 
@@ -90,27 +122,102 @@ namespace NCB {
             TVector<ui32> catFeatures;
             catFeatures.yresize(featuresLayout->GetCatFeatureCount());
 
-            TDsvLineParser parser(
-                FieldDelimiter,
-                DataMetaInfo.ColumnsInfo->Columns,
-                FeatureIgnored,
-                featuresLayout,
+            ParseLine(
+                line,
+                inBlockIdx,
+                AsyncRowProcessor.GetLinesProcessed() + inBlockIdx + 1,
                 floatFeatures,
                 catFeatures,
-                visitor);
-
-            if (const auto errCtx = parser.Parse(line, inBlockIdx)) {
-                const auto lineIdx = AsyncRowProcessor.GetLinesProcessed() + inBlockIdx + 1;
-                ythrow TDsvLineParser::MakeException(errCtx.GetRef()) << "; " << LabeledOutput(lineIdx);
-            }
+                visitor
+            );
         };
 
         AsyncRowProcessor.ProcessBlock(parseBlock);
     }
 
+
+    void TCBDsvDataLoader::DoMapped(
+        TMappedFileLineDataReader* mappedFileReader,
+        IRawObjectsOrderDataVisitor* visitor
+    ) {
+        // the first line has been read in the constructor to get the columns count
+        TVector<TStringBuf> chunks = {MappedDataFirstLine};
+        {
+            const TVector<TStringBuf> dataChunks = mappedFileReader->ReadChunks(MAPPED_DATA_CHUNK_SIZE);
+            chunks.insert(chunks.end(), dataChunks.begin(), dataChunks.end());
+        }
+
+        StartBuilder(false, IRawObjectsOrderDataVisitor::UNKNOWN_OBJECT_COUNT, 0, visitor);
+
+        const auto* const featuresLayout = DataMetaInfo.FeaturesLayout.Get();
+        const int threadCount = Args.LocalExecutor->GetThreadCount() + 1;
+
+        // chunks are processed in rounds of threadCount chunks, lines of a round are added as one block
+        TVector<TVector<TStringBuf>> chunkLines(threadCount); // [chunkIdxInRound][lineIdx]
+        TVector<TVector<float>> floatFeaturesBuffers(threadCount); // [chunkIdxInRound]
+        TVector<TVector<ui32>> catFeaturesBuffers(threadCount); // [chunkIdxInRound]
+        for (auto chunkIdxInRound : xrange(threadCount)) {
+            floatFeaturesBuffers[chunkIdxInRound].yresize(featuresLayout->GetFloatFeatureCount());
+            catFeaturesBuffers[chunkIdxInRound].yresize(featuresLayout->GetCatFeatureCount());
+        }
+
+        ui64 linesProcessed = 0;
+        for (size_t roundBegin = 0; roundBegin < chunks.size(); roundBegin += threadCount) {
+            const int roundChunkCount = (int)Min<size_t>(threadCount, chunks.size() - roundBegin);
+
+            Args.LocalExecutor->ExecRangeWithThrow(
+                [&] (int chunkIdxInRound) {
+                    auto& lines = chunkLines[chunkIdxInRound];
+                    lines.clear();
+                    TMappedFileLineDataReader::SplitToLines(chunks[roundBegin + chunkIdxInRound], &lines);
+                },
+                0,
+                roundChunkCount,
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+
+            TVector<ui32> chunkOffsets(roundChunkCount + 1, 0); // in block
+            for (auto chunkIdxInRound : xrange(roundChunkCount)) {
+                chunkOffsets[chunkIdxInRound + 1]
+                    = chunkOffsets[chunkIdxInRound] + chunkLines[chunkIdxInRound].size();
+            }
+            CB_ENSURE(
+                linesProcessed + chunkOffsets.back() < Max<ui32>(),
+                "CatBoost does not support datasets with more than " << Max<ui32>() << " objects"
+            );
+            visitor->StartNextBlock(chunkOffsets.back());
+
+            Args.LocalExecutor->ExecRangeWithThrow(
+                [&] (int chunkIdxInRound) {
+                    const auto& lines = chunkLines[chunkIdxInRound];
+                    for (auto lineIdx : xrange(lines.size())) {
+                        const ui32 localObjectIdx = chunkOffsets[chunkIdxInRound] + lineIdx;
+                        ParseLine(
+                            lines[lineIdx],
+                            localObjectIdx,
+                            linesProcessed + localObjectIdx + 1,
+                            floatFeaturesBuffers[chunkIdxInRound],
+                            catFeaturesBuffers[chunkIdxInRound],
+                            visitor
+                        );
+                    }
+                },
+                0,
+                roundChunkCount,
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+
+            linesProcessed += chunkOffsets.back();
+        }
+
+        MappedDataObjectCount = (ui32)linesProcessed;
+        FinalizeBuilder(false, visitor);
+    }
+
     namespace {
         TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> DefDataLoaderReg("");
         TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> CBDsvDataLoaderReg("dsv");
+        TDatasetLoaderFactory::TRegistrator<TCBDsvDataLoader> MappedFileCBDsvDataLoaderReg("mmap");
     }
 }
 
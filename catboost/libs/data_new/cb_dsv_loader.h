@@ -6,7 +6,10 @@
 #include <catboost/libs/data_util/line_data_reader.h>
 #include <catboost/libs/helpers/exception.h>
 
+#include <util/generic/array_ref.h>
+#include <util/generic/maybe.h>
 #include <util/generic/ptr.h>
+#include <util/generic/strbuf.h>
 #include <util/generic/string.h>
 #include <util/generic/vector.h>
 #include <util/generic/ylimits.h>
@@ -29,6 +32,10 @@ namespace NCB {
             };
         }
 
+    public:
+        // approximate size of data in bytes parsed by one task when the data is memory mapped
+        static constexpr size_t MAPPED_DATA_CHUNK_SIZE = 4 << 20;
+
     public:
         explicit TCBDsvDataLoader(TDatasetLoaderPullArgs&& args);
 
@@ -39,16 +46,25 @@ namespace NCB {
         }
 
         void Do(IRawObjectsOrderDataVisitor* visitor) override {
+            if (auto* mappedFileReader = dynamic_cast<TMappedFileLineDataReader*>(LineDataReader.Get())) {
+                DoMapped(mappedFileReader, visitor);
+                return;
+            }
+            StartAsyncRead();
             TBase::Do(GetReadFunc(), visitor);
         }
 
         bool DoBlock(IRawObjectsOrderDataVisitor* visitor) override {
+            StartAsyncRead();
             return TBase::DoBlock(GetReadFunc(), visitor);
         }
 
         TVector<TColumn> CreateColumnsDescription(ui32 columnsCount);
 
         ui32 GetObjectCount() override {
+            if (MappedDataObjectCount) {
+                return *MappedDataObjectCount;
+            }
             const ui64 dataLineCount = LineDataReader->GetDataLineCount();
             CB_ENSURE(
                 dataLineCount <= Max<ui32>(), "CatBoost does not support datasets with more than "
@@ -67,10 +83,35 @@ namespace NCB {
 
         void ProcessBlock(IRawObjectsOrderDataVisitor* visitor) override;
 
+    protected:
+        void StartAsyncRead() {
+            if (!AsyncReadStarted) {
+                AsyncRowProcessor.ReadBlockAsync(GetReadFunc());
+                AsyncReadStarted = true;
+            }
+        }
+
+        /* chunks of whole lines are parsed in parallel directly from the mapped data,
+         * objects storage grows with processed data, so data line count is not calculated in advance
+         */
+        void DoMapped(TMappedFileLineDataReader* mappedFileReader, IRawObjectsOrderDataVisitor* visitor);
+
+        void ParseLine(
+            TStringBuf line,
+            ui32 localObjectIdx,
+            ui64 lineIdx, // for error messages
+            TArrayRef<float> floatFeaturesBuffer,
+            TArrayRef<ui32> catFeaturesBuffer,
+            IRawObjectsOrderDataVisitor* visitor
+        ) const;
+
     protected:
         TVector<bool> FeatureIgnored; // init in process
         char FieldDelimiter;
         THolder<NCB::ILineDataReader> LineDataReader;
+        bool AsyncReadStarted = false;
+        TString MappedDataFirstLine; // read in constructor, used only in DoMapped
+        TMaybe<ui32> MappedDataObjectCount; // defined after DoMapped
     };
 
 }
@@ -0,0 +1,141 @@
+#include "columnar_pool_format.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/cast.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+
+#include <cstring>
+
+
+namespace NCB {
+
+    TColumnarPoolWriter::TColumnarPoolWriter(const TString& path, ui64 objectCount)
+        : File(path, CreateAlways | WrOnly)
+        , ObjectCount(objectCount)
+        , Offset(0)
+        , Finished(false)
+    {
+        // real header is written in Finish
+        TColumnarPoolHeader header;
+        Zero(header);
+        Write(&header, sizeof(header));
+        Align();
+    }
+
+    void TColumnarPoolWriter::AddFloatColumn(EColumn columnType, TConstArrayRef<float> values, TStringBuf name) {
+        CB_ENSURE(
+            (columnType == EColumn::Num) || (columnType == EColumn::Label) || (columnType == EColumn::Weight)
+            || (columnType == EColumn::GroupWeight) || (columnType == EColumn::Baseline),
+            "Column type " << columnType << " can't be stored as float"
+        );
+        StartColumn(columnType, EColumnarValueType::Float, name, values.size());
+        Write(values.data(), values.size() * sizeof(float));
+        ColumnsHeaders.back().DataSize = Offset - ColumnsHeaders.back().DataOffset;
+    }
+
+    void TColumnarPoolWriter::AddHashedCatColumn(TConstArrayRef<ui32> values, TStringBuf name) {
+        StartColumn(EColumn::Categ, EColumnarValueType::UI32, name, values.size());
+        Write(values.data(), values.size() * sizeof(ui32));
+        ColumnsHeaders.back().DataSize = Offset - ColumnsHeaders.back().DataOffset;
+    }
+
+    void TColumnarPoolWriter::AddUI64Column(EColumn columnType, TConstArrayRef<ui64> values, TStringBuf name) {
+        CB_ENSURE(
+            (columnType == EColumn::GroupId) || (columnType == EColumn::SubgroupId)
+            || (columnType == EColumn::Timestamp),
+            "Column type " << columnType << " can't be stored as ui64"
+        );
+        StartColumn(columnType, EColumnarValueType::UI64, name, values.size());
+        Write(values.data(), values.size() * sizeof(ui64));
+        ColumnsHeaders.back().DataSize = Offset - ColumnsHeaders.back().DataOffset;
+    }
+
+    void TColumnarPoolWriter::AddStringColumn(
+        EColumn columnType,
+        TConstArrayRef<TString> values,
+        TStringBuf name
+    ) {
+        CB_ENSURE(
+            (columnType == EColumn::Categ) || (columnType == EColumn::Label) || (columnType == EColumn::GroupId)
+            || (columnType == EColumn::SubgroupId),
+            "Column type " << columnType << " can't be stored as string"
+        );
+        StartColumn(columnType, EColumnarValueType::String, name, values.size());
+
+        TVector<ui64> offsets;
+        offsets.yresize(values.size() + 1);
+        ui64 offset = offsets.size() * sizeof(ui64);
+        for (auto i : xrange(values.size())) {
+            offsets[i] = offset;
+            offset += values[i].size();
+        }
+        offsets.back() = offset;
+        Write(offsets.data(), offsets.size() * sizeof(ui64));
+        for (const auto& value : values) {
+            Write(value.data(), value.size());
+        }
+        ColumnsHeaders.back().DataSize = Offset - ColumnsHeaders.back().DataOffset;
+    }
+
+    void TColumnarPoolWriter::Finish() {
+        CB_ENSURE_INTERNAL(!Finished, "TColumnarPoolWriter::Finish called twice");
+        Finished = true;
+
+        for (auto columnIdx : xrange(ColumnsHeaders.size())) {
+            ColumnsHeaders[columnIdx].NameOffset = Offset;
+            ColumnsHeaders[columnIdx].NameSize = ColumnsNames[columnIdx].size();
+            Write(ColumnsNames[columnIdx].data(), ColumnsNames[columnIdx].size());
+        }
+        Align();
+
+        TColumnarPoolHeader header;
+        memcpy(header.Magic, COLUMNAR_POOL_MAGIC.data(), sizeof(header.Magic));
+        header.Version = COLUMNAR_POOL_VERSION;
+        header.ColumnCount = SafeIntegerCast<ui32>(ColumnsHeaders.size());
+        header.ObjectCount = ObjectCount;
+        header.ColumnsHeadersOffset = Offset;
+
+        Write(ColumnsHeaders.data(), ColumnsHeaders.size() * sizeof(TColumnarPoolColumnHeader));
+        File.Pwrite(&header, sizeof(header), 0);
+        File.Close();
+    }
+
+    void TColumnarPoolWriter::StartColumn(
+        EColumn columnType,
+        EColumnarValueType valueType,
+        TStringBuf name,
+        size_t size
+    ) {
+        CB_ENSURE_INTERNAL(!Finished, "TColumnarPoolWriter: column added after Finish");
+        CB_ENSURE(
+            size == ObjectCount,
+            "Column " << ColumnsHeaders.size() << " size " << size << " is not equal to object count "
+            << ObjectCount
+        );
+        Align();
+
+        TColumnarPoolColumnHeader columnHeader;
+        Zero(columnHeader);
+        columnHeader.ColumnType = static_cast<ui32>(columnType);
+        columnHeader.ValueType = static_cast<ui32>(valueType);
+        columnHeader.DataOffset = Offset;
+        ColumnsHeaders.push_back(columnHeader);
+        ColumnsNames.push_back(TString(name));
+    }
+
+    void TColumnarPoolWriter::Write(const void* data, size_t size) {
+        File.Write(data, size);
+        Offset += size;
+    }
+
+    void TColumnarPoolWriter::Align() {
+        static const char padding[COLUMNAR_POOL_ALIGNMENT] = {};
+        const ui64 tail = Offset % COLUMNAR_POOL_ALIGNMENT;
+        if (tail) {
+            Write(padding, COLUMNAR_POOL_ALIGNMENT - tail);
+        }
+    }
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <catboost/libs/column_description/column.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/system/file.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+
+    /* Columnar raw pool format (scheme "columnar"), designed to be memory mapped
+     * and passed to IRawFeaturesOrderDataVisitor without parsing or copying:
+     *
+     *   TColumnarPoolHeader
+     *   column data, each column starts at COLUMNAR_POOL_ALIGNMENT-aligned offset
+     *   column names
+     *   TColumnarPoolColumnHeader[ColumnCount] at ColumnsHeadersOffset
+     *
+     * Column data is an array of ObjectCount values of ValueType:
+     *   Float  - float
+     *   UI32   - ui32 (hashed categorical feature values)
+     *   UI64   - ui64 (group ids, subgroup ids, timestamps)
+     *   String - ui64 offsets[ObjectCount + 1] relative to the start of the column data
+     *            followed by concatenated string values, i-th value is [offsets[i], offsets[i + 1])
+     *
+     * Headers and column data are in the native byte order of the writing machine (mapped data is used as is),
+     * so pools are portable only between machines with the same endianness.
+     */
+
+    constexpr TStringBuf COLUMNAR_POOL_MAGIC = AsStringBuf("CBRAWCOL");
+    constexpr ui32 COLUMNAR_POOL_VERSION = 1;
+    constexpr ui64 COLUMNAR_POOL_ALIGNMENT = 16;
+
+    enum class EColumnarValueType : ui32 {
+        Float,
+        UI32,
+        UI64,
+        String
+    };
+
+    struct TColumnarPoolHeader {
+        char Magic[8];
+        ui32 Version;
+        ui32 ColumnCount;
+        ui64 ObjectCount;
+        ui64 ColumnsHeadersOffset;
+    };
+
+    struct TColumnarPoolColumnHeader {
+        ui32 ColumnType; // EColumn
+        ui32 ValueType; // EColumnarValueType
+        ui64 NameOffset;
+        ui64 NameSize;
+        ui64 DataOffset;
+        ui64 DataSize;
+    };
+
+    static_assert(sizeof(TColumnarPoolHeader) == 32, "");
+    static_assert(sizeof(TColumnarPoolColumnHeader) == 40, "");
+
+
+    /* Writes columns one by one without keeping them in memory,
+     * headers are written in Finish
+     */
+    class TColumnarPoolWriter {
+    public:
+        TColumnarPoolWriter(const TString& path, ui64 objectCount);
+
+        void AddFloatColumn(EColumn columnType, TConstArrayRef<float> values, TStringBuf name = {});
+
+        // for Categ only, values are CalcCatFeatureHash results
+        void AddHashedCatColumn(TConstArrayRef<ui32> values, TStringBuf name = {});
+
+        // for GroupId, SubgroupId and Timestamp
+        void AddUI64Column(EColumn columnType, TConstArrayRef<ui64> values, TStringBuf name = {});
+
+        void AddStringColumn(EColumn columnType, TConstArrayRef<TString> values, TStringBuf name = {});
+
+        void Finish();
+
+    private:
+        void StartColumn(EColumn columnType, EColumnarValueType valueType, TStringBuf name, size_t size);
+        void Write(const void* data, size_t size);
+        void Align();
+
+    private:
+        TFile File;
+        ui64 ObjectCount;
+        ui64 Offset;
+        TVector<TColumnarPoolColumnHeader> ColumnsHeaders;
+        TVector<TString> ColumnsNames;
+        bool Finished;
+    };
+
+}
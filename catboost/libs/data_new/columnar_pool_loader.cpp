@@ -0,0 +1,302 @@
+#include "columnar_pool_loader.h"
+
+#include <catboost/libs/column_description/column.h>
+#include <catboost/libs/data_types/groupid.h>
+#include <catboost/libs/data_util/exists_checker.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/object_factory/object_factory.h>
+
+#include <util/generic/xrange.h>
+#include <util/generic/ylimits.h>
+
+
+namespace NCB {
+
+    namespace {
+        struct TBlobHolder : public IResourceHolder {
+            TBlob Blob;
+
+        public:
+            explicit TBlobHolder(const TBlob& blob)
+                : Blob(blob)
+            {}
+        };
+    }
+
+
+    static ui64 GetValueSize(EColumnarValueType valueType) {
+        switch (valueType) {
+            case EColumnarValueType::Float:
+                return sizeof(float);
+            case EColumnarValueType::UI32:
+                return sizeof(ui32);
+            case EColumnarValueType::UI64:
+            case EColumnarValueType::String:
+                return sizeof(ui64);
+        }
+        Y_UNREACHABLE();
+    }
+
+    static void CheckColumnHeader(const TColumnarPoolColumnHeader& columnHeader, ui64 objectCount, ui64 dataSize) {
+        CB_ENSURE(columnHeader.ValueType <= static_cast<ui32>(EColumnarValueType::String), "Bad value type");
+        CB_ENSURE(columnHeader.ColumnType <= static_cast<ui32>(EColumn::Prediction), "Bad column type");
+
+        const auto valueType = static_cast<EColumnarValueType>(columnHeader.ValueType);
+        const auto columnType = static_cast<EColumn>(columnHeader.ColumnType);
+        switch (columnType) {
+            case EColumn::Num:
+            case EColumn::Weight:
+            case EColumn::GroupWeight:
+            case EColumn::Baseline:
+                CB_ENSURE(valueType == EColumnarValueType::Float, columnType << " column data must be float");
+                break;
+            case EColumn::Label:
+                CB_ENSURE(
+                    (valueType == EColumnarValueType::Float) || (valueType == EColumnarValueType::String),
+                    "Label column data must be float or string"
+                );
+                break;
+            case EColumn::Categ:
+                CB_ENSURE(
+                    (valueType == EColumnarValueType::UI32) || (valueType == EColumnarValueType::String),
+                    "Categ column data must be ui32 hashes or strings"
+                );
+                break;
+            case EColumn::GroupId:
+            case EColumn::SubgroupId:
+                CB_ENSURE(
+                    (valueType == EColumnarValueType::UI64) || (valueType == EColumnarValueType::String),
+                    columnType << " column data must be ui64 or string"
+                );
+                break;
+            case EColumn::Timestamp:
+                CB_ENSURE(valueType == EColumnarValueType::UI64, "Timestamp column data must be ui64");
+                break;
+            case EColumn::Auxiliary:
+            case EColumn::DocId:
+                break;
+            default:
+                CB_ENSURE(false, columnType << " columns are not supported in columnar pool format");
+        }
+
+        CB_ENSURE(
+            columnHeader.DataOffset % COLUMNAR_POOL_ALIGNMENT == 0,
+            "Column data is not aligned"
+        );
+        CB_ENSURE(
+            (columnHeader.DataOffset <= dataSize) && (columnHeader.DataSize <= dataSize - columnHeader.DataOffset),
+            "Column data is out of file bounds"
+        );
+        CB_ENSURE(
+            (columnHeader.NameOffset <= dataSize) && (columnHeader.NameSize <= dataSize - columnHeader.NameOffset),
+            "Column name is out of file bounds"
+        );
+
+        const ui64 valuesSize = (objectCount + (valueType == EColumnarValueType::String ? 1 : 0))
+            * GetValueSize(valueType);
+        if (valueType == EColumnarValueType::String) {
+            CB_ENSURE(columnHeader.DataSize >= valuesSize, "String column data is too small");
+        } else {
+            CB_ENSURE(
+                columnHeader.DataSize == valuesSize,
+                "Column data size " << columnHeader.DataSize << " does not correspond to object count"
+            );
+        }
+    }
+
+
+    TColumnarPoolDataLoader::TColumnarPoolDataLoader(TDatasetLoaderPullArgs&& args)
+        : Args(std::move(args.CommonArgs))
+    {
+        CB_ENSURE(!Args.PairsFilePath.Inited() || CheckExists(Args.PairsFilePath),
+                  "TColumnarPoolDataLoader:PairsFilePath does not exist");
+        CB_ENSURE(!Args.GroupWeightsFilePath.Inited() || CheckExists(Args.GroupWeightsFilePath),
+                  "TColumnarPoolDataLoader:GroupWeightsFilePath does not exist");
+        CB_ENSURE(
+            !Args.CdProvider->Inited(),
+            "TColumnarPoolDataLoader: columns description is not supported, column types are stored in the data"
+        );
+
+        Data = TBlob::FromFile(args.PoolPath.Path);
+        DataHolder = MakeIntrusive<TBlobHolder>(Data);
+
+        CB_ENSURE(Data.Size() >= sizeof(TColumnarPoolHeader), "TColumnarPoolDataLoader: file is too small");
+        const auto& header = *reinterpret_cast<const TColumnarPoolHeader*>(Data.AsCharPtr());
+        CB_ENSURE(
+            TStringBuf(header.Magic, sizeof(header.Magic)) == COLUMNAR_POOL_MAGIC,
+            "TColumnarPoolDataLoader: not a columnar pool file"
+        );
+        CB_ENSURE(
+            header.Version == COLUMNAR_POOL_VERSION,
+            "TColumnarPoolDataLoader: unsupported format version " << header.Version
+        );
+        CB_ENSURE(header.ObjectCount, "TColumnarPoolDataLoader: no objects in pool");
+        CB_ENSURE(
+            header.ObjectCount <= (ui64)Max<ui32>(),
+            "CatBoost does not support datasets with more than " << Max<ui32>() << " objects"
+        );
+        ObjectCount = (ui32)header.ObjectCount;
+        CB_ENSURE(
+            (header.ColumnsHeadersOffset % COLUMNAR_POOL_ALIGNMENT == 0)
+            && (header.ColumnsHeadersOffset <= Data.Size())
+            && ((ui64)header.ColumnCount * sizeof(TColumnarPoolColumnHeader)
+                <= Data.Size() - header.ColumnsHeadersOffset),
+            "TColumnarPoolDataLoader: columns headers are out of file bounds"
+        );
+        ColumnsHeaders = TConstArrayRef<TColumnarPoolColumnHeader>(
+            reinterpret_cast<const TColumnarPoolColumnHeader*>(Data.AsCharPtr() + header.ColumnsHeadersOffset),
+            header.ColumnCount
+        );
+
+        TVector<TColumn> columns;
+        for (auto columnIdx : xrange(ColumnsHeaders.size())) {
+            const auto& columnHeader = ColumnsHeaders[columnIdx];
+            try {
+                CheckColumnHeader(columnHeader, ObjectCount, Data.Size());
+            } catch (const TCatBoostException& e) {
+                throw TCatBoostException() << "TColumnarPoolDataLoader: column #" << columnIdx << ": "
+                    << e.what();
+            }
+            columns.push_back(
+                TColumn{
+                    static_cast<EColumn>(columnHeader.ColumnType),
+                    TString(Data.AsCharPtr() + columnHeader.NameOffset, columnHeader.NameSize)
+                }
+            );
+        }
+
+        auto columnsDescription = TDataColumnsMetaInfo{std::move(columns)};
+        auto featureIds = columnsDescription.GenerateFeatureIds(Nothing());
+
+        DataMetaInfo = TDataMetaInfo(
+            std::move(columnsDescription),
+            Args.GroupWeightsFilePath.Inited(),
+            Args.PairsFilePath.Inited(),
+            &featureIds
+        );
+
+        ProcessIgnoredFeaturesList(Args.IgnoredFeatures, &DataMetaInfo, &FeatureIgnored);
+    }
+
+    template <class T>
+    TConstArrayRef<T> TColumnarPoolDataLoader::GetColumnData(const TColumnarPoolColumnHeader& columnHeader) const {
+        // size and alignment have been checked in constructor
+        return TConstArrayRef<T>(reinterpret_cast<const T*>(Data.AsCharPtr() + columnHeader.DataOffset), ObjectCount);
+    }
+
+    TVector<TStringBuf> TColumnarPoolDataLoader::GetStringColumnData(
+        const TColumnarPoolColumnHeader& columnHeader
+    ) const {
+        const char* columnData = Data.AsCharPtr() + columnHeader.DataOffset;
+        const ui64* offsets = reinterpret_cast<const ui64*>(columnData);
+
+        TVector<TStringBuf> result;
+        result.yresize(ObjectCount);
+        for (auto objectIdx : xrange(ObjectCount)) {
+            CB_ENSURE(
+                (offsets[objectIdx] <= offsets[objectIdx + 1]) && (offsets[objectIdx + 1] <= columnHeader.DataSize),
+                "TColumnarPoolDataLoader: bad string offset for object #" << objectIdx
+            );
+            result[objectIdx] = TStringBuf(
+                columnData + offsets[objectIdx],
+                columnData + offsets[objectIdx + 1]
+            );
+        }
+        return result;
+    }
+
+    void TColumnarPoolDataLoader::Do(IRawFeaturesOrderDataVisitor* visitor) {
+        visitor->Start(DataMetaInfo, ObjectCount, Args.ObjectsOrder, {DataHolder});
+
+        ui32 flatFeatureIdx = 0;
+        ui32 baselineIdx = 0;
+        for (const auto& columnHeader : ColumnsHeaders) {
+            const auto valueType = static_cast<EColumnarValueType>(columnHeader.ValueType);
+            switch (static_cast<EColumn>(columnHeader.ColumnType)) {
+                case EColumn::Num:
+                    if (!FeatureIgnored[flatFeatureIdx]) {
+                        visitor->AddFloatFeature(flatFeatureIdx, GetColumnDataHolder<float>(columnHeader));
+                    }
+                    ++flatFeatureIdx;
+                    break;
+                case EColumn::Categ:
+                    if (!FeatureIgnored[flatFeatureIdx]) {
+                        if (valueType == EColumnarValueType::UI32) {
+                            visitor->AddCatFeature(flatFeatureIdx, GetColumnDataHolder<ui32>(columnHeader));
+                        } else {
+                            const auto values = GetStringColumnData(columnHeader);
+                            visitor->AddCatFeature(flatFeatureIdx, TConstArrayRef<TStringBuf>(values));
+                        }
+                    }
+                    ++flatFeatureIdx;
+                    break;
+                case EColumn::Label:
+                    if (valueType == EColumnarValueType::Float) {
+                        visitor->AddTarget(GetColumnData<float>(columnHeader));
+                    } else {
+                        const auto values = GetStringColumnData(columnHeader);
+                        visitor->AddTarget(TVector<TString>(values.begin(), values.end()));
+                    }
+                    break;
+                case EColumn::Weight:
+                    visitor->AddWeights(GetColumnData<float>(columnHeader));
+                    break;
+                case EColumn::GroupWeight:
+                    visitor->AddGroupWeights(GetColumnData<float>(columnHeader));
+                    break;
+                case EColumn::Baseline:
+                    visitor->AddBaseline(baselineIdx++, GetColumnData<float>(columnHeader));
+                    break;
+                case EColumn::GroupId:
+                    if (valueType == EColumnarValueType::UI64) {
+                        const auto values = GetColumnData<ui64>(columnHeader);
+                        for (auto objectIdx : xrange(ObjectCount)) {
+                            visitor->AddGroupId(objectIdx, values[objectIdx]);
+                        }
+                    } else {
+                        const auto values = GetStringColumnData(columnHeader);
+                        for (auto objectIdx : xrange(ObjectCount)) {
+                            visitor->AddGroupId(objectIdx, CalcGroupIdFor(values[objectIdx]));
+                        }
+                    }
+                    break;
+                case EColumn::SubgroupId:
+                    if (valueType == EColumnarValueType::UI64) {
+                        const auto values = GetColumnData<ui64>(columnHeader);
+                        // truncated the same way as in CalcSubgroupIdFor
+                        for (auto objectIdx : xrange(ObjectCount)) {
+                            visitor->AddSubgroupId(objectIdx, static_cast<TSubgroupId>(values[objectIdx]));
+                        }
+                    } else {
+                        const auto values = GetStringColumnData(columnHeader);
+                        for (auto objectIdx : xrange(ObjectCount)) {
+                            visitor->AddSubgroupId(objectIdx, CalcSubgroupIdFor(values[objectIdx]));
+                        }
+                    }
+                    break;
+                case EColumn::Timestamp:
+                    {
+                        const auto values = GetColumnData<ui64>(columnHeader);
+                        for (auto objectIdx : xrange(ObjectCount)) {
+                            visitor->AddTimestamp(objectIdx, values[objectIdx]);
+                        }
+                    }
+                    break;
+                default:
+                    // Auxiliary and DocId are not used in training
+                    break;
+            }
+        }
+
+        SetGroupWeights(Args.GroupWeightsFilePath, ObjectCount, visitor);
+        SetPairs(Args.PairsFilePath, ObjectCount, visitor);
+        visitor->Finish();
+    }
+
+
+    namespace {
+        TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSColumnarPoolExistsCheckerReg("columnar");
+        TDatasetLoaderFactory::TRegistrator<TColumnarPoolDataLoader> ColumnarPoolDataLoaderReg("columnar");
+    }
+}
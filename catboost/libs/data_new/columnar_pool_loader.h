@@ -0,0 +1,50 @@
+#pragma once
+
+#include "columnar_pool_format.h"
+#include "loader.h"
+
+#include <catboost/libs/helpers/maybe_owning_array_holder.h>
+#include <catboost/libs/helpers/resource_holder.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/ptr.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/vector.h>
+#include <util/memory/blob.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+
+    /* Loads data in columnar_pool_format.h format.
+     * The file is memory mapped and float and hashed categorical feature columns are passed to the visitor
+     * as views of the mapping without copying, so loading time is bounded by the disk read speed.
+     */
+    class TColumnarPoolDataLoader : public IRawFeaturesOrderDatasetLoader {
+    public:
+        explicit TColumnarPoolDataLoader(TDatasetLoaderPullArgs&& args);
+
+        void Do(IRawFeaturesOrderDataVisitor* visitor) override;
+
+    private:
+        template <class T>
+        TConstArrayRef<T> GetColumnData(const TColumnarPoolColumnHeader& columnHeader) const;
+
+        template <class T>
+        TMaybeOwningConstArrayHolder<T> GetColumnDataHolder(const TColumnarPoolColumnHeader& columnHeader) const {
+            return TMaybeOwningConstArrayHolder<T>::CreateOwning(GetColumnData<T>(columnHeader), DataHolder);
+        }
+
+        TVector<TStringBuf> GetStringColumnData(const TColumnarPoolColumnHeader& columnHeader) const;
+
+    private:
+        TDatasetLoaderCommonArgs Args;
+        TBlob Data;
+        TIntrusivePtr<IResourceHolder> DataHolder; // keeps Data mapped while the dataset is alive
+        TConstArrayRef<TColumnarPoolColumnHeader> ColumnsHeaders;
+        ui32 ObjectCount = 0;
+        TDataMetaInfo DataMetaInfo;
+        TVector<bool> FeatureIgnored; // [flatFeatureIdx]
+    };
+
+}
@@ -1 +1,38 @@
 #include "columns.h"
+
+
+using namespace NCB;
+
+
+TMaybeOwningArrayHolder<float> TSparseFloatValuesHolder::ExtractValues(
+    NPar::TLocalExecutor* localExecutor
+) const {
+    if (HoldsAlternative<TFullSubset<ui32>>(*SubsetIndexing)) {
+        return TMaybeOwningArrayHolder<float>::CreateOwning(SrcData->ExtractValues());
+    }
+    TVector<float> values;
+    values.yresize(SubsetIndexing->Size());
+    SubsetIndexing->ParallelForEach(
+        [&] (ui32 idx, ui32 srcIdx) { values[idx] = SrcData->GetValue(srcIdx); },
+        localExecutor
+    );
+    return TMaybeOwningArrayHolder<float>::CreateOwning(std::move(values));
+}
+
+TMaybeOwningArrayHolder<ui8> TSparseQuantizedFloatValuesHolder::ExtractValues(
+    NPar::TLocalExecutor* localExecutor
+) const {
+    TVector<ui8> srcValues = SrcData->ExtractValues();
+    return TMaybeOwningArrayHolder<ui8>::CreateOwning(
+        ::NCB::GetSubset<ui8>(srcValues, *SubsetIndexing, localExecutor)
+    );
+}
+
+TMaybeOwningArrayHolder<ui8> TBlockCompressedQuantizedFloatValuesHolder::ExtractValues(
+    NPar::TLocalExecutor* localExecutor
+) const {
+    TVector<ui8> srcValues = SrcData->ExtractValues(localExecutor);
+    return TMaybeOwningArrayHolder<ui8>::CreateOwning(
+        ::NCB::GetSubset<ui8>(srcValues, *SubsetIndexing, localExecutor)
+    );
+}
@@ -3,13 +3,16 @@
 #include "features_layout.h"
 
 #include <catboost/libs/helpers/array_subset.h>
+#include <catboost/libs/helpers/block_compressed_array.h>
 #include <catboost/libs/helpers/compression.h>
 #include <catboost/libs/helpers/maybe_owning_array_holder.h>
+#include <catboost/libs/helpers/sparse_array.h>
 
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/system/types.h>
 #include <util/generic/noncopyable.h>
+#include <util/generic/ptr.h>
 #include <util/generic/string.h>
 #include <util/generic/vector.h>
 #include <util/generic/yexception.h>
@@ -129,6 +132,48 @@ namespace NCB {
     using THashedCatValuesHolder = TArrayValuesHolder<ui32, EFeatureValuesType::HashedCategorical>;
 
 
+    /* for float features where most of the objects have the same (default) value (data in libsvm format)
+     * only values different from default are stored
+     */
+    class TSparseFloatValuesHolder: public IFeatureValuesHolder {
+    public:
+        using TSrcData = TSparseArray<float, ui32>;
+
+    public:
+        TSparseFloatValuesHolder(ui32 featureId,
+                                 TAtomicSharedPtr<const TSrcData> srcData,
+                                 const TFeaturesArraySubsetIndexing* subsetIndexing)
+            : IFeatureValuesHolder(EFeatureValuesType::Float,
+                                   featureId,
+                                   subsetIndexing->Size())
+            , SrcData(std::move(srcData))
+            , SubsetIndexing(subsetIndexing)
+        {
+            CB_ENSURE(SubsetIndexing, "subsetIndexing is empty");
+        }
+
+        // without subset indexing, indices are in the source data objects' space
+        const TSrcData& GetSrcData() const {
+            return *SrcData;
+        }
+
+        TAtomicSharedPtr<const TSrcData> GetSrcDataPtr() const {
+            return SrcData;
+        }
+
+        const TFeaturesArraySubsetIndexing* GetSubsetIndexing() const {
+            return SubsetIndexing;
+        }
+
+        // dense values in subset order, for code that does not support sparse data
+        TMaybeOwningArrayHolder<float> ExtractValues(NPar::TLocalExecutor* localExecutor) const;
+
+    private:
+        TAtomicSharedPtr<const TSrcData> SrcData;
+        const TFeaturesArraySubsetIndexing* SubsetIndexing;
+    };
+
+
     /*******************************************************************************************************
      * Quantized/prepared for quantization data
      */
@@ -220,6 +265,88 @@ namespace NCB {
     using TQuantizedFloatValuesHolder = TCompressedValuesHolderImpl<IQuantizedFloatValuesHolder>;
 
 
+    /* for features where most of the objects fall into the same (default) bin
+     * only bins different from default are stored
+     */
+    class TSparseQuantizedFloatValuesHolder : public IQuantizedFloatValuesHolder {
+    public:
+        using TSrcData = TSparseArray<ui8, ui32>;
+
+    public:
+        TSparseQuantizedFloatValuesHolder(ui32 featureId,
+                                          TAtomicSharedPtr<const TSrcData> srcData,
+                                          const TFeaturesArraySubsetIndexing* subsetIndexing)
+            : IQuantizedFloatValuesHolder(featureId, subsetIndexing->Size())
+            , SrcData(std::move(srcData))
+            , SubsetIndexing(subsetIndexing)
+        {
+            CB_ENSURE(SubsetIndexing, "subsetIndexing is empty");
+        }
+
+        THolder<IQuantizedFloatValuesHolder> CloneWithNewSubsetIndexing(
+            const TFeaturesArraySubsetIndexing* subsetIndexing
+        ) const override {
+            return MakeHolder<TSparseQuantizedFloatValuesHolder>(GetId(), SrcData, subsetIndexing);
+        }
+
+        TMaybeOwningArrayHolder<ui8> ExtractValues(NPar::TLocalExecutor* localExecutor) const override;
+
+        // without subset indexing, indices are in the source data objects' space
+        const TSrcData& GetSrcData() const {
+            return *SrcData;
+        }
+
+        const TFeaturesArraySubsetIndexing* GetSubsetIndexing() const {
+            return SubsetIndexing;
+        }
+
+    private:
+        TAtomicSharedPtr<const TSrcData> SrcData;
+        const TFeaturesArraySubsetIndexing* SubsetIndexing;
+    };
+
+
+    /* for keeping large datasets in RAM: bins are compressed by blocks and decompressed when the feature
+     * is used (see TQuantizedForCPUObjectsDataProvider::GetFloatFeatureSrcBins)
+     */
+    class TBlockCompressedQuantizedFloatValuesHolder : public IQuantizedFloatValuesHolder {
+    public:
+        using TSrcData = TBlockCompressedArray;
+
+    public:
+        TBlockCompressedQuantizedFloatValuesHolder(ui32 featureId,
+                                                   TAtomicSharedPtr<const TSrcData> srcData,
+                                                   const TFeaturesArraySubsetIndexing* subsetIndexing)
+            : IQuantizedFloatValuesHolder(featureId, subsetIndexing->Size())
+            , SrcData(std::move(srcData))
+            , SubsetIndexing(subsetIndexing)
+        {
+            CB_ENSURE(SubsetIndexing, "subsetIndexing is empty");
+        }
+
+        THolder<IQuantizedFloatValuesHolder> CloneWithNewSubsetIndexing(
+            const TFeaturesArraySubsetIndexing* subsetIndexing
+        ) const override {
+            return MakeHolder<TBlockCompressedQuantizedFloatValuesHolder>(GetId(), SrcData, subsetIndexing);
+        }
+
+        TMaybeOwningArrayHolder<ui8> ExtractValues(NPar::TLocalExecutor* localExecutor) const override;
+
+        // without subset indexing, indices are in the source data objects' space
+        const TSrcData& GetSrcData() const {
+            return *SrcData;
+        }
+
+        const TFeaturesArraySubsetIndexing* GetSubsetIndexing() const {
+            return SubsetIndexing;
+        }
+
+    private:
+        TAtomicSharedPtr<const TSrcData> SrcData;
+        const TFeaturesArraySubsetIndexing* SubsetIndexing;
+    };
+
+
     /* interface instead of concrete TQuantizedFloatValuesHolder because there is
      * an alternative implementation TExternalFloatValuesHolder for GPU
      */
@@ -45,6 +45,19 @@ namespace NCB {
     };
 
 
+    // capacity is kept equal to size, growth policy is up to the caller
+    template <class T>
+    static void ResizeExactly(size_t size, TVector<T>* data) {
+        if (size > data->capacity()) {
+            data->reserve(size);
+        }
+        data->yresize(size);
+        if (data->capacity() > size) {
+            data->shrink_to_fit();
+        }
+    }
+
+
     class TRawObjectsOrderDataProviderBuilder : public IDataProviderBuilder,
                                                 public IRawObjectsOrderDataVisitor
     {
@@ -54,6 +67,7 @@ namespace NCB {
             NPar::TLocalExecutor* localExecutor
         )
             : InBlock(false)
+            , ObjectCountIsUnknown(false)
             , ObjectCount(0)
             , CatFeatureCount(0)
             , Cursor(NotSet)
@@ -78,6 +92,11 @@ namespace NCB {
             ResultTaken = false;
 
             InBlock = inBlock;
+            ObjectCountIsUnknown = (objectCount == UNKNOWN_OBJECT_COUNT);
+            if (ObjectCountIsUnknown) {
+                CB_ENSURE_INTERNAL(!InBlock, "Unknown object count is not supported in block processing");
+                objectCount = 0;
+            }
 
             ui32 prevTailSize = 0;
             if (InBlock) {
@@ -104,6 +123,16 @@ namespace NCB {
             FloatFeaturesStorage.PrepareForInitialization(*metaInfo.FeaturesLayout, ObjectCount, prevTailSize);
             CatFeaturesStorage.PrepareForInitialization(*metaInfo.FeaturesLayout, ObjectCount, prevTailSize);
 
+            FloatFeaturesQuantileSketches.clear();
+            if (Options.BuildFloatFeaturesQuantileSketches && !InBlock) {
+                FloatFeaturesQuantileSketches.resize(FloatFeaturesStorage.IsAvailable.size());
+                for (auto floatFeatureIdx : xrange(FloatFeaturesStorage.IsAvailable.size())) {
+                    if (FloatFeaturesStorage.IsAvailable[floatFeatureIdx]) {
+                        FloatFeaturesQuantileSketches[floatFeatureIdx].ConstructInPlace();
+                    }
+                }
+            }
+
             if (metaInfo.HasWeights) {
                 PrepareForInitialization(ObjectCount, prevTailSize, &WeightsBuffer);
             }
@@ -113,8 +142,15 @@ namespace NCB {
         }
 
         void StartNextBlock(ui32 blockSize) override {
+            AddBlockToFloatFeaturesQuantileSketches();
+
             Cursor = NextCursor;
             NextCursor = Cursor + blockSize;
+
+            if (ObjectCountIsUnknown && (NextCursor > ObjectCount)) {
+                // grow geometrically to make reallocations amortized O(1) per object
+                ResizeObjectsStorage(Max(NextCursor, ObjectCount + ObjectCount / 2));
+            }
         }
 
         // TCommonObjectsData
@@ -224,11 +260,19 @@ namespace NCB {
 
         void Finish() override {
             CB_ENSURE(InProcess, "Attempt to Finish without starting processing");
+            if (ObjectCountIsUnknown) {
+                AddBlockToFloatFeaturesQuantileSketches();
+                ResizeObjectsStorage(NextCursor);
+                Data.TargetData.SetTrivialWeights(ObjectCount);
+                ObjectCountIsUnknown = false;
+            }
             CB_ENSURE(
                 NextCursor >= ObjectCount,
                 "processed object count is less than than specified in metadata"
             );
 
+            AddBlockToFloatFeaturesQuantileSketches();
+
             if (ObjectCount != 0) {
                 CATBOOST_INFO_LOG << "Object info sizes: " << ObjectCount << " "
                     << Data.MetaInfo.FeaturesLayout->GetExternalFeatureCount() << Endl;
@@ -283,6 +327,8 @@ namespace NCB {
                 &Data.ObjectsData.CatFeatures
             );
 
+            Data.ObjectsData.FloatFeaturesQuantileSketches = std::move(FloatFeaturesQuantileSketches);
+
             if (CatFeatureCount) {
                 auto& catFeaturesHashToString = *Data.CommonObjectsData.CatFeaturesHashToString;
                 catFeaturesHashToString.resize(CatFeatureCount);
@@ -366,6 +412,63 @@ namespace NCB {
         }
 
     private:
+        // only for ObjectCountIsUnknown, existing data is preserved
+        void ResizeObjectsStorage(ui32 objectCount) {
+            ObjectCount = objectCount;
+
+            if (Data.TargetData.Target) {
+                ResizeExactly(objectCount, &*Data.TargetData.Target);
+            }
+            for (auto& baseline : Data.TargetData.Baseline) {
+                ResizeExactly(objectCount, &baseline);
+            }
+            if (Data.CommonObjectsData.GroupIds) {
+                ResizeExactly(objectCount, &*Data.CommonObjectsData.GroupIds);
+            }
+            if (Data.CommonObjectsData.SubgroupIds) {
+                ResizeExactly(objectCount, &*Data.CommonObjectsData.SubgroupIds);
+            }
+            if (Data.CommonObjectsData.Timestamp) {
+                ResizeExactly(objectCount, &*Data.CommonObjectsData.Timestamp);
+            }
+            if (Data.MetaInfo.HasWeights) {
+                ResizeExactly(objectCount, &WeightsBuffer);
+            }
+            if (Data.MetaInfo.HasGroupWeight) {
+                ResizeExactly(objectCount, &GroupWeightsBuffer);
+            }
+            FloatFeaturesStorage.Resize(objectCount);
+            CatFeaturesStorage.Resize(objectCount);
+        }
+
+        // add float features values of the last processed block [Cursor, NextCursor)
+        void AddBlockToFloatFeaturesQuantileSketches() {
+            if (FloatFeaturesQuantileSketches.empty() || (Cursor == NotSet)) {
+                return;
+            }
+            const ui32 blockBegin = Cursor;
+            const ui32 blockEnd = Min(NextCursor, ObjectCount);
+
+            LocalExecutor->ExecRangeWithThrow(
+                [&, blockBegin, blockEnd] (int floatFeatureIdx) {
+                    auto& sketch = FloatFeaturesQuantileSketches[floatFeatureIdx];
+                    if (!sketch) {
+                        return;
+                    }
+                    const auto featureValues = FloatFeaturesStorage.DstView[floatFeatureIdx];
+                    for (auto objectIdx : xrange(blockBegin, blockEnd)) {
+                        sketch->Add(featureValues[objectIdx]);
+                    }
+                },
+                0,
+                SafeIntegerCast<int>(FloatFeaturesQuantileSketches.size()),
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+
+            // to avoid adding the same block twice
+            Cursor = NotSet;
+        }
+
         void RollbackNextCursorToLastGroupStart() {
             const auto& groupIds = *Data.CommonObjectsData.GroupIds;
             if (ObjectCount == 0) {
@@ -451,6 +554,17 @@ namespace NCB {
                 }
             }
 
+            // existing data is preserved
+            void Resize(ui32 objectCount) {
+                for (auto perTypeFeatureIdx : xrange(Storage.size())) {
+                    if (IsAvailable[perTypeFeatureIdx]) {
+                        auto& data = Storage[perTypeFeatureIdx]->Data;
+                        ResizeExactly(objectCount, &data);
+                        DstView[perTypeFeatureIdx] = data;
+                    }
+                }
+            }
+
             void Set(TFeatureIdx<FeatureType> perTypeFeatureIdx, ui32 objectIdx, T value) {
                 if (IsAvailable[*perTypeFeatureIdx]) {
                     DstView[*perTypeFeatureIdx][objectIdx] = value;
@@ -498,6 +612,8 @@ namespace NCB {
     private:
         bool InBlock;
 
+        // see IRawObjectsOrderDataVisitor::UNKNOWN_OBJECT_COUNT, ObjectCount is the allocated size in this case
+        bool ObjectCountIsUnknown;
         ui32 ObjectCount;
         ui32 CatFeatureCount;
 
@@ -510,6 +626,9 @@ namespace NCB {
         TFeaturesStorage<EFeatureType::Float, float> FloatFeaturesStorage;
         TFeaturesStorage<EFeatureType::Categorical, ui32> CatFeaturesStorage;
 
+        // will be moved to Data.ObjectsData at GetResult, empty if not built
+        TVector<TMaybe<NSplitSelection::TQuantileSketch>> FloatFeaturesQuantileSketches;
+
         std::array<THashPart, CB_THREAD_LIMIT> HashMapParts;
 
 
@@ -599,6 +718,20 @@ namespace NCB {
             );
         }
 
+        void AddSparseFloatFeature(ui32 flatFeatureIdx, TSparseArray<float, ui32>&& features) override {
+            CheckDataSize(features.GetSize(), ObjectCount, "sparse float feature size");
+            auto floatFeatureIdx = GetInternalFeatureIdx<EFeatureType::Float>(flatFeatureIdx);
+            auto& sparseFloatFeatures = Data.ObjectsData.SparseFloatFeatures;
+            if (sparseFloatFeatures.empty()) {
+                sparseFloatFeatures.resize(Data.ObjectsData.FloatFeatures.size());
+            }
+            sparseFloatFeatures[*floatFeatureIdx] = MakeHolder<TSparseFloatValuesHolder>(
+                flatFeatureIdx,
+                MakeAtomicShared<TSparseArray<float, ui32>>(std::move(features)),
+                Data.CommonObjectsData.SubsetIndexing.Get()
+            );
+        }
+
         void AddCatFeature(ui32 flatFeatureIdx, TConstArrayRef<TString> feature) override {
             AddCatFeatureImpl(flatFeatureIdx, feature);
         }
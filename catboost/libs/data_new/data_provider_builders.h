@@ -30,6 +30,12 @@ namespace NCB {
         bool CpuCompatibleFormat = true;
         bool GpuCompatibleFormat = true;
         bool SkipCheck = false; // to increase speed, esp. when applying
+
+        /* accumulate TRawObjectsData::FloatFeaturesQuantileSketches block by block while loading
+         * so EBorderSelectionType::QuantileSketch borders are ready when loading finishes.
+         * Supported only by raw objects order builder when not in block processing mode.
+         */
+        bool BuildFloatFeaturesQuantileSketches = false;
     };
 
     // can return nullptr if IDataProviderBuilder for such visitor type hasn't been implemented yet
@@ -0,0 +1,243 @@
+#include "exclusive_feature_bundling.h"
+
+#include <catboost/libs/helpers/compression.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/bitmap.h>
+#include <util/generic/cast.h>
+#include <util/generic/maybe.h>
+#include <util/generic/xrange.h>
+
+#include <array>
+
+
+namespace NCB {
+
+    // bundle bins are stored as ui8
+    static constexpr ui32 MAX_BUNDLE_BIN_COUNT = 256;
+
+    // bundles checked for conflicts with each candidate, a new bundle is created if none of them fits
+    static constexpr ui32 MAX_SEARCHED_BUNDLE_COUNT = 100;
+
+
+    namespace {
+        struct TBundlingCandidate {
+            ui32 FloatFeatureIdx = 0;
+            ui8 DefaultBin = 0;
+            ui32 NonDefaultCount = 0;
+        };
+    }
+
+
+    // f is called with (objectIdx, bin) for bins different from defaultBin
+    template <class F>
+    static void ForEachNonDefaultBin(const IQuantizedFloatValuesHolder& feature, ui8 defaultBin, F&& f) {
+        if (const auto* sparseFeature = dynamic_cast<const TSparseQuantizedFloatValuesHolder*>(&feature)) {
+            const auto& srcData = sparseFeature->GetSrcData();
+            Y_ASSERT(srcData.GetDefaultValue() == defaultBin);
+            srcData.ForEachNonDefault(f);
+        } else {
+            dynamic_cast<const TQuantizedFloatValuesHolder&>(feature).GetArrayData().ForEach(
+                [&] (ui32 objectIdx, ui8 bin) {
+                    if (bin != defaultBin) {
+                        f(objectIdx, bin);
+                    }
+                }
+            );
+        }
+    }
+
+
+    // both arrays are sorted
+    static bool HaveCommonElements(TConstArrayRef<ui32> lhs, TConstArrayRef<ui32> rhs) {
+        auto lhsIt = lhs.begin();
+        auto rhsIt = rhs.begin();
+        while ((lhsIt != lhs.end()) && (rhsIt != rhs.end())) {
+            if (*lhsIt < *rhsIt) {
+                ++lhsIt;
+            } else if (*rhsIt < *lhsIt) {
+                ++rhsIt;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    // the most frequent bin is selected as default
+    static TBundlingCandidate GetBundlingCandidate(
+        ui32 floatFeatureIdx,
+        const IQuantizedFloatValuesHolder& feature
+    ) {
+        TBundlingCandidate result;
+        result.FloatFeatureIdx = floatFeatureIdx;
+
+        if (const auto* sparseFeature = dynamic_cast<const TSparseQuantizedFloatValuesHolder*>(&feature)) {
+            result.DefaultBin = sparseFeature->GetSrcData().GetDefaultValue();
+            result.NonDefaultCount = sparseFeature->GetSrcData().GetNonDefaultSize();
+        } else {
+            std::array<ui32, 256> binCounts;
+            binCounts.fill(0);
+            dynamic_cast<const TQuantizedFloatValuesHolder&>(feature).GetArrayData().ForEach(
+                [&] (ui32 /*objectIdx*/, ui8 bin) { ++binCounts[bin]; }
+            );
+            result.DefaultBin = (ui8)(MaxElement(binCounts.begin(), binCounts.end()) - binCounts.begin());
+            result.NonDefaultCount = feature.GetSize() - binCounts[result.DefaultBin];
+        }
+        return result;
+    }
+
+
+    TVector<TExclusiveFeaturesBundle> CreateExclusiveFeaturesBundles(
+        TConstArrayRef<THolder<IQuantizedFloatValuesHolder>> floatFeatures,
+        TConstArrayRef<ui32> binCounts,
+        ui32 objectCount,
+        NPar::TLocalExecutor* localExecutor
+    ) {
+        CB_ENSURE_INTERNAL(
+            floatFeatures.size() == binCounts.size(),
+            "CreateExclusiveFeaturesBundles: floatFeatures and binCounts have different sizes"
+        );
+
+        TVector<TMaybe<TBundlingCandidate>> perFeatureCandidates(floatFeatures.size());
+        localExecutor->ExecRangeWithThrow(
+            [&] (int floatFeatureIdx) {
+                if (floatFeatures[floatFeatureIdx] && (binCounts[floatFeatureIdx] > 1)) {
+                    perFeatureCandidates[floatFeatureIdx]
+                        = GetBundlingCandidate(floatFeatureIdx, *floatFeatures[floatFeatureIdx]);
+                }
+            },
+            0,
+            SafeIntegerCast<int>(floatFeatures.size()),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+
+        // features with non-default bins for the most of objects have little chance to be bundled
+        TVector<TBundlingCandidate> candidates;
+        for (const auto& candidate : perFeatureCandidates) {
+            if (candidate && (2 * (ui64)candidate->NonDefaultCount <= objectCount)) {
+                candidates.push_back(*candidate);
+            }
+        }
+        StableSort(
+            candidates,
+            [] (const TBundlingCandidate& lhs, const TBundlingCandidate& rhs) {
+                return lhs.NonDefaultCount > rhs.NonDefaultCount;
+            }
+        );
+
+        TVector<TExclusiveFeaturesBundle> bundles;
+
+        /* objects with non-default bins of bundles, [bundleIdx]
+         * single part bundles keep a sorted list (most bundles never get a second part),
+         * it is replaced by a bitmap when the second feature joins the bundle
+         */
+        TVector<TVector<ui32>> bundlesNonDefaultObjects;
+        TVector<TDynBitMap> bundlesUsedObjects;
+
+        TVector<ui32> nonDefaultObjects; // increasing
+        for (const auto& candidate : candidates) {
+            nonDefaultObjects.clear();
+            ForEachNonDefaultBin(
+                *floatFeatures[candidate.FloatFeatureIdx],
+                candidate.DefaultBin,
+                [&] (ui32 objectIdx, ui8 /*bin*/) { nonDefaultObjects.push_back(objectIdx); }
+            );
+
+            const ui32 binCount = binCounts[candidate.FloatFeatureIdx];
+
+            TMaybe<size_t> compatibleBundleIdx;
+            ui32 searchedBundleCount = 0;
+            for (size_t bundleIdx = 0;
+                 (bundleIdx < bundles.size()) && (searchedBundleCount < MAX_SEARCHED_BUNDLE_COUNT);
+                 ++bundleIdx)
+            {
+                const auto& bundle = bundles[bundleIdx];
+                if (bundle.GetBinCount() + binCount - 1 > MAX_BUNDLE_BIN_COUNT) {
+                    continue;
+                }
+                ++searchedBundleCount;
+                bool isCompatible;
+                if (bundle.Parts.size() == 1) {
+                    isCompatible = !HaveCommonElements(bundlesNonDefaultObjects[bundleIdx], nonDefaultObjects);
+                } else {
+                    const auto& usedObjects = bundlesUsedObjects[bundleIdx];
+                    isCompatible = AllOf(nonDefaultObjects, [&] (ui32 objectIdx) { return !usedObjects.Get(objectIdx); });
+                }
+                if (isCompatible) {
+                    compatibleBundleIdx = bundleIdx;
+                    break;
+                }
+            }
+            if (!compatibleBundleIdx) {
+                compatibleBundleIdx = bundles.size();
+                bundles.emplace_back();
+                bundlesNonDefaultObjects.emplace_back();
+                bundlesUsedObjects.emplace_back();
+            }
+            const size_t bundleIdx = *compatibleBundleIdx;
+
+            auto& bundle = bundles[bundleIdx];
+            if (bundle.Parts.empty()) {
+                bundlesNonDefaultObjects[bundleIdx] = nonDefaultObjects;
+            } else {
+                auto& usedObjects = bundlesUsedObjects[bundleIdx];
+                if (bundle.Parts.size() == 1) {
+                    usedObjects.Reserve(objectCount);
+                    for (auto objectIdx : bundlesNonDefaultObjects[bundleIdx]) {
+                        usedObjects.Set(objectIdx);
+                    }
+                    TVector<ui32>().swap(bundlesNonDefaultObjects[bundleIdx]);
+                }
+                for (auto objectIdx : nonDefaultObjects) {
+                    usedObjects.Set(objectIdx);
+                }
+            }
+            bundle.Add(candidate.FloatFeatureIdx, binCount, candidate.DefaultBin);
+        }
+
+        EraseIf(bundles, [] (const TExclusiveFeaturesBundle& bundle) { return bundle.Parts.size() < 2; });
+
+        return bundles;
+    }
+
+
+    THolder<IQuantizedFloatValuesHolder> CreateExclusiveFeaturesBundleColumn(
+        const TExclusiveFeaturesBundle& bundle,
+        TConstArrayRef<THolder<IQuantizedFloatValuesHolder>> floatFeatures,
+        const TFeaturesArraySubsetIndexing* subsetIndexing
+    ) {
+        CB_ENSURE_INTERNAL(!bundle.Parts.empty(), "Empty exclusive features bundle");
+
+        const ui32 objectCount = subsetIndexing->Size();
+
+        const ui32 bitsPerKey = 8;
+        TIndexHelper<ui64> indexHelper(bitsPerKey);
+        TVector<ui64> storage(indexHelper.CompressedSize(objectCount), 0);
+        ui8* bundleBins = reinterpret_cast<ui8*>(storage.data());
+
+        for (const auto& part : bundle.Parts) {
+            ForEachNonDefaultBin(
+                *floatFeatures[part.FloatFeatureIdx],
+                part.DefaultBin,
+                [&] (ui32 objectIdx, ui8 bin) {
+                    Y_ASSERT(bundleBins[objectIdx] == 0);
+                    bundleBins[objectIdx] = (ui8)part.GetBundleBin(bin);
+                }
+            );
+        }
+
+        // bundle column has the id of the first feature in the bundle
+        return MakeHolder<TQuantizedFloatValuesHolder>(
+            floatFeatures[bundle.Parts[0].FloatFeatureIdx]->GetId(),
+            TCompressedArray(
+                objectCount,
+                bitsPerKey,
+                TMaybeOwningArrayHolder<ui64>::CreateOwning(std::move(storage))
+            ),
+            subsetIndexing
+        );
+    }
+}
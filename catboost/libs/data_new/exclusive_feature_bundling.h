@@ -0,0 +1,88 @@
+#pragma once
+
+#include "columns.h"
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/ptr.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+#include <util/system/yassert.h>
+
+#include <tuple>
+
+
+namespace NCB {
+
+    struct TExclusiveBundlePart {
+        ui32 FloatFeatureIdx = 0;
+        ui32 BinCount = 0; // feature's own bin count
+        ui8 DefaultBin = 0;
+
+        // bundle bin of the first non-default bin of the feature
+        ui32 BundleBinOffset = 0;
+
+    public:
+        bool operator==(const TExclusiveBundlePart& rhs) const {
+            return std::tie(FloatFeatureIdx, BinCount, DefaultBin, BundleBinOffset)
+                == std::tie(rhs.FloatFeatureIdx, rhs.BinCount, rhs.DefaultBin, rhs.BundleBinOffset);
+        }
+
+        // bin must be non-default
+        ui32 GetBundleBin(ui8 bin) const {
+            Y_ASSERT(bin != DefaultBin);
+            return BundleBinOffset + bin - (bin > DefaultBin ? 1 : 0);
+        }
+
+        // bundleBin must be in [BundleBinOffset, BundleBinOffset + BinCount - 1)
+        ui8 GetFeatureBin(ui32 bundleBin) const {
+            Y_ASSERT((bundleBin >= BundleBinOffset) && (bundleBin < BundleBinOffset + BinCount - 1));
+            const ui32 bin = bundleBin - BundleBinOffset;
+            return (ui8)(bin < DefaultBin ? bin : bin + 1);
+        }
+    };
+
+
+    /* Float features where at most one feature has a non-default bin for each object.
+     * Bundle bin 0 means that all features have default bins, non-default bins of parts follow it
+     * sequentially, so the bundle can be stored and scored as a single ui8 column.
+     */
+    struct TExclusiveFeaturesBundle {
+        TVector<TExclusiveBundlePart> Parts;
+
+    public:
+        bool operator==(const TExclusiveFeaturesBundle& rhs) const {
+            return Parts == rhs.Parts;
+        }
+
+        ui32 GetBinCount() const {
+            return Parts.empty() ? 1 : (Parts.back().BundleBinOffset + Parts.back().BinCount - 1);
+        }
+
+        void Add(ui32 floatFeatureIdx, ui32 binCount, ui8 defaultBin) {
+            Parts.push_back(TExclusiveBundlePart{floatFeatureIdx, binCount, defaultBin, GetBinCount()});
+        }
+    };
+
+
+    /* Greedily merges quantized float features that do not have non-default bins for the same objects.
+     * Each feature is checked against a limited number of existing bundles (as in LightGBM's EFB),
+     * it starts a new bundle if none of them fits.
+     * floatFeatures must not have subset indexing (as after quantization), nullptr features are skipped.
+     * binCounts are [floatFeatureIdx].
+     * Only bundles with more than one feature are returned.
+     */
+    TVector<TExclusiveFeaturesBundle> CreateExclusiveFeaturesBundles(
+        TConstArrayRef<THolder<IQuantizedFloatValuesHolder>> floatFeatures,
+        TConstArrayRef<ui32> binCounts,
+        ui32 objectCount,
+        NPar::TLocalExecutor* localExecutor
+    );
+
+    THolder<IQuantizedFloatValuesHolder> CreateExclusiveFeaturesBundleColumn(
+        const TExclusiveFeaturesBundle& bundle,
+        TConstArrayRef<THolder<IQuantizedFloatValuesHolder>> floatFeatures,
+        const TFeaturesArraySubsetIndexing* subsetIndexing
+    );
+}
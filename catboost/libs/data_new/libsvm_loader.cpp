@@ -0,0 +1,183 @@
+#include "libsvm_loader.h"
+
+#include <catboost/libs/column_description/column.h>
+#include <catboost/libs/data_util/exists_checker.h>
+
+#include <library/object_factory/object_factory.h>
+
+#include <util/generic/strbuf.h>
+#include <util/generic/xrange.h>
+#include <util/string/cast.h>
+#include <util/string/iterator.h>
+
+
+namespace NCB {
+
+    static const TStringBuf GROUP_ID_PREFIX = "qid:";
+
+
+    // returns (1-based) feature index
+    static ui32 ParseFeatureIdxAndValue(TStringBuf token, float* value) {
+        TStringBuf featureIdxPart;
+        TStringBuf valuePart;
+        CB_ENSURE(token.TrySplit(':', featureIdxPart, valuePart), "Bad feature token: " << token);
+
+        ui32 featureIdx = 0;
+        CB_ENSURE(
+            TryFromString(featureIdxPart, featureIdx) && (featureIdx > 0),
+            "Bad feature index: " << featureIdxPart << " (must be a positive integer)"
+        );
+        CB_ENSURE(
+            TryParseFloatFeatureValue(valuePart, value),
+            "Bad feature value: " << valuePart
+        );
+        return featureIdx;
+    }
+
+    // iterates over tokens, calls groupIdFunc(TStringBuf) and featureFunc(featureIdx, value) if needed
+    template <class TGroupIdFunc, class TFeatureFunc>
+    static TStringBuf ParseLine(TStringBuf line, TGroupIdFunc&& groupIdFunc, TFeatureFunc&& featureFunc) {
+        TStringBuf label;
+        ui32 prevFeatureIdx = 0;
+        for (auto it : StringSplitter(line).SplitBySet(" \t").SkipEmpty()) {
+            const TStringBuf token = it.Token();
+            if (!label) {
+                label = token;
+            } else if (token.StartsWith(GROUP_ID_PREFIX)) {
+                CB_ENSURE(prevFeatureIdx == 0, "Group id must precede features");
+                groupIdFunc(token.SubStr(GROUP_ID_PREFIX.size()));
+            } else {
+                float value;
+                const ui32 featureIdx = ParseFeatureIdxAndValue(token, &value);
+                CB_ENSURE(featureIdx > prevFeatureIdx, "Feature indices must be increasing");
+                featureFunc(featureIdx, value);
+                prevFeatureIdx = featureIdx;
+            }
+        }
+        CB_ENSURE(label, "Empty line");
+        return label;
+    }
+
+
+    TLibSvmDataLoader::TLibSvmDataLoader(TDatasetLoaderPullArgs&& args)
+        : Args(std::move(args.CommonArgs))
+    {
+        CB_ENSURE(!Args.PairsFilePath.Inited() || CheckExists(Args.PairsFilePath),
+                  "TLibSvmDataLoader:PairsFilePath does not exist");
+        CB_ENSURE(!Args.GroupWeightsFilePath.Inited() || CheckExists(Args.GroupWeightsFilePath),
+                  "TLibSvmDataLoader:GroupWeightsFilePath does not exist");
+        CB_ENSURE(
+            !Args.CdProvider->Inited(),
+            "TLibSvmDataLoader: columns description is not supported for libsvm format"
+        );
+
+        // the number of features is not known until all the data is seen, so ignored features are skipped
+        // while reading by this mask and FeatureIgnored is inited afterwards
+        TVector<bool> skipFeature;
+        for (auto flatFeatureIdx : Args.IgnoredFeatures) {
+            if (flatFeatureIdx >= skipFeature.size()) {
+                skipFeature.resize(flatFeatureIdx + 1, false);
+            }
+            skipFeature[flatFeatureIdx] = true;
+        }
+
+        THolder<ILineDataReader> lineDataReader = GetLineDataReader(args.PoolPath, Args.PoolFormat);
+
+        bool hasGroupIds = false;
+        TString line;
+        for (; lineDataReader->ReadLine(&line); ++ObjectCount) {
+            try {
+                bool lineHasGroupId = false;
+                const TStringBuf label = ParseLine(
+                    line,
+                    [&] (TStringBuf groupId) {
+                        lineHasGroupId = true;
+                        GroupIds.push_back(CalcGroupIdFor(groupId));
+                    },
+                    [&] (ui32 featureIdx, float value) {
+                        // all features are numeric so flat and float feature indices are the same
+                        const ui32 flatFeatureIdx = featureIdx - 1;
+                        if (flatFeatureIdx >= Features.size()) {
+                            Features.resize(flatFeatureIdx + 1);
+                        }
+                        // zeros are default values, explicitly specified ones are not stored
+                        if ((value != 0.0f)
+                            && ((flatFeatureIdx >= skipFeature.size()) || !skipFeature[flatFeatureIdx]))
+                        {
+                            Features[flatFeatureIdx].Indices.push_back(ObjectCount);
+                            Features[flatFeatureIdx].Values.push_back(value);
+                        }
+                    }
+                );
+                CB_ENSURE(
+                    (ObjectCount == 0) || (lineHasGroupId == hasGroupIds),
+                    "Group ids must be specified either for all or for none of the lines"
+                );
+                hasGroupIds = lineHasGroupId;
+                Labels.push_back(TString(label));
+            } catch (const TCatBoostException& e) {
+                throw TCatBoostException() << "Incorrect libsvm data. Invalid line number #"
+                    << ObjectCount << ": " << e.what();
+            }
+        }
+        CB_ENSURE(ObjectCount, "TLibSvmDataLoader: no data rows in pool");
+        CB_ENSURE(!Features.empty(), "TLibSvmDataLoader: no features in pool");
+
+        TVector<TColumn> columns;
+        columns.push_back(TColumn{EColumn::Label, TString()});
+        if (hasGroupIds) {
+            columns.push_back(TColumn{EColumn::GroupId, TString()});
+        }
+        columns.resize(columns.size() + Features.size(), TColumn{EColumn::Num, TString()});
+
+        auto columnsDescription = TDataColumnsMetaInfo{std::move(columns)};
+        auto featureIds = columnsDescription.GenerateFeatureIds(Nothing());
+
+        DataMetaInfo = TDataMetaInfo(
+            std::move(columnsDescription),
+            Args.GroupWeightsFilePath.Inited(),
+            Args.PairsFilePath.Inited(),
+            &featureIds
+        );
+
+        ProcessIgnoredFeaturesList(Args.IgnoredFeatures, &DataMetaInfo, &FeatureIgnored);
+    }
+
+
+    void TLibSvmDataLoader::Do(IRawFeaturesOrderDataVisitor* visitor) {
+        visitor->Start(DataMetaInfo, ObjectCount, Args.ObjectsOrder, {});
+
+        for (auto objectIdx : xrange(GroupIds.size())) {
+            visitor->AddGroupId(objectIdx, GroupIds[objectIdx]);
+        }
+        GroupIds = TVector<TGroupId>();
+
+        for (auto flatFeatureIdx : xrange(Features.size())) {
+            if (FeatureIgnored[flatFeatureIdx]) {
+                continue;
+            }
+            auto& feature = Features[flatFeatureIdx];
+            visitor->AddSparseFloatFeature(
+                flatFeatureIdx,
+                TSparseArray<float, ui32>(
+                    ObjectCount,
+                    std::move(feature.Indices),
+                    std::move(feature.Values),
+                    0.0f
+                )
+            );
+        }
+        Features = TVector<TSparseColumn>();
+
+        visitor->AddTarget(Labels);
+        Labels = TVector<TString>();
+
+        SetGroupWeights(Args.GroupWeightsFilePath, ObjectCount, visitor);
+        SetPairs(Args.PairsFilePath, ObjectCount, visitor);
+        visitor->Finish();
+    }
+
+    namespace {
+        TDatasetLoaderFactory::TRegistrator<TLibSvmDataLoader> LibSvmDataLoaderReg("libsvm");
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "loader.h"
+
+#include <catboost/libs/data_types/groupid.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+namespace NCB {
+
+    /* libsvm format: each line is
+     *   <label> [qid:<groupId>] <featureIdx>:<value> <featureIdx>:<value> ...
+     * feature indices are 1-based and increasing, missing features are equal to 0
+     *
+     * The data is read in one pass in the constructor (so standard input is supported as well),
+     * only the specified feature values are stored and passed to the visitor as sparse columns.
+     */
+    class TLibSvmDataLoader : public IRawFeaturesOrderDatasetLoader {
+    public:
+        explicit TLibSvmDataLoader(TDatasetLoaderPullArgs&& args);
+
+        void Do(IRawFeaturesOrderDataVisitor* visitor) override;
+
+    private:
+        struct TSparseColumn {
+            TVector<ui32> Indices; // objectIdx, increasing
+            TVector<float> Values;
+        };
+
+    private:
+        TDatasetLoaderCommonArgs Args;
+        ui32 ObjectCount = 0;
+        TDataMetaInfo DataMetaInfo;
+        TVector<bool> FeatureIgnored; // [flatFeatureIdx]
+
+        TVector<TString> Labels; // [objectIdx]
+        TVector<TGroupId> GroupIds; // [objectIdx], empty if there're no group ids in data
+        TVector<TSparseColumn> Features; // [flatFeatureIdx], empty for ignored features
+    };
+
+}
@@ -20,7 +20,8 @@ namespace NCB {
         const NCatboostOptions::TDsvPoolFormatParams& dsvPoolFormatParams,
         const TVector<ui32>& ignoredFeatures,
         EObjectsOrder objectsOrder,
-        NPar::TLocalExecutor* localExecutor
+        NPar::TLocalExecutor* localExecutor,
+        const TDataProviderBuilderOptions& builderOptions
     ) {
         auto datasetLoader = GetProcessor<IDatasetLoader>(
             poolPath, // for choosing processor
@@ -44,7 +45,7 @@ namespace NCB {
 
         THolder<IDataProviderBuilder> dataProviderBuilder = CreateDataProviderBuilder(
             datasetLoader->GetVisitorType(),
-            TDataProviderBuilderOptions{},
+            builderOptions,
             localExecutor
         );
         CB_ENSURE_INTERNAL(
@@ -130,6 +131,7 @@ namespace NCB {
         const NCatboostOptions::TPoolLoadParams& loadOptions,
         EObjectsOrder objectsOrder,
         bool readTestData,
+        const TDataProviderBuilderOptions& learnDataBuilderOptions,
         NPar::TLocalExecutor* const executor,
         TProfileInfo* const profile
     ) {
@@ -147,7 +149,8 @@ namespace NCB {
                 loadOptions.DsvPoolFormatParams,
                 loadOptions.IgnoredFeatures,
                 objectsOrder,
-                executor
+                executor,
+                learnDataBuilderOptions
             );
             CATBOOST_DEBUG_LOG << "Loading features time: " << (Now() - start).Seconds() << Endl;
             if (profile) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "data_provider.h"
+#include "data_provider_builders.h"
 #include "objects.h"
 
 #include <catboost/libs/column_description/column.h>
@@ -26,7 +27,8 @@ namespace NCB {
         const NCatboostOptions::TDsvPoolFormatParams& dsvPoolFormatParams,
         const TVector<ui32>& ignoredFeatures,
         EObjectsOrder objectsOrder,
-        NPar::TLocalExecutor* localExecutor
+        NPar::TLocalExecutor* localExecutor,
+        const TDataProviderBuilderOptions& builderOptions = TDataProviderBuilderOptions()
     );
 
     // for use from context where there's no localExecutor and proper logging handling is unimplemented
@@ -57,6 +59,7 @@ namespace NCB {
         const NCatboostOptions::TPoolLoadParams& loadOptions,
         EObjectsOrder objectsOrder,
         bool readTestData,
+        const TDataProviderBuilderOptions& learnDataBuilderOptions,
         NPar::TLocalExecutor* executor,
         TProfileInfo* profile
     );
@@ -350,8 +350,21 @@ static bool AreFeaturesValuesEqual(
 }
 
 
+static bool AreSparseFloatFeaturesEqual(
+    const TVector<THolder<TSparseFloatValuesHolder>>& lhs,
+    const TVector<THolder<TSparseFloatValuesHolder>>& rhs,
+    size_t floatFeatureCount
+) {
+    if (lhs.empty() || rhs.empty()) {
+        auto isNull = [] (const THolder<TSparseFloatValuesHolder>& feature) { return !feature; };
+        return AllOf(lhs, isNull) && AllOf(rhs, isNull);
+    }
+    return (lhs.size() == floatFeatureCount) && AreFeaturesValuesEqual(lhs, rhs);
+}
+
 bool NCB::TRawObjectsData::operator==(const NCB::TRawObjectsData& rhs) const {
     return AreFeaturesValuesEqual(FloatFeatures, rhs.FloatFeatures) &&
+        AreSparseFloatFeaturesEqual(SparseFloatFeatures, rhs.SparseFloatFeatures, FloatFeatures.size()) &&
         AreFeaturesValuesEqual(CatFeatures, rhs.CatFeatures);
 }
 
@@ -363,18 +376,25 @@ void NCB::TRawObjectsData::PrepareForInitialization(const TDataMetaInfo& metaInf
     CatFeatures.clear();
     const size_t catFeatureCount = (size_t)metaInfo.FeaturesLayout->GetCatFeatureCount();
     CatFeatures.resize(catFeatureCount);
+
+    // resized by builders that add sparse features
+    SparseFloatFeatures.clear();
+
+    FloatFeaturesQuantileSketches.clear();
 }
 
 
-template <class TFeaturesColumn>
+// getFeatureFunc(featureIdx) returns const IFeatureValuesHolder*
+template <class TGetFeatureFunc>
 static void CheckDataSizes(
     ui32 objectCount,
     const TFeaturesLayout& featuresLayout,
     const EFeatureType featureType,
-    const TVector<THolder<TFeaturesColumn>>& featuresData
+    size_t featureCount,
+    TGetFeatureFunc&& getFeatureFunc
 ) {
     CheckDataSize(
-        featuresData.size(),
+        featureCount,
         (size_t)featuresLayout.GetFeatureCount(featureType),
         TStringBuilder() << "ObjectDataProvider's " << featureType << " features",
         false,
@@ -382,11 +402,11 @@ static void CheckDataSizes(
         true
     );
 
-    for (auto featureIdx : xrange(featuresData.size())) {
+    for (auto featureIdx : xrange(featureCount)) {
         TString dataDescription =
             TStringBuilder() << "ObjectDataProvider's " << featureType << " feature #" << featureIdx;
 
-        auto dataPtr = featuresData[featureIdx].Get();
+        const IFeatureValuesHolder* dataPtr = getFeatureFunc(featureIdx);
         bool isAvailable = featuresLayout.GetInternalFeatureMetaInfo(featureIdx, featureType).IsAvailable;
         if (isAvailable) {
             CB_ENSURE_INTERNAL(
@@ -405,6 +425,22 @@ static void CheckDataSizes(
     }
 }
 
+template <class TFeaturesColumn>
+static void CheckDataSizes(
+    ui32 objectCount,
+    const TFeaturesLayout& featuresLayout,
+    const EFeatureType featureType,
+    const TVector<THolder<TFeaturesColumn>>& featuresData
+) {
+    CheckDataSizes(
+        objectCount,
+        featuresLayout,
+        featureType,
+        featuresData.size(),
+        [&] (size_t featureIdx) -> const IFeatureValuesHolder* { return featuresData[featureIdx].Get(); }
+    );
+}
+
 
 void NCB::TRawObjectsData::Check(
     ui32 objectCount,
@@ -412,7 +448,60 @@ void NCB::TRawObjectsData::Check(
     const TVector<THashMap<ui32, TString>>* catFeaturesHashToString,
     NPar::TLocalExecutor* localExecutor
 ) const {
-    CheckDataSizes(objectCount, featuresLayout, EFeatureType::Float, FloatFeatures);
+    if (SparseFloatFeatures.empty()) {
+        CheckDataSizes(objectCount, featuresLayout, EFeatureType::Float, FloatFeatures);
+    } else {
+        CheckDataSize(
+            SparseFloatFeatures.size(),
+            FloatFeatures.size(),
+            "SparseFloatFeatures",
+            /*dataCanBeEmpty*/ false,
+            "FloatFeatures size",
+            /*internalCheck*/ true
+        );
+        CheckDataSizes(
+            objectCount,
+            featuresLayout,
+            EFeatureType::Float,
+            FloatFeatures.size(),
+            [&] (size_t floatFeatureIdx) -> const IFeatureValuesHolder* {
+                CB_ENSURE_INTERNAL(
+                    !FloatFeatures[floatFeatureIdx] || !SparseFloatFeatures[floatFeatureIdx],
+                    "Float feature #" << floatFeatureIdx << " is stored both densely and sparsely"
+                );
+                if (SparseFloatFeatures[floatFeatureIdx]) {
+                    return SparseFloatFeatures[floatFeatureIdx].Get();
+                }
+                return FloatFeatures[floatFeatureIdx].Get();
+            }
+        );
+    }
+
+    if (!FloatFeaturesQuantileSketches.empty()) {
+        CheckDataSize(
+            FloatFeaturesQuantileSketches.size(),
+            FloatFeatures.size(),
+            "FloatFeaturesQuantileSketches",
+            /*dataCanBeEmpty*/ false,
+            "FloatFeatures size",
+            /*internalCheck*/ true
+        );
+        for (auto floatFeatureIdx : xrange(FloatFeatures.size())) {
+            const auto& sketch = FloatFeaturesQuantileSketches[floatFeatureIdx];
+            if (sketch) {
+                CB_ENSURE_INTERNAL(
+                    FloatFeatures[floatFeatureIdx],
+                    "Quantile sketch is present for unavailable float feature #" << floatFeatureIdx
+                );
+                CB_ENSURE_INTERNAL(
+                    sketch->GetCount() + sketch->GetNanCount() == objectCount,
+                    "Quantile sketch for float feature #" << floatFeatureIdx << " has "
+                    << (sketch->GetCount() + sketch->GetNanCount()) << " values, but object count is "
+                    << objectCount
+                );
+            }
+        }
+    }
 
     if (CatFeatures.size()) {
         CheckDataSize(
@@ -499,6 +588,19 @@ TObjectsDataProviderPtr NCB::TRawObjectsDataProvider::GetSubset(
         &subsetData.CatFeatures
     );
 
+    // sparse source data is shared with the subset
+    for (const auto& sparseFeature : Data.SparseFloatFeatures) {
+        subsetData.SparseFloatFeatures.push_back(
+            sparseFeature ?
+                MakeHolder<TSparseFloatValuesHolder>(
+                    sparseFeature->GetId(),
+                    sparseFeature->GetSrcDataPtr(),
+                    subsetCommonData.SubsetIndexing.Get()
+                )
+                : nullptr
+        );
+    }
+
     return MakeIntrusive<TRawObjectsDataProvider>(
         objectsGroupingSubset.GetSubsetGrouping(),
         std::move(subsetCommonData),
@@ -556,8 +658,16 @@ TVector<float> NCB::TRawObjectsDataProvider::GetFeatureDataOldFormat(ui32 flatFe
     result.yresize(GetObjectCount());
 
     if (featureMetaInfo.Type == EFeatureType::Float) {
-        const auto& feature = **GetFloatFeature(featuresLayout.GetInternalFeatureIdx(flatFeatureIdx));
-        feature.GetArrayData().ForEach([&result](ui32 idx, float value) { result[idx] = value; });
+        const ui32 floatFeatureIdx = featuresLayout.GetInternalFeatureIdx(flatFeatureIdx);
+        if (auto sparseFeature = GetSparseFloatFeature(floatFeatureIdx)) {
+            const auto& srcData = (**sparseFeature).GetSrcData();
+            (**sparseFeature).GetSubsetIndexing()->ForEach(
+                [&] (ui32 idx, ui32 srcIdx) { result[idx] = srcData.GetValue(srcIdx); }
+            );
+        } else {
+            const auto& feature = **GetFloatFeature(floatFeatureIdx);
+            feature.GetArrayData().ForEach([&result](ui32 idx, float value) { result[idx] = value; });
+        }
     } else {
         const auto& feature = **GetCatFeature(featuresLayout.GetInternalFeatureIdx(flatFeatureIdx));
         feature.GetArrayData().ForEach(
@@ -574,7 +684,8 @@ TVector<float> NCB::TRawObjectsDataProvider::GetFeatureDataOldFormat(ui32 flatFe
 
 bool NCB::TQuantizedObjectsData::operator==(const NCB::TQuantizedObjectsData& rhs) const {
     return AreFeaturesValuesEqual(FloatFeatures, rhs.FloatFeatures) &&
-        AreFeaturesValuesEqual(CatFeatures, rhs.CatFeatures);
+        AreFeaturesValuesEqual(CatFeatures, rhs.CatFeatures) &&
+        AreFeaturesValuesEqual(ExclusiveFeaturesBundles, rhs.ExclusiveFeaturesBundles);
 }
 
 
@@ -590,6 +701,8 @@ void NCB::TQuantizedObjectsData::PrepareForInitialization(
     const ui32 catFeatureCount = metaInfo.FeaturesLayout->GetCatFeatureCount();
     CatFeatures.resize(catFeatureCount);
 
+    ExclusiveFeaturesBundles.clear();
+
     if (!QuantizedFeaturesInfo) {
         QuantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
             *metaInfo.FeaturesLayout,
@@ -618,6 +731,31 @@ void NCB::TQuantizedObjectsData::Check(
 
     CheckDataSizes(objectCount, featuresLayout, EFeatureType::Float, FloatFeatures);
     CheckDataSizes(objectCount, featuresLayout, EFeatureType::Categorical, CatFeatures);
+
+    if (!ExclusiveFeaturesBundles.empty()) {
+        CheckDataSize(
+            ExclusiveFeaturesBundles.size(),
+            QuantizedFeaturesInfo->GetExclusiveFeaturesBundles().size(),
+            "ExclusiveFeaturesBundles",
+            /*dataCanBeEmpty*/ false,
+            "QuantizedFeaturesInfo's exclusive features bundles",
+            /*internalCheck*/ true
+        );
+        for (auto bundleIdx : xrange(ExclusiveFeaturesBundles.size())) {
+            CB_ENSURE_INTERNAL(
+                ExclusiveFeaturesBundles[bundleIdx],
+                "ExclusiveFeaturesBundles[" << bundleIdx << "] is null"
+            );
+            CheckDataSize(
+                ExclusiveFeaturesBundles[bundleIdx]->GetSize(),
+                objectCount,
+                TStringBuilder() << "ExclusiveFeaturesBundles[" << bundleIdx << ']',
+                /*dataCanBeEmpty*/ false,
+                "object count",
+                /*internalCheck*/ true
+            );
+        }
+    }
 }
 
 
@@ -653,6 +791,11 @@ TQuantizedObjectsData NCB::TQuantizedObjectsData::GetSubset(
         subsetComposition,
         &subsetData.CatFeatures
     );
+    CreateSubsetFeatures(
+        ExclusiveFeaturesBundles,
+        subsetComposition,
+        &subsetData.ExclusiveFeaturesBundles
+    );
     subsetData.QuantizedFeaturesInfo = QuantizedFeaturesInfo;
 
     return subsetData;
@@ -864,6 +1007,43 @@ NCB::TQuantizedForCPUObjectsDataProvider::TQuantizedForCPUObjectsDataProvider(
 
 
 
+template <class IColumnType>
+static THolder<IColumnType> MakeConsecutiveCompressedValuesHolder(
+    const IColumnType& src,
+    ui32 objectCount,
+    const NCB::TFeaturesArraySubsetIndexing* newSubsetIndexing,
+    NPar::TLocalExecutor* localExecutor
+) {
+    constexpr ui32 bytesPerKey = sizeof(typename IColumnType::TValueType);
+    constexpr ui32 bitsPerKey = bytesPerKey*8;
+
+    TIndexHelper<ui64> indexHelper(bitsPerKey);
+
+    const auto& srcCompressedValuesHolder = dynamic_cast<const TCompressedValuesHolderImpl<IColumnType>&>(src);
+
+    TVector<ui64> storage;
+    storage.yresize(indexHelper.CompressedSize(objectCount));
+    auto dstBuffer = (typename IColumnType::TValueType*)(storage.data());
+
+    srcCompressedValuesHolder.GetArrayData().ParallelForEach(
+        [&] (ui32 idx, typename IColumnType::TValueType value) {
+            dstBuffer[idx] = value;
+        },
+        localExecutor
+    );
+
+    return MakeHolder<TCompressedValuesHolderImpl<IColumnType>>(
+        src.GetId(),
+        TCompressedArray(
+            objectCount,
+            bitsPerKey,
+            TMaybeOwningArrayHolder<ui64>::CreateOwning(std::move(storage))
+        ),
+        newSubsetIndexing
+    );
+}
+
+
 template <EFeatureType FeatureType, class IColumnType>
 static void MakeConsecutiveArrayFeatures(
     const TFeaturesLayout& featuresLayout,
@@ -873,12 +1053,6 @@ static void MakeConsecutiveArrayFeatures(
     NPar::TLocalExecutor* localExecutor,
     TVector<THolder<IColumnType>>* dst
 ) {
-    constexpr ui32 bytesPerKey = sizeof(typename IColumnType::TValueType);
-    constexpr ui32 bitsPerKey = bytesPerKey*8;
-
-    TIndexHelper<ui64> indexHelper(bitsPerKey);
-    const ui32 dstStorageSize = indexHelper.CompressedSize(objectCount);
-
     if (&src != dst) {
         dst->clear();
         dst->resize(featuresLayout.GetFeatureCount(FeatureType));
@@ -890,30 +1064,51 @@ static void MakeConsecutiveArrayFeatures(
         [&] (TFeatureIdx<FeatureType> featureIdx) {
             tasks.emplace_back(
                 [&, featureIdx]() {
-                    auto& srcCompressedValuesHolder = dynamic_cast<TCompressedValuesHolderImpl<IColumnType>&>(
-                        *(src[*featureIdx])
-                    );
-
-                    TVector<ui64> storage;
-                    storage.yresize(dstStorageSize);
-                    auto dstBuffer = (typename IColumnType::TValueType*)(storage.data());
-
-                    srcCompressedValuesHolder.GetArrayData().ParallelForEach(
-                        [&] (ui32 idx, typename IColumnType::TValueType value) {
-                            dstBuffer[idx] = value;
-                        },
+                    if constexpr (FeatureType == EFeatureType::Float) {
+                        if (auto* srcSparseValuesHolder = dynamic_cast<const TSparseQuantizedFloatValuesHolder*>(
+                                src[*featureIdx].Get()
+                            ))
+                        {
+                            const auto values = srcSparseValuesHolder->ExtractValues(localExecutor);
+                            (*dst)[*featureIdx] = MakeHolder<TSparseQuantizedFloatValuesHolder>(
+                                srcSparseValuesHolder->GetId(),
+                                MakeAtomicShared<TSparseQuantizedFloatValuesHolder::TSrcData>(
+                                    TSparseQuantizedFloatValuesHolder::TSrcData::CreateFromDense(
+                                        *values,
+                                        srcSparseValuesHolder->GetSrcData().GetDefaultValue()
+                                    )
+                                ),
+                                newSubsetIndexing
+                            );
+                            return;
+                        }
+                        if (auto* srcBlockCompressedValuesHolder
+                                = dynamic_cast<const TBlockCompressedQuantizedFloatValuesHolder*>(
+                                    src[*featureIdx].Get()
+                                ))
+                        {
+                            const auto& srcData = srcBlockCompressedValuesHolder->GetSrcData();
+                            const auto values = srcBlockCompressedValuesHolder->ExtractValues(localExecutor);
+                            (*dst)[*featureIdx] = MakeHolder<TBlockCompressedQuantizedFloatValuesHolder>(
+                                srcBlockCompressedValuesHolder->GetId(),
+                                MakeAtomicShared<TBlockCompressedQuantizedFloatValuesHolder::TSrcData>(
+                                    *values,
+                                    srcData.GetCodecName(),
+                                    srcData.GetBlockSize(),
+                                    localExecutor
+                                ),
+                                newSubsetIndexing
+                            );
+                            return;
+                        }
+                    }
+
+                    (*dst)[*featureIdx] = MakeConsecutiveCompressedValuesHolder(
+                        *(src[*featureIdx]),
+                        objectCount,
+                        newSubsetIndexing,
                         localExecutor
                     );
-
-                    (*dst)[*featureIdx] = MakeHolder<TCompressedValuesHolderImpl<IColumnType>>(
-                        src[*featureIdx]->GetId(),
-                        TCompressedArray(
-                            objectCount,
-                            bitsPerKey,
-                            TMaybeOwningArrayHolder<ui64>::CreateOwning(std::move(storage))
-                        ),
-                        newSubsetIndexing
-                    );
                 }
             );
         }
@@ -922,6 +1117,25 @@ static void MakeConsecutiveArrayFeatures(
     ExecuteTasksInParallel(&tasks, localExecutor);
 }
 
+TMaybeOwningConstArrayHolder<ui8> NCB::TQuantizedForCPUObjectsDataProvider::GetFloatFeatureSrcBins(
+    ui32 floatFeatureIdx,
+    NPar::TLocalExecutor* localExecutor
+) const {
+    if (auto sparseFeature = GetSparseFloatFeature(floatFeatureIdx)) {
+        return TMaybeOwningConstArrayHolder<ui8>::CreateOwning((*sparseFeature)->GetSrcData().ExtractValues());
+    }
+    if (auto blockCompressedFeature = GetBlockCompressedFloatFeature(floatFeatureIdx)) {
+        const auto& srcData = (*blockCompressedFeature)->GetSrcData();
+        auto buffer = MakeIntrusive<TPooledVectorHolder<ui8>>(DecompressedBinsBuffers, srcData.GetSize());
+        srcData.ExtractValues(buffer->Data, localExecutor);
+        return TMaybeOwningConstArrayHolder<ui8>::CreateOwning(buffer->Data, buffer);
+    }
+    return TMaybeOwningConstArrayHolder<ui8>::CreateNonOwning(
+        (*GetFloatFeature(floatFeatureIdx))->GetCompressedData().GetSrc()->GetRawArray<const ui8>()
+    );
+}
+
+
 void NCB::TQuantizedForCPUObjectsDataProvider::EnsureConsecutiveFeaturesData(
     NPar::TLocalExecutor* localExecutor
 ) {
@@ -949,6 +1163,14 @@ void NCB::TQuantizedForCPUObjectsDataProvider::EnsureConsecutiveFeaturesData(
         localExecutor,
         &Data.CatFeatures
     );
+    for (auto& bundle : Data.ExclusiveFeaturesBundles) {
+        bundle = MakeConsecutiveCompressedValuesHolder(
+            *bundle,
+            GetObjectCount(),
+            newSubsetIndexing.Get(),
+            localExecutor
+        );
+    }
 
     CommonData.SubsetIndexing = std::move(newSubsetIndexing);
 }
@@ -959,13 +1181,21 @@ static void CheckIsRequiredType(
     EFeatureType featureType,
     // not TConstArrayRef to allow template parameter deduction
     const TVector<THolder<TBaseFeatureColumn>>& data,
-    const TStringBuf requiredTypeName
+    const TStringBuf requiredTypeName,
+    bool allowSparse = false,
+    bool allowBlockCompressed = false
 ) {
     for (auto featureIdx : xrange(data.size())) {
         auto* dataPtr = data[featureIdx].Get();
         if (!dataPtr) {
             continue;
         }
+        if (allowSparse && dynamic_cast<const TSparseQuantizedFloatValuesHolder*>(dataPtr)) {
+            continue;
+        }
+        if (allowBlockCompressed && dynamic_cast<const TBlockCompressedQuantizedFloatValuesHolder*>(dataPtr)) {
+            continue;
+        }
 
         auto requiredTypePtr = dynamic_cast<TRequiredFeatureColumn*>(dataPtr);
         CB_ENSURE_INTERNAL(
@@ -983,13 +1213,25 @@ void NCB::TQuantizedForCPUObjectsDataProvider::Check() const {
         CheckIsRequiredType<TQuantizedFloatValuesHolder, ui8>(
             EFeatureType::Float,
             Data.FloatFeatures,
-            "TQuantizedFloatValuesHolder"
+            "TQuantizedFloatValuesHolder",
+            /*allowSparse*/ true,
+            /*allowBlockCompressed*/ true
         );
         CheckIsRequiredType<TQuantizedCatValuesHolder, ui32>(
             EFeatureType::Categorical,
             Data.CatFeatures,
             "TQuantizedCatValuesHolder"
         );
+        for (auto bundleIdx : xrange(Data.ExclusiveFeaturesBundles.size())) {
+            auto* bundlePtr = dynamic_cast<const TQuantizedFloatValuesHolder*>(
+                Data.ExclusiveFeaturesBundles[bundleIdx].Get()
+            );
+            CB_ENSURE_INTERNAL(
+                bundlePtr,
+                "Data.ExclusiveFeaturesBundles[" << bundleIdx << "] is not of type TQuantizedFloatValuesHolder"
+            );
+            bundlePtr->GetCompressedData().GetSrc()->CheckIfCanBeInterpretedAsRawArray<ui8>();
+        }
     } catch (const TCatBoostException& e) {
         // not ythrow to avoid double line info in exception message
         throw TCatBoostException() << "Incompatible with TQuantizedForCPUObjectsDataProvider: " << e.what();
@@ -17,6 +17,7 @@
 #include <catboost/libs/options/binarization_options.h>
 
 #include <library/binsaver/bin_saver.h>
+#include <library/grid_creator/quantile_sketch.h>
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/array_ref.h>
@@ -186,6 +187,20 @@ namespace NCB {
         TVector<THolder<TFloatValuesHolder>> FloatFeatures; // [floatFeatureIdx]
         TVector<THolder<THashedCatValuesHolder>> CatFeatures; // [catFeatureIdx]
 
+        /* float features stored sparsely, empty or [floatFeatureIdx],
+         * FloatFeatures[floatFeatureIdx] is nullptr for such features
+         */
+        TVector<THolder<TSparseFloatValuesHolder>> SparseFloatFeatures;
+
+        /* optional summaries of FloatFeatures values accumulated while loading
+         * (see TDataProviderBuilderOptions::BuildFloatFeaturesQuantileSketches),
+         * used instead of the feature values when borders are selected with
+         * EBorderSelectionType::QuantileSketch.
+         * empty or [floatFeatureIdx], Nothing() for unavailable features.
+         * Not copied to subsets and not compared in operator== as they are derived from FloatFeatures.
+         */
+        TVector<TMaybe<NSplitSelection::TQuantileSketch>> FloatFeaturesQuantileSketches;
+
     public:
         bool operator==(const TRawObjectsData& rhs) const;
 
@@ -251,11 +266,24 @@ namespace NCB {
 
         /* can return nullptr if this feature is unavailable
          * (ignored or this data provider contains only subset of features)
+         * or stored sparsely (see GetSparseFloatFeature)
          */
         TMaybeData<const TFloatValuesHolder*> GetFloatFeature(ui32 floatFeatureIdx) const {
             return MakeMaybeData<const TFloatValuesHolder>(Data.FloatFeatures[floatFeatureIdx]);
         }
 
+        bool IsSparseFloatFeature(ui32 floatFeatureIdx) const {
+            return GetSparseFloatFeature(floatFeatureIdx).Defined();
+        }
+
+        // returns Nothing() if the feature is unavailable or is stored densely
+        TMaybeData<const TSparseFloatValuesHolder*> GetSparseFloatFeature(ui32 floatFeatureIdx) const {
+            if (Data.SparseFloatFeatures.empty()) {
+                return Nothing();
+            }
+            return MakeMaybeData<const TSparseFloatValuesHolder>(Data.SparseFloatFeatures[floatFeatureIdx]);
+        }
+
         /* can return nullptr if this feature is unavailable
          * (ignored or this data provider contains only subset of features)
          */
@@ -292,6 +320,11 @@ namespace NCB {
         TVector<THolder<IQuantizedFloatValuesHolder>> FloatFeatures; // [floatFeatureIdx]
         TVector<THolder<IQuantizedCatValuesHolder>> CatFeatures; // [catFeatureIdx]
 
+        /* bundle bins (see TExclusiveFeaturesBundle), [bundleIdx] from QuantizedFeaturesInfo
+         * only present in the data bundles have been calculated on (learn), empty otherwise
+         */
+        TVector<THolder<IQuantizedFloatValuesHolder>> ExclusiveFeaturesBundles;
+
         TQuantizedFeaturesInfoPtr QuantizedFeaturesInfo;
 
     public:
@@ -456,8 +489,12 @@ namespace NCB {
         /* overrides base class implementation with more restricted type
          * (more efficient for CPU score calculation)
          * features guaranteed to be stored as an array of ui8
+         * must not be called for sparse and block compressed features
+         * (see GetSparseFloatFeature, GetBlockCompressedFloatFeature)
          */
         TMaybeData<const TQuantizedFloatValuesHolder*> GetFloatFeature(ui32 floatFeatureIdx) const {
+            Y_ASSERT(!IsSparseFloatFeature(floatFeatureIdx));
+            Y_ASSERT(!GetBlockCompressedFloatFeature(floatFeatureIdx));
             return MakeMaybeData(
                 // already checked in ctor that this cast is safe
                 static_cast<const TQuantizedFloatValuesHolder*>(
@@ -466,11 +503,43 @@ namespace NCB {
             );
         }
 
+        bool IsSparseFloatFeature(ui32 floatFeatureIdx) const {
+            return GetSparseFloatFeature(floatFeatureIdx).Defined();
+        }
+
+        // returns Nothing() if the feature is unavailable or is stored densely
+        TMaybeData<const TSparseQuantizedFloatValuesHolder*> GetSparseFloatFeature(ui32 floatFeatureIdx) const {
+            return MakeMaybeData(
+                dynamic_cast<const TSparseQuantizedFloatValuesHolder*>(Data.FloatFeatures[floatFeatureIdx].Get())
+            );
+        }
+
+        // returns Nothing() if the feature is unavailable or is not block compressed
+        TMaybeData<const TBlockCompressedQuantizedFloatValuesHolder*> GetBlockCompressedFloatFeature(
+            ui32 floatFeatureIdx
+        ) const {
+            return MakeMaybeData(
+                dynamic_cast<const TBlockCompressedQuantizedFloatValuesHolder*>(
+                    Data.FloatFeatures[floatFeatureIdx].Get()
+                )
+            );
+        }
+
         // low-level function, data is without subset indexing, apply external subset indexing!
         const ui8* GetFloatFeatureRawSrcData(ui32 floatFeatureIdx) const {
             return *((*GetFloatFeature(floatFeatureIdx))->GetArrayData().GetSrc());
         }
 
+        /* low-level function, data is without subset indexing, apply external subset indexing!
+         * works for dense, sparse and block compressed features, sparse ones are materialized and
+         * block compressed ones are decompressed (in parallel if localExecutor is not nullptr) to a buffer
+         * that is reused after the returned holder is destroyed
+         */
+        TMaybeOwningConstArrayHolder<ui8> GetFloatFeatureSrcBins(
+            ui32 floatFeatureIdx,
+            NPar::TLocalExecutor* localExecutor = nullptr
+        ) const;
+
         /* overrides base class implementation with more restricted type
          * (more efficient for CPU score calculation)
          * features guaranteed to be stored as an array of ui32
@@ -493,6 +562,19 @@ namespace NCB {
             return CatFeatureUniqueValuesCounts[catFeatureIdx];
         }
 
+        // returns Nothing() if bundle columns are not present in this data
+        TMaybeData<const TQuantizedFloatValuesHolder*> GetExclusiveFeaturesBundle(ui32 bundleIdx) const {
+            if (bundleIdx >= Data.ExclusiveFeaturesBundles.size()) {
+                return Nothing();
+            }
+            return MakeMaybeData(
+                // already checked in ctor that this cast is safe
+                static_cast<const TQuantizedFloatValuesHolder*>(
+                    Data.ExclusiveFeaturesBundles[bundleIdx].Get()
+                )
+            );
+        }
+
     private:
         // check that additional CPU-specific constraints are respected
         void Check() const;
@@ -500,6 +582,9 @@ namespace NCB {
     private:
         // store directly instead of looking up in Data.QuantizedFeaturesInfo for runtime efficiency
         TVector<TCatFeatureUniqueValuesCounts> CatFeatureUniqueValuesCounts; // [catFeatureIdx]
+
+        // shared with holders returned from GetFloatFeatureSrcBins that can outlive this provider
+        TIntrusivePtr<TBuffersPool<ui8>> DecompressedBinsBuffers = MakeIntrusive<TBuffersPool<ui8>>();
     };
 
 
@@ -2,10 +2,12 @@
 
 #include "cat_feature_perfect_hash_helper.h"
 #include "columns.h"
+#include "exclusive_feature_bundling.h"
 #include "external_columns.h"
 #include "util.h"
 
 #include <catboost/libs/helpers/array_subset.h>
+#include <catboost/libs/helpers/block_compressed_array.h>
 #include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/helpers/resource_constrained_executor.h>
 #include <catboost/libs/logging/logging.h>
@@ -13,7 +15,9 @@
 #include <catboost/libs/quantization_schema/quantize.h>
 
 #include <library/grid_creator/binarization.h>
+#include <library/grid_creator/quantile_sketch.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/cast.h>
 #include <util/generic/maybe.h>
 #include <util/generic/utility.h>
@@ -24,12 +28,21 @@
 #include <util/system/compiler.h>
 #include <util/system/mem_info.h>
 
+#include <array>
 #include <functional>
 #include <limits>
 #include <numeric>
 
 
 namespace NCB {
+    /* for EBorderSelectionType::QuantileSketch sketches are built for blocks of fixed size and merged in
+     * the order of blocks so the result does not depend on the number of threads.
+     * Blocks are processed in rounds to limit memory used by unmerged sketches.
+     */
+    constexpr ui32 QUANTILE_SKETCH_BLOCK_SIZE = 1 << 16;
+    constexpr ui32 QUANTILE_SKETCH_BLOCKS_PER_ROUND = 64;
+
+
     static bool NeedToCalcBorders(const TQuantizedFeaturesInfo& quantizedFeaturesInfo) {
         bool needToCalcBorders = false;
         quantizedFeaturesInfo.GetFeaturesLayout()->IterateOverAvailableFeatures<EFeatureType::Float>(
@@ -105,13 +118,21 @@ namespace NCB {
                 options.MaxSubsetSizeForSlowBuildBordersAlgorithms
             );
 
-            result += sizeof(float) * sampleSize; // for copying to srcFeatureValuesForBuildBorders
+            const int borderCount =
+                SafeIntegerCast<int>(quantizedFeaturesInfo.GetFloatFeatureBinarization().BorderCount.Get());
 
-            result += CalcMemoryForFindBestSplit(
-                SafeIntegerCast<int>(quantizedFeaturesInfo.GetFloatFeatureBinarization().BorderCount.Get()),
-                (size_t)sampleSize,
-                borderSelectionType
-            );
+            if (borderSelectionType == EBorderSelectionType::QuantileSketch) {
+                // values are not copied, only sketches for blocks and the merged one are stored
+                result += QUANTILE_SKETCH_BLOCKS_PER_ROUND * CalcMemoryForFindBestSplit(
+                    borderCount,
+                    (size_t)Min<ui32>(sampleSize, QUANTILE_SKETCH_BLOCK_SIZE),
+                    borderSelectionType
+                );
+            } else {
+                result += sizeof(float) * sampleSize; // for copying to srcFeatureValuesForBuildBorders
+            }
+
+            result += CalcMemoryForFindBestSplit(borderCount, (size_t)sampleSize, borderSelectionType);
         }
 
         if (doQuantization && (options.CpuCompatibleFormat || clearSrcData)) {
@@ -124,44 +145,61 @@ namespace NCB {
     }
 
 
-    static void CalcBordersAndNanMode(
-        const TFloatValuesHolder& srcFeature,
-        const TFeaturesArraySubsetIndexing* subsetForBuildBorders,
-        const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
-        ENanMode* nanMode,
-        TVector<float>* borders
+    static NSplitSelection::TQuantileSketch BuildQuantileSketch(
+        const TMaybeOwningConstArraySubset<float, ui32>& srcData,
+        NPar::TLocalExecutor* localExecutor
     ) {
-        const auto& binarizationOptions = quantizedFeaturesInfo.GetFloatFeatureBinarization();
-
-        Y_VERIFY(binarizationOptions.BorderCount > 0);
+        const auto& subsetIndexing = *srcData.GetSubsetIndexing();
+        const TConstArrayRef<float> srcValues = **srcData.GetSrc();
 
-        TMaybeOwningConstArraySubset<float, ui32> srcFeatureData = srcFeature.GetArrayData();
+        NSplitSelection::TQuantileSketch result;
+        if (!subsetIndexing.Size()) {
+            return result;
+        }
 
-        TMaybeOwningConstArraySubset<float, ui32> srcDataForBuildBorders(
-            srcFeatureData.GetSrc(),
-            subsetForBuildBorders
-        );
+        const auto unitRanges = subsetIndexing.GetParallelUnitRanges(QUANTILE_SKETCH_BLOCK_SIZE);
 
-        // does not contain nans
-        TVector<float> srcFeatureValuesForBuildBorders;
-        srcFeatureValuesForBuildBorders.reserve(srcDataForBuildBorders.Size());
+        TVector<NSplitSelection::TQuantileSketch> roundSketches;
+        for (ui32 roundBegin = 0; roundBegin < unitRanges.RangesCount(); roundBegin += QUANTILE_SKETCH_BLOCKS_PER_ROUND) {
+            const ui32 roundEnd = Min<ui32>(roundBegin + QUANTILE_SKETCH_BLOCKS_PER_ROUND, unitRanges.RangesCount());
 
-        bool hasNans = false;
-
-        srcDataForBuildBorders.ForEach(
-            [&] (ui32 /*idx*/, float value) {
-                if (IsNan(value)) {
-                    hasNans = true;
-                } else {
-                    srcFeatureValuesForBuildBorders.push_back(value);
-                }
+            roundSketches.assign(roundEnd - roundBegin, NSplitSelection::TQuantileSketch());
+            localExecutor->ExecRangeWithThrow(
+                [&] (int blockIdx) {
+                    auto& sketch = roundSketches[blockIdx];
+                    subsetIndexing.ForEachInSubRange(
+                        unitRanges.GetRange(roundBegin + blockIdx),
+                        [&] (ui32 /*idx*/, ui32 srcIdx) {
+                            sketch.Add(srcValues[srcIdx]);
+                        }
+                    );
+                },
+                0,
+                SafeIntegerCast<int>(roundSketches.size()),
+                NPar::TLocalExecutor::WAIT_COMPLETE
+            );
+            for (const auto& sketch : roundSketches) {
+                result.Merge(sketch);
             }
-        );
+        }
+        return result;
+    }
+
 
+    // quantileSketch is used instead of valuesForBuildBorders if defined
+    static void SelectBordersAndNanMode(
+        ui32 featureId, // for error message
+        const NCatboostOptions::TBinarizationOptions& binarizationOptions,
+        bool hasNans,
+        const NSplitSelection::TQuantileSketch* quantileSketch,
+        TVector<float>& valuesForBuildBorders, // does not contain nans
+        ENanMode* nanMode,
+        TVector<float>* borders
+    ) {
         CB_ENSURE(
             (binarizationOptions.NanMode != ENanMode::Forbidden) ||
             !hasNans,
-            "Feature #" << srcFeature.GetId() << ": There are nan factors and nan values for "
+            "Feature #" << featureId << ": There are nan factors and nan values for "
             " float features are not allowed. Set nan_mode != Forbidden."
         );
 
@@ -176,11 +214,15 @@ namespace NCB {
         THashSet<float> borderSet;
 
         if (nonNanValuesBorderCount > 0) {
-            borderSet = BestSplit(
-                srcFeatureValuesForBuildBorders,
-                nonNanValuesBorderCount,
-                binarizationOptions.BorderSelectionType
-            );
+            if (quantileSketch) {
+                borderSet = quantileSketch->GetBorders(nonNanValuesBorderCount);
+            } else {
+                borderSet = BestSplit(
+                    valuesForBuildBorders,
+                    nonNanValuesBorderCount,
+                    binarizationOptions.BorderSelectionType
+                );
+            }
 
             if (borderSet.contains(-0.0f)) { // BestSplit might add negative zeros
                 borderSet.erase(-0.0f);
@@ -201,10 +243,336 @@ namespace NCB {
     }
 
 
+    static void CalcBordersAndNanMode(
+        const TFloatValuesHolder& srcFeature,
+        const TFeaturesArraySubsetIndexing* subsetForBuildBorders,
+        const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
+
+        // can be nullptr, if defined must be built for the full data of srcFeature
+        const NSplitSelection::TQuantileSketch* precomputedQuantileSketch,
+        NPar::TLocalExecutor* localExecutor,
+        ENanMode* nanMode,
+        TVector<float>* borders
+    ) {
+        const auto& binarizationOptions = quantizedFeaturesInfo.GetFloatFeatureBinarization();
+
+        Y_VERIFY(binarizationOptions.BorderCount > 0);
+
+        TMaybeOwningConstArraySubset<float, ui32> srcFeatureData = srcFeature.GetArrayData();
+
+        TMaybeOwningConstArraySubset<float, ui32> srcDataForBuildBorders(
+            srcFeatureData.GetSrc(),
+            subsetForBuildBorders
+        );
+
+        // does not contain nans
+        TVector<float> srcFeatureValuesForBuildBorders;
+
+        // approximate summary is used instead of srcFeatureValuesForBuildBorders if defined
+        const NSplitSelection::TQuantileSketch* quantileSketch = nullptr;
+        TMaybe<NSplitSelection::TQuantileSketch> builtQuantileSketch;
+
+        bool hasNans = false;
+
+        if (binarizationOptions.BorderSelectionType == EBorderSelectionType::QuantileSketch) {
+            if (precomputedQuantileSketch) {
+                quantileSketch = precomputedQuantileSketch;
+            } else {
+                builtQuantileSketch = BuildQuantileSketch(srcDataForBuildBorders, localExecutor);
+                quantileSketch = builtQuantileSketch.Get();
+            }
+            hasNans = quantileSketch->GetNanCount() != 0;
+        } else {
+            srcFeatureValuesForBuildBorders.reserve(srcDataForBuildBorders.Size());
+
+            srcDataForBuildBorders.ForEach(
+                [&] (ui32 /*idx*/, float value) {
+                    if (IsNan(value)) {
+                        hasNans = true;
+                    } else {
+                        srcFeatureValuesForBuildBorders.push_back(value);
+                    }
+                }
+            );
+        }
+
+        SelectBordersAndNanMode(
+            srcFeature.GetId(),
+            binarizationOptions,
+            hasNans,
+            quantileSketch,
+            srcFeatureValuesForBuildBorders,
+            nanMode,
+            borders
+        );
+    }
+
+
+    static void CalcBordersAndNanMode(
+        const TSparseFloatValuesHolder& srcFeature,
+        const TFeaturesArraySubsetIndexing* subsetForBuildBorders,
+        const TQuantizedFeaturesInfo& quantizedFeaturesInfo,
+
+        // sketches are not precomputed for sparse features, must be nullptr
+        const NSplitSelection::TQuantileSketch* precomputedQuantileSketch,
+        NPar::TLocalExecutor* /*localExecutor*/,
+        ENanMode* nanMode,
+        TVector<float>* borders
+    ) {
+        CB_ENSURE_INTERNAL(!precomputedQuantileSketch, "Unexpected quantile sketch for a sparse feature");
+
+        const auto& binarizationOptions = quantizedFeaturesInfo.GetFloatFeatureBinarization();
+
+        Y_VERIFY(binarizationOptions.BorderCount > 0);
+
+        const auto& srcData = srcFeature.GetSrcData();
+
+        // does not contain nans
+        TVector<float> srcFeatureValuesForBuildBorders;
+
+        TMaybe<NSplitSelection::TQuantileSketch> quantileSketch;
+        if (binarizationOptions.BorderSelectionType == EBorderSelectionType::QuantileSketch) {
+            quantileSketch.ConstructInPlace();
+        } else {
+            srcFeatureValuesForBuildBorders.reserve(subsetForBuildBorders->Size());
+        }
+
+        bool hasNans = false;
+        auto addValue = [&] (float value) {
+            if (quantileSketch) {
+                quantileSketch->Add(value);
+            } else if (IsNan(value)) {
+                hasNans = true;
+            } else {
+                srcFeatureValuesForBuildBorders.push_back(value);
+            }
+        };
+
+        if (HoldsAlternative<TFullSubset<ui32>>(*subsetForBuildBorders)) {
+            // the order of values does not matter for border selection
+            srcData.ForEachNonDefault([&] (ui32 /*idx*/, float value) { addValue(value); });
+            for (auto i : xrange(srcData.GetSize() - srcData.GetNonDefaultSize())) {
+                Y_UNUSED(i);
+                addValue(srcData.GetDefaultValue());
+            }
+        } else {
+            subsetForBuildBorders->ForEach(
+                [&] (ui32 /*idx*/, ui32 srcIdx) { addValue(srcData.GetValue(srcIdx)); }
+            );
+        }
+        if (quantileSketch) {
+            hasNans = quantileSketch->GetNanCount() != 0;
+        }
+
+        SelectBordersAndNanMode(
+            srcFeature.GetId(),
+            binarizationOptions,
+            hasNans,
+            quantileSketch.Get(),
+            srcFeatureValuesForBuildBorders,
+            nanMode,
+            borders
+        );
+    }
+
+
+    // returns nullptr if the most frequent bin does not cover more than defaultBinFraction of objects
+    static THolder<IQuantizedFloatValuesHolder> TryMakeSparseQuantizedFloatFeature(
+        ui32 featureId,
+        TConstArrayRef<ui8> quantizedData,
+        float defaultBinFraction,
+        const TFeaturesArraySubsetIndexing* dstSubsetIndexing
+    ) {
+        if (defaultBinFraction >= 1.0f) {
+            return nullptr;
+        }
+
+        std::array<ui32, 256> binCounts;
+        binCounts.fill(0);
+        for (auto bin : quantizedData) {
+            ++binCounts[bin];
+        }
+        const auto defaultBin = (ui8)(MaxElement(binCounts.begin(), binCounts.end()) - binCounts.begin());
+
+        if (binCounts[defaultBin] <= defaultBinFraction * quantizedData.size()) {
+            return nullptr;
+        }
+
+        return MakeHolder<TSparseQuantizedFloatValuesHolder>(
+            featureId,
+            MakeAtomicShared<TSparseQuantizedFloatValuesHolder::TSrcData>(
+                TSparseQuantizedFloatValuesHolder::TSrcData::CreateFromDense(quantizedData, defaultBin)
+            ),
+            dstSubsetIndexing
+        );
+    }
+
+
+    static void QuantizeFloatFeature(
+        const TFloatValuesHolder& srcFeature,
+        ENanMode nanMode,
+        TConstArrayRef<float> borders,
+        const TQuantizationOptions& options,
+        bool clearSrcData,
+        const TFeaturesArraySubsetIndexing* dstSubsetIndexing,
+        NPar::TLocalExecutor* localExecutor,
+        TQuantizedFeaturesInfoPtr quantizedFeaturesInfo,
+        THolder<IQuantizedFloatValuesHolder>* dstQuantizedFeature
+    ) {
+        TMaybeOwningConstArraySubset<float, ui32> srcFeatureData = srcFeature.GetArrayData();
+
+        if (!options.CpuCompatibleFormat && !clearSrcData) {
+            // use GPU-only external columns
+            *dstQuantizedFeature = MakeHolder<TExternalFloatValuesHolder>(
+                srcFeature.GetId(),
+                *srcFeatureData.GetSrc(),
+                dstSubsetIndexing,
+                quantizedFeaturesInfo
+            );
+        } else {
+            // TODO(akhropov): support other bitsPerKey. MLTOOLS-2425
+            const ui32 bitsPerKey = 8;
+            TIndexHelper<ui64> indexHelper(bitsPerKey);
+            TVector<ui64> quantizedDataStorage;
+            quantizedDataStorage.yresize(indexHelper.CompressedSize(srcFeatureData.Size()));
+
+            TArrayRef<ui8> quantizedData(
+                reinterpret_cast<ui8*>(quantizedDataStorage.data()),
+                srcFeatureData.Size()
+            );
+
+            // it's ok even if it is learn data, for learn nans are checked at CalcBordersAndNanMode stage
+            bool allowNans = (nanMode != ENanMode::Forbidden) ||
+                quantizedFeaturesInfo->GetFloatFeaturesAllowNansInTestOnly();
+
+            Quantize(
+                srcFeatureData,
+                allowNans,
+                nanMode,
+                srcFeature.GetId(),
+                borders,
+                localExecutor,
+                &quantizedData
+            );
+
+            *dstQuantizedFeature = TryMakeSparseQuantizedFloatFeature(
+                srcFeature.GetId(),
+                quantizedData,
+                options.SparseFeaturesDefaultBinFraction,
+                dstSubsetIndexing
+            );
+            if (!*dstQuantizedFeature) {
+                *dstQuantizedFeature = MakeHolder<TQuantizedFloatValuesHolder>(
+                    srcFeature.GetId(),
+                    TCompressedArray(
+                        srcFeatureData.Size(),
+                        indexHelper.GetBitsPerKey(),
+                        TMaybeOwningArrayHolder<ui64>::CreateOwning(std::move(quantizedDataStorage))
+                    ),
+                    dstSubsetIndexing
+                );
+            }
+        }
+    }
+
+
+    // quantizes only non-default values, src data must not be a subset
+    static void QuantizeFloatFeature(
+        const TSparseFloatValuesHolder& srcFeature,
+        ENanMode nanMode,
+        TConstArrayRef<float> borders,
+        const TQuantizationOptions& options,
+        bool /*clearSrcData*/,
+        const TFeaturesArraySubsetIndexing* dstSubsetIndexing,
+        NPar::TLocalExecutor* /*localExecutor*/,
+        TQuantizedFeaturesInfoPtr quantizedFeaturesInfo,
+        THolder<IQuantizedFloatValuesHolder>* dstQuantizedFeature
+    ) {
+        CB_ENSURE_INTERNAL(
+            HoldsAlternative<TFullSubset<ui32>>(*srcFeature.GetSubsetIndexing()),
+            "Feature #" << srcFeature.GetId() << ": sparse quantization is not supported for data subsets"
+        );
+
+        const auto& srcData = srcFeature.GetSrcData();
+
+        // it's ok even if it is learn data, for learn nans are checked at CalcBordersAndNanMode stage
+        const bool allowNans = (nanMode != ENanMode::Forbidden) ||
+            quantizedFeaturesInfo->GetFloatFeaturesAllowNansInTestOnly();
+
+        auto quantize = [&] (float srcValue) {
+            CB_ENSURE(
+                allowNans || !IsNan(srcValue),
+                "There are NaNs in test dataset (feature number "
+                << srcFeature.GetId() << ") but there were no NaNs in learn dataset"
+            );
+            return Binarize<ui8>(nanMode, borders, srcValue);
+        };
+
+        const ui8 defaultBin = quantize(srcData.GetDefaultValue());
+
+        TVector<ui32> nonDefaultIndices;
+        TVector<ui8> nonDefaultBins;
+        srcData.ForEachNonDefault(
+            [&] (ui32 idx, float value) {
+                const ui8 bin = quantize(value);
+                if (bin != defaultBin) {
+                    nonDefaultIndices.push_back(idx);
+                    nonDefaultBins.push_back(bin);
+                }
+            }
+        );
+
+        const ui32 objectCount = srcData.GetSize();
+        const ui32 defaultBinCount = objectCount - (ui32)nonDefaultIndices.size();
+
+        // the same criterion as in TryMakeSparseQuantizedFloatFeature
+        if ((options.SparseFeaturesDefaultBinFraction < 1.0f)
+            && (defaultBinCount > options.SparseFeaturesDefaultBinFraction * objectCount))
+        {
+            *dstQuantizedFeature = MakeHolder<TSparseQuantizedFloatValuesHolder>(
+                srcFeature.GetId(),
+                MakeAtomicShared<TSparseQuantizedFloatValuesHolder::TSrcData>(
+                    objectCount,
+                    std::move(nonDefaultIndices),
+                    std::move(nonDefaultBins),
+                    defaultBin
+                ),
+                dstSubsetIndexing
+            );
+            return;
+        }
+
+        // TODO(akhropov): support other bitsPerKey. MLTOOLS-2425
+        const ui32 bitsPerKey = 8;
+        TIndexHelper<ui64> indexHelper(bitsPerKey);
+        TVector<ui64> quantizedDataStorage;
+        quantizedDataStorage.yresize(indexHelper.CompressedSize(objectCount));
+
+        TArrayRef<ui8> quantizedData(reinterpret_cast<ui8*>(quantizedDataStorage.data()), objectCount);
+        Fill(quantizedData.begin(), quantizedData.end(), defaultBin);
+        for (auto i : xrange(nonDefaultIndices.size())) {
+            quantizedData[nonDefaultIndices[i]] = nonDefaultBins[i];
+        }
+
+        *dstQuantizedFeature = MakeHolder<TQuantizedFloatValuesHolder>(
+            srcFeature.GetId(),
+            TCompressedArray(
+                objectCount,
+                indexHelper.GetBitsPerKey(),
+                TMaybeOwningArrayHolder<ui64>::CreateOwning(std::move(quantizedDataStorage))
+            ),
+            dstSubsetIndexing
+        );
+    }
+
+
+    // TFloatFeatureValuesHolder is TFloatValuesHolder or TSparseFloatValuesHolder
+    template <class TFloatFeatureValuesHolder>
     static void ProcessFloatFeature(
         TFloatFeatureIdx floatFeatureIdx,
-        const TFloatValuesHolder& srcFeature,
+        const TFloatFeatureValuesHolder& srcFeature,
         const TFeaturesArraySubsetIndexing* subsetForBuildBorders,
+        const NSplitSelection::TQuantileSketch* precomputedQuantileSketch, // can be nullptr
         const TQuantizationOptions& options,
         bool clearSrcData,
         bool calcBordersAndNanModeOnly,
@@ -246,6 +614,8 @@ namespace NCB {
                 srcFeature,
                 subsetForBuildBorders,
                 *quantizedFeaturesInfo,
+                precomputedQuantileSketch,
+                localExecutor,
                 &nanMode,
                 &calculatedBorders
             );
@@ -254,52 +624,17 @@ namespace NCB {
         }
 
         if (!calcBordersAndNanModeOnly && !borders.Empty()) {
-            TMaybeOwningConstArraySubset<float, ui32> srcFeatureData = srcFeature.GetArrayData();
-
-            if (!options.CpuCompatibleFormat && !clearSrcData) {
-                // use GPU-only external columns
-                *dstQuantizedFeature = MakeHolder<TExternalFloatValuesHolder>(
-                    srcFeature.GetId(),
-                    *srcFeatureData.GetSrc(),
-                    dstSubsetIndexing,
-                    quantizedFeaturesInfo
-                );
-            } else {
-                // TODO(akhropov): support other bitsPerKey. MLTOOLS-2425
-                const ui32 bitsPerKey = 8;
-                TIndexHelper<ui64> indexHelper(bitsPerKey);
-                TVector<ui64> quantizedDataStorage;
-                quantizedDataStorage.yresize(indexHelper.CompressedSize(srcFeatureData.Size()));
-
-                TArrayRef<ui8> quantizedData(
-                    reinterpret_cast<ui8*>(quantizedDataStorage.data()),
-                    srcFeatureData.Size()
-                );
-
-                // it's ok even if it is learn data, for learn nans are checked at CalcBordersAndNanMode stage
-                bool allowNans = (nanMode != ENanMode::Forbidden) ||
-                    quantizedFeaturesInfo->GetFloatFeaturesAllowNansInTestOnly();
-
-                Quantize(
-                    srcFeatureData,
-                    allowNans,
-                    nanMode,
-                    srcFeature.GetId(),
-                    borders,
-                    localExecutor,
-                    &quantizedData
-                );
-
-                *dstQuantizedFeature = MakeHolder<TQuantizedFloatValuesHolder>(
-                    srcFeature.GetId(),
-                    TCompressedArray(
-                        srcFeatureData.Size(),
-                        indexHelper.GetBitsPerKey(),
-                        TMaybeOwningArrayHolder<ui64>::CreateOwning(std::move(quantizedDataStorage))
-                    ),
-                    dstSubsetIndexing
-                );
-            }
+            QuantizeFloatFeature(
+                srcFeature,
+                nanMode,
+                borders,
+                options,
+                clearSrcData,
+                dstSubsetIndexing,
+                localExecutor,
+                quantizedFeaturesInfo,
+                dstQuantizedFeature
+            );
         }
 
         if (calculateNanMode || calculateBorders) {
@@ -408,6 +743,97 @@ namespace NCB {
     }
 
 
+    /* bundles are calculated only once for quantizedFeaturesInfo (on learn data),
+     * other data is used with separate features in training
+     */
+    static void ProcessExclusiveFeaturesBundles(
+        const TFeaturesArraySubsetIndexing* subsetIndexing,
+        NPar::TLocalExecutor* localExecutor,
+        TQuantizedFeaturesInfo* quantizedFeaturesInfo,
+        TQuantizedObjectsData* data
+    ) {
+        if (quantizedFeaturesInfo->HasExclusiveFeaturesBundles()) {
+            return;
+        }
+
+        const auto& featuresLayout = *quantizedFeaturesInfo->GetFeaturesLayout();
+
+        TVector<ui32> binCounts(featuresLayout.GetFloatFeatureCount(), 0);
+        featuresLayout.IterateOverAvailableFeatures<EFeatureType::Float>(
+            [&] (TFloatFeatureIdx floatFeatureIdx) {
+                if (data->FloatFeatures[*floatFeatureIdx]) {
+                    binCounts[*floatFeatureIdx] = quantizedFeaturesInfo->GetBinCount(floatFeatureIdx);
+                }
+            }
+        );
+
+        TVector<TExclusiveFeaturesBundle> bundles = CreateExclusiveFeaturesBundles(
+            data->FloatFeatures,
+            binCounts,
+            subsetIndexing->Size(),
+            localExecutor
+        );
+
+        data->ExclusiveFeaturesBundles.resize(bundles.size());
+        localExecutor->ExecRangeWithThrow(
+            [&] (int bundleIdx) {
+                data->ExclusiveFeaturesBundles[bundleIdx] = CreateExclusiveFeaturesBundleColumn(
+                    bundles[bundleIdx],
+                    data->FloatFeatures,
+                    subsetIndexing
+                );
+            },
+            0,
+            SafeIntegerCast<int>(bundles.size()),
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+
+        ui32 bundledFeatureCount = 0;
+        for (const auto& bundle : bundles) {
+            bundledFeatureCount += bundle.Parts.size();
+        }
+        CATBOOST_DEBUG_LOG << "Exclusive features bundling: " << bundledFeatureCount
+            << " float features are merged into " << bundles.size() << " bundles" << Endl;
+
+        quantizedFeaturesInfo->SetExclusiveFeaturesBundles(std::move(bundles));
+    }
+
+
+    /* done after bundling because bundles are created from dense columns,
+     * bundled features data is compressed as well because it is used for other datasets
+     */
+    static void CompressFloatFeatures(
+        const TString& codecName,
+        NPar::TLocalExecutor* localExecutor,
+        TQuantizedObjectsData* data
+    ) {
+        size_t rawSize = 0;
+        size_t compressedSize = 0;
+        for (auto& floatFeature : data->FloatFeatures) {
+            auto* denseFeature = dynamic_cast<const TQuantizedFloatValuesHolder*>(floatFeature.Get());
+            if (!denseFeature) {
+                continue;
+            }
+            const auto compressedData = denseFeature->GetCompressedData();
+            auto srcData = MakeAtomicShared<TBlockCompressedArray>(
+                compressedData.GetSrc()->GetRawArray<const ui8>(),
+                codecName,
+                TBlockCompressedArray::DEFAULT_BLOCK_SIZE,
+                localExecutor
+            );
+            rawSize += srcData->GetSize();
+            compressedSize += srcData->GetCompressedSize();
+            floatFeature = MakeHolder<TBlockCompressedQuantizedFloatValuesHolder>(
+                denseFeature->GetId(),
+                std::move(srcData),
+                compressedData.GetSubsetIndexing()
+            );
+        }
+        CATBOOST_DEBUG_LOG << "Float features compression with " << codecName << ": " << rawSize
+            << " bytes are compressed to " << compressedSize << " bytes" << Endl;
+    }
+
+
     // this is a helper class needed for friend declarations
     class TQuantizationImpl {
     public:
@@ -451,6 +877,18 @@ namespace NCB {
                 rand
             );
 
+            /* sketches accumulated while loading can be used only if they describe exactly
+             * the data that is used to build borders
+             */
+            const auto& srcFloatFeaturesQuantileSketches =
+                rawDataProvider->ObjectsData->Data.FloatFeaturesQuantileSketches;
+            const bool usePrecomputedQuantileSketches =
+                !srcFloatFeaturesQuantileSketches.empty()
+                && !subsetForBuildBorders
+                && (quantizedFeaturesInfo->GetFloatFeatureBinarization().BorderSelectionType
+                    == EBorderSelectionType::QuantileSketch)
+                && HoldsAlternative<TFullSubset<ui32>>(*srcObjectsCommonData.SubsetIndexing);
+
             TMaybe<TQuantizedBuilderData> data;
             TAtomicSharedPtr<TArraySubsetIndexing<ui32>> subsetIndexing;
 
@@ -494,27 +932,65 @@ namespace NCB {
                             {
                                 maxMemUsageForFloatFeature,
                                 [&, floatFeatureIdx]() {
-                                    auto& srcFloatFeatureHolder =
-                                        rawDataProvider->ObjectsData->Data.FloatFeatures[*floatFeatureIdx];
-
-                                    ProcessFloatFeature(
-                                        floatFeatureIdx,
-                                        *srcFloatFeatureHolder,
-                                        subsetForBuildBorders ?
-                                            subsetForBuildBorders.Get()
-                                            : srcObjectsCommonData.SubsetIndexing.Get(),
-                                        options,
-                                        clearSrcObjectsData,
-                                        calcBordersAndNanModeOnly,
-                                        subsetIndexing.Get(),
-                                        localExecutor,
-                                        quantizedFeaturesInfo,
-                                        calcBordersAndNanModeOnly ?
-                                            nullptr
-                                            : &(data->ObjectsData.FloatFeatures[*floatFeatureIdx])
-                                    );
-                                    if (clearSrcObjectsData) {
-                                        srcFloatFeatureHolder.Destroy();
+                                    auto& srcObjectsData = rawDataProvider->ObjectsData->Data;
+                                    auto& srcFloatFeatureHolder = srcObjectsData.FloatFeatures[*floatFeatureIdx];
+
+                                    const NSplitSelection::TQuantileSketch* precomputedQuantileSketch =
+                                        usePrecomputedQuantileSketches ?
+                                            srcFloatFeaturesQuantileSketches[*floatFeatureIdx].Get()
+                                            : nullptr;
+
+                                    auto processFloatFeature = [&] (const auto& srcFeature, bool clearSrcData) {
+                                        ProcessFloatFeature(
+                                            floatFeatureIdx,
+                                            srcFeature,
+                                            subsetForBuildBorders ?
+                                                subsetForBuildBorders.Get()
+                                                : srcObjectsCommonData.SubsetIndexing.Get(),
+                                            precomputedQuantileSketch,
+                                            options,
+                                            clearSrcData,
+                                            calcBordersAndNanModeOnly,
+                                            subsetIndexing.Get(),
+                                            localExecutor,
+                                            quantizedFeaturesInfo,
+                                            calcBordersAndNanModeOnly ?
+                                                nullptr
+                                                : &(data->ObjectsData.FloatFeatures[*floatFeatureIdx])
+                                        );
+                                    };
+
+                                    if (!srcObjectsData.SparseFloatFeatures.empty()
+                                        && srcObjectsData.SparseFloatFeatures[*floatFeatureIdx])
+                                    {
+                                        auto& srcSparseFeatureHolder =
+                                            srcObjectsData.SparseFloatFeatures[*floatFeatureIdx];
+                                        const auto& srcSubsetIndexing = *srcObjectsCommonData.SubsetIndexing;
+                                        if (HoldsAlternative<TFullSubset<ui32>>(srcSubsetIndexing)) {
+                                            processFloatFeature(*srcSparseFeatureHolder, clearSrcObjectsData);
+                                        } else {
+                                            /* indices of subsetForBuildBorders are in the src data space
+                                             * so the whole src data is densified for subsets
+                                             */
+                                            const TFloatValuesHolder densifiedFeature(
+                                                srcSparseFeatureHolder->GetId(),
+                                                TMaybeOwningConstArrayHolder<float>::CreateOwning(
+                                                    srcSparseFeatureHolder->GetSrcData().ExtractValues()
+                                                ),
+                                                &srcSubsetIndexing
+                                            );
+
+                                            // densified data is temporary so it can't be referenced
+                                            processFloatFeature(densifiedFeature, /*clearSrcData*/ true);
+                                        }
+                                        if (clearSrcObjectsData) {
+                                            srcSparseFeatureHolder.Destroy();
+                                        }
+                                    } else {
+                                        processFloatFeature(*srcFloatFeatureHolder, clearSrcObjectsData);
+                                        if (clearSrcObjectsData) {
+                                            srcFloatFeatureHolder.Destroy();
+                                        }
                                     }
                                 }
                             }
@@ -572,6 +1048,23 @@ namespace NCB {
 
             data->ObjectsData.QuantizedFeaturesInfo = quantizedFeaturesInfo;
 
+            if (options.CpuCompatibleFormat && options.ExclusiveFeaturesBundling) {
+                ProcessExclusiveFeaturesBundles(
+                    subsetIndexing.Get(),
+                    localExecutor,
+                    quantizedFeaturesInfo.Get(),
+                    &data->ObjectsData
+                );
+            }
+
+            if (options.CpuCompatibleFormat && options.QuantizedFeaturesCompressionCodec) {
+                CompressFloatFeatures(
+                    options.QuantizedFeaturesCompressionCodec,
+                    localExecutor,
+                    &data->ObjectsData
+                );
+            }
+
             if (clearSrcData) {
                 data->MetaInfo = std::move(rawDataProvider->MetaInfo);
                 data->TargetData = std::move(rawDataProvider->RawTargetData.Data);
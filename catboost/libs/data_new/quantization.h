@@ -7,6 +7,7 @@
 
 #include <library/threading/local_executor/local_executor.h>
 
+#include <util/generic/string.h>
 #include <util/generic/ylimits.h>
 
 
@@ -19,6 +20,21 @@ namespace NCB {
         ui32 MaxSubsetSizeForSlowBuildBordersAlgorithms = 200000;
         bool AllowWriteFiles = true;
 
+        /* CPU-compatible float features with a greater fraction of objects in the most frequent bin
+         * are stored as TSparseQuantizedFloatValuesHolder
+         */
+        float SparseFeaturesDefaultBinFraction = 1.0f;
+
+        /* merge CPU-compatible float features without common non-default objects into
+         * TExclusiveFeaturesBundle-s (calculated on the first quantized data, usually learn)
+         */
+        bool ExclusiveFeaturesBundling = false;
+
+        /* if not empty, CPU-compatible dense float features are stored as
+         * TBlockCompressedQuantizedFloatValuesHolder compressed with this library/blockcodecs codec
+         */
+        TString QuantizedFeaturesCompressionCodec;
+
         // TODO(akhropov): remove after checking global tests consistency
         bool CpuCompatibilityShuffleOverFullData = true;
     };
@@ -67,7 +67,41 @@ namespace NCB {
         return (*FeaturesLayout == *rhs.FeaturesLayout) &&
             (FloatFeaturesBinarization == rhs.FloatFeaturesBinarization) &&
             ApproximatelyEqualBorders(Borders, rhs.Borders) && (NanModes == rhs.NanModes) &&
-            (CatFeaturesPerfectHash == rhs.CatFeaturesPerfectHash);
+            (CatFeaturesPerfectHash == rhs.CatFeaturesPerfectHash) &&
+            (ExclusiveFeaturesBundles == rhs.ExclusiveFeaturesBundles);
+    }
+
+    void TQuantizedFeaturesInfo::SetExclusiveFeaturesBundles(TVector<TExclusiveFeaturesBundle>&& bundles) {
+        FloatFeatureToExclusiveFeaturesBundle.clear();
+        for (auto bundleIdx : xrange(bundles.size())) {
+            for (const auto& part : bundles[bundleIdx].Parts) {
+                CheckCorrectPerTypeFeatureIdx(TFloatFeatureIdx(part.FloatFeatureIdx));
+                CB_ENSURE_INTERNAL(
+                    part.BinCount == GetBinCount(TFloatFeatureIdx(part.FloatFeatureIdx)),
+                    "Exclusive features bundle part for float feature #" << part.FloatFeatureIdx
+                    << " has a bin count different from the feature's one"
+                );
+                const bool inserted
+                    = FloatFeatureToExclusiveFeaturesBundle.emplace(part.FloatFeatureIdx, (ui32)bundleIdx).second;
+                CB_ENSURE_INTERNAL(
+                    inserted,
+                    "Float feature #" << part.FloatFeatureIdx << " is in several exclusive features bundles"
+                );
+            }
+        }
+        ExclusiveFeaturesBundles = std::move(bundles);
+    }
+
+    const TExclusiveBundlePart& TQuantizedFeaturesInfo::GetExclusiveBundlePart(
+        const TFloatFeatureIdx floatFeatureIdx
+    ) const {
+        const ui32 bundleIdx = FloatFeatureToExclusiveFeaturesBundle.at(*floatFeatureIdx);
+        for (const auto& part : (*ExclusiveFeaturesBundles)[bundleIdx].Parts) {
+            if (part.FloatFeatureIdx == *floatFeatureIdx) {
+                return part;
+            }
+        }
+        Y_FAIL("This place should be inaccessible");
     }
 
     ENanMode TQuantizedFeaturesInfo::ComputeNanMode(const TFloatValuesHolder& feature) const {
@@ -2,6 +2,7 @@
 
 #include "columns.h"
 #include "cat_feature_perfect_hash.h"
+#include "exclusive_feature_bundling.h"
 #include "feature_index.h"
 #include "features_layout.h"
 
@@ -17,7 +18,9 @@
 #include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/guid.h>
+#include <util/generic/hash.h>
 #include <util/generic/map.h>
+#include <util/generic/maybe.h>
 #include <util/generic/ptr.h>
 #include <util/generic/vector.h>
 #include <util/generic/xrange.h>
@@ -123,6 +126,30 @@ namespace NCB {
         }
 
 
+        /* defined after quantization of the data bundles are calculated on (learn),
+         * not serialized so distributed workers always process features separately
+         */
+        bool HasExclusiveFeaturesBundles() const {
+            return ExclusiveFeaturesBundles.Defined();
+        }
+
+        void SetExclusiveFeaturesBundles(TVector<TExclusiveFeaturesBundle>&& bundles);
+
+        TConstArrayRef<TExclusiveFeaturesBundle> GetExclusiveFeaturesBundles() const {
+            return ExclusiveFeaturesBundles ?
+                TConstArrayRef<TExclusiveFeaturesBundle>(*ExclusiveFeaturesBundles)
+                : TConstArrayRef<TExclusiveFeaturesBundle>();
+        }
+
+        TMaybe<ui32> GetExclusiveFeaturesBundleIdx(const TFloatFeatureIdx floatFeatureIdx) const {
+            const auto* bundleIdx = FloatFeatureToExclusiveFeaturesBundle.FindPtr(*floatFeatureIdx);
+            return bundleIdx ? MakeMaybe(*bundleIdx) : Nothing();
+        }
+
+        // returns the bundle part for floatFeatureIdx, feature must be in some bundle
+        const TExclusiveBundlePart& GetExclusiveBundlePart(const TFloatFeatureIdx floatFeatureIdx) const;
+
+
         TCatFeatureUniqueValuesCounts GetUniqueValuesCounts(const TCatFeatureIdx catFeatureIdx) const {
             CheckCorrectPerTypeFeatureIdx(catFeatureIdx);
             return CatFeaturesPerfectHash.GetUniqueValuesCounts(catFeatureIdx);
@@ -195,6 +222,9 @@ namespace NCB {
         TMap<ui32, TVector<float>> Borders; // [floatFeatureIdx]
         TMap<ui32, ENanMode> NanModes; // [floatFeatureIdx]
 
+        TMaybe<TVector<TExclusiveFeaturesBundle>> ExclusiveFeaturesBundles;
+        THashMap<ui32, ui32> FloatFeatureToExclusiveFeaturesBundle; // floatFeatureIdx -> bundleIdx
+
         TCatFeaturesPerfectHash CatFeaturesPerfectHash;
     };
 
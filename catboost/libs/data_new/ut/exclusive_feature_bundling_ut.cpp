@@ -0,0 +1,109 @@
+#include <catboost/libs/data_new/exclusive_feature_bundling.h>
+
+#include <catboost/libs/helpers/compression.h>
+
+#include <library/unittest/registar.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+
+
+using namespace NCB;
+
+
+static THolder<IQuantizedFloatValuesHolder> MakeDenseFeature(
+    ui32 featureId,
+    const TVector<ui8>& bins,
+    const TFeaturesArraySubsetIndexing* subsetIndexing
+) {
+    return MakeHolder<TQuantizedFloatValuesHolder>(
+        featureId,
+        TCompressedArray(
+            bins.size(),
+            8,
+            TMaybeOwningArrayHolder<ui64>::CreateOwning(CompressVector<ui64>(bins, 8))
+        ),
+        subsetIndexing
+    );
+}
+
+
+Y_UNIT_TEST_SUITE(ExclusiveFeatureBundling) {
+    Y_UNIT_TEST(TestBundlePartBins) {
+        TExclusiveFeaturesBundle bundle;
+        bundle.Add(/*floatFeatureIdx*/ 3, /*binCount*/ 4, /*defaultBin*/ 2);
+        bundle.Add(/*floatFeatureIdx*/ 1, /*binCount*/ 2, /*defaultBin*/ 0);
+
+        UNIT_ASSERT_VALUES_EQUAL(bundle.GetBinCount(), 5);
+
+        const auto& part0 = bundle.Parts[0];
+        UNIT_ASSERT_VALUES_EQUAL(part0.BundleBinOffset, 1);
+        UNIT_ASSERT_VALUES_EQUAL(part0.GetBundleBin(0), 1);
+        UNIT_ASSERT_VALUES_EQUAL(part0.GetBundleBin(1), 2);
+        UNIT_ASSERT_VALUES_EQUAL(part0.GetBundleBin(3), 3);
+
+        const auto& part1 = bundle.Parts[1];
+        UNIT_ASSERT_VALUES_EQUAL(part1.BundleBinOffset, 4);
+        UNIT_ASSERT_VALUES_EQUAL(part1.GetBundleBin(1), 4);
+
+        for (const auto& part : bundle.Parts) {
+            for (ui32 bin : xrange(part.BinCount)) {
+                if (bin != part.DefaultBin) {
+                    UNIT_ASSERT_VALUES_EQUAL(part.GetFeatureBin(part.GetBundleBin(bin)), bin);
+                }
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestCreateBundles) {
+        const ui32 objectCount = 8;
+        TFeaturesArraySubsetIndexing subsetIndexing(TFullSubset<ui32>{objectCount});
+
+        TVector<THolder<IQuantizedFloatValuesHolder>> floatFeatures;
+        floatFeatures.push_back(MakeDenseFeature(0, {0, 1, 0, 0, 0, 0, 0, 0}, &subsetIndexing));
+        floatFeatures.push_back(MakeDenseFeature(1, {0, 0, 2, 0, 0, 0, 0, 0}, &subsetIndexing));
+
+        // conflicts with feature 0 on object 1
+        floatFeatures.push_back(
+            MakeHolder<TSparseQuantizedFloatValuesHolder>(
+                2,
+                MakeAtomicShared<TSparseQuantizedFloatValuesHolder::TSrcData>(
+                    TSparseQuantizedFloatValuesHolder::TSrcData::CreateFromDense(
+                        TVector<ui8>{1, 2, 1, 1, 0, 1, 1, 1},
+                        1
+                    )
+                ),
+                &subsetIndexing
+            )
+        );
+
+        // too many non-default objects
+        floatFeatures.push_back(MakeDenseFeature(3, {1, 2, 1, 2, 1, 2, 0, 0}, &subsetIndexing));
+
+        // ignored
+        floatFeatures.push_back(nullptr);
+
+        TVector<ui32> binCounts = {3, 3, 3, 3, 0};
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(1);
+
+        const auto bundles = CreateExclusiveFeaturesBundles(floatFeatures, binCounts, objectCount, &localExecutor);
+
+        TExclusiveFeaturesBundle expectedBundle;
+        expectedBundle.Add(2, 3, 1);
+        expectedBundle.Add(1, 3, 0);
+
+        UNIT_ASSERT_VALUES_EQUAL(bundles.size(), 1);
+        UNIT_ASSERT(bundles[0] == expectedBundle);
+
+        const auto bundleColumn = CreateExclusiveFeaturesBundleColumn(bundles[0], floatFeatures, &subsetIndexing);
+
+        UNIT_ASSERT_VALUES_EQUAL(bundleColumn->GetId(), 2);
+
+        const auto bundleBins = bundleColumn->ExtractValues(&localExecutor);
+        const TVector<ui8> expectedBundleBins = {0, 2, 4, 0, 1, 0, 0, 0};
+        UNIT_ASSERT_VALUES_EQUAL((*bundleBins).size(), expectedBundleBins.size());
+        UNIT_ASSERT(Equal(expectedBundleBins.begin(), expectedBundleBins.end(), (*bundleBins).begin()));
+    }
+}
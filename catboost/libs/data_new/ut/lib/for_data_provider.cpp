@@ -2,8 +2,10 @@
 
 #include <catboost/libs/cat_feature/cat_feature.h>
 #include <catboost/libs/data_new/util.h>
+#include <catboost/libs/helpers/math_utils.h>
 #include <catboost/libs/helpers/vector_helpers.h>
 
+#include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
 #include <util/generic/string.h>
 #include <util/generic/xrange.h>
@@ -98,17 +100,33 @@ namespace NCB {
         CompareSubgroupIds(objectsData.GetSubgroupIds(), expectedData.Objects.SubgroupIds);
         Compare(objectsData.GetTimestamp(), expectedData.Objects.Timestamp);
 
-        CompareFeatures<EFeatureType::Float, float, TFloatValuesHolder>(
+        NPar::TLocalExecutor localExecutor;
+
+        // features can be stored densely or sparsely
+        CompareFeatures<EFeatureType::Float, float, IFeatureValuesHolder>(
             *objectsData.GetFeaturesLayout(),
-            /*getFeatureFunc*/ [&] (ui32 floatFeatureIdx) {
-                return objectsData.GetFloatFeature(floatFeatureIdx);
+            /*getFeatureFunc*/ [&] (ui32 floatFeatureIdx) -> TMaybeData<const IFeatureValuesHolder*> {
+                if (auto sparseFeature = objectsData.GetSparseFloatFeature(floatFeatureIdx)) {
+                    return TMaybeData<const IFeatureValuesHolder*>(*sparseFeature);
+                }
+                if (auto denseFeature = objectsData.GetFloatFeature(floatFeatureIdx)) {
+                    return TMaybeData<const IFeatureValuesHolder*>(*denseFeature);
+                }
+                return Nothing();
             },
             /*getExpectedFeatureFunc*/ [&] (ui32 floatFeatureIdx) {
                 UNIT_ASSERT(floatFeatureIdx < expectedData.Objects.FloatFeatures.size());
                 return expectedData.Objects.FloatFeatures[floatFeatureIdx];
             },
-            /*areEqualFunc*/ [&](const TVector<float>& lhs, const TFloatValuesHolder& rhs) {
-                return EqualWithNans<float>(lhs, rhs.GetArrayData());
+            /*areEqualFunc*/ [&](const TVector<float>& lhs, const IFeatureValuesHolder& rhs) {
+                if (const auto* sparseFeature = dynamic_cast<const TSparseFloatValuesHolder*>(&rhs)) {
+                    const auto values = sparseFeature->ExtractValues(&localExecutor);
+                    return (lhs.size() == (*values).size()) && AllOf(
+                        xrange(lhs.size()),
+                        [&] (size_t i) { return EqualWithNans(lhs[i], (*values)[i]); }
+                    );
+                }
+                return EqualWithNans<float>(lhs, dynamic_cast<const TFloatValuesHolder&>(rhs).GetArrayData());
             }
         );
 
@@ -0,0 +1,128 @@
+#include <catboost/libs/data_new/ut/lib/for_data_provider.h>
+
+#include <catboost/libs/data_new/columnar_pool_format.h>
+#include <catboost/libs/data_new/data_provider.h>
+#include <catboost/libs/data_new/load_data.h>
+#include <catboost/libs/data_new/objects_grouping.h>
+
+#include <util/generic/strbuf.h>
+#include <util/stream/file.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCB;
+using namespace NCB::NDataNewUT;
+
+
+Y_UNIT_TEST_SUITE(LoadDataFromColumnar) {
+    Y_UNIT_TEST(ReadDataset) {
+        TTempFile poolFile(MakeTempName());
+        {
+            TColumnarPoolWriter writer(poolFile.Name(), 6);
+            writer.AddFloatColumn(EColumn::Label, TVector<float>{0.5f, 1.0f, 0.0f, 2.0f, 0.25f, 3.0f});
+            writer.AddStringColumn(
+                EColumn::GroupId,
+                TVector<TString>{"query0", "query0", "query1", "Query 2", "Query 2", "Query 2"}
+            );
+            writer.AddStringColumn(
+                EColumn::SubgroupId,
+                TVector<TString>{"site1", "site22", "Site9", "site12", "site22", "Site45"}
+            );
+            writer.AddFloatColumn(EColumn::Weight, TVector<float>{0.12f, 0.18f, 1.0f, 0.45f, 1.0f, 2.0f});
+            writer.AddFloatColumn(EColumn::Num, TVector<float>{0.1f, 0.97f, 0.13f, 0.14f, 0.9f, 0.66f}, "f0");
+            writer.AddStringColumn(EColumn::Categ, TVector<TString>{"a", "b", "", "a", "c", "b"}, "c0");
+            writer.AddFloatColumn(EColumn::Num, TVector<float>{0.2f, 0.82f, 0.22f, 0.18f, 0.67f, 0.1f}, "f1");
+            writer.Finish();
+        }
+
+        TExpectedRawData expectedData;
+
+        TDataColumnsMetaInfo dataColumnsMetaInfo;
+        dataColumnsMetaInfo.Columns = {
+            {EColumn::Label, ""},
+            {EColumn::GroupId, ""},
+            {EColumn::SubgroupId, ""},
+            {EColumn::Weight, ""},
+            {EColumn::Num, "f0"},
+            {EColumn::Categ, "c0"},
+            {EColumn::Num, "f1"}
+        };
+
+        TVector<TString> featureId = {"f0", "c0", "f1"};
+
+        expectedData.MetaInfo = TDataMetaInfo(std::move(dataColumnsMetaInfo), false, false, &featureId);
+        expectedData.Objects.Order = EObjectsOrder::Ordered;
+        expectedData.Objects.GroupIds = TVector<TStringBuf>{
+            "query0",
+            "query0",
+            "query1",
+            "Query 2",
+            "Query 2",
+            "Query 2"
+        };
+        expectedData.Objects.SubgroupIds = TVector<TStringBuf>{
+            "site1",
+            "site22",
+            "Site9",
+            "site12",
+            "site22",
+            "Site45"
+        };
+        expectedData.Objects.FloatFeatures = {
+            TVector<float>{0.1f, 0.97f, 0.13f, 0.14f, 0.9f, 0.66f},
+            TVector<float>{0.2f, 0.82f, 0.22f, 0.18f, 0.67f, 0.1f}
+        };
+        expectedData.Objects.CatFeatures = {
+            TVector<TStringBuf>{"a", "b", "", "a", "c", "b"}
+        };
+
+        expectedData.ObjectsGrouping = TObjectsGrouping(
+            TVector<TGroupBounds>{{0, 2}, {2, 3}, {3, 6}}
+        );
+        expectedData.Target.Target = TVector<TString>{"0.5", "1", "0", "2", "0.25", "3"};
+        expectedData.Target.Weights = TWeights<float>(
+            TVector<float>{0.12f, 0.18f, 1.0f, 0.45f, 1.0f, 2.0f}
+        );
+        expectedData.Target.GroupWeights = TWeights<float>(6);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        TDataProviderPtr dataProvider = ReadDataset(
+            TPathWithScheme("columnar://" + poolFile.Name()),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            NCatboostOptions::TDsvPoolFormatParams(),
+            /*ignoredFeatures*/ {},
+            EObjectsOrder::Ordered,
+            &localExecutor
+        );
+
+        Compare<TRawObjectsDataProvider>(std::move(dataProvider), expectedData);
+    }
+
+    Y_UNIT_TEST(BadMagic) {
+        TTempFile poolFile(MakeTempName());
+        {
+            TFileOutput output(poolFile.Name());
+            output.Write(TString(64, 'x'));
+        }
+
+        NPar::TLocalExecutor localExecutor;
+        UNIT_ASSERT_EXCEPTION(
+            ReadDataset(
+                TPathWithScheme("columnar://" + poolFile.Name()),
+                TPathWithScheme(),
+                TPathWithScheme(),
+                NCatboostOptions::TDsvPoolFormatParams(),
+                /*ignoredFeatures*/ {},
+                EObjectsOrder::Undefined,
+                &localExecutor
+            ),
+            TCatBoostException
+        );
+    }
+}
@@ -701,4 +701,77 @@ Y_UNIT_TEST_SUITE(LoadDataFromDsv) {
             Test(testCase);
         }
     }
+
+    // memory mapped file is parsed by chunks in parallel, the result must be the same as for line by line reading
+    Y_UNIT_TEST(ReadDatasetMapped) {
+        TSrcData srcData;
+        srcData.CdFileData = AsStringBuf(
+            "0\tTarget\n"
+            "1\tGroupId\n"
+            "2\tNum\tf0\n"
+            "3\tCateg\tc0\n"
+            "4\tNum\tf1\n"
+        );
+        srcData.DsvFileData = AsStringBuf(
+            "Target\tGroup\tf0\tc0\tf1\n"
+            "0.12\tquery0\t0.1\tRussia\t0.2\n"
+            "0.22\tquery0\t0.97\tGermany\t0.82\n"
+            "0.34\tquery1\t0.13\t\t0.22\n"
+            "0.42\tQuery 2\t\tUSA\t0.1"
+        );
+        srcData.DsvFileHasHeader = true;
+        srcData.ObjectsOrder = EObjectsOrder::Ordered;
+
+        TReadDatasetMainParams readDatasetMainParams;
+        TVector<THolder<TTempFile>> srcDataFiles;
+        SaveSrcData(srcData, &readDatasetMainParams, &srcDataFiles);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        TDataProviderPtr dataProvider = ReadDataset(
+            TPathWithScheme("mmap://" + readDatasetMainParams.PoolPath.Path),
+            TPathWithScheme(),
+            TPathWithScheme(),
+            readDatasetMainParams.DsvPoolFormatParams,
+            srcData.IgnoredFeatures,
+            srcData.ObjectsOrder,
+            &localExecutor
+        );
+
+
+        TExpectedRawData expectedData;
+
+        TDataColumnsMetaInfo dataColumnsMetaInfo;
+        dataColumnsMetaInfo.Columns = {
+            {EColumn::Label, ""},
+            {EColumn::GroupId, ""},
+            {EColumn::Num, "f0"},
+            {EColumn::Categ, "c0"},
+            {EColumn::Num, "f1"},
+        };
+
+        TVector<TString> featureId = {"f0", "c0", "f1"};
+
+        expectedData.MetaInfo = TDataMetaInfo(std::move(dataColumnsMetaInfo), false, false, &featureId);
+        expectedData.Objects.Order = EObjectsOrder::Ordered;
+        expectedData.Objects.GroupIds = TVector<TStringBuf>{"query0", "query0", "query1", "Query 2"};
+
+        auto nanValue = std::numeric_limits<float>::quiet_NaN();
+
+        expectedData.Objects.FloatFeatures = {
+            TVector<float>{0.1f, 0.97f, 0.13f, nanValue},
+            TVector<float>{0.2f, 0.82f, 0.22f, 0.1f}
+        };
+        expectedData.Objects.CatFeatures = {TVector<TStringBuf>{"Russia", "Germany", "", "USA"}};
+
+        expectedData.ObjectsGrouping = TObjectsGrouping(
+            TVector<TGroupBounds>{{0, 2}, {2, 3}, {3, 4}}
+        );
+        expectedData.Target.Target = TVector<TString>{"0.12", "0.22", "0.34", "0.42"};
+        expectedData.Target.Weights = TWeights<float>(4);
+        expectedData.Target.GroupWeights = TWeights<float>(4);
+
+        Compare<TRawObjectsDataProvider>(std::move(dataProvider), expectedData);
+    }
 }
@@ -0,0 +1,188 @@
+#include <catboost/libs/data_new/ut/lib/for_data_provider.h>
+#include <catboost/libs/data_new/ut/lib/for_loader.h>
+
+#include <catboost/libs/data_new/load_data.h>
+
+#include <catboost/libs/data_new/data_provider.h>
+#include <catboost/libs/data_new/objects_grouping.h>
+
+#include <util/generic/maybe.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/xrange.h>
+
+#include <library/unittest/registar.h>
+
+
+using namespace NCB;
+using namespace NCB::NDataNewUT;
+
+
+Y_UNIT_TEST_SUITE(LoadDataFromLibSvm) {
+    struct TTestCase {
+        TSrcData SrcData;
+        TExpectedRawData ExpectedData;
+    };
+
+    void Test(const TTestCase& testCase) {
+        TReadDatasetMainParams readDatasetMainParams;
+
+        // TODO(akhropov): temporarily use THolder until TTempFile move semantic are fixed
+        TVector<THolder<TTempFile>> srcDataFiles;
+
+        SaveSrcData(testCase.SrcData, &readDatasetMainParams, &srcDataFiles);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        TDataProviderPtr dataProvider = ReadDataset(
+            TPathWithScheme("libsvm://" + readDatasetMainParams.PoolPath.Path),
+            readDatasetMainParams.PairsFilePath, // can be uninited
+            readDatasetMainParams.GroupWeightsFilePath, // can be uninited
+            readDatasetMainParams.DsvPoolFormatParams,
+            testCase.SrcData.IgnoredFeatures,
+            testCase.SrcData.ObjectsOrder,
+            &localExecutor
+        );
+
+        // libsvm data is loaded to sparse columns
+        const auto* rawObjectsData = dynamic_cast<const TRawObjectsDataProvider*>(
+            dataProvider->ObjectsData.Get()
+        );
+        UNIT_ASSERT(rawObjectsData);
+        const auto& featuresLayout = *rawObjectsData->GetFeaturesLayout();
+        for (auto floatFeatureIdx : xrange(featuresLayout.GetFloatFeatureCount())) {
+            const bool isAvailable = featuresLayout.GetInternalFeatureMetaInfo(
+                floatFeatureIdx,
+                EFeatureType::Float
+            ).IsAvailable;
+            UNIT_ASSERT_VALUES_EQUAL(rawObjectsData->IsSparseFloatFeature(floatFeatureIdx), isAvailable);
+        }
+
+        Compare<TRawObjectsDataProvider>(std::move(dataProvider), testCase.ExpectedData);
+    }
+
+    TDataMetaInfo MakeExpectedMetaInfo(bool hasGroupIds, ui32 featureCount, bool hasPairs) {
+        TDataColumnsMetaInfo dataColumnsMetaInfo;
+        dataColumnsMetaInfo.Columns.push_back({EColumn::Label, ""});
+        if (hasGroupIds) {
+            dataColumnsMetaInfo.Columns.push_back({EColumn::GroupId, ""});
+        }
+        dataColumnsMetaInfo.Columns.resize(
+            dataColumnsMetaInfo.Columns.size() + featureCount,
+            TColumn{EColumn::Num, ""}
+        );
+
+        auto featureIds = dataColumnsMetaInfo.GenerateFeatureIds(Nothing());
+        return TDataMetaInfo(std::move(dataColumnsMetaInfo), false, hasPairs, &featureIds);
+    }
+
+
+    Y_UNIT_TEST(ReadDataset) {
+        TVector<TTestCase> testCases;
+
+        {
+            TTestCase simpleTestCase;
+            TSrcData srcData;
+            srcData.DsvFileData = AsStringBuf(
+                "1 1:0.1 3:0.2\n"
+                "0 2:0.97\n"
+                "1\n"
+                "0 1:0.13 2:0 3:-1\n"
+            );
+            simpleTestCase.SrcData = std::move(srcData);
+
+
+            TExpectedRawData expectedData;
+            expectedData.MetaInfo = MakeExpectedMetaInfo(/*hasGroupIds*/ false, /*featureCount*/ 3, false);
+            expectedData.Objects.FloatFeatures = {
+                TVector<float>{0.1f, 0.0f, 0.0f, 0.13f},
+                TVector<float>{0.0f, 0.97f, 0.0f, 0.0f},
+                TVector<float>{0.2f, 0.0f, 0.0f, -1.0f}
+            };
+
+            expectedData.ObjectsGrouping = TObjectsGrouping(4);
+            expectedData.Target.Target = TVector<TString>{"1", "0", "1", "0"};
+            expectedData.Target.Weights = TWeights<float>(4);
+            expectedData.Target.GroupWeights = TWeights<float>(4);
+
+            simpleTestCase.ExpectedData = std::move(expectedData);
+
+            testCases.push_back(std::move(simpleTestCase));
+        }
+
+        {
+            TTestCase groupDataTestCase;
+            TSrcData srcData;
+            srcData.DsvFileData = AsStringBuf(
+                "0.12 qid:0 1:0.1 4:0.2\n"
+                "0.22 qid:0 2:0.97\n"
+                "0.34 qid:1 1:0.13 3:0.22 4:0.23\n"
+                "0.42 qid:2\n"
+                "0.01 qid:2 3:0.67\n"
+            );
+            srcData.PairsFileData = AsStringBuf(
+                "0\t1\t1.0\n"
+                "4\t3\t0.5\n"
+            );
+            srcData.IgnoredFeatures = {1};
+            srcData.ObjectsOrder = EObjectsOrder::Ordered;
+            groupDataTestCase.SrcData = std::move(srcData);
+
+
+            TExpectedRawData expectedData;
+            expectedData.MetaInfo = MakeExpectedMetaInfo(/*hasGroupIds*/ true, /*featureCount*/ 4, true);
+            expectedData.MetaInfo.FeaturesLayout->IgnoreExternalFeature(1);
+            expectedData.Objects.Order = EObjectsOrder::Ordered;
+            expectedData.Objects.GroupIds = TVector<TStringBuf>{"0", "0", "1", "2", "2"};
+            expectedData.Objects.FloatFeatures = {
+                TVector<float>{0.1f, 0.0f, 0.13f, 0.0f, 0.0f},
+                Nothing(),
+                TVector<float>{0.0f, 0.0f, 0.22f, 0.0f, 0.67f},
+                TVector<float>{0.2f, 0.0f, 0.23f, 0.0f, 0.0f}
+            };
+
+            expectedData.ObjectsGrouping = TObjectsGrouping(
+                TVector<TGroupBounds>{{0, 2}, {2, 3}, {3, 5}}
+            );
+            expectedData.Target.Target = TVector<TString>{"0.12", "0.22", "0.34", "0.42", "0.01"};
+            expectedData.Target.Weights = TWeights<float>(5);
+            expectedData.Target.GroupWeights = TWeights<float>(5);
+            expectedData.Target.Pairs = {TPair(0, 1, 1.0f), TPair(4, 3, 0.5f)};
+
+            groupDataTestCase.ExpectedData = std::move(expectedData);
+
+            testCases.push_back(std::move(groupDataTestCase));
+        }
+
+        for (const auto& testCase : testCases) {
+            Test(testCase);
+        }
+    }
+
+    Y_UNIT_TEST(BadLine) {
+        TSrcData srcData;
+        srcData.DsvFileData = AsStringBuf(
+            "1 1:0.1\n"
+            "0 2:0.97 1:0.2\n"
+        );
+
+        TReadDatasetMainParams readDatasetMainParams;
+        TVector<THolder<TTempFile>> srcDataFiles;
+        SaveSrcData(srcData, &readDatasetMainParams, &srcDataFiles);
+
+        NPar::TLocalExecutor localExecutor;
+
+        UNIT_ASSERT_EXCEPTION(
+            ReadDataset(
+                TPathWithScheme("libsvm://" + readDatasetMainParams.PoolPath.Path),
+                TPathWithScheme(),
+                TPathWithScheme(),
+                readDatasetMainParams.DsvPoolFormatParams,
+                /*ignoredFeatures*/ {},
+                EObjectsOrder::Undefined,
+                &localExecutor
+            ),
+            TCatBoostException
+        );
+    }
+}
@@ -790,4 +790,99 @@ Y_UNIT_TEST_SUITE(Quantization) {
 
         Test(std::move(generateTestCase));
    }
+
+    Y_UNIT_TEST(TestQuantileSketchBorders) {
+        constexpr auto quiet_NaN = std::numeric_limits<float>::quiet_NaN();
+
+        const TVector<TVector<float>> floatFeatures = {
+            {0.12f, 0.33f, 0.0f, 0.11f, 0.9f, 0.67f, 1.2f, 2.1f, 0.56f},
+            {0.88f, 0.0f, 0.12f, quiet_NaN, 0.45f, 0.19f, quiet_NaN, 0.82f, 0.11f}
+        };
+
+        auto createRawData = [&] (bool addQuantileSketches, NPar::TLocalExecutor* localExecutor) {
+            TRawBuilderData srcData;
+
+            TDataColumnsMetaInfo dataColumnsMetaInfo;
+            dataColumnsMetaInfo.Columns = {
+                {EColumn::Label, ""},
+                {EColumn::Num, ""},
+                {EColumn::Num, ""}
+            };
+            srcData.MetaInfo = TDataMetaInfo(std::move(dataColumnsMetaInfo), false, false, nullptr);
+
+            srcData.TargetData.Target = {"0", "1", "1", "0", "1", "0", "1", "0", "0"};
+            srcData.TargetData.SetTrivialWeights(9);
+
+            srcData.CommonObjectsData.FeaturesLayout = srcData.MetaInfo.FeaturesLayout;
+            srcData.CommonObjectsData.SubsetIndexing = MakeAtomicShared<TArraySubsetIndexing<ui32>>(
+                TFullSubset<ui32>(9)
+            );
+
+            ui32 featureIdx = 0;
+            InitFeatures(
+                floatFeatures,
+                *srcData.CommonObjectsData.SubsetIndexing,
+                &featureIdx,
+                &srcData.ObjectsData.FloatFeatures
+            );
+
+            if (addQuantileSketches) {
+                for (const auto& featureValues : floatFeatures) {
+                    srcData.ObjectsData.FloatFeaturesQuantileSketches.emplace_back();
+                    auto& sketch = srcData.ObjectsData.FloatFeaturesQuantileSketches.back().ConstructInPlace();
+                    for (auto value : featureValues) {
+                        sketch.Add(value);
+                    }
+                }
+            }
+
+            return MakeDataProvider<TRawObjectsDataProvider>(
+                Nothing(),
+                std::move(srcData),
+                false,
+                localExecutor
+            );
+        };
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        auto calcBorders = [&] (EBorderSelectionType borderSelectionType, bool addQuantileSketches) {
+            TRawDataProviderPtr rawDataProvider = createRawData(addQuantileSketches, &localExecutor);
+
+            auto quantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
+                *rawDataProvider->MetaInfo.FeaturesLayout,
+                TConstArrayRef<ui32>(),
+                NCatboostOptions::TBinarizationOptions(borderSelectionType, 4, ENanMode::Min)
+            );
+
+            TRestorableFastRng64 rand(0);
+            CalcBordersAndNanMode(
+                TQuantizationOptions{true, false},
+                rawDataProvider,
+                quantizedFeaturesInfo,
+                &rand,
+                &localExecutor
+            );
+            return quantizedFeaturesInfo;
+        };
+
+        // sketches are exact for small data so borders must be the same as for Median
+        auto expectedQuantizedFeaturesInfo = calcBorders(EBorderSelectionType::Median, false);
+
+        for (auto addQuantileSketches : {false, true}) {
+            auto quantizedFeaturesInfo = calcBorders(EBorderSelectionType::QuantileSketch, addQuantileSketches);
+            for (auto i : xrange(floatFeatures.size())) {
+                const auto floatFeatureIdx = TFloatFeatureIdx(i);
+                UNIT_ASSERT_EQUAL(
+                    quantizedFeaturesInfo->GetNanMode(floatFeatureIdx),
+                    expectedQuantizedFeaturesInfo->GetNanMode(floatFeatureIdx)
+                );
+                UNIT_ASSERT_VALUES_EQUAL(
+                    quantizedFeaturesInfo->GetBorders(floatFeatureIdx),
+                    expectedQuantizedFeaturesInfo->GetBorders(floatFeatureIdx)
+                );
+            }
+        }
+    }
 }
@@ -10,6 +10,7 @@
 #include <catboost/libs/data_types/pair.h>
 #include <catboost/libs/helpers/maybe_owning_array_holder.h>
 #include <catboost/libs/helpers/resource_holder.h>
+#include <catboost/libs/helpers/sparse_array.h>
 #include <catboost/libs/helpers/vector_helpers.h>
 #include <catboost/libs/quantization_schema/schema.h>
 
@@ -63,6 +64,11 @@ namespace NCB {
     public:
         constexpr static EDatasetVisitorType Type = EDatasetVisitorType::RawObjectsOrder;
 
+        /* can be passed as objectCount to Start if !inBlock and object count is not known in advance,
+         * then the data grows with StartNextBlock calls and object count is the sum of block sizes
+         */
+        constexpr static ui32 UNKNOWN_OBJECT_COUNT = Max<ui32>();
+
     public:
         EDatasetVisitorType GetType() const override {
             return Type;
@@ -139,6 +145,9 @@ namespace NCB {
         // shared ownership is passed to IRawFeaturesOrderDataVisitor
         virtual void AddFloatFeature(ui32 flatFeatureIdx, TMaybeOwningConstArrayHolder<float> features) = 0;
 
+        // only non-default values are stored, the feature is not densified
+        virtual void AddSparseFloatFeature(ui32 flatFeatureIdx, TSparseArray<float, ui32>&& features) = 0;
+
         virtual void AddCatFeature(ui32 flatFeatureIdx, TConstArrayRef<TString> feature) = 0;
         virtual void AddCatFeature(ui32 flatFeatureIdx, TConstArrayRef<TStringBuf> feature) = 0;
 
@@ -13,6 +13,8 @@ namespace NCB {
     TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSExistsCheckerReg("");
     TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSFileExistsCheckerReg("file");
     TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSDsvExistsCheckerReg("dsv");
+    TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSLibSvmExistsCheckerReg("libsvm");
+    TExistsCheckerFactory::TRegistrator<TFSExistsChecker> FSMappedFileExistsCheckerReg("mmap");
 
     }
 }
@@ -2,7 +2,9 @@
 
 #include <catboost/libs/helpers/exception.h>
 
+#include <util/generic/algorithm.h>
 #include <util/stream/file.h>
+#include <util/stream/input.h>
 #include <util/system/fs.h>
 
 
@@ -17,6 +19,94 @@ namespace NCB {
     }
 
 
+    // removes '\n' or "\r\n" like IInputStream::ReadLine
+    static TStringBuf NextLine(TStringBuf* data) {
+        TStringBuf line = data->NextTok('\n');
+        line.ChopSuffix("\r");
+        return line;
+    }
+
+
+    TMappedFileLineDataReader::TMappedFileLineDataReader(const TLineDataReaderArgs& args)
+        : Args(args)
+        , HeaderProcessed(!Args.Format.HasHeader)
+    {
+        CB_ENSURE(
+            NFs::Exists(Args.PathWithScheme.Path),
+            "pool file '" << Args.PathWithScheme.Path << "' is not found"
+        );
+        Data = TBlob::FromFile(Args.PathWithScheme.Path);
+        Unread = TStringBuf(Data.AsCharPtr(), Data.Size());
+    }
+
+    ui64 TMappedFileLineDataReader::GetDataLineCount() {
+        TStringBuf data(Data.AsCharPtr(), Data.Size());
+        ui64 nLines = Count(data, '\n');
+        if (data && (data.back() != '\n')) {
+            ++nLines;
+        }
+        if (Args.Format.HasHeader) {
+            --nLines;
+        }
+        return nLines;
+    }
+
+    TMaybe<TString> TMappedFileLineDataReader::GetHeader() {
+        if (Args.Format.HasHeader) {
+            CB_ENSURE(!HeaderProcessed, "TMappedFileLineDataReader: multiple calls to GetHeader");
+            CB_ENSURE(Unread, "TMappedFileLineDataReader: no header in file");
+            HeaderProcessed = true;
+            return TString(NextLine(&Unread));
+        }
+
+        return {};
+    }
+
+    bool TMappedFileLineDataReader::ReadLine(TString* line) {
+        TStringBuf lineBuf;
+        if (!ReadLine(&lineBuf)) {
+            return false;
+        }
+        *line = lineBuf;
+        return true;
+    }
+
+    bool TMappedFileLineDataReader::ReadLine(TStringBuf* line) {
+        SkipHeader();
+        if (!Unread) {
+            return false;
+        }
+        *line = NextLine(&Unread);
+        return true;
+    }
+
+    TVector<TStringBuf> TMappedFileLineDataReader::ReadChunks(size_t chunkSize) {
+        CB_ENSURE_INTERNAL(chunkSize > 0, "TMappedFileLineDataReader: chunkSize == 0");
+        SkipHeader();
+
+        TVector<TStringBuf> chunks;
+        while (Unread) {
+            size_t chunkEnd = Unread.find('\n', Min(chunkSize, Unread.size()) - 1);
+            chunkEnd = (chunkEnd == TStringBuf::npos) ? Unread.size() : (chunkEnd + 1);
+            chunks.push_back(Unread.Head(chunkEnd));
+            Unread.Skip(chunkEnd);
+        }
+        return chunks;
+    }
+
+    void TMappedFileLineDataReader::SplitToLines(TStringBuf chunk, TVector<TStringBuf>* lines) {
+        while (chunk) {
+            lines->push_back(NextLine(&chunk));
+        }
+    }
+
+    void TMappedFileLineDataReader::SkipHeader() {
+        if (!HeaderProcessed) {
+            GetHeader();
+        }
+    }
+
+
     namespace {
 
     template <class TStr>
@@ -31,15 +121,27 @@ namespace NCB {
         return count;
     }
 
+    // path "-" means standard input, it can be read only once so only block processing is possible
     class TFileLineDataReader : public ILineDataReader {
     public:
         TFileLineDataReader(const TLineDataReaderArgs& args)
             : Args(args)
-            , IFStream(args.PathWithScheme.Path)
             , HeaderProcessed(!Args.Format.HasHeader)
-        {}
+        {
+            if (IsStdInput()) {
+                Input = &Cin;
+            } else {
+                IFStream = MakeHolder<TIFStream>(args.PathWithScheme.Path);
+                Input = IFStream.Get();
+            }
+        }
 
         ui64 GetDataLineCount() override {
+            CB_ENSURE(
+                !IsStdInput(),
+                "TFileLineDataReader: data line count is unknown for standard input,"
+                " it can be processed only in blocks"
+            );
             ui64 nLines = (ui64)CountLines(Args.PathWithScheme.Path);
             if (Args.Format.HasHeader) {
                 --nLines;
@@ -51,7 +153,7 @@ namespace NCB {
             if (Args.Format.HasHeader) {
                 CB_ENSURE(!HeaderProcessed, "TFileLineDataReader: multiple calls to GetHeader");
                 TString header;
-                CB_ENSURE(IFStream.ReadLine(header), "TFileLineDataReader: no header in file");
+                CB_ENSURE(Input->ReadLine(header), "TFileLineDataReader: no header in file");
                 HeaderProcessed = true;
                 return header;
             }
@@ -64,12 +166,18 @@ namespace NCB {
             if (!HeaderProcessed) {
                 GetHeader();
             }
-            return IFStream.ReadLine(*line) != 0;
+            return Input->ReadLine(*line) != 0;
+        }
+
+    private:
+        bool IsStdInput() const {
+            return Args.PathWithScheme.Path == "-";
         }
 
     private:
         TLineDataReaderArgs Args;
-        TIFStream IFStream;
+        THolder<TIFStream> IFStream; // not used for standard input
+        IInputStream* Input;
         bool HeaderProcessed;
     };
 
@@ -77,6 +185,8 @@ namespace NCB {
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DefLineDataReaderReg("");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> FileLineDataReaderReg("file");
     TLineDataReaderFactory::TRegistrator<TFileLineDataReader> DsvLineDataReaderReg("dsv");
+    TLineDataReaderFactory::TRegistrator<TFileLineDataReader> LibSvmLineDataReaderReg("libsvm");
+    TLineDataReaderFactory::TRegistrator<TMappedFileLineDataReader> MappedFileLineDataReaderReg("mmap");
 
     }
 }
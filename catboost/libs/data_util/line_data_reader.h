@@ -5,7 +5,10 @@
 #include <library/object_factory/object_factory.h>
 
 #include <util/generic/maybe.h>
+#include <util/generic/strbuf.h>
 #include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/memory/blob.h>
 
 
 
@@ -41,6 +44,41 @@ namespace NCB {
         virtual ~ILineDataReader() = default;
     };
 
+    /* scheme "mmap": the whole file is memory mapped, so lines are available without copying and
+     * data can be split into chunks of whole lines to be processed in parallel (see TCBDsvDataLoader)
+     */
+    class TMappedFileLineDataReader : public ILineDataReader {
+    public:
+        explicit TMappedFileLineDataReader(const TLineDataReaderArgs& args);
+
+        // scans mapped data, so it is cheaper than for TFileLineDataReader but still not free
+        ui64 GetDataLineCount() override;
+
+        TMaybe<TString> GetHeader() override;
+
+        bool ReadLine(TString* line) override;
+
+        // line is a reference to the mapped data without line end
+        bool ReadLine(TStringBuf* line);
+
+        /* all unread data lines split into chunks of approximately chunkSize bytes
+         * (a chunk contains whole lines, line ends are not removed), chunks are marked as read
+         */
+        TVector<TStringBuf> ReadChunks(size_t chunkSize);
+
+        // append chunk lines without line ends to lines
+        static void SplitToLines(TStringBuf chunk, TVector<TStringBuf>* lines);
+
+    private:
+        void SkipHeader();
+
+    private:
+        TLineDataReaderArgs Args;
+        TBlob Data;
+        TStringBuf Unread;
+        bool HeaderProcessed;
+    };
+
     using TLineDataReaderFactory =
         NObjectFactory::TParametrizedObjectFactory<ILineDataReader, TString, TLineDataReaderArgs>;
 
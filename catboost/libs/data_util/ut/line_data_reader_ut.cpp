@@ -0,0 +1,88 @@
+#include <library/unittest/registar.h>
+
+#include <catboost/libs/data_util/line_data_reader.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/stream/file.h>
+#include <util/system/mktemp.h>
+#include <util/system/tempfile.h>
+
+#include <cstdio>
+
+
+using namespace NCB;
+
+
+static THolder<ILineDataReader> GetReader(const TString& path, bool hasHeader) {
+    TDsvFormatOptions format;
+    format.HasHeader = hasHeader;
+    return GetLineDataReader(TPathWithScheme("mmap://" + path), format);
+}
+
+
+Y_UNIT_TEST_SUITE(TMappedFileLineDataReaderTest) {
+    Y_UNIT_TEST(ReadLines) {
+        TTempFile file(MakeTempName());
+        TOFStream(file.Name()).Write("h0\th1\r\na\tb\n\nc\td");
+
+        auto reader = GetReader(file.Name(), true);
+        UNIT_ASSERT_VALUES_EQUAL(reader->GetDataLineCount(), 3);
+        UNIT_ASSERT_VALUES_EQUAL(*reader->GetHeader(), "h0\th1");
+
+        TVector<TString> lines;
+        TString line;
+        while (reader->ReadLine(&line)) {
+            lines.push_back(line);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(lines, (TVector<TString>{"a\tb", "", "c\td"}));
+    }
+
+    Y_UNIT_TEST(ReadChunks) {
+        TTempFile file(MakeTempName());
+        TOFStream(file.Name()).Write("header\n0\n11\n222\n3333\n44444\n");
+
+        auto reader = GetReader(file.Name(), true);
+        auto* mappedReader = dynamic_cast<TMappedFileLineDataReader*>(reader.Get());
+        UNIT_ASSERT(mappedReader);
+
+        TString firstLine;
+        UNIT_ASSERT(reader->ReadLine(&firstLine));
+        UNIT_ASSERT_VALUES_EQUAL(firstLine, "0");
+
+        const TVector<TStringBuf> chunks = mappedReader->ReadChunks(4);
+        UNIT_ASSERT_VALUES_EQUAL(chunks, (TVector<TStringBuf>{"11\n222\n", "3333\n", "44444\n"}));
+
+        TVector<TStringBuf> lines;
+        for (auto chunk : chunks) {
+            TMappedFileLineDataReader::SplitToLines(chunk, &lines);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(lines, (TVector<TStringBuf>{"11", "222", "3333", "44444"}));
+
+        TString line;
+        UNIT_ASSERT(!reader->ReadLine(&line));
+    }
+}
+
+
+Y_UNIT_TEST_SUITE(TFileLineDataReaderTest) {
+    Y_UNIT_TEST(ReadStdInput) {
+        TTempFile file(MakeTempName());
+        TOFStream(file.Name()).Write("h0\th1\na\tb\nc\td\n");
+
+        // Cin reads from stdin
+        UNIT_ASSERT(freopen(file.Name().c_str(), "r", stdin));
+
+        TDsvFormatOptions format;
+        format.HasHeader = true;
+        auto reader = GetLineDataReader(TPathWithScheme("-"), format);
+        UNIT_ASSERT_EXCEPTION(reader->GetDataLineCount(), TCatBoostException);
+        UNIT_ASSERT_VALUES_EQUAL(*reader->GetHeader(), "h0\th1");
+
+        TVector<TString> lines;
+        TString line;
+        while (reader->ReadLine(&line)) {
+            lines.push_back(line);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(lines, (TVector<TString>{"a\tb", "c\td"}));
+    }
+}
@@ -6,6 +6,7 @@
 #include <catboost/libs/algo/online_predictor.h>
 #include <catboost/libs/algo/pairwise_scoring.h>
 #include <catboost/libs/algo/score_bin.h>
+#include <catboost/libs/algo/scratch_arena.h>
 #include <catboost/libs/algo/target_classifier.h>
 #include <catboost/libs/data_new/data_provider.h>
 #include <catboost/libs/helpers/restorable_rng.h>
@@ -104,6 +105,7 @@ struct TLocalTensorSearchData {
     TCalcScoreFold SampledDocs;
     TCalcScoreFold SmallestSplitSideDocs;
     TBucketStatsCache PrevTreeLevelStats;
+    TIterationScratchArena ScratchArena;
     THolder<TRestorableFastRng64> Rand;
 
     // data used by CalcScore, SetPermutedIndices, CalcApprox, CalcWeightedDerivatives
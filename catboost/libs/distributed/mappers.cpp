@@ -99,6 +99,7 @@ void TTensorSearchStarter::DoMap(NPar::IUserContext* /*ctx*/, int /*hostId*/, TI
     if (localData.UseTreeLevelCaching) {
         localData.PrevTreeLevelStats.GarbageCollect();
     }
+    localData.ScratchArena.Reset();
 }
 
 void TBootstrapMaker::DoMap(NPar::IUserContext* /*ctx*/, int /*hostId*/, TInput* /*unused*/, TOutput* /*unused*/) const {
@@ -153,6 +154,7 @@ static void CalcStats3D(const NPar::TCtxPtr<TTrainData>& trainData,
         localData.Depth,
         localData.UseTreeLevelCaching,
         &NPar::LocalExecutor(),
+        &localData.ScratchArena,
         &localData.PrevTreeLevelStats,
         stats3D,
         /*pairwiseStats*/nullptr,
@@ -177,6 +179,7 @@ static void CalcPairwiseStats(const NPar::TCtxPtr<TTrainData>& trainData,
         localData.Depth,
         localData.UseTreeLevelCaching,
         &NPar::LocalExecutor(),
+        &localData.ScratchArena,
         &localData.PrevTreeLevelStats,
         /*stats3D*/nullptr,
         pairwiseStats,
@@ -0,0 +1,150 @@
+#include "binary_eval_result.h"
+
+#include "column_printer.h"
+#include "eval_helpers.h"
+
+#include <catboost/libs/column_description/column.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/cast.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+#include <util/string/cast.h>
+#include <util/ysaveload.h>
+
+#include <type_traits>
+
+
+namespace NCB {
+
+    static const char BINARY_EVAL_RESULT_MAGIC[4] = {'C', 'B', 'E', 'V'};
+    static const ui32 BINARY_EVAL_RESULT_FORMAT_VERSION = 1;
+
+
+    TBinaryEvalResultWriter::TBinaryEvalResultWriter(
+        IOutputStream* outputStream,
+        const TVector<TString>& outputColumns,
+        const TExternalLabelsHelper& visibleLabelsHelper,
+        ui32 approxDimension,
+        bool useDoublePrecision,
+        TMaybe<std::pair<size_t, size_t>> evalParameters)
+        : OutputStream(outputStream)
+        , VisibleLabelsHelper(visibleLabelsHelper)
+        , UseDoublePrecision(useDoublePrecision)
+        , ColumnCount(0)
+        , Finished(false)
+    {
+        for (const auto& columnName : outputColumns) {
+            EPredictionType predictionType;
+            if (TryFromString<EPredictionType>(columnName, predictionType)) {
+                PredictionTypes.push_back(predictionType);
+                continue;
+            }
+            EColumn columnType;
+            CB_ENSURE(
+                TryFromString<EColumn>(columnName, columnType) && (columnType == EColumn::DocId),
+                "Column " << columnName << " is not supported for binary output,"
+                " only DocId and prediction columns are supported"
+            );
+        }
+        CB_ENSURE(PredictionTypes, "No prediction type chosen for binary output");
+
+        // same as the number of TEvalResult::RawValues elements filled by block evaluation
+        const size_t evalIterationCount = evalParameters && evalParameters->first ?
+            Max<size_t>(1, (evalParameters->second + evalParameters->first - 1) / evalParameters->first)
+            : 1;
+
+        TVector<TString> columnNames;
+        for (auto predictionType : PredictionTypes) {
+            ui32 startTreeIndex = 0;
+            for (auto evalIteration : xrange(evalIterationCount)) {
+                Y_UNUSED(evalIteration);
+                const auto headers = CreatePredictionTypeHeader(
+                    approxDimension,
+                    predictionType,
+                    VisibleLabelsHelper,
+                    startTreeIndex,
+                    evalParameters.Get()
+                );
+                columnNames.insert(columnNames.end(), headers.begin(), headers.end());
+                if (evalParameters) {
+                    startTreeIndex += evalParameters->first;
+                }
+            }
+        }
+        ColumnCount = columnNames.size();
+
+        OutputStream->Write(BINARY_EVAL_RESULT_MAGIC, sizeof(BINARY_EVAL_RESULT_MAGIC));
+        ::Save(OutputStream, BINARY_EVAL_RESULT_FORMAT_VERSION);
+        ::Save(OutputStream, UseDoublePrecision ? (ui32)sizeof(double) : (ui32)sizeof(float));
+        ::Save(OutputStream, SafeIntegerCast<ui32>(ColumnCount));
+        for (const auto& columnName : columnNames) {
+            ::Save(OutputStream, SafeIntegerCast<ui32>(columnName.size()));
+            OutputStream->Write(columnName.data(), columnName.size());
+        }
+    }
+
+    template <class TValue>
+    void TBinaryEvalResultWriter::WriteValues(const TVector<double>& values) {
+        if (std::is_same<TValue, double>::value) {
+            ::SaveArray(OutputStream, values.data(), values.size());
+        } else {
+            TVector<TValue> convertedValues(values.begin(), values.end());
+            ::SaveArray(OutputStream, convertedValues.data(), convertedValues.size());
+        }
+    }
+
+    void TBinaryEvalResultWriter::WriteBlock(
+        const TEvalResult& evalResult,
+        ui64 docIdOffset,
+        NPar::TLocalExecutor* executor) {
+
+        CB_ENSURE_INTERNAL(!Finished, "TBinaryEvalResultWriter: WriteBlock after Finish");
+
+        const auto& rawValues = evalResult.GetRawValuesConstRef();
+        const size_t objectCount = (rawValues.empty() || rawValues[0].empty()) ? 0 : rawValues[0][0].size();
+        if (!objectCount) {
+            return;
+        }
+
+        ::Save(OutputStream, SafeIntegerCast<ui32>(objectCount));
+
+        TVector<ui64> docIds;
+        docIds.yresize(objectCount);
+        for (auto i : xrange(objectCount)) {
+            docIds[i] = docIdOffset + i;
+        }
+        ::SaveArray(OutputStream, docIds.data(), docIds.size());
+
+        size_t writtenColumnCount = 0;
+        for (auto predictionType : PredictionTypes) {
+            for (const auto& raws : rawValues) {
+                const auto& approx = VisibleLabelsHelper.IsInitialized() ?
+                    MakeExternalApprox(raws, VisibleLabelsHelper)
+                    : raws;
+                const auto predictions = PrepareEval(predictionType, approx, executor);
+                for (const auto& column : predictions) {
+                    if (UseDoublePrecision) {
+                        WriteValues<double>(column);
+                    } else {
+                        WriteValues<float>(column);
+                    }
+                }
+                writtenColumnCount += predictions.size();
+            }
+        }
+        CB_ENSURE_INTERNAL(
+            writtenColumnCount == ColumnCount,
+            "TBinaryEvalResultWriter: written " << writtenColumnCount << " columns, but the header has "
+            << ColumnCount
+        );
+    }
+
+    void TBinaryEvalResultWriter::Finish() {
+        CB_ENSURE_INTERNAL(!Finished, "TBinaryEvalResultWriter: Finish called twice");
+        ::Save(OutputStream, ui32(0));
+        OutputStream->Flush();
+        Finished = true;
+    }
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "eval_result.h"
+
+#include <catboost/libs/labels/external_label_helper.h>
+#include <catboost/libs/options/enums.h>
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/maybe.h>
+#include <util/generic/string.h>
+#include <util/generic/vector.h>
+#include <util/stream/output.h>
+#include <util/system/types.h>
+
+#include <utility>
+
+
+namespace NCB {
+
+    /* Compact columnar output of predictions, written block by block, an alternative to tsv output
+     * for large datasets (no text formatting and parsing).
+     *
+     * Layout (numbers are written in the native byte order of the writing machine, so files are portable
+     * only between machines with the same endianness):
+     *   header:
+     *     char[4] "CBEV", ui32 format version, ui32 value size (4 for float32, 8 for float64),
+     *     ui32 column count, then for each column: ui32 name length, name bytes.
+     *     Column names are the same as tsv output headers ("Probability:Class=1" etc.)
+     *   blocks:
+     *     ui32 object count, ui64 doc ids[object count], then for each column: values[object count].
+     *   end of data:
+     *     ui32 zero object count
+     *
+     * Only prediction columns and DocId are supported, doc ids are object indices in the input data.
+     * Class predictions are written as class indices.
+     */
+    class TBinaryEvalResultWriter {
+    public:
+        TBinaryEvalResultWriter(
+            IOutputStream* outputStream,
+            const TVector<TString>& outputColumns,
+            const TExternalLabelsHelper& visibleLabelsHelper,
+            ui32 approxDimension,
+            bool useDoublePrecision,
+            TMaybe<std::pair<size_t, size_t>> evalParameters = Nothing() // (evalPeriod, iterationsLimit)
+        );
+
+        void WriteBlock(const TEvalResult& evalResult, ui64 docIdOffset, NPar::TLocalExecutor* executor);
+
+        // writes end of data mark, must be called after the last block
+        void Finish();
+
+    private:
+        template <class TValue>
+        void WriteValues(const TVector<double>& values);
+
+    private:
+        IOutputStream* OutputStream;
+        const TExternalLabelsHelper& VisibleLabelsHelper;
+        bool UseDoublePrecision;
+        TVector<EPredictionType> PredictionTypes;
+        size_t ColumnCount;
+        bool Finished;
+    };
+
+}
@@ -273,11 +273,20 @@ namespace NCB {
                         )
                     );
                 } else {
-                    const auto arrayData = (*rawObjectsData->GetFloatFeature(it->second.Index))->GetArrayData();
-                    TVector<float> floatFeaturesArray = GetSubset<float>(
-                        *arrayData.GetSrc(),
-                        *arrayData.GetSubsetIndexing()
-                    );
+                    TVector<float> floatFeaturesArray;
+                    if (const auto sparseFeature = rawObjectsData->GetSparseFloatFeature(it->second.Index)) {
+                        const auto& srcData = (**sparseFeature).GetSrcData();
+                        floatFeaturesArray.yresize((**sparseFeature).GetSize());
+                        (**sparseFeature).GetSubsetIndexing()->ForEach(
+                            [&] (ui32 idx, ui32 srcIdx) { floatFeaturesArray[idx] = srcData.GetValue(srcIdx); }
+                        );
+                    } else {
+                        const auto arrayData = (*rawObjectsData->GetFloatFeature(it->second.Index))->GetArrayData();
+                        floatFeaturesArray = GetSubset<float>(
+                            *arrayData.GetSrc(),
+                            *arrayData.GetSubsetIndexing()
+                        );
+                    }
 
                     columnPrinter.push_back(
                         MakeHolder<TArrayPrinter<float>>(
@@ -0,0 +1,122 @@
+#include "block_compressed_array.h"
+
+#include "exception.h"
+
+#include <library/blockcodecs/codecs.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+
+
+using namespace NCB;
+
+
+TBlockCompressedArray::TBlockCompressedArray(
+    TConstArrayRef<ui8> data,
+    TStringBuf codecName,
+    ui32 blockSize,
+    NPar::TLocalExecutor* localExecutor
+)
+    : Size((ui32)data.size())
+    , BlockSize(blockSize)
+{
+    CB_ENSURE(blockSize > 0, "Block size must be positive");
+    CB_ENSURE(
+        IsIn(NBlockCodecs::ListAllCodecs(), codecName),
+        "Unknown block codec " << codecName << ", available codecs are: " << NBlockCodecs::ListAllCodecsAsString()
+    );
+    Codec = NBlockCodecs::Codec(codecName);
+
+    const ui32 blockCount = (Size + BlockSize - 1) / BlockSize;
+    TVector<TVector<char>> compressedBlocks(blockCount);
+    const auto compressBlock = [&] (ui32 blockIdx) {
+        const TStringBuf block((const char*)data.data() + blockIdx * BlockSize, GetBlockLength(blockIdx));
+        auto& compressedBlock = compressedBlocks[blockIdx];
+        compressedBlock.yresize(Codec->MaxCompressedLength(block));
+        compressedBlock.resize(Codec->Compress(block, compressedBlock.data()));
+    };
+    if (localExecutor) {
+        NPar::ParallelFor(*localExecutor, 0, blockCount, compressBlock);
+    } else {
+        for (auto blockIdx : xrange(blockCount)) {
+            compressBlock(blockIdx);
+        }
+    }
+
+    for (const auto& compressedBlock : compressedBlocks) {
+        BlockOffsets.push_back(BlockOffsets.back() + compressedBlock.size());
+    }
+    CompressedData.yresize(BlockOffsets.back());
+    for (auto blockIdx : xrange(blockCount)) {
+        Copy(compressedBlocks[blockIdx].begin(), compressedBlocks[blockIdx].end(), CompressedData.begin() + BlockOffsets[blockIdx]);
+    }
+}
+
+TStringBuf TBlockCompressedArray::GetCodecName() const {
+    return Codec ? Codec->Name() : TStringBuf();
+}
+
+void TBlockCompressedArray::DecompressBlock(ui32 blockIdx, TArrayRef<ui8> dst) const {
+    Y_ASSERT(dst.size() == GetBlockLength(blockIdx));
+    const TStringBuf compressedBlock(
+        CompressedData.data() + BlockOffsets[blockIdx],
+        BlockOffsets[blockIdx + 1] - BlockOffsets[blockIdx]
+    );
+    const size_t decompressedSize = Codec->Decompress(compressedBlock, dst.data());
+    CB_ENSURE_INTERNAL(
+        decompressedSize == dst.size(),
+        "Block " << blockIdx << " is decompressed to " << decompressedSize << " bytes instead of " << dst.size()
+    );
+}
+
+void TBlockCompressedArray::ExtractValues(ui32 begin, TArrayRef<ui8> dst) const {
+    const ui32 end = begin + dst.size();
+    Y_ASSERT(end <= Size);
+    if (begin == end) {
+        return;
+    }
+    TVector<ui8> blockBuffer; // for blocks partially covered by [begin, end)
+    for (auto blockIdx : xrange(begin / BlockSize, (end - 1) / BlockSize + 1)) {
+        const ui32 blockBegin = blockIdx * BlockSize;
+        const ui32 blockLength = GetBlockLength(blockIdx);
+        const ui32 copyBegin = Max(begin, blockBegin);
+        const ui32 copyEnd = Min(end, blockBegin + blockLength);
+        auto dstPart = dst.Slice(copyBegin - begin, copyEnd - copyBegin);
+        if ((copyBegin == blockBegin) && (copyEnd == blockBegin + blockLength)) {
+            DecompressBlock(blockIdx, dstPart);
+        } else {
+            blockBuffer.yresize(blockLength);
+            DecompressBlock(blockIdx, blockBuffer);
+            Copy(
+                blockBuffer.begin() + (copyBegin - blockBegin),
+                blockBuffer.begin() + (copyEnd - blockBegin),
+                dstPart.begin()
+            );
+        }
+    }
+}
+
+void TBlockCompressedArray::ExtractValues(TArrayRef<ui8> dst, NPar::TLocalExecutor* localExecutor) const {
+    Y_ASSERT(dst.size() == (size_t)Size);
+    if (!localExecutor) {
+        for (auto blockIdx : xrange(GetBlockCount())) {
+            DecompressBlock(blockIdx, dst.Slice(blockIdx * BlockSize, GetBlockLength(blockIdx)));
+        }
+        return;
+    }
+    NPar::ParallelFor(
+        *localExecutor,
+        0,
+        GetBlockCount(),
+        [&] (ui32 blockIdx) {
+            DecompressBlock(blockIdx, dst.Slice(blockIdx * BlockSize, GetBlockLength(blockIdx)));
+        }
+    );
+}
+
+TVector<ui8> TBlockCompressedArray::ExtractValues(NPar::TLocalExecutor* localExecutor) const {
+    TVector<ui8> result;
+    result.yresize(Size);
+    ExtractValues(result, localExecutor);
+    return result;
+}
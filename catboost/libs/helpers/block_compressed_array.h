@@ -0,0 +1,80 @@
+#pragma once
+
+#include <library/threading/local_executor/local_executor.h>
+
+#include <util/generic/array_ref.h>
+#include <util/generic/strbuf.h>
+#include <util/generic/utility.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+namespace NBlockCodecs {
+    struct ICodec;
+}
+
+
+namespace NCB {
+
+    /* ui8 array stored compressed with a library/blockcodecs codec by independent blocks of BlockSize
+     * elements, so a block can be decompressed separately and blocks can be decompressed in parallel
+     */
+    class TBlockCompressedArray {
+    public:
+        // block of decompressed data and its compressed source fit into L2 cache
+        static constexpr ui32 DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    public:
+        TBlockCompressedArray() = default;
+
+        // blocks are compressed sequentially if localExecutor is nullptr
+        TBlockCompressedArray(
+            TConstArrayRef<ui8> data,
+            TStringBuf codecName,
+            ui32 blockSize,
+            NPar::TLocalExecutor* localExecutor
+        );
+
+        ui32 GetSize() const {
+            return Size;
+        }
+
+        ui32 GetBlockSize() const {
+            return BlockSize;
+        }
+
+        ui32 GetBlockCount() const {
+            return (ui32)BlockOffsets.size() - 1;
+        }
+
+        // size of decompressed data of the block
+        ui32 GetBlockLength(ui32 blockIdx) const {
+            return Min(BlockSize, Size - blockIdx * BlockSize);
+        }
+
+        TStringBuf GetCodecName() const;
+
+        size_t GetCompressedSize() const {
+            return CompressedData.size();
+        }
+
+        // dst must be of size GetBlockLength(blockIdx)
+        void DecompressBlock(ui32 blockIdx, TArrayRef<ui8> dst) const;
+
+        // fills dst with elements [begin, begin + dst.size()), only blocks containing them are decompressed
+        void ExtractValues(ui32 begin, TArrayRef<ui8> dst) const;
+
+        // dst must be of size GetSize(), blocks are decompressed sequentially if localExecutor is nullptr
+        void ExtractValues(TArrayRef<ui8> dst, NPar::TLocalExecutor* localExecutor) const;
+
+        TVector<ui8> ExtractValues(NPar::TLocalExecutor* localExecutor) const;
+
+    private:
+        const NBlockCodecs::ICodec* Codec = nullptr;
+        ui32 Size = 0;
+        ui32 BlockSize = 0;
+        TVector<size_t> BlockOffsets = {0}; // [blockIdx] -> offset in CompressedData, BlockCount + 1 elements
+        TVector<char> CompressedData;
+    };
+
+}
@@ -2,8 +2,25 @@
 
 #include <catboost/libs/logging/logging.h>
 
+#include <util/generic/vector.h>
 #include <util/system/mem_info.h>
+#include <util/system/types.h>
 
 inline void DumpMemUsage(const TString& msg) {
     CATBOOST_DEBUG_LOG << "Mem usage: " << msg << ": " << NMemInfo::GetMemInfo().RSS << Endl;
 }
+
+// allocated (not used) size of data
+template <typename T, typename TAlloc>
+inline ui64 GetVectorMemoryUsage(const TVector<T, TAlloc>& data) {
+    return data.capacity() * sizeof(T);
+}
+
+template <typename T, typename TAlloc>
+inline ui64 GetVectorMemoryUsage(const TVector<TVector<T>, TAlloc>& data) {
+    ui64 usage = data.capacity() * sizeof(TVector<T>);
+    for (const auto& subData : data) {
+        usage += GetVectorMemoryUsage(subData);
+    }
+    return usage;
+}
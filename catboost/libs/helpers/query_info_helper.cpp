@@ -5,6 +5,8 @@
 #include <util/generic/vector.h>
 #include <util/stream/labeled.h>
 
+#include <algorithm>
+
 void UpdateQueriesInfo(
     const TConstArrayRef<TGroupId> queriesId,
     const TConstArrayRef<float> groupWeight,
@@ -131,3 +133,33 @@ TFlatPairsInfo UnpackPairsFromQueries(const TConstArrayRef<TQueryInfo> queries)
     pairs.shrink_to_fit();
     return pairs;
 }
+
+TVector<int> GetQueryBlockBoundsByDocCount(
+    TConstArrayRef<TQueryInfo> queriesInfo,
+    int queryStartIndex,
+    int queryEndIndex,
+    int blockCount
+) {
+    Y_ASSERT(queryStartIndex < queryEndIndex && blockCount > 0);
+    const ui64 docBegin = queriesInfo[queryStartIndex].Begin;
+    const ui64 docCount = queriesInfo[queryEndIndex - 1].End - docBegin;
+    const auto queriesEnd = queriesInfo.begin() + queryEndIndex;
+
+    TVector<int> blockBounds = {queryStartIndex};
+    for (int blockIdx = 1; blockIdx < blockCount; ++blockIdx) {
+        const ui64 docBound = docBegin + docCount * blockIdx / blockCount;
+        const auto blockEnd = std::partition_point(
+            queriesInfo.begin() + blockBounds.back(),
+            queriesEnd,
+            [=] (const TQueryInfo& queryInfo) { return queryInfo.End <= docBound; }
+        );
+        if (blockEnd == queriesEnd) {
+            break;
+        }
+        if (blockEnd - queriesInfo.begin() > blockBounds.back()) {
+            blockBounds.push_back(blockEnd - queriesInfo.begin());
+        }
+    }
+    blockBounds.push_back(queryEndIndex);
+    return blockBounds;
+}
@@ -28,3 +28,13 @@ void UpdateQueriesPairs(
     TVector<TQueryInfo>* queryInfo);
 
 TFlatPairsInfo UnpackPairsFromQueries(TConstArrayRef<TQueryInfo> queries);
+
+/* Split queries [queryStartIndex, queryEndIndex) into at most blockCount consecutive blocks with close
+ * document counts (a query is never split, so a large query can make its block larger).
+ * Returns block bounds: block i is [result[i], result[i + 1])
+ */
+TVector<int> GetQueryBlockBoundsByDocCount(
+    TConstArrayRef<TQueryInfo> queriesInfo,
+    int queryStartIndex,
+    int queryEndIndex,
+    int blockCount);
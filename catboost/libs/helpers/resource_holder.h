@@ -2,6 +2,8 @@
 
 #include <util/generic/ptr.h>
 #include <util/generic/vector.h>
+#include <util/system/guard.h>
+#include <util/system/spinlock.h>
 
 
 namespace NCB {
@@ -21,5 +23,50 @@ namespace NCB {
         {}
     };
 
-}
 
+    // thread-safe storage of released vectors to reuse their memory, see TPooledVectorHolder
+    template <class T>
+    class TBuffersPool : public TThrRefBase {
+    public:
+        // returned vector contents is uninitialized
+        TVector<T> Acquire(size_t size) {
+            TVector<T> buffer;
+            with_lock (Lock) {
+                if (!FreeBuffers.empty()) {
+                    buffer = std::move(FreeBuffers.back());
+                    FreeBuffers.pop_back();
+                }
+            }
+            buffer.yresize(size);
+            return buffer;
+        }
+
+        void Release(TVector<T>&& buffer) {
+            with_lock (Lock) {
+                FreeBuffers.push_back(std::move(buffer));
+            }
+        }
+
+    private:
+        TAdaptiveLock Lock;
+        TVector<TVector<T>> FreeBuffers;
+    };
+
+    // Data is returned to the pool on destruction
+    template <class T>
+    struct TPooledVectorHolder : public IResourceHolder {
+        TVector<T> Data;
+        TIntrusivePtr<TBuffersPool<T>> Pool;
+
+    public:
+        TPooledVectorHolder(TIntrusivePtr<TBuffersPool<T>> pool, size_t size)
+            : Data(pool->Acquire(size))
+            , Pool(std::move(pool))
+        {}
+
+        ~TPooledVectorHolder() override {
+            Pool->Release(std::move(Data));
+        }
+    };
+
+}
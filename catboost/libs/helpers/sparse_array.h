@@ -0,0 +1,128 @@
+#pragma once
+
+#include "exception.h"
+
+#include <util/generic/algorithm.h>
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/system/yassert.h>
+
+#include <algorithm>
+
+
+namespace NCB {
+
+    /* Array where most of the elements are equal to DefaultValue.
+     * Only non-default elements are stored as (index, value) pairs sorted by index.
+     */
+    template <class TValue, class TSize = ui32>
+    class TSparseArray {
+    public:
+        TSparseArray() = default;
+
+        // indices must be strictly increasing and less than size
+        TSparseArray(TSize size, TVector<TSize>&& indices, TVector<TValue>&& values, TValue defaultValue)
+            : Size(size)
+            , Indices(std::move(indices))
+            , Values(std::move(values))
+            , DefaultValue(defaultValue)
+        {
+            CB_ENSURE_INTERNAL(
+                Indices.size() == Values.size(),
+                "TSparseArray: indices and values have different sizes"
+            );
+            CB_ENSURE_INTERNAL(
+                Indices.empty() || (Indices.back() < Size),
+                "TSparseArray: index " << Indices.back() << " is out of range [0, " << Size << ')'
+            );
+            Y_ASSERT(std::is_sorted(Indices.begin(), Indices.end()));
+        }
+
+        static TSparseArray CreateFromDense(TConstArrayRef<TValue> dense, TValue defaultValue) {
+            TVector<TSize> indices;
+            TVector<TValue> values;
+            for (auto i : xrange(dense.size())) {
+                if (dense[i] != defaultValue) {
+                    indices.push_back((TSize)i);
+                    values.push_back(dense[i]);
+                }
+            }
+            return TSparseArray((TSize)dense.size(), std::move(indices), std::move(values), defaultValue);
+        }
+
+        bool operator==(const TSparseArray& rhs) const {
+            return (Size == rhs.Size) && (DefaultValue == rhs.DefaultValue) && (Indices == rhs.Indices)
+                && (Values == rhs.Values);
+        }
+
+        TSize GetSize() const {
+            return Size;
+        }
+
+        TSize GetNonDefaultSize() const {
+            return (TSize)Indices.size();
+        }
+
+        TValue GetDefaultValue() const {
+            return DefaultValue;
+        }
+
+        TConstArrayRef<TSize> GetIndices() const {
+            return Indices;
+        }
+
+        TConstArrayRef<TValue> GetValues() const {
+            return Values;
+        }
+
+        // f is called with (index, value) for non-default elements in increasing index order
+        template <class F>
+        void ForEachNonDefault(F&& f) const {
+            for (auto i : xrange(Indices.size())) {
+                f(Indices[i], Values[i]);
+            }
+        }
+
+        // binary search over non-default elements
+        TValue GetValue(TSize idx) const {
+            Y_ASSERT(idx < Size);
+            const auto it = LowerBound(Indices.begin(), Indices.end(), idx);
+            return ((it != Indices.end()) && (*it == idx)) ? Values[it - Indices.begin()] : DefaultValue;
+        }
+
+        // dst must be of size GetSize()
+        void ExtractValues(TArrayRef<TValue> dst) const {
+            Y_ASSERT(dst.size() == (size_t)Size);
+            Fill(dst.begin(), dst.end(), DefaultValue);
+            ForEachNonDefault([dst] (TSize idx, TValue value) { dst[idx] = value; });
+        }
+
+        // fills dst with elements [begin, begin + dst.size())
+        void ExtractValues(TSize begin, TArrayRef<TValue> dst) const {
+            Y_ASSERT((size_t)begin + dst.size() <= (size_t)Size);
+            Fill(dst.begin(), dst.end(), DefaultValue);
+            const TSize end = begin + (TSize)dst.size();
+            for (auto i = LowerBound(Indices.begin(), Indices.end(), begin) - Indices.begin();
+                 (i < (ptrdiff_t)Indices.size()) && (Indices[i] < end);
+                 ++i)
+            {
+                dst[Indices[i] - begin] = Values[i];
+            }
+        }
+
+        TVector<TValue> ExtractValues() const {
+            TVector<TValue> result;
+            result.yresize(Size);
+            ExtractValues(result);
+            return result;
+        }
+
+    private:
+        TSize Size = 0;
+        TVector<TSize> Indices;
+        TVector<TValue> Values;
+        TValue DefaultValue = TValue();
+    };
+
+}
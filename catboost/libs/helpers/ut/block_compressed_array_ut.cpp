@@ -0,0 +1,67 @@
+#include <catboost/libs/helpers/block_compressed_array.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+
+#include <utility>
+
+
+Y_UNIT_TEST_SUITE(TBlockCompressedArray) {
+    Y_UNIT_TEST(TestCompressDecompress) {
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(3);
+
+        TVector<ui8> data(1000);
+        for (auto i : xrange(data.size())) {
+            data[i] = (i % 7 == 0) ? (ui8)(i % 251) : 0;
+        }
+
+        for (auto codecName : {"lz4", "zstd_1"}) {
+            NCB::TBlockCompressedArray compressedArray(data, codecName, 64, &localExecutor);
+
+            UNIT_ASSERT_VALUES_EQUAL(compressedArray.GetSize(), data.size());
+            UNIT_ASSERT_VALUES_EQUAL(compressedArray.GetBlockCount(), 16);
+            UNIT_ASSERT_VALUES_EQUAL(compressedArray.GetBlockLength(15), 1000 - 15 * 64);
+            UNIT_ASSERT(compressedArray.GetCompressedSize() < data.size());
+            UNIT_ASSERT_EQUAL(compressedArray.ExtractValues(&localExecutor), data);
+
+            // sequential compression and decompression
+            NCB::TBlockCompressedArray sequentiallyCompressedArray(data, codecName, 64, /*localExecutor*/ nullptr);
+            UNIT_ASSERT_VALUES_EQUAL(sequentiallyCompressedArray.GetCompressedSize(), compressedArray.GetCompressedSize());
+            UNIT_ASSERT_EQUAL(sequentiallyCompressedArray.ExtractValues(/*localExecutor*/ nullptr), data);
+
+            TVector<ui8> block(compressedArray.GetBlockLength(3));
+            compressedArray.DecompressBlock(3, block);
+            UNIT_ASSERT_EQUAL(block, TVector<ui8>(data.begin() + 3 * 64, data.begin() + 4 * 64));
+
+            // within a block, whole blocks with partial ones at both ends, up to the end of data
+            for (auto [begin, end] : {std::make_pair(70, 100), std::make_pair(30, 200), std::make_pair(900, 1000)}) {
+                TVector<ui8> range(end - begin);
+                compressedArray.ExtractValues(begin, range);
+                UNIT_ASSERT_EQUAL(range, TVector<ui8>(data.begin() + begin, data.begin() + end));
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestEmpty) {
+        NPar::TLocalExecutor localExecutor;
+        NCB::TBlockCompressedArray compressedArray({}, "lz4", 64, &localExecutor);
+
+        UNIT_ASSERT_VALUES_EQUAL(compressedArray.GetSize(), 0);
+        UNIT_ASSERT_VALUES_EQUAL(compressedArray.GetBlockCount(), 0);
+        UNIT_ASSERT(compressedArray.ExtractValues(&localExecutor).empty());
+    }
+
+    Y_UNIT_TEST(TestUnknownCodec) {
+        NPar::TLocalExecutor localExecutor;
+        TVector<ui8> data(10, 1);
+        UNIT_ASSERT_EXCEPTION(
+            [&] () { NCB::TBlockCompressedArray(data, "unknown_codec", 64, &localExecutor); }(),
+            TCatBoostException
+        );
+    }
+}
@@ -0,0 +1,50 @@
+#include <catboost/libs/helpers/query_info_helper.h>
+
+#include <util/generic/vector.h>
+
+#include <library/unittest/registar.h>
+
+
+static TVector<TQueryInfo> MakeQueriesInfo(const TVector<ui32>& querySizes) {
+    TVector<TQueryInfo> queriesInfo;
+    ui32 begin = 0;
+    for (auto querySize : querySizes) {
+        queriesInfo.emplace_back(begin, begin + querySize);
+        begin += querySize;
+    }
+    return queriesInfo;
+}
+
+Y_UNIT_TEST_SUITE(TQueryInfoHelperTest) {
+    Y_UNIT_TEST(TestGetQueryBlockBoundsByDocCount) {
+        {
+            const auto queriesInfo = MakeQueriesInfo({10, 10, 10, 10, 10, 10, 10, 10});
+            UNIT_ASSERT_VALUES_EQUAL(
+                GetQueryBlockBoundsByDocCount(queriesInfo, 0, 8, 4),
+                (TVector<int>{0, 2, 4, 6, 8})
+            );
+            UNIT_ASSERT_VALUES_EQUAL(
+                GetQueryBlockBoundsByDocCount(queriesInfo, 2, 8, 3),
+                (TVector<int>{2, 4, 6, 8})
+            );
+            UNIT_ASSERT_VALUES_EQUAL(
+                GetQueryBlockBoundsByDocCount(queriesInfo, 0, 2, 16),
+                (TVector<int>{0, 1, 2})
+            );
+        }
+        {
+            /* blocks end only after whole queries, the block with the large query gets all the following
+             * queries as their ends are past the remaining doc bounds
+             */
+            const auto queriesInfo = MakeQueriesInfo({10, 1000, 10, 10, 10});
+            UNIT_ASSERT_VALUES_EQUAL(
+                GetQueryBlockBoundsByDocCount(queriesInfo, 0, 5, 4),
+                (TVector<int>{0, 1, 5})
+            );
+            UNIT_ASSERT_VALUES_EQUAL(
+                GetQueryBlockBoundsByDocCount(queriesInfo, 0, 5, 1),
+                (TVector<int>{0, 5})
+            );
+        }
+    }
+}
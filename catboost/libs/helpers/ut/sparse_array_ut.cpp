@@ -0,0 +1,68 @@
+#include <catboost/libs/helpers/sparse_array.h>
+
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+
+#include <library/unittest/registar.h>
+
+
+Y_UNIT_TEST_SUITE(TSparseArray) {
+    Y_UNIT_TEST(TestEmpty) {
+        NCB::TSparseArray<ui8> sparseArray(5, {}, {}, 3);
+
+        UNIT_ASSERT_VALUES_EQUAL(sparseArray.GetSize(), 5);
+        UNIT_ASSERT_VALUES_EQUAL(sparseArray.GetNonDefaultSize(), 0);
+        UNIT_ASSERT_EQUAL(sparseArray.ExtractValues(), TVector<ui8>(5, 3));
+    }
+
+    Y_UNIT_TEST(TestCreateFromDense) {
+        TVector<float> dense = {0.0f, 1.5f, 0.0f, 0.0f, -2.0f, 0.0f};
+
+        auto sparseArray = NCB::TSparseArray<float>::CreateFromDense(dense, 0.0f);
+
+        UNIT_ASSERT_VALUES_EQUAL(sparseArray.GetSize(), 6);
+        UNIT_ASSERT_VALUES_EQUAL(sparseArray.GetNonDefaultSize(), 2);
+        UNIT_ASSERT_EQUAL(sparseArray.GetIndices(), TConstArrayRef<ui32>(TVector<ui32>{1, 4}));
+        UNIT_ASSERT_EQUAL(sparseArray.ExtractValues(), dense);
+
+        TVector<std::pair<ui32, float>> nonDefault;
+        sparseArray.ForEachNonDefault(
+            [&] (ui32 idx, float value) { nonDefault.emplace_back(idx, value); }
+        );
+        UNIT_ASSERT_EQUAL(nonDefault, (TVector<std::pair<ui32, float>>{{1, 1.5f}, {4, -2.0f}}));
+
+        UNIT_ASSERT_EQUAL(
+            sparseArray,
+            NCB::TSparseArray<float>(6, TVector<ui32>{1, 4}, TVector<float>{1.5f, -2.0f}, 0.0f)
+        );
+    }
+
+    Y_UNIT_TEST(TestGetValueAndExtractRange) {
+        TVector<float> dense = {0.0f, 1.5f, 0.0f, 0.0f, -2.0f, 0.0f, 3.0f};
+
+        auto sparseArray = NCB::TSparseArray<float>::CreateFromDense(dense, 0.0f);
+
+        for (auto i : xrange(dense.size())) {
+            UNIT_ASSERT_VALUES_EQUAL(sparseArray.GetValue(i), dense[i]);
+        }
+
+        for (auto begin : xrange(dense.size() + 1)) {
+            for (auto end : xrange(begin, dense.size() + 1)) {
+                TVector<float> range(end - begin, -1.0f);
+                sparseArray.ExtractValues(begin, range);
+                UNIT_ASSERT_EQUAL(range, TVector<float>(dense.begin() + begin, dense.begin() + end));
+            }
+        }
+    }
+
+    Y_UNIT_TEST(TestBadIndices) {
+        UNIT_ASSERT_EXCEPTION(
+            NCB::TSparseArray<ui8>(3, TVector<ui32>{0, 3}, TVector<ui8>{1, 2}, 0),
+            TCatBoostException
+        );
+        UNIT_ASSERT_EXCEPTION(
+            NCB::TSparseArray<ui8>(3, TVector<ui32>{0, 1}, TVector<ui8>{1}, 0),
+            TCatBoostException
+        );
+    }
+}
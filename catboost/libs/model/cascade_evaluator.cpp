@@ -0,0 +1,229 @@
+#include "cascade_evaluator.h"
+
+#include "compact_leaf_values.h"
+#include "formula_evaluator.h"
+
+#include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+
+#include <limits>
+
+
+// leaf values actually used in evaluation, see GetCalcTreesFunction
+static double GetEvaluatedLeafValue(const TObliviousTrees& trees, size_t treeIdx, size_t leafIdx) {
+    switch (trees.CompactLeafValuesType) {
+        case NCatBoostFbs::ECompactLeafValuesType_Int16:
+            return trees.CompactLeafScales[treeIdx]
+                * DecodeCompactLeafValue<NCatBoostFbs::ECompactLeafValuesType_Int16>(trees.CompactLeafValues[leafIdx]);
+        case NCatBoostFbs::ECompactLeafValuesType_Float16:
+            return trees.CompactLeafScales[treeIdx]
+                * DecodeCompactLeafValue<NCatBoostFbs::ECompactLeafValuesType_Float16>(trees.CompactLeafValues[leafIdx]);
+        default:
+            return trees.LeafValues[leafIdx];
+    }
+}
+
+TCascadeEvaluator::TCascadeEvaluator(const TFullModel& model, double threshold, size_t treeChunkSize)
+    : Model(model)
+    , Threshold(threshold)
+{
+    const auto& trees = Model.ObliviousTrees;
+    CB_ENSURE(trees.ApproxDimension == 1, "Cascade evaluation is supported only for single dimension models");
+    CB_ENSURE(treeChunkSize > 0, "Tree chunk size should be positive");
+
+    const size_t treeCount = trees.TreeSizes.size();
+    for (size_t chunkStart = 0; chunkStart < treeCount; chunkStart += treeChunkSize) {
+        ChunkEnds.push_back(Min(chunkStart + treeChunkSize, treeCount));
+    }
+
+    TVector<double> treeSuffixMin(treeCount + 1, 0.0);
+    TVector<double> treeSuffixMax(treeCount + 1, 0.0);
+    const auto& leafOffsets = trees.GetFirstLeafOffsets();
+    for (size_t treeIdx = treeCount; treeIdx > 0; --treeIdx) {
+        const size_t leafBegin = leafOffsets[treeIdx - 1];
+        const size_t leafEnd = leafBegin + (size_t(1) << trees.TreeSizes[treeIdx - 1]);
+        double minValue = std::numeric_limits<double>::infinity();
+        double maxValue = -std::numeric_limits<double>::infinity();
+        for (auto leafIdx : xrange(leafBegin, leafEnd)) {
+            const double value = GetEvaluatedLeafValue(trees, treeIdx - 1, leafIdx);
+            minValue = Min(minValue, value);
+            maxValue = Max(maxValue, value);
+        }
+        treeSuffixMin[treeIdx - 1] = treeSuffixMin[treeIdx] + minValue;
+        treeSuffixMax[treeIdx - 1] = treeSuffixMax[treeIdx] + maxValue;
+    }
+    for (auto chunkEnd : ChunkEnds) {
+        SuffixMin.push_back(treeSuffixMin[chunkEnd]);
+        SuffixMax.push_back(treeSuffixMax[chunkEnd]);
+    }
+}
+
+template <typename TFloatFeatureAccessor, typename TCatFeatureAccessor>
+TCascadeEvaluationResult TCascadeEvaluator::CalcGeneric(
+    TFloatFeatureAccessor floatFeatureAccessor,
+    TCatFeatureAccessor catFeaturesAccessor,
+    size_t docCount) const {
+
+    TCascadeEvaluationResult result;
+    result.Decisions.resize(docCount);
+    result.Scores.resize(docCount, std::numeric_limits<double>::quiet_NaN());
+    if (docCount == 0) {
+        return result;
+    }
+    if (ChunkEnds.empty()) {
+        for (auto docIdx : xrange(docCount)) {
+            result.Decisions[docIdx] = 0.0 > Threshold;
+            result.Scores[docIdx] = 0.0;
+        }
+        return result;
+    }
+
+    const auto& trees = Model.ObliviousTrees;
+    const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
+    const size_t bucketCount = trees.GetEffectiveBinaryFeaturesBucketsCount();
+    TVector<ui8> binFeatures(blockSize * bucketCount);
+    TVector<TCalcerIndexType> indexesVec(blockSize);
+    TVector<ui32> transposedHash(blockSize * Model.GetUsedCatFeaturesCount());
+    TVector<float> ctrs(trees.GetUsedModelCtrs().size() * blockSize);
+    TVector<double> partialScores(blockSize);
+    TVector<ui32> activeDocs(blockSize);
+    // blocked calcer adds to results for any object count
+    auto calcTrees = GetCalcTreesFunction(Model, FORMULA_EVALUATION_BLOCK_SIZE);
+    for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
+        const auto docCountInBlock = Min(blockSize, docCount - blockStart);
+        BinarizeFeatures(
+            Model,
+            floatFeatureAccessor,
+            catFeaturesAccessor,
+            blockStart,
+            blockStart + docCountInBlock,
+            binFeatures,
+            transposedHash,
+            ctrs
+        );
+        size_t activeCount = docCountInBlock;
+        for (auto i : xrange(activeCount)) {
+            activeDocs[i] = i;
+            partialScores[i] = 0.0;
+        }
+        size_t chunkStart = 0;
+        for (auto chunkIdx : xrange(ChunkEnds.size())) {
+            const size_t chunkEnd = ChunkEnds[chunkIdx];
+            calcTrees(
+                Model,
+                binFeatures.data(),
+                activeCount,
+                indexesVec.data(),
+                chunkStart,
+                chunkEnd,
+                partialScores.data()
+            );
+            result.EvaluatedTreeCount += activeCount * (chunkEnd - chunkStart);
+            chunkStart = chunkEnd;
+
+            if (chunkIdx + 1 == ChunkEnds.size()) {
+                for (auto i : xrange(activeCount)) {
+                    const size_t docIdx = blockStart + activeDocs[i];
+                    result.Decisions[docIdx] = partialScores[i] > Threshold;
+                    result.Scores[docIdx] = partialScores[i];
+                }
+                break;
+            }
+
+            // bins of still undecided objects are compacted in place, their positions only decrease
+            size_t newActiveCount = 0;
+            for (auto i : xrange(activeCount)) {
+                const size_t docIdx = blockStart + activeDocs[i];
+                if (partialScores[i] + SuffixMin[chunkIdx] > Threshold) {
+                    result.Decisions[docIdx] = true;
+                } else if (partialScores[i] + SuffixMax[chunkIdx] <= Threshold) {
+                    result.Decisions[docIdx] = false;
+                } else {
+                    activeDocs[newActiveCount] = activeDocs[i];
+                    partialScores[newActiveCount] = partialScores[i];
+                    indexesVec[newActiveCount] = i; // reused as position in the current active block
+                    ++newActiveCount;
+                }
+            }
+            if (newActiveCount == 0) {
+                break;
+            }
+            if (newActiveCount != activeCount) {
+                for (auto bucketIdx : xrange(bucketCount)) {
+                    const ui8* src = binFeatures.data() + bucketIdx * activeCount;
+                    ui8* dst = binFeatures.data() + bucketIdx * newActiveCount;
+                    for (auto i : xrange(newActiveCount)) {
+                        dst[i] = src[indexesVec[i]];
+                    }
+                }
+                activeCount = newActiveCount;
+            }
+        }
+    }
+    return result;
+}
+
+TCascadeEvaluationResult TCascadeEvaluator::Calc(
+    TConstArrayRef<TConstArrayRef<float>> floatFeatures,
+    TConstArrayRef<TConstArrayRef<int>> catFeatures) const {
+
+    if (!floatFeatures.empty() && !catFeatures.empty()) {
+        CB_ENSURE(catFeatures.size() == floatFeatures.size());
+    }
+    const size_t docCount = Max(catFeatures.size(), floatFeatures.size());
+    const auto& trees = Model.ObliviousTrees;
+    CB_ENSURE(
+        trees.GetUsedFloatFeaturesCount() == 0 || !floatFeatures.empty(),
+        "Model has float features but no float features provided"
+    );
+    CB_ENSURE(
+        trees.GetUsedCatFeaturesCount() == 0 || !catFeatures.empty(),
+        "Model has categorical features but no categorical features provided"
+    );
+    for (const auto& floatFeaturesVec : floatFeatures) {
+        CB_ENSURE(
+            floatFeaturesVec.size() >= trees.GetMinimalSufficientFloatFeaturesVectorSize(),
+            "insufficient float features vector size: " << floatFeaturesVec.size()
+            << " expected: " << trees.GetMinimalSufficientFloatFeaturesVectorSize()
+        );
+    }
+    for (const auto& catFeaturesVec : catFeatures) {
+        CB_ENSURE(
+            catFeaturesVec.size() >= trees.GetMinimalSufficientCatFeaturesVectorSize(),
+            "insufficient cat features vector size: " << catFeaturesVec.size()
+            << " expected: " << trees.GetMinimalSufficientCatFeaturesVectorSize()
+        );
+    }
+    return CalcGeneric(
+        [&floatFeatures](const TFloatFeature& floatFeature, size_t index) -> float {
+            return floatFeatures[index][floatFeature.FeatureIndex];
+        },
+        [&catFeatures](const TCatFeature& catFeature, size_t index) -> int {
+            return catFeatures[index][catFeature.FeatureIndex];
+        },
+        docCount
+    );
+}
+
+TCascadeEvaluationResult TCascadeEvaluator::CalcFlat(TConstArrayRef<TConstArrayRef<float>> features) const {
+    const auto expectedFlatVecSize = Model.ObliviousTrees.GetFlatFeatureVectorExpectedSize();
+    for (const auto& flatFeaturesVec : features) {
+        CB_ENSURE(
+            flatFeaturesVec.size() >= expectedFlatVecSize,
+            "insufficient flat features vector size: " << flatFeaturesVec.size()
+            << " expected: " << expectedFlatVecSize
+        );
+    }
+    return CalcGeneric(
+        [&features](const TFloatFeature& floatFeature, size_t index) -> float {
+            return features[index][floatFeature.FlatFeatureIndex];
+        },
+        [&features](const TCatFeature& catFeature, size_t index) -> int {
+            return ConvertFloatCatFeatureToIntHash(features[index][catFeature.FlatFeatureIndex]);
+        },
+        features.size()
+    );
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "model.h"
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+
+struct TCascadeEvaluationResult {
+    //! Decision for each object: raw formula value > threshold
+    TVector<bool> Decisions;
+    /**
+     * Exact raw formula values for objects that remained undecided until the last tree chunk,
+     * NaN for objects decided early
+     */
+    TVector<double> Scores;
+    //! Number of (object, tree) pairs actually evaluated
+    ui64 EvaluatedTreeCount = 0;
+};
+
+/**
+ * Early exit evaluator for models used only to compare raw formula value against a threshold.
+ * Trees are applied in chunks, after each chunk objects whose decision can't be changed by the remaining
+ * trees (min/max leaf value sums are precomputed for each tree suffix) are dropped from the evaluated block.
+ * Decisions are the same as for full evaluation up to floating point summation order.
+ * Only single dimension models are supported.
+ */
+class TCascadeEvaluator {
+public:
+    TCascadeEvaluator(const TFullModel& model, double threshold, size_t treeChunkSize = 32);
+
+    /**
+     * Evaluate decisions on user data
+     * @param[in] floatFeatures
+     * @param[in] catFeatures hashed cat feature values
+     */
+    TCascadeEvaluationResult Calc(
+        TConstArrayRef<TConstArrayRef<float>> floatFeatures,
+        TConstArrayRef<TConstArrayRef<int>> catFeatures) const;
+
+    /**
+     * Same as Calc but for **flat** feature vectors
+     */
+    TCascadeEvaluationResult CalcFlat(TConstArrayRef<TConstArrayRef<float>> features) const;
+
+private:
+    template <typename TFloatFeatureAccessor, typename TCatFeatureAccessor>
+    TCascadeEvaluationResult CalcGeneric(
+        TFloatFeatureAccessor floatFeatureAccessor,
+        TCatFeatureAccessor catFeaturesAccessor,
+        size_t docCount) const;
+
+private:
+    const TFullModel& Model;
+    double Threshold;
+    TVector<size_t> ChunkEnds;
+    //! [chunkIdx] -> bounds of the sum of leaf values of trees after the chunk
+    TVector<double> SuffixMin;
+    TVector<double> SuffixMax;
+};
@@ -0,0 +1,112 @@
+#include "compact_leaf_values.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/utility.h>
+#include <util/generic/ymath.h>
+#include <util/generic/xrange.h>
+
+#include <cmath>
+
+
+static ui16 RoundToInt16(double value, double scale) {
+    const double rounded = std::round(value / scale);
+    return static_cast<ui16>(static_cast<i16>(Min(Max(rounded, -32767.0), 32767.0)));
+}
+
+// float16 conversion truncates mantissa, so check next representable value too
+static ui16 RoundToFloat16(double value, double scale) {
+    const float normalized = static_cast<float>(value / scale);
+    const ui16 truncated = NFloat16Impl::ConvertFloat32IntoFloat16(normalized);
+    const ui16 next = truncated + 1;
+    const bool nextIsCloser = (next & NFloat16Impl::ExponentFloat16Mask) != NFloat16Impl::ExponentFloat16Mask
+        && Abs(NFloat16Impl::ConvertFloat16IntoFloat32(next) - normalized)
+            < Abs(NFloat16Impl::ConvertFloat16IntoFloat32(truncated) - normalized);
+    return nextIsCloser ? next : truncated;
+}
+
+static TVector<double> CalcControlPredictions(
+    const TFullModel& model,
+    TConstArrayRef<TConstArrayRef<float>> controlFlatFeatures) {
+
+    TVector<double> predictions(controlFlatFeatures.size() * model.ObliviousTrees.ApproxDimension);
+    if (!controlFlatFeatures.empty()) {
+        model.CalcFlat(controlFlatFeatures, predictions);
+    }
+    return predictions;
+}
+
+TCompactLeafValuesReport CompactLeafValues(
+    NCatBoostFbs::ECompactLeafValuesType type,
+    TConstArrayRef<TConstArrayRef<float>> controlFlatFeatures,
+    TFullModel* model) {
+
+    auto& trees = model->ObliviousTrees;
+    trees.CompactLeafValuesType = NCatBoostFbs::ECompactLeafValuesType_None;
+    trees.CompactLeafValues.clear();
+    trees.CompactLeafScales.clear();
+
+    TCompactLeafValuesReport report;
+    report.LeafValuesBytes = trees.LeafValues.size() * sizeof(double);
+    if (type == NCatBoostFbs::ECompactLeafValuesType_None) {
+        return report;
+    }
+    CB_ENSURE(
+        type == NCatBoostFbs::ECompactLeafValuesType_Int16 || type == NCatBoostFbs::ECompactLeafValuesType_Float16,
+        "Unsupported compact leaf values type " << (int)type
+    );
+
+    const auto fullPrecisionPredictions = CalcControlPredictions(*model, controlFlatFeatures);
+
+    const auto& leafOffsets = trees.GetFirstLeafOffsets();
+    TVector<ui16> compactLeafValues(trees.LeafValues.size());
+    TVector<double> compactLeafScales(trees.TreeSizes.size());
+    for (auto treeIdx : xrange(trees.TreeSizes.size())) {
+        const size_t leafBegin = leafOffsets[treeIdx];
+        const size_t leafEnd = leafBegin + (size_t(1) << trees.TreeSizes[treeIdx]) * trees.ApproxDimension;
+        double maxAbsValue = 0.0;
+        for (auto leafIdx : xrange(leafBegin, leafEnd)) {
+            maxAbsValue = Max(maxAbsValue, Abs(trees.LeafValues[leafIdx]));
+        }
+        double scale = 1.0;
+        if (maxAbsValue > 0.0) {
+            scale = type == NCatBoostFbs::ECompactLeafValuesType_Int16 ? maxAbsValue / 32767.0 : maxAbsValue;
+        }
+        compactLeafScales[treeIdx] = scale;
+
+        double maxTreeError = 0.0;
+        for (auto leafIdx : xrange(leafBegin, leafEnd)) {
+            const double value = trees.LeafValues[leafIdx];
+            double restoredValue;
+            if (type == NCatBoostFbs::ECompactLeafValuesType_Int16) {
+                compactLeafValues[leafIdx] = RoundToInt16(value, scale);
+                restoredValue = scale * DecodeCompactLeafValue<NCatBoostFbs::ECompactLeafValuesType_Int16>(compactLeafValues[leafIdx]);
+            } else {
+                compactLeafValues[leafIdx] = RoundToFloat16(value, scale);
+                restoredValue = scale * DecodeCompactLeafValue<NCatBoostFbs::ECompactLeafValuesType_Float16>(compactLeafValues[leafIdx]);
+            }
+            maxTreeError = Max(maxTreeError, Abs(restoredValue - value));
+        }
+        report.MaxLeafValueError = Max(report.MaxLeafValueError, maxTreeError);
+        report.PredictionErrorBound += maxTreeError;
+    }
+
+    trees.CompactLeafValuesType = type;
+    trees.CompactLeafValues = std::move(compactLeafValues);
+    trees.CompactLeafScales = std::move(compactLeafScales);
+    report.CompactLeafValuesBytes = trees.CompactLeafValues.size() * sizeof(ui16)
+        + trees.CompactLeafScales.size() * sizeof(double);
+
+    const auto compactPredictions = CalcControlPredictions(*model, controlFlatFeatures);
+    report.ControlObjectCount = controlFlatFeatures.size();
+    double diffSum = 0.0;
+    for (auto i : xrange(compactPredictions.size())) {
+        const double diff = Abs(compactPredictions[i] - fullPrecisionPredictions[i]);
+        report.MaxPredictionDiff = Max(report.MaxPredictionDiff, diff);
+        diffSum += diff;
+    }
+    if (!compactPredictions.empty()) {
+        report.MeanPredictionDiff = diffSum / compactPredictions.size();
+    }
+    return report;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "model.h"
+
+#include <library/float16/float16.h>
+
+#include <util/generic/array_ref.h>
+#include <util/system/compiler.h>
+#include <util/system/types.h>
+
+
+template <NCatBoostFbs::ECompactLeafValuesType Type>
+Y_FORCE_INLINE double DecodeCompactLeafValue(ui16 value) {
+    static_assert(
+        Type == NCatBoostFbs::ECompactLeafValuesType_Int16 || Type == NCatBoostFbs::ECompactLeafValuesType_Float16,
+        "unexpected compact leaf values type"
+    );
+    if (Type == NCatBoostFbs::ECompactLeafValuesType_Int16) {
+        return static_cast<i16>(value);
+    } else {
+        return NFloat16Impl::ConvertFloat16IntoFloat32(value);
+    }
+}
+
+struct TCompactLeafValuesReport {
+    size_t LeafValuesBytes = 0;
+    size_t CompactLeafValuesBytes = 0; // stored values and per-tree scales
+
+    //! Max absolute rounding error of a single leaf value
+    double MaxLeafValueError = 0.0;
+    //! Sum of per-tree max leaf errors, bounds raw prediction error for any object
+    double PredictionErrorBound = 0.0;
+
+    //! Raw prediction differences with the full precision model on control objects
+    size_t ControlObjectCount = 0;
+    double MaxPredictionDiff = 0.0;
+    double MeanPredictionDiff = 0.0;
+};
+
+/**
+ * Model compaction step: makes reduced precision copy of leaf values (int16 or float16 with per-tree scale)
+ * which is used in model evaluation instead of double leaf values, see TObliviousTrees::CompactLeafValues.
+ * Full precision leaf values are kept in the model.
+ * @param[in] type ECompactLeafValuesType_None drops compact leaf values
+ * @param[in] controlFlatFeatures objects to compare predictions with the full precision model on, can be empty
+ * @param[in, out] model
+ * @return tolerance report
+ */
+TCompactLeafValuesReport CompactLeafValues(
+    NCatBoostFbs::ECompactLeafValuesType type,
+    TConstArrayRef<TConstArrayRef<float>> controlFlatFeatures,
+    TFullModel* model);
@@ -4,7 +4,11 @@
 #include <catboost/libs/helpers/exception.h>
 
 
-TIntrusivePtr<ICtrProvider> MergeCtrProvidersData(const TVector<TIntrusivePtr<ICtrProvider>>& providers, ECtrTableMergePolicy mergePolicy) {
+TIntrusivePtr<ICtrProvider> MergeCtrProvidersData(
+    const TVector<TIntrusivePtr<ICtrProvider>>& providers,
+    ECtrTableMergePolicy mergePolicy,
+    NPar::TLocalExecutor* localExecutor) {
+
     TVector<const TStaticCtrProvider*> nonEmptyStaticProviders;
     for (const auto& provider : providers) {
         if (provider) {
@@ -19,5 +23,5 @@ TIntrusivePtr<ICtrProvider> MergeCtrProvidersData(const TVector<TIntrusivePtr<IC
     if (nonEmptyStaticProviders.size() == 1) {
         return nonEmptyStaticProviders.back()->Clone();
     }
-    return MergeStaticCtrProvidersData(nonEmptyStaticProviders, mergePolicy);
+    return MergeStaticCtrProvidersData(nonEmptyStaticProviders, mergePolicy, localExecutor);
 }
@@ -6,6 +6,7 @@
 #include "ctr_value_table.h"
 
 #include <library/json/json_value.h>
+#include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/array_ref.h>
 #include <util/generic/ptr.h>
@@ -127,6 +128,11 @@ enum class ECtrTableMergePolicy {
     IntersectingCountersAverage
 };
 
+/**
+ * Merge ctr tables of several providers, tables of different ctrs and hash ranges of the same ctr
+ * are merged in parallel
+ */
 TIntrusivePtr<ICtrProvider> MergeCtrProvidersData(
     const TVector<TIntrusivePtr<ICtrProvider>>& providers,
-    ECtrTableMergePolicy mergePolicy);
+    ECtrTableMergePolicy mergePolicy,
+    NPar::TLocalExecutor* localExecutor);
@@ -1,5 +1,7 @@
 #include "formula_evaluator.h"
 
+#include "compact_leaf_values.h"
+
 #include <util/generic/algorithm.h>
 #include <util/stream/format.h>
 #include <util/system/compiler.h>
@@ -464,8 +466,143 @@ inline void CalcTreesSingleDocImpl(
     }
 }
 
+template <NCatBoostFbs::ECompactLeafValuesType CompactType, bool IsSingleClassModel, typename TIndexType>
+Y_FORCE_INLINE void CalculateCompactLeafValues(
+    const size_t docCountInBlock,
+    const ui16* __restrict treeLeafPtr,
+    const double scale,
+    const TIndexType* __restrict indexesPtr,
+    const int approxDimension,
+    double* __restrict writePtr)
+{
+    Y_PREFETCH_READ(treeLeafPtr, 3);
+    if (IsSingleClassModel) {
+        for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+            writePtr[docId] += scale * DecodeCompactLeafValue<CompactType>(treeLeafPtr[indexesPtr[docId]]);
+        }
+    } else {
+        for (size_t docId = 0; docId < docCountInBlock; ++docId) {
+            const ui16* leafValuePtr = treeLeafPtr + indexesPtr[docId] * approxDimension;
+            for (int classId = 0; classId < approxDimension; ++classId) {
+                writePtr[classId] += scale * DecodeCompactLeafValue<CompactType>(leafValuePtr[classId]);
+            }
+            writePtr += approxDimension;
+        }
+    }
+}
+
+/*
+ * Same as CalcTreesBlockedImpl, but leaf values are gathered from the compact leaf values table
+ * (2 bytes per leaf value instead of 8) and scaled by per-tree scale
+ */
+template <NCatBoostFbs::ECompactLeafValuesType CompactType, bool IsSingleClassModel, bool NeedXorMask, int SSEBlockCount>
+Y_FORCE_INLINE void CalcTreesCompactImpl(
+    const TFullModel& model,
+    const ui8* __restrict binFeatures,
+    const size_t docCountInBlock,
+    TCalcerIndexType* __restrict indexesVecUI32,
+    size_t treeStart,
+    const size_t treeEnd,
+    double* __restrict resultsPtr)
+{
+    const auto& trees = model.ObliviousTrees;
+    const TRepackedBin* treeSplitsCurPtr = trees.GetRepackedBins().data() + trees.TreeStartOffsets[treeStart];
+    ui8* __restrict indexesVec = (ui8*)indexesVecUI32;
+    const ui16* compactLeafPtr = trees.CompactLeafValues.data();
+    auto firstLeafOffsetsPtr = trees.GetFirstLeafOffsets().data();
+    for (size_t treeId = treeStart; treeId < treeEnd; ++treeId) {
+        const auto curTreeSize = trees.TreeSizes[treeId];
+        const ui16* treeLeafPtr = compactLeafPtr + firstLeafOffsetsPtr[treeId];
+        const double scale = trees.CompactLeafScales[treeId];
+        memset(indexesVec, 0, sizeof(ui32) * docCountInBlock);
+#ifdef _sse2_
+        if (curTreeSize <= 8) {
+            CalcIndexesSse<NeedXorMask, SSEBlockCount>(binFeatures, docCountInBlock, indexesVec, treeSplitsCurPtr, curTreeSize);
+            CalculateCompactLeafValues<CompactType, IsSingleClassModel>(
+                docCountInBlock, treeLeafPtr, scale, indexesVec, trees.ApproxDimension, resultsPtr);
+        } else {
+#else
+        {
+#endif
+            CalcIndexesBasic<NeedXorMask, 0>(binFeatures, docCountInBlock, indexesVecUI32, treeSplitsCurPtr, curTreeSize);
+            CalculateCompactLeafValues<CompactType, IsSingleClassModel>(
+                docCountInBlock, treeLeafPtr, scale, indexesVecUI32, trees.ApproxDimension, resultsPtr);
+        }
+        treeSplitsCurPtr += curTreeSize;
+    }
+}
+
+template <NCatBoostFbs::ECompactLeafValuesType CompactType, bool IsSingleClassModel, bool NeedXorMask>
+void CalcTreesCompact(
+    const TFullModel& model,
+    const ui8* __restrict binFeatures,
+    size_t docCountInBlock,
+    TCalcerIndexType* __restrict indexesVec,
+    size_t treeStart,
+    size_t treeEnd,
+    double* __restrict resultsPtr)
+{
+    switch (docCountInBlock / SSE_BLOCK_SIZE) {
+    case 0:
+        CalcTreesCompactImpl<CompactType, IsSingleClassModel, NeedXorMask, 0>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        break;
+    case 1:
+        CalcTreesCompactImpl<CompactType, IsSingleClassModel, NeedXorMask, 1>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        break;
+    case 2:
+        CalcTreesCompactImpl<CompactType, IsSingleClassModel, NeedXorMask, 2>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        break;
+    case 3:
+        CalcTreesCompactImpl<CompactType, IsSingleClassModel, NeedXorMask, 3>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        break;
+    case 4:
+        CalcTreesCompactImpl<CompactType, IsSingleClassModel, NeedXorMask, 4>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        break;
+    case 5:
+        CalcTreesCompactImpl<CompactType, IsSingleClassModel, NeedXorMask, 5>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        break;
+    case 6:
+        CalcTreesCompactImpl<CompactType, IsSingleClassModel, NeedXorMask, 6>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        break;
+    case 7:
+        CalcTreesCompactImpl<CompactType, IsSingleClassModel, NeedXorMask, 7>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        break;
+    case 8:
+        CalcTreesCompactImpl<CompactType, IsSingleClassModel, NeedXorMask, 8>(model, binFeatures, docCountInBlock, indexesVec, treeStart, treeEnd, resultsPtr);
+        break;
+    default:
+        Y_UNREACHABLE();
+    }
+}
+
+template <NCatBoostFbs::ECompactLeafValuesType CompactType>
+static TTreeCalcFunction GetCalcTreesCompactFunction(const TFullModel& model) {
+    const bool hasOneHots = !model.ObliviousTrees.OneHotFeatures.empty();
+    if (model.ObliviousTrees.ApproxDimension == 1) {
+        if (hasOneHots) {
+            return CalcTreesCompact<CompactType, true, true>;
+        } else {
+            return CalcTreesCompact<CompactType, true, false>;
+        }
+    } else {
+        if (hasOneHots) {
+            return CalcTreesCompact<CompactType, false, true>;
+        } else {
+            return CalcTreesCompact<CompactType, false, false>;
+        }
+    }
+}
+
 TTreeCalcFunction GetCalcTreesFunction(const TFullModel& model, size_t docCountInBlock) {
     const bool hasOneHots = !model.ObliviousTrees.OneHotFeatures.empty();
+    switch (model.ObliviousTrees.CompactLeafValuesType) {
+        case NCatBoostFbs::ECompactLeafValuesType_Int16:
+            return GetCalcTreesCompactFunction<NCatBoostFbs::ECompactLeafValuesType_Int16>(model);
+        case NCatBoostFbs::ECompactLeafValuesType_Float16:
+            return GetCalcTreesCompactFunction<NCatBoostFbs::ECompactLeafValuesType_Float16>(model);
+        default:
+            break;
+    }
     if (model.ObliviousTrees.ApproxDimension == 1) {
         if (docCountInBlock == 1) {
             if (hasOneHots) {
@@ -27,29 +27,23 @@ constexpr ui32 MAX_VALUES_PER_BIN = 254;
 
 inline void OneHotBinsFromTransposedCatFeatures(
     const TVector<TOneHotFeature>& OneHotFeatures,
-    const THashMap<int, int> catFeaturePackedIndex,
+    const TVector<TObliviousTrees::TMetaData::TOneHotValuesTable>& oneHotValuesTables,
     const size_t docCount,
     ui8*& result,
     TVector<ui32>& transposedHash
 ) {
-    for (const auto& oheFeature : OneHotFeatures) {
-        const auto catIdx = catFeaturePackedIndex.at(oheFeature.CatFeatureIndex);
+    Y_ASSERT(OneHotFeatures.size() == oneHotValuesTables.size());
+    for (size_t featureIdx = 0; featureIdx < OneHotFeatures.size(); ++featureIdx) {
+        const auto& valuesTable = oneHotValuesTables[featureIdx];
+        const ui32* catFeatureHashes = &transposedHash[valuesTable.PackedCatFeatureIndex * docCount];
         for (size_t docId = 0; docId < docCount; ++docId) {
-            static_assert(sizeof(int) >= sizeof(i32));
-            const int val = *reinterpret_cast<i32*>(&(transposedHash[catIdx * docCount + docId]));
-            ui8* writePosition = &result[docId];
-            for (size_t blockStart = 0;
-                 blockStart < oheFeature.Values.size();
-                 blockStart += MAX_VALUES_PER_BIN)
-            {
-                const size_t blockEnd = Min(blockStart + MAX_VALUES_PER_BIN, oheFeature.Values.size());
-                for (size_t borderIdx = blockStart; borderIdx < blockEnd; ++borderIdx) {
-                    *writePosition |= (ui8)(val == oheFeature.Values[borderIdx]) * (borderIdx - blockStart + 1);
-                }
-                writePosition += docCount;
+            const ui32 valueIdx = valuesTable.Find(static_cast<i32>(catFeatureHashes[docId]));
+            if (valueIdx) { // result is zero filled, objects with unknown values stay in zero bin
+                result[((valueIdx - 1) / MAX_VALUES_PER_BIN) * docCount + docId]
+                    = (valueIdx - 1) % MAX_VALUES_PER_BIN + 1;
             }
         }
-        result += docCount * ((oheFeature.Values.size() + MAX_VALUES_PER_BIN - 1) / MAX_VALUES_PER_BIN);
+        result += docCount * ((OneHotFeatures[featureIdx].Values.size() + MAX_VALUES_PER_BIN - 1) / MAX_VALUES_PER_BIN);
     }
 }
 
@@ -283,13 +277,11 @@ inline void BinarizeFeatures(
         }
     }
     if (model.HasCategoricalFeatures()) {
-        THashMap<int, int> catFeaturePackedIndexes;
         int usedFeatureIdx = 0;
         for (const auto& catFeature : model.ObliviousTrees.CatFeatures) {
             if (!catFeature.UsedInModel) {
                 continue;
             }
-            catFeaturePackedIndexes[catFeature.FeatureIndex] = usedFeatureIdx;
             for (size_t docId = 0, writeIdx = usedFeatureIdx * docCount;
                  docId < docCount;
                  ++docId, ++writeIdx)
@@ -301,7 +293,7 @@ inline void BinarizeFeatures(
         Y_ASSERT(model.GetUsedCatFeaturesCount() == (size_t)usedFeatureIdx);
         OneHotBinsFromTransposedCatFeatures(
             model.ObliviousTrees.OneHotFeatures,
-            catFeaturePackedIndexes,
+            model.ObliviousTrees.GetOneHotValuesTables(),
             docCount,
             resultPtr,
             transposedHash
@@ -19,8 +19,10 @@
 #include <contrib/libs/coreml/Model.pb.h>
 
 #include <library/json/json_reader.h>
+#include <library/threading/local_executor/local_executor.h>
 
 #include <util/generic/algorithm.h>
+#include <util/generic/bitops.h>
 #include <util/generic/buffer.h>
 #include <util/generic/fwd.h>
 #include <util/generic/variant.h>
@@ -28,6 +30,7 @@
 #include <util/string/builder.h>
 #include <util/stream/buffer.h>
 #include <util/stream/file.h>
+#include <util/stream/mem.h>
 #include <util/system/fs.h>
 #include <util/stream/str.h>
 
@@ -102,8 +105,7 @@ TFullModel ReadModel(const TString& modelFile, EModelType format){
 }
 
 TFullModel ReadModel(const void* binaryBuffer, size_t binaryBufferSize, EModelType format)  {
-    TBuffer buf((char*)binaryBuffer, binaryBufferSize);
-    TBufferInput bs(buf);
+    TMemoryInput bs(binaryBuffer, binaryBufferSize);
     return ReadModel(&bs, format);
 }
 
@@ -299,7 +301,10 @@ TObliviousTrees::FBSerialize(TModelPartsCachingSerializer& serializer) const {
         &oneHotFeaturesOffsets,
         &ctrFeaturesOffsets,
         &LeafValues,
-        &flatLeafWeights
+        &flatLeafWeights,
+        CompactLeafValuesType,
+        HasCompactLeafValues() ? &CompactLeafValues : nullptr,
+        HasCompactLeafValues() ? &CompactLeafScales : nullptr
     );
 }
 
@@ -343,15 +348,34 @@ void TObliviousTrees::UpdateMetadata() const {
         ref.EffectiveBinFeaturesBucketCount
             += (feature.Borders.size() + MAX_VALUES_PER_BIN - 1) / MAX_VALUES_PER_BIN;
     }
+    THashMap<int, ui32> catFeaturePackedIndexes;
     for (const auto& feature : CatFeatures) {
         if (!feature.UsedInModel) {
             continue;
         }
+        catFeaturePackedIndexes[feature.FeatureIndex] = ref.UsedCatFeaturesCount;
         ++ref.UsedCatFeaturesCount;
         ref.MinimalSufficientCatFeaturesVectorSize = static_cast<size_t>(feature.FeatureIndex) + 1;
     }
     for (size_t i = 0; i < OneHotFeatures.size(); ++i) {
         const auto& feature = OneHotFeatures[i];
+        auto& valuesTable = ref.OneHotValuesTables.emplace_back();
+        valuesTable.PackedCatFeatureIndex = catFeaturePackedIndexes.at(feature.CatFeatureIndex);
+        const ui32 tableSize = FastClp2(2 * feature.Values.size() + 1); // load factor is at most 1/2
+        valuesTable.Mask = tableSize - 1;
+        valuesTable.Keys.resize(tableSize, 0);
+        valuesTable.ValueIndexes.resize(tableSize, 0);
+        for (int valueId = 0; valueId < feature.Values.ysize(); ++valueId) {
+            const i32 value = feature.Values[valueId];
+            ui32 slot = IntHash<ui32>(value) & valuesTable.Mask;
+            while (valuesTable.ValueIndexes[slot] && valuesTable.Keys[slot] != value) {
+                slot = (slot + 1) & valuesTable.Mask;
+            }
+            if (!valuesTable.ValueIndexes[slot]) { // first occurrence of the value is used in binarization
+                valuesTable.Keys[slot] = value;
+                valuesTable.ValueIndexes[slot] = valueId + 1;
+            }
+        }
         for (int valueId = 0; valueId < feature.Values.ysize(); ++valueId) {
             TOneHotSplit oh{feature.CatFeatureIndex, feature.Values[valueId]};
             ref.BinFeatures.emplace_back(oh);
@@ -872,31 +896,32 @@ static void StreamModelTreesToBuilder(
 
     const auto& binFeatures = trees.GetBinFeatures();
     const auto& leafOffsets = trees.GetFirstLeafOffsets();
+    TVector<TModelSplit> modelSplits;
+    TVector<double> leafValues;
     for (size_t treeIdx = 0; treeIdx < trees.TreeSizes.size(); ++treeIdx) {
-        TVector<TModelSplit> modelSplits;
+        modelSplits.clear();
         for (int splitIdx = trees.TreeStartOffsets[treeIdx];
              splitIdx < trees.TreeStartOffsets[treeIdx] + trees.TreeSizes[treeIdx];
              ++splitIdx)
         {
             modelSplits.push_back(binFeatures[trees.TreeSplits[splitIdx]]);
         }
+        TConstArrayRef<double> leafValuesRef(
+            trees.LeafValues.begin() + leafOffsets[treeIdx],
+            trees.LeafValues.begin() + leafOffsets[treeIdx]
+                + trees.ApproxDimension * (1u << trees.TreeSizes[treeIdx])
+        );
+        const TConstArrayRef<double> leafWeights = treeIdx < trees.LeafWeights.size() ?
+            TConstArrayRef<double>(trees.LeafWeights[treeIdx])
+            : TConstArrayRef<double>();
         if (leafMultiplier == 1.0) {
-            TConstArrayRef<double> leafValuesRef(
-                trees.LeafValues.begin() + leafOffsets[treeIdx],
-                trees.LeafValues.begin() + leafOffsets[treeIdx]
-                    + trees.ApproxDimension * (1u << trees.TreeSizes[treeIdx])
-            );
-            builder->AddTree(modelSplits, leafValuesRef, trees.LeafWeights[treeIdx]);
+            builder->AddTree(modelSplits, leafValuesRef, leafWeights);
         } else {
-            TVector<double> leafValues(
-                trees.LeafValues.begin() + leafOffsets[treeIdx],
-                trees.LeafValues.begin() + leafOffsets[treeIdx]
-                    + trees.ApproxDimension * (1u << trees.TreeSizes[treeIdx])
-            );
+            leafValues.assign(leafValuesRef.begin(), leafValuesRef.end());
             for (auto& leafValue: leafValues) {
                 leafValue *= leafMultiplier;
             }
-            builder->AddTree(modelSplits, leafValues, trees.LeafWeights[treeIdx]);
+            builder->AddTree(modelSplits, leafValues, leafWeights);
         }
     }
 }
@@ -904,10 +929,12 @@ static void StreamModelTreesToBuilder(
 TFullModel SumModels(
     const TVector<const TFullModel*> modelVector,
     const TVector<double>& weights,
-    ECtrTableMergePolicy ctrMergePolicy) {
+    ECtrTableMergePolicy ctrMergePolicy,
+    int threadCount) {
 
     CB_ENSURE(!modelVector.empty(), "empty model vector unexpected");
     CB_ENSURE(modelVector.size() == weights.size());
+    CB_ENSURE(threadCount > 0, "Thread count should be positive");
     const auto approxDimension = modelVector.back()->ObliviousTrees.ApproxDimension;
     size_t maxFlatFeatureVectorSize = 0;
     TVector<TIntrusivePtr<ICtrProvider>> ctrProviders;
@@ -937,6 +964,10 @@ TFullModel SumModels(
     for (auto& flatFeature: flatFeatureInfoVector) {
         Visit(merger, flatFeature.FeatureVariant);
     }
+
+    NPar::TLocalExecutor localExecutor;
+    localExecutor.RunAdditionalThreads(threadCount - 1);
+
     TObliviousTreeBuilder builder(merger.MergedFloatFeatures, merger.MergedCatFeatures, approxDimension);
     for (const auto modelId : xrange(modelVector.size())) {
         StreamModelTreesToBuilder(modelVector[modelId]->ObliviousTrees, weights[modelId], &builder);
@@ -950,7 +981,7 @@ TFullModel SumModels(
             result.ModelInfo[keyPrefix + key] = value;
         }
     }
-    result.CtrProvider = MergeCtrProvidersData(ctrProviders, ctrMergePolicy);
+    result.CtrProvider = MergeCtrProvidersData(ctrProviders, ctrMergePolicy, &localExecutor);
     result.UpdateDynamicData();
     return result;
 }
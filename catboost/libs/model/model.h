@@ -18,6 +18,7 @@
 #include <util/generic/string.h>
 #include <util/generic/utility.h>
 #include <util/generic/vector.h>
+#include <util/digest/numeric.h>
 #include <util/stream/fwd.h>
 #include <util/stream/mem.h>
 #include <util/system/types.h>
@@ -96,6 +97,34 @@ public:
 
         //! Offset of first tree leaf in flat tree leafs array
         TVector<size_t> TreeFirstLeafOffsets;
+
+        /**
+         * Open addressing hash table from categorical feature value hash to one hot value index, used
+         * for one hot features binarization instead of scanning all values for every object.
+         */
+        struct TOneHotValuesTable {
+            //! Index of the categorical feature among categorical features used in model
+            ui32 PackedCatFeatureIndex = 0;
+            ui32 Mask = 0;
+            TVector<i32> Keys;
+            //! Value index + 1, zero for empty slot
+            TVector<ui32> ValueIndexes;
+
+            /**
+             * @return one hot value index + 1 or zero if value is not one of one hot feature values
+             */
+            Y_FORCE_INLINE ui32 Find(i32 value) const {
+                for (ui32 slot = IntHash<ui32>(value) & Mask; ValueIndexes[slot]; slot = (slot + 1) & Mask) {
+                    if (Keys[slot] == value) {
+                        return ValueIndexes[slot];
+                    }
+                }
+                return 0;
+            }
+        };
+
+        //! [oneHotFeatureIdx] -> values table of OneHotFeatures[oneHotFeatureIdx]
+        TVector<TOneHotValuesTable> OneHotValuesTables;
     };
 
 public:
@@ -124,6 +153,18 @@ public:
      */
     TVector<TVector<double>> LeafWeights;
 
+    /**
+     * Optional reduced precision copy of LeafValues, made by CompactLeafValues (compact_leaf_values.h).
+     * If present it is used in model evaluation instead of LeafValues.
+     * Leaf value is CompactLeafScales[treeIndex] * stored value, where stored value is int16 or float16
+     * depending on CompactLeafValuesType.
+     *
+     *  layout: same as LeafValues
+     */
+    NCatBoostFbs::ECompactLeafValuesType CompactLeafValuesType = NCatBoostFbs::ECompactLeafValuesType_None;
+    TVector<ui16> CompactLeafValues;
+    TVector<double> CompactLeafScales;
+
     //! Categorical features, used in model in OneHot conditions or/and in CTR feature combinations
     TVector<TCatFeature> CatFeatures;
 
@@ -146,6 +187,9 @@ public:
             TreeSizes,
             TreeStartOffsets,
             LeafValues,
+            CompactLeafValuesType,
+            CompactLeafValues,
+            CompactLeafScales,
             CatFeatures,
             FloatFeatures,
             OneHotFeatures,
@@ -156,6 +200,9 @@ public:
             other.TreeSizes,
             other.TreeStartOffsets,
             other.LeafValues,
+            other.CompactLeafValuesType,
+            other.CompactLeafValues,
+            other.CompactLeafScales,
             other.CatFeatures,
             other.FloatFeatures,
             other.OneHotFeatures,
@@ -202,6 +249,13 @@ public:
                 leafValIter += treeLeafCout;
             }
         }
+        CompactLeafValuesType = fbObj->CompactLeafValuesType();
+        if (fbObj->CompactLeafValues()) {
+            CompactLeafValues.assign(fbObj->CompactLeafValues()->begin(), fbObj->CompactLeafValues()->end());
+        }
+        if (fbObj->CompactLeafScales()) {
+            CompactLeafScales.assign(fbObj->CompactLeafScales()->begin(), fbObj->CompactLeafScales()->end());
+        }
 
 #define FEATURES_ARRAY_DESERIALIZER(var) \
         if (fbObj->var()) {\
@@ -277,11 +331,20 @@ public:
         return MetaData->RepackedBins;
     }
 
+    const TVector<TMetaData::TOneHotValuesTable>& GetOneHotValuesTables() const {
+        CB_ENSURE(MetaData.Defined(), "metadata should be initialized");
+        return MetaData->OneHotValuesTables;
+    }
+
     const TVector<size_t>& GetFirstLeafOffsets() const {
         CB_ENSURE(MetaData.Defined(), "metadata should be initialized");
         return MetaData->TreeFirstLeafOffsets;
     }
 
+    bool HasCompactLeafValues() const {
+        return CompactLeafValuesType != NCatBoostFbs::ECompactLeafValuesType_None;
+    }
+
     const double* GetFirstLeafPtrForTree(size_t treeIdx) const {
         CB_ENSURE(MetaData.Defined(), "metadata should be initialized");
         return &LeafValues[MetaData->TreeFirstLeafOffsets[treeIdx]];
@@ -739,7 +802,12 @@ TVector<TString> GetModelUsedFeaturesNames(const TFullModel& model);
 
 TVector<TString> GetModelClassNames(const TFullModel& model);
 
+/**
+ * Make model with sum of weighted predictions of given models.
+ * Trees of different models and ctr tables are prepared in parallel using threadCount threads.
+ */
 TFullModel SumModels(
     const TVector<const TFullModel*> modelVector,
     const TVector<double>& weights,
-    ECtrTableMergePolicy ctrMergePolicy = ECtrTableMergePolicy::IntersectingCountersAverage);
+    ECtrTableMergePolicy ctrMergePolicy = ECtrTableMergePolicy::IntersectingCountersAverage,
+    int threadCount = 1);
@@ -0,0 +1,158 @@
+#include "model_bundle.h"
+
+#include "formula_evaluator.h"
+#include "static_ctr_provider.h"
+
+#include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/hash.h>
+#include <util/generic/utility.h>
+#include <util/generic/xrange.h>
+
+
+TModelBundle::TModelBundle(const TVector<const TFullModel*>& models) {
+    CB_ENSURE(!models.empty(), "TModelBundle: empty model vector unexpected");
+
+    // CTRs are calculated once for all models, so the result is exact only for the same value tables
+    THashMap<TModelCtrBase, const TCtrValueTable*> ctrValueTables;
+    size_t treeStart = 0;
+    for (const auto* model : models) {
+        Y_ASSERT(model != nullptr);
+        if (model->CtrProvider) {
+            const auto* staticCtrProvider = dynamic_cast<const TStaticCtrProvider*>(model->CtrProvider.Get());
+            CB_ENSURE(staticCtrProvider != nullptr, "TModelBundle: only static ctr providers are supported");
+            for (const auto& [ctrBase, ctrValueTable] : staticCtrProvider->CtrData.LearnCtrs) {
+                const auto [it, inserted] = ctrValueTables.emplace(ctrBase, &ctrValueTable);
+                CB_ENSURE(
+                    inserted || (*it->second == ctrValueTable),
+                    "TModelBundle: models have different value tables for the same ctr"
+                );
+            }
+        }
+        const size_t treeEnd = treeStart + model->ObliviousTrees.TreeSizes.size();
+        ModelTreeRanges.emplace_back(treeStart, treeEnd);
+        treeStart = treeEnd;
+    }
+
+    // intersecting ctr tables are the same so any merge policy except failing gives the same result
+    MergedModel = SumModels(
+        models,
+        TVector<double>(models.size(), 1.0),
+        ECtrTableMergePolicy::LeaveMostDiversifiedTable
+    );
+    Y_ASSERT(MergedModel.ObliviousTrees.TreeSizes.size() == treeStart);
+}
+
+template <typename TFloatFeatureAccessor, typename TCatFeatureAccessor>
+static TVector<TVector<double>> CalcModelBundleGeneric(
+    const TFullModel& mergedModel,
+    TConstArrayRef<std::pair<size_t, size_t>> modelTreeRanges,
+    TFloatFeatureAccessor floatFeatureAccessor,
+    TCatFeatureAccessor catFeaturesAccessor,
+    size_t docCount
+) {
+    const auto approxDimension = mergedModel.ObliviousTrees.ApproxDimension;
+    TVector<TVector<double>> results(modelTreeRanges.size(), TVector<double>(docCount * approxDimension, 0.0));
+    if (docCount == 0) {
+        return results;
+    }
+
+    const size_t blockSize = Min(FORMULA_EVALUATION_BLOCK_SIZE, docCount);
+    TVector<ui8> binFeatures(blockSize * mergedModel.ObliviousTrees.GetEffectiveBinaryFeaturesBucketsCount());
+    TVector<TCalcerIndexType> indexesVec(blockSize);
+    TVector<ui32> transposedHash(blockSize * mergedModel.GetUsedCatFeaturesCount());
+    TVector<float> ctrs(mergedModel.ObliviousTrees.GetUsedModelCtrs().size() * blockSize);
+    auto calcTrees = GetCalcTreesFunction(mergedModel, blockSize);
+    for (size_t blockStart = 0; blockStart < docCount; blockStart += blockSize) {
+        const auto docCountInBlock = Min(blockSize, docCount - blockStart);
+        BinarizeFeatures(
+            mergedModel,
+            floatFeatureAccessor,
+            catFeaturesAccessor,
+            blockStart,
+            blockStart + docCountInBlock,
+            binFeatures,
+            transposedHash,
+            ctrs
+        );
+        for (auto modelIdx : xrange(modelTreeRanges.size())) {
+            calcTrees(
+                mergedModel,
+                binFeatures.data(),
+                docCountInBlock,
+                indexesVec.data(),
+                modelTreeRanges[modelIdx].first,
+                modelTreeRanges[modelIdx].second,
+                results[modelIdx].data() + blockStart * approxDimension
+            );
+        }
+    }
+    return results;
+}
+
+TVector<TVector<double>> TModelBundle::Calc(
+    TConstArrayRef<TConstArrayRef<float>> floatFeatures,
+    TConstArrayRef<TConstArrayRef<int>> catFeatures) const {
+
+    if (!floatFeatures.empty() && !catFeatures.empty()) {
+        CB_ENSURE(catFeatures.size() == floatFeatures.size());
+    }
+    const size_t docCount = Max(catFeatures.size(), floatFeatures.size());
+    const auto& trees = MergedModel.ObliviousTrees;
+    CB_ENSURE(
+        trees.GetUsedFloatFeaturesCount() == 0 || !floatFeatures.empty(),
+        "Model has float features but no float features provided"
+    );
+    CB_ENSURE(
+        trees.GetUsedCatFeaturesCount() == 0 || !catFeatures.empty(),
+        "Model has categorical features but no categorical features provided"
+    );
+    for (const auto& floatFeaturesVec : floatFeatures) {
+        CB_ENSURE(
+            floatFeaturesVec.size() >= trees.GetMinimalSufficientFloatFeaturesVectorSize(),
+            "insufficient float features vector size: " << floatFeaturesVec.size()
+            << " expected: " << trees.GetMinimalSufficientFloatFeaturesVectorSize()
+        );
+    }
+    for (const auto& catFeaturesVec : catFeatures) {
+        CB_ENSURE(
+            catFeaturesVec.size() >= trees.GetMinimalSufficientCatFeaturesVectorSize(),
+            "insufficient cat features vector size: " << catFeaturesVec.size()
+            << " expected: " << trees.GetMinimalSufficientCatFeaturesVectorSize()
+        );
+    }
+    return CalcModelBundleGeneric(
+        MergedModel,
+        ModelTreeRanges,
+        [&floatFeatures](const TFloatFeature& floatFeature, size_t index) -> float {
+            return floatFeatures[index][floatFeature.FeatureIndex];
+        },
+        [&catFeatures](const TCatFeature& catFeature, size_t index) -> int {
+            return catFeatures[index][catFeature.FeatureIndex];
+        },
+        docCount
+    );
+}
+
+TVector<TVector<double>> TModelBundle::CalcFlat(TConstArrayRef<TConstArrayRef<float>> features) const {
+    const auto expectedFlatVecSize = MergedModel.ObliviousTrees.GetFlatFeatureVectorExpectedSize();
+    for (const auto& flatFeaturesVec : features) {
+        CB_ENSURE(
+            flatFeaturesVec.size() >= expectedFlatVecSize,
+            "insufficient flat features vector size: " << flatFeaturesVec.size()
+            << " expected: " << expectedFlatVecSize
+        );
+    }
+    return CalcModelBundleGeneric(
+        MergedModel,
+        ModelTreeRanges,
+        [&features](const TFloatFeature& floatFeature, size_t index) -> float {
+            return features[index][floatFeature.FlatFeatureIndex];
+        },
+        [&features](const TCatFeature& catFeature, size_t index) -> int {
+            return ConvertFloatCatFeatureToIntHash(features[index][catFeature.FlatFeatureIndex]);
+        },
+        features.size()
+    );
+}
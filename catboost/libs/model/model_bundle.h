@@ -0,0 +1,59 @@
+#pragma once
+
+#include "model.h"
+
+#include <util/generic/array_ref.h>
+#include <util/generic/vector.h>
+
+#include <utility>
+
+
+/**
+ * Evaluator for several models trained on the same features (champion/challengers, per-segment models).
+ * Features of all models are merged in the same way as in SumModels, so each block of objects is
+ * binarized (with categorical features hashing and CTR calculation) only once and then trees of every
+ * model are applied to the shared binarized block.
+ * All models must have the same approx dimension. If several models use the same CTR their value
+ * tables must be the same (i.e. models have been trained on the same learn data).
+ */
+class TModelBundle {
+public:
+    explicit TModelBundle(const TVector<const TFullModel*>& models);
+
+    size_t GetModelCount() const {
+        return ModelTreeRanges.size();
+    }
+
+    int GetApproxDimension() const {
+        return MergedModel.ObliviousTrees.ApproxDimension;
+    }
+
+    /**
+     * Model with merged features and trees of all models (in the order of models)
+     */
+    const TFullModel& GetMergedModel() const {
+        return MergedModel;
+    }
+
+    /**
+     * Evaluate raw formula predictions of all models on user data
+     * @param[in] floatFeatures
+     * @param[in] catFeatures hashed cat feature values
+     * @return results indexation is [modelIdx][objectIndex * ApproxDimension + classId]
+     */
+    TVector<TVector<double>> Calc(
+        TConstArrayRef<TConstArrayRef<float>> floatFeatures,
+        TConstArrayRef<TConstArrayRef<int>> catFeatures) const;
+
+    /**
+     * Same as Calc but for **flat** feature vectors
+     * @param[in] features vector of flat features array reference. First dimension is object index, second
+     *  dimension is feature index.
+     * @return results indexation is [modelIdx][objectIndex * ApproxDimension + classId]
+     */
+    TVector<TVector<double>> CalcFlat(TConstArrayRef<TConstArrayRef<float>> features) const;
+
+private:
+    TFullModel MergedModel;
+    TVector<std::pair<size_t, size_t>> ModelTreeRanges; // [modelIdx] -> [treeStart, treeEnd) in MergedModel
+};
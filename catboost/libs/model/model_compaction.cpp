@@ -0,0 +1,127 @@
+#include "model_compaction.h"
+
+#include "compact_leaf_values.h"
+#include "model_build_helper.h"
+
+#include <catboost/libs/helpers/exception.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/map.h>
+#include <util/generic/xrange.h>
+
+
+namespace {
+    struct TCompactedTree {
+        TVector<TModelSplit> Splits;
+        TVector<double> LeafValues;
+        TVector<double> LeafWeights;
+        //! Sorted unique bins buckets of the source model used by the tree
+        TVector<ui32> Buckets;
+    };
+}
+
+static void FillReport(const TObliviousTrees& trees, size_t* treeCount, size_t* binFeatureCount, size_t* bucketCount) {
+    *treeCount = trees.GetTreeCount();
+    *binFeatureCount = trees.GetBinFeatures().size();
+    *bucketCount = trees.GetEffectiveBinaryFeaturesBucketsCount();
+}
+
+TFullModel CompactModel(const TFullModel& model, TModelCompactionReport* report) {
+    const auto& trees = model.ObliviousTrees;
+    const auto approxDimension = trees.ApproxDimension;
+    const auto& binFeatures = trees.GetBinFeatures();
+    const auto& repackedBins = trees.GetRepackedBins();
+    const auto& leafOffsets = trees.GetFirstLeafOffsets();
+
+    TVector<TCompactedTree> compactedTrees;
+    TMap<TVector<TModelSplit>, TVector<size_t>> treeIndicesBySplits;
+    for (auto treeIdx : xrange(trees.GetTreeCount())) {
+        const int treeDepth = trees.TreeSizes[treeIdx];
+        const int splitOffset = trees.TreeStartOffsets[treeIdx];
+
+        // leaf index bit j of the result is bit splitOrder[j] of the source leaf index
+        TVector<int> splitOrder(treeDepth);
+        Iota(splitOrder.begin(), splitOrder.end(), 0);
+        StableSort(splitOrder, [&](int lhs, int rhs) {
+            return binFeatures[trees.TreeSplits[splitOffset + lhs]] < binFeatures[trees.TreeSplits[splitOffset + rhs]];
+        });
+        TVector<TModelSplit> splits;
+        for (auto splitIdx : splitOrder) {
+            splits.push_back(binFeatures[trees.TreeSplits[splitOffset + splitIdx]]);
+        }
+        const size_t leafCount = size_t(1) << treeDepth;
+        TVector<double> leafValues(leafCount * approxDimension);
+        TVector<double> leafWeights;
+        const bool hasLeafWeights = treeIdx < trees.LeafWeights.size() && !trees.LeafWeights[treeIdx].empty();
+        if (hasLeafWeights) {
+            leafWeights.resize(leafCount);
+        }
+        for (auto leafIdx : xrange(leafCount)) {
+            size_t sourceLeafIdx = 0;
+            for (auto bit : xrange(treeDepth)) {
+                sourceLeafIdx |= ((leafIdx >> bit) & 1) << splitOrder[bit];
+            }
+            for (auto dim : xrange(approxDimension)) {
+                leafValues[leafIdx * approxDimension + dim]
+                    = trees.LeafValues[leafOffsets[treeIdx] + sourceLeafIdx * approxDimension + dim];
+            }
+            if (hasLeafWeights) {
+                leafWeights[leafIdx] = trees.LeafWeights[treeIdx][sourceLeafIdx];
+            }
+        }
+
+        /* trees of the same learn data have the same leaf weights, different leaf weights mean different
+         * data (i.e. trees from summed models), such trees are not merged as no leaf weight is right for the sum
+         */
+        auto& sameSplitsTrees = treeIndicesBySplits[splits];
+        const auto sameTreeIt = FindIf(sameSplitsTrees, [&](size_t compactedTreeIdx) {
+            return compactedTrees[compactedTreeIdx].LeafWeights == leafWeights;
+        });
+        if (sameTreeIt != sameSplitsTrees.end()) {
+            auto& sameTree = compactedTrees[*sameTreeIt];
+            for (auto i : xrange(leafValues.size())) {
+                sameTree.LeafValues[i] += leafValues[i];
+            }
+            continue;
+        }
+        sameSplitsTrees.push_back(compactedTrees.size());
+        TVector<ui32> buckets;
+        for (auto splitIdx : xrange(splitOffset, splitOffset + treeDepth)) {
+            buckets.push_back(repackedBins[splitIdx].FeatureIndex);
+        }
+        SortUnique(buckets);
+        compactedTrees.push_back({std::move(splits), std::move(leafValues), std::move(leafWeights), std::move(buckets)});
+    }
+
+    StableSort(compactedTrees, [](const TCompactedTree& lhs, const TCompactedTree& rhs) {
+        return lhs.Buckets < rhs.Buckets;
+    });
+
+    TObliviousTreeBuilder builder(trees.FloatFeatures, trees.CatFeatures, approxDimension);
+    for (const auto& tree : compactedTrees) {
+        builder.AddTree(tree.Splits, tree.LeafValues, tree.LeafWeights);
+    }
+    TFullModel result;
+    result.ObliviousTrees = builder.Build();
+    result.ObliviousTrees.DropUnusedFeatures();
+    result.ModelInfo = model.ModelInfo;
+    if (model.CtrProvider) {
+        result.CtrProvider = model.CtrProvider->Clone();
+        result.CtrProvider->DropUnusedTables(result.ObliviousTrees.GetUsedModelCtrBases());
+    }
+    result.UpdateDynamicData();
+    if (trees.HasCompactLeafValues()) {
+        CompactLeafValues(trees.CompactLeafValuesType, {}, &result);
+    }
+
+    if (report) {
+        FillReport(trees, &report->TreeCountBefore, &report->BinFeatureCountBefore, &report->BucketCountBefore);
+        FillReport(
+            result.ObliviousTrees,
+            &report->TreeCountAfter,
+            &report->BinFeatureCountAfter,
+            &report->BucketCountAfter
+        );
+    }
+    return result;
+}
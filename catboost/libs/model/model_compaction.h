@@ -0,0 +1,29 @@
+#pragma once
+
+#include "model.h"
+
+
+struct TModelCompactionReport {
+    size_t TreeCountBefore = 0;
+    size_t TreeCountAfter = 0;
+    //! Number of binary features (borders, one hot values, ctr borders) used in trees
+    size_t BinFeatureCountBefore = 0;
+    size_t BinFeatureCountAfter = 0;
+    //! Number of binarized feature buckets, i.e. size of binarized features for one object
+    size_t BucketCountBefore = 0;
+    size_t BucketCountAfter = 0;
+};
+
+/**
+ * Make model with the same final predictions which is faster to evaluate:
+ *  - splits inside each tree are sorted (leaf values are permuted accordingly) and trees with the same
+ *    set of splits and the same leaf weights are merged by summing their leaf values;
+ *  - trees are reordered to put trees using the same binarized features next to each other;
+ *  - unused borders, one hot values, ctrs and features are dropped, so bins layout is rebuilt.
+ * Predictions of tree ranges (staged predictions, eval period) of the result don't correspond to ones
+ * of the source model. Compact leaf values of the source model are recalculated with the same type.
+ * @param[in] model
+ * @param[out] report can be nullptr
+ * @return compacted model
+ */
+TFullModel CompactModel(const TFullModel& model, TModelCompactionReport* report = nullptr);
@@ -2,19 +2,44 @@
 
 #include "export_helpers.h"
 
+#include <catboost/libs/model/formula_evaluator.h>
 #include <catboost/libs/model/static_ctr_provider.h>
 
+#include <library/json/json_reader.h>
 #include <library/resource/resource.h>
 
 #include <util/generic/map.h>
 #include <util/generic/set.h>
+#include <util/generic/xrange.h>
 #include <util/string/builder.h>
 #include <util/string/cast.h>
 #include <util/stream/input.h>
+#include <util/stream/str.h>
 
 namespace NCatboost {
     using namespace NCatboostModelExportHelpers;
 
+    TCatboostModelToCppConverter::TCatboostModelToCppConverter(
+        const TString& modelFile,
+        bool addFileFormatExtension,
+        const TString& userParametersJson)
+        : Out(modelFile + (addFileFormatExtension ? ".cpp" : ""))
+    {
+        if (userParametersJson.empty()) {
+            return;
+        }
+        TStringInput is(userParametersJson);
+        NJson::TJsonValue params;
+        NJson::ReadJsonTree(&is, &params, /*throwOnError*/ true);
+        for (const auto& [key, value] : params.GetMapSafe()) {
+            if (key == "specialized_evaluator") {
+                SpecializedEvaluator = value.GetBooleanSafe();
+            } else {
+                CB_ENSURE(false, "JSON user param " << key << " for exporting the model to C++ is not supported");
+            }
+        }
+    }
+
     /*
      * Tiny code for case when cat features not present
      */
@@ -327,4 +352,291 @@ namespace NCatboost {
         Out << '\n';
         Out << NResource::Find("catboost_model_export_cpp_model_applicator");
     }
+
+    /*
+     * Evaluator specialized for the model: all model data are compile-time constants, so the compiler
+     * unrolls binarization loops for exact border counts and leaf index calculation for each tree depth.
+     * Float features only, each used feature must fit a single bin bucket (at most 254 borders).
+     */
+
+    void TCatboostModelToCppConverter::WriteSpecializedHeader() {
+        Out << "#include <cmath>" << '\n';
+        Out << "#include <cstddef>" << '\n';
+        Out << "#include <limits>" << '\n';
+        Out << "#include <string>" << '\n';
+        Out << "#include <vector>" << '\n';
+        Out << '\n';
+        Out << "#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)" << '\n';
+        Out << "#include <emmintrin.h>" << '\n';
+        Out << "#define CATBOOST_MODEL_USE_SSE2" << '\n';
+        Out << "#endif" << '\n';
+        Out << '\n';
+    }
+
+    static TString FloatToExactString(float value) {
+        // 9 significant digits are enough to restore any float exactly
+        return FloatToString(value, PREC_NDIGITS, 9) + "f";
+    }
+
+    static TString DoubleToExactString(double value) {
+        return FloatToString(value, PREC_NDIGITS, 17);
+    }
+
+    void TCatboostModelToCppConverter::WriteSpecializedModel(const TFullModel& model) {
+        const auto& trees = model.ObliviousTrees;
+        CB_ENSURE(!model.HasCategoricalFeatures(), "Specialized evaluator export of model with categorical features is not supported.");
+        CB_ENSURE(trees.ApproxDimension == 1, "Specialized evaluator export of MultiClassification model is not supported.");
+        for (const auto& floatFeature : trees.FloatFeatures) {
+            CB_ENSURE(
+                floatFeature.Borders.size() <= MAX_VALUES_PER_BIN,
+                "Specialized evaluator export: float feature " << floatFeature.FeatureIndex << " has "
+                << floatFeature.Borders.size() << " borders, at most " << MAX_VALUES_PER_BIN << " are supported"
+            );
+        }
+        const auto& repackedBins = trees.GetRepackedBins();
+        CB_ENSURE_INTERNAL(repackedBins.size() == trees.TreeSplits.size(), "Unexpected repacked bins count");
+        for (const auto& bin : repackedBins) {
+            CB_ENSURE_INTERNAL(bin.XorMask == 0, "Unexpected xor mask for float feature split");
+        }
+
+        TIndent indent(1);
+        Out << "namespace {" << '\n';
+        Out << indent << "/* Model data */" << '\n';
+        Out << indent << "constexpr std::size_t CatboostModelBlockSize = " << FORMULA_EVALUATION_BLOCK_SIZE << ";" << '\n';
+        Out << indent << "constexpr unsigned int CatboostModelFloatFeatureCount = " << trees.GetNumFloatFeatures() << ";" << '\n';
+        Out << indent << "constexpr unsigned int CatboostModelUsedFeatureCount = " << trees.GetUsedFloatFeaturesCount() << ";" << '\n';
+        Out << indent << "constexpr unsigned int CatboostModelTreeCount = " << trees.TreeSizes.size() << ";" << '\n';
+        Out << '\n';
+
+        Out << indent << "/* Borders of used float features, bins of i-th used feature are CatboostModelBordersI */" << '\n';
+        size_t usedFeatureIdx = 0;
+        for (const auto& floatFeature : trees.FloatFeatures) {
+            if (!floatFeature.UsedInModel()) {
+                continue;
+            }
+            Out << indent << "/* float feature " << floatFeature.FeatureIndex << " */" << '\n';
+            Out << indent << "constexpr float CatboostModelBorders" << usedFeatureIdx
+                << "[" << floatFeature.Borders.size() << "] = {"
+                << OutputArrayInitializer([&floatFeature](size_t i) { return FloatToExactString(floatFeature.Borders[i]); }, floatFeature.Borders.size())
+                << "};" << '\n';
+            ++usedFeatureIdx;
+        }
+        Out << '\n';
+
+        if (!trees.TreeSizes.empty()) {
+            Out << indent << "constexpr unsigned char CatboostModelTreeDepth[" << trees.TreeSizes.size() << "] = {"
+                << OutputArrayInitializer(trees.TreeSizes) << "};" << '\n';
+        }
+        if (!repackedBins.empty()) {
+            Out << indent << "/* Split is true for an object if the bin of used feature SplitBuckets[i] is >= SplitThresholds[i] */" << '\n';
+            Out << indent << "constexpr unsigned short CatboostModelSplitBuckets[" << repackedBins.size() << "] = {"
+                << OutputArrayInitializer([&repackedBins](size_t i) { return repackedBins[i].FeatureIndex; }, repackedBins.size())
+                << "};" << '\n';
+            Out << indent << "constexpr unsigned char CatboostModelSplitThresholds[" << repackedBins.size() << "] = {"
+                << OutputArrayInitializer([&repackedBins](size_t i) { return (ui32)repackedBins[i].SplitIdx; }, repackedBins.size())
+                << "};" << '\n';
+        }
+        Out << '\n';
+        Out << indent << "/* Aggregated array of leaf values for trees. Each tree is represented by a separate line: */" << '\n';
+        Out << indent++ << "constexpr double CatboostModelLeafValues[" << Max<size_t>(trees.LeafValues.size(), 1) << "] = {" << '\n';
+        size_t leafOffset = 0;
+        TSequenceCommaSeparator treeComma(trees.TreeSizes.size());
+        for (auto treeSize : trees.TreeSizes) {
+            const size_t leafCount = size_t(1) << treeSize;
+            Out << indent
+                << OutputArrayInitializer(
+                    [&trees, leafOffset](size_t i) { return DoubleToExactString(trees.LeafValues[leafOffset + i]); },
+                    leafCount)
+                << treeComma << '\n';
+            leafOffset += leafCount;
+        }
+        if (trees.TreeSizes.empty()) {
+            Out << indent << "0.0" << '\n';
+        }
+        Out << --indent << "};" << '\n';
+        Out << "}" << '\n';
+        Out << '\n';
+    }
+
+    void TCatboostModelToCppConverter::WriteSpecializedApplicator(const TFullModel& model) {
+        const auto& trees = model.ObliviousTrees;
+
+        Out << "namespace {" << '\n';
+        Out << "    /* Counts borders less than the feature value for each object, NaN is counted as +inf if NanAsTrue */" << '\n';
+        Out << "    template <bool NanAsTrue, unsigned int BorderCount>" << '\n';
+        Out << "    inline void CatboostModelBinarizeFeature(" << '\n';
+        Out << "        const float* features," << '\n';
+        Out << "        std::size_t featureStride," << '\n';
+        Out << "        unsigned int featureIndex," << '\n';
+        Out << "        std::size_t docCount," << '\n';
+        Out << "        const float (&borders)[BorderCount]," << '\n';
+        Out << "        unsigned char* bins" << '\n';
+        Out << "    ) {" << '\n';
+        Out << "        std::size_t docId = 0;" << '\n';
+        Out << "#ifdef CATBOOST_MODEL_USE_SSE2" << '\n';
+        Out << "        for (; docId + 4 <= docCount; docId += 4) {" << '\n';
+        Out << "            __m128 values = _mm_setr_ps(" << '\n';
+        Out << "                features[(docId + 0) * featureStride + featureIndex]," << '\n';
+        Out << "                features[(docId + 1) * featureStride + featureIndex]," << '\n';
+        Out << "                features[(docId + 2) * featureStride + featureIndex]," << '\n';
+        Out << "                features[(docId + 3) * featureStride + featureIndex]" << '\n';
+        Out << "            );" << '\n';
+        Out << "            if (NanAsTrue) {" << '\n';
+        Out << "                const __m128 isNan = _mm_cmpunord_ps(values, values);" << '\n';
+        Out << "                const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());" << '\n';
+        Out << "                values = _mm_or_ps(_mm_and_ps(isNan, infinity), _mm_andnot_ps(isNan, values));" << '\n';
+        Out << "            }" << '\n';
+        Out << "            __m128i counts = _mm_setzero_si128();" << '\n';
+        Out << "            for (unsigned int borderId = 0; borderId < BorderCount; ++borderId) {" << '\n';
+        Out << "                /* comparison mask is -1 for values greater than the border */" << '\n';
+        Out << "                const __m128 greater = _mm_cmpgt_ps(values, _mm_set1_ps(borders[borderId]));" << '\n';
+        Out << "                counts = _mm_sub_epi32(counts, _mm_castps_si128(greater));" << '\n';
+        Out << "            }" << '\n';
+        Out << "            int countsArray[4];" << '\n';
+        Out << "            _mm_storeu_si128((__m128i*)countsArray, counts);" << '\n';
+        Out << "            for (unsigned int i = 0; i < 4; ++i) {" << '\n';
+        Out << "                bins[docId + i] = (unsigned char)countsArray[i];" << '\n';
+        Out << "            }" << '\n';
+        Out << "        }" << '\n';
+        Out << "#endif" << '\n';
+        Out << "        for (; docId < docCount; ++docId) {" << '\n';
+        Out << "            float value = features[docId * featureStride + featureIndex];" << '\n';
+        Out << "            if (NanAsTrue && std::isnan(value)) {" << '\n';
+        Out << "                value = std::numeric_limits<float>::infinity();" << '\n';
+        Out << "            }" << '\n';
+        Out << "            unsigned int count = 0;" << '\n';
+        Out << "            for (unsigned int borderId = 0; borderId < BorderCount; ++borderId) {" << '\n';
+        Out << "                count += (unsigned int)(value > borders[borderId]);" << '\n';
+        Out << "            }" << '\n';
+        Out << "            bins[docId] = (unsigned char)count;" << '\n';
+        Out << "        }" << '\n';
+        Out << "    }" << '\n';
+        Out << '\n';
+
+        Out << "    /* Bins are stored by used feature: bins[usedFeatureIdx * CatboostModelBlockSize + docId] */" << '\n';
+        Out << "    inline void CatboostModelBinarize(" << '\n';
+        Out << "        const float* features," << '\n';
+        Out << "        std::size_t featureStride," << '\n';
+        Out << "        std::size_t docCount," << '\n';
+        Out << "        unsigned char* bins" << '\n';
+        Out << "    ) {" << '\n';
+        size_t usedFeatureIdx = 0;
+        for (const auto& floatFeature : trees.FloatFeatures) {
+            if (!floatFeature.UsedInModel()) {
+                continue;
+            }
+            // AsFalse and AsIs treatments give zero bin for NaN, same as plain comparison
+            const bool nanAsTrue = floatFeature.HasNans
+                && floatFeature.NanValueTreatment == NCatBoostFbs::ENanValueTreatment_AsTrue;
+            Out << "        CatboostModelBinarizeFeature<" << (nanAsTrue ? "true" : "false") << ">("
+                << "features, featureStride, " << floatFeature.FeatureIndex << ", docCount, "
+                << "CatboostModelBorders" << usedFeatureIdx << ", "
+                << "bins + " << usedFeatureIdx << " * CatboostModelBlockSize);" << '\n';
+            ++usedFeatureIdx;
+        }
+        if (usedFeatureIdx == 0) {
+            Out << "        (void)features;" << '\n';
+            Out << "        (void)featureStride;" << '\n';
+            Out << "        (void)docCount;" << '\n';
+            Out << "        (void)bins;" << '\n';
+        }
+        Out << "    }" << '\n';
+        Out << '\n';
+
+        const TSet<int> treeDepths(trees.TreeSizes.begin(), trees.TreeSizes.end());
+        for (auto depth : treeDepths) {
+            Out << "    inline unsigned int CatboostModelLeafIndex" << depth << "(" << '\n';
+            Out << "        const unsigned char* bins," << '\n';
+            Out << "        std::size_t docId," << '\n';
+            Out << "        const unsigned short* buckets," << '\n';
+            Out << "        const unsigned char* thresholds" << '\n';
+            Out << "    ) {" << '\n';
+            if (depth == 0) {
+                Out << "        (void)bins;" << '\n';
+                Out << "        (void)docId;" << '\n';
+                Out << "        (void)buckets;" << '\n';
+                Out << "        (void)thresholds;" << '\n';
+                Out << "        return 0;" << '\n';
+            } else {
+                Out << "        return" << '\n';
+                for (auto level : xrange(depth)) {
+                    Out << "            ((unsigned int)(bins[buckets[" << level << "] * CatboostModelBlockSize + docId] >= "
+                        << "thresholds[" << level << "]) << " << level << ")"
+                        << (level + 1 == depth ? ";" : " |") << '\n';
+                }
+            }
+            Out << "    }" << '\n';
+            Out << '\n';
+        }
+
+        Out << "    /* Adds values of all trees to results[0 .. docCount) */" << '\n';
+        Out << "    inline void CatboostModelCalcTrees(const unsigned char* bins, std::size_t docCount, double* results) {" << '\n';
+        if (trees.TreeSizes.empty()) {
+            Out << "        (void)bins;" << '\n';
+            Out << "        (void)docCount;" << '\n';
+            Out << "        (void)results;" << '\n';
+        } else {
+            Out << "        const unsigned short* buckets = " << (trees.TreeSplits.empty() ? "nullptr" : "CatboostModelSplitBuckets") << ";" << '\n';
+            Out << "        const unsigned char* thresholds = " << (trees.TreeSplits.empty() ? "nullptr" : "CatboostModelSplitThresholds") << ";" << '\n';
+            Out << "        const double* leafValues = CatboostModelLeafValues;" << '\n';
+            Out << "        for (unsigned int treeId = 0; treeId < CatboostModelTreeCount; ++treeId) {" << '\n';
+            Out << "            const unsigned int depth = CatboostModelTreeDepth[treeId];" << '\n';
+            Out << "            switch (depth) {" << '\n';
+            for (auto depth : treeDepths) {
+                Out << "                case " << depth << ":" << '\n';
+                Out << "                    for (std::size_t docId = 0; docId < docCount; ++docId) {" << '\n';
+                Out << "                        results[docId] += leafValues[CatboostModelLeafIndex" << depth << "(bins, docId, buckets, thresholds)];" << '\n';
+                Out << "                    }" << '\n';
+                Out << "                    break;" << '\n';
+            }
+            Out << "            }" << '\n';
+            Out << "            buckets += depth;" << '\n';
+            Out << "            thresholds += depth;" << '\n';
+            Out << "            leafValues += (std::size_t(1) << depth);" << '\n';
+            Out << "        }" << '\n';
+        }
+        Out << "    }" << '\n';
+        Out << "}" << '\n';
+        Out << '\n';
+
+        Out << "/* Model applicator" << '\n';
+        Out << " * features: row-major matrix of docCount objects, featureStride floats per object" << '\n';
+        Out << " *     (featureStride >= CatboostModelFloatFeatureCount)" << '\n';
+        Out << " * results: raw formula values for docCount objects" << '\n';
+        Out << " */" << '\n';
+        Out << "void ApplyCatboostModelBatch(" << '\n';
+        Out << "    const float* features," << '\n';
+        Out << "    std::size_t featureStride," << '\n';
+        Out << "    std::size_t docCount," << '\n';
+        Out << "    double* results" << '\n';
+        Out << ") {" << '\n';
+        Out << "    unsigned char bins[(CatboostModelUsedFeatureCount ? CatboostModelUsedFeatureCount : 1) * CatboostModelBlockSize];" << '\n';
+        Out << "    for (std::size_t blockStart = 0; blockStart < docCount; blockStart += CatboostModelBlockSize) {" << '\n';
+        Out << "        const std::size_t blockDocCount = docCount - blockStart < CatboostModelBlockSize ?" << '\n';
+        Out << "            docCount - blockStart : CatboostModelBlockSize;" << '\n';
+        Out << "        for (std::size_t docId = 0; docId < blockDocCount; ++docId) {" << '\n';
+        Out << "            results[blockStart + docId] = 0.0;" << '\n';
+        Out << "        }" << '\n';
+        Out << "        CatboostModelBinarize(features + blockStart * featureStride, featureStride, blockDocCount, bins);" << '\n';
+        Out << "        CatboostModelCalcTrees(bins, blockDocCount, results + blockStart);" << '\n';
+        Out << "    }" << '\n';
+        Out << "}" << '\n';
+        Out << '\n';
+        Out << "double ApplyCatboostModel(" << '\n';
+        Out << "    const std::vector<float>& features" << '\n';
+        Out << ") {" << '\n';
+        Out << "    double result = 0.0;" << '\n';
+        Out << "    ApplyCatboostModelBatch(features.data(), CatboostModelFloatFeatureCount, 1, &result);" << '\n';
+        Out << "    return result;" << '\n';
+        Out << "}" << '\n';
+
+        // Also emit the API with catFeatures, for uniformity
+        Out << '\n';
+        Out << "double ApplyCatboostModel(" << '\n';
+        Out << "    const std::vector<float>& floatFeatures," << '\n';
+        Out << "    const std::vector<std::string>&" << '\n';
+        Out << ") {" << '\n';
+        Out << "    return ApplyCatboostModel(floatFeatures);" << '\n';
+        Out << "}" << '\n';
+    }
 }
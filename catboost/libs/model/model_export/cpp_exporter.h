@@ -11,16 +11,23 @@ namespace NCatboost {
     class TCatboostModelToCppConverter: public ICatboostModelExporter {
     private:
         TOFStream Out;
+        bool SpecializedEvaluator = false;
 
     public:
-        TCatboostModelToCppConverter(const TString& modelFile, bool addFileFormatExtension, const TString& userParametersJson)
-            : Out(modelFile + (addFileFormatExtension ? ".cpp" : ""))
-        {
-            CB_ENSURE(userParametersJson.empty(), "JSON user params for exporting the model to C++ are not supported");
-        };
+        /*
+         * Supported JSON user params:
+         *   "specialized_evaluator": bool - emit evaluator specialized for the model (constexpr model data,
+         *       unrolled leaf index calculation, binarization with compile-time border counts) with batch API.
+         *       Only models without categorical features are supported.
+         */
+        TCatboostModelToCppConverter(const TString& modelFile, bool addFileFormatExtension, const TString& userParametersJson);
 
         void Write(const TFullModel& model, const THashMap<ui32, TString>* catFeaturesHashToString = nullptr) override {
-            if (model.HasCategoricalFeatures()) {
+            if (SpecializedEvaluator) {
+                WriteSpecializedHeader();
+                WriteSpecializedModel(model);
+                WriteSpecializedApplicator(model);
+            } else if (model.HasCategoricalFeatures()) {
                 WriteHeader(/*forCatFeatures*/true);
                 WriteModelCatFeatures(model, catFeaturesHashToString);
                 WriteApplicatorCatFeatures();
@@ -38,5 +45,8 @@ namespace NCatboost {
         void WriteCTRStructs();
         void WriteModelCatFeatures(const TFullModel& model, const THashMap<ui32, TString>* catFeaturesHashToString);
         void WriteApplicatorCatFeatures();
+        void WriteSpecializedHeader();
+        void WriteSpecializedModel(const TFullModel& model);
+        void WriteSpecializedApplicator(const TFullModel& model);
     };
 }
@@ -90,6 +90,11 @@ static void ParseFeatures(
 
 extern double ApplyCatboostModel(const vector<float>& floatFeatures, const vector<string>& catFeatures);
 
+#ifdef APPLY_CATBOOST_MODEL_BATCH
+// exported by specialized evaluators, float features only
+extern void ApplyCatboostModelBatch(const float* features, size_t featureStride, size_t docCount, double* results);
+#endif
+
 int main(int argc, char *argv[]) {
     assert(argc == 4);  // main.exe test.tsv cd.tsv predictions.txt
 
@@ -101,6 +106,10 @@ int main(int argc, char *argv[]) {
 
     ifstream test(argv[1]);
     ofstream predictions(argv[3]);
+#ifdef APPLY_CATBOOST_MODEL_BATCH
+    vector<float> batchFeatures; // row-major
+    size_t batchFeatureStride = 0;
+#endif
     string line;
     for (size_t docId = 0; getline(test, line); ++docId) {
         vector<float> floatFeatures;
@@ -113,6 +122,12 @@ int main(int argc, char *argv[]) {
         }
         ParseFeatures(line, floatColumns, catColumns, &floatFeatures, &catFeatures);
 
+#ifdef APPLY_CATBOOST_MODEL_BATCH
+        assert(catFeatures.empty());
+        batchFeatureStride = floatFeatures.size();
+        batchFeatures.insert(batchFeatures.end(), floatFeatures.begin(), floatFeatures.end());
+        continue;
+#endif
         double rawFormulaVal = ApplyCatboostModel(floatFeatures, catFeatures);
 
         if (docId == 0) {
@@ -121,5 +136,16 @@ int main(int argc, char *argv[]) {
         predictions << docId << DELIMITER << rawFormulaVal << endl;
     }
 
+#ifdef APPLY_CATBOOST_MODEL_BATCH
+    // all objects in one call, so several evaluation blocks are used
+    const size_t docCount = batchFeatureStride ? batchFeatures.size() / batchFeatureStride : 0;
+    vector<double> rawFormulaVals(docCount);
+    ApplyCatboostModelBatch(batchFeatures.data(), batchFeatureStride, docCount, rawFormulaVals.data());
+    predictions << "DocId" << DELIMITER << "RawFormulaVal" << endl;
+    for (size_t docId = 0; docId < docCount; ++docId) {
+        predictions << docId << DELIMITER << rawFormulaVals[docId] << endl;
+    }
+#endif
+
     return 0;
 }
@@ -103,6 +103,106 @@ def test_cpp_export(dataset):
             raise
 
 
+def test_cpp_export_specialized_evaluator():
+    _, _, model_cbm = _get_cpp_py_cbm_model('higgs')
+    _, test_path, cd_path = _get_train_test_cd_path('higgs')
+
+    model = CatBoost()
+    model.load_model(model_cbm)
+    model_cpp = yatest.common.test_output_path('model_specialized.cpp')
+    model.save_model(model_cpp, format="cpp", export_parameters={'specialized_evaluator': True})
+
+    applicator_cpp = yatest.common.source_path('catboost/libs/model/model_export/ut/applicator.cpp')
+    applicator_exe = yatest.common.test_output_path('applicator_specialized.exe')
+    predictions_by_catboost_path = yatest.common.test_output_path('predictions_by_catboost.txt')
+    predictions_path = yatest.common.test_output_path('predictions_specialized.txt')
+
+    if os.name == 'posix':
+        compile_cmd = ['g++', '-std=c++14', '-O2', '-o', applicator_exe]
+    else:
+        compile_cmd = ['cl.exe', '-O2', '-Fe' + applicator_exe]
+    compile_cmd += [applicator_cpp, model_cpp]
+    apply_cmd = [applicator_exe, test_path, cd_path, predictions_path]
+    calc_cmd = [CATBOOST_APP_PATH, 'calc',
+                '-m', model_cbm,
+                '--input-path', test_path,
+                '--cd', cd_path,
+                '--output-path', predictions_by_catboost_path,
+                ]
+    compare_cmd = [APPROXIMATE_DIFF_PATH,
+                   '--have-header',
+                   '--diff-limit', '1e-6',
+                   predictions_path,
+                   predictions_by_catboost_path,
+                   ]
+
+    try:
+        yatest.common.execute(compile_cmd)
+        yatest.common.execute(apply_cmd)
+        yatest.common.execute(calc_cmd)
+        yatest.common.execute(compare_cmd)
+    except OSError as e:
+        if re.search(r"No such file or directory.*'{}'".format(re.escape(compile_cmd[0])), str(e)):
+            pytest.xfail(reason='We ignore `compiler not found` error: {}\n'.format(str(e)))
+        else:
+            raise
+
+
+def test_cpp_export_specialized_evaluator_batch():
+    _, _, model_cbm = _get_cpp_py_cbm_model('higgs')
+    _, test_path, cd_path = _get_train_test_cd_path('higgs')
+
+    model = CatBoost()
+    model.load_model(model_cbm)
+    model_cpp = yatest.common.test_output_path('model_specialized.cpp')
+    model.save_model(model_cpp, format="cpp", export_parameters={'specialized_evaluator': True})
+
+    # several evaluation blocks (128 objects) and an incomplete last one
+    batch_test_path = yatest.common.test_output_path('test_batch')
+    with open(test_path) as test_file:
+        test_lines = test_file.read().splitlines()
+    with open(batch_test_path, 'w') as batch_test_file:
+        for _ in range(3):
+            for test_line in test_lines:
+                batch_test_file.write(test_line + '\n')
+    assert 3 * len(test_lines) > 2 * 128
+
+    applicator_cpp = yatest.common.source_path('catboost/libs/model/model_export/ut/applicator.cpp')
+    applicator_exe = yatest.common.test_output_path('applicator_specialized_batch.exe')
+    predictions_by_catboost_path = yatest.common.test_output_path('predictions_by_catboost_batch.txt')
+    predictions_path = yatest.common.test_output_path('predictions_specialized_batch.txt')
+
+    if os.name == 'posix':
+        compile_cmd = ['g++', '-std=c++14', '-O2', '-DAPPLY_CATBOOST_MODEL_BATCH', '-o', applicator_exe]
+    else:
+        compile_cmd = ['cl.exe', '-O2', '-DAPPLY_CATBOOST_MODEL_BATCH', '-Fe' + applicator_exe]
+    compile_cmd += [applicator_cpp, model_cpp]
+    apply_cmd = [applicator_exe, batch_test_path, cd_path, predictions_path]
+    calc_cmd = [CATBOOST_APP_PATH, 'calc',
+                '-m', model_cbm,
+                '--input-path', batch_test_path,
+                '--cd', cd_path,
+                '--output-path', predictions_by_catboost_path,
+                ]
+    compare_cmd = [APPROXIMATE_DIFF_PATH,
+                   '--have-header',
+                   '--diff-limit', '1e-6',
+                   predictions_path,
+                   predictions_by_catboost_path,
+                   ]
+
+    try:
+        yatest.common.execute(compile_cmd)
+        yatest.common.execute(apply_cmd)
+        yatest.common.execute(calc_cmd)
+        yatest.common.execute(compare_cmd)
+    except OSError as e:
+        if re.search(r"No such file or directory.*'{}'".format(re.escape(compile_cmd[0])), str(e)):
+            pytest.xfail(reason='We ignore `compiler not found` error: {}\n'.format(str(e)))
+        else:
+            raise
+
+
 def _predict_python(test_pool, apply_catboost_model):
     pred_python = []
     cat_feature_indices = test_pool.get_cat_feature_indices()
@@ -4,6 +4,8 @@
 
 #include <catboost/libs/model/model_export/export_helpers.h>
 
+#include <util/generic/algorithm.h>
+#include <util/generic/hash_set.h>
 #include <util/generic/xrange.h>
 #include <util/generic/set.h>
 #include <util/string/cast.h>
@@ -236,20 +238,81 @@ TIntrusivePtr<ICtrProvider> TStaticCtrProvider::Clone() const {
  * This function contains simple and mostly incorrect ctr values table merging approach.
  * In this version we just leave unique values as-is and are using averaging for intersection
  */
-static void MergeBuckets(const TVector<const TCtrValueTable*>& tables, TCtrValueTable* target) {
+static void MergeBuckets(
+    const TVector<const TCtrValueTable*>& tables,
+    TCtrValueTable* target,
+    NPar::TLocalExecutor* localExecutor) {
+
     Y_ASSERT(!tables.empty());
     TVector<NCatboost::TDenseIndexHashView> indexViewers;
-    THashSet<NCatboost::TBucket::THashType> uniqueHashes;
     for (const auto& table : tables) {
         indexViewers.emplace_back(table->GetIndexHashViewer());
-        for (const auto& bucket : indexViewers.back().GetBuckets()) {
-            if (bucket.Hash != NCatboost::TBucket::InvalidHashValue) {
-                uniqueHashes.insert(bucket.Hash);
+    }
+    /* unique hashes are collected by hash partitions in parallel:
+     * buckets of each table are scanned once in parallel blocks and distributed to partitions,
+     * then hashes of each partition are deduplicated (in the order of tables and buckets).
+     * Unique hashes are ordered by their first occurrence, so the merged table does not depend on the thread count.
+     */
+    using THashWithPosition = std::pair<ui64, NCatboost::TBucket::THashType>; // (position in all tables buckets, hash)
+    TVector<ui64> tableOffsets; // positions of the first buckets of tables
+    ui64 totalBucketCount = 0;
+    for (const auto& indexViewer : indexViewers) {
+        tableOffsets.push_back(totalBucketCount);
+        totalBucketCount += indexViewer.GetBuckets().size();
+    }
+    const ui32 partCount = localExecutor->GetThreadCount() + 1;
+    const ui32 blocksPerTable = partCount;
+    // [tableIdx * blocksPerTable + blockIdx][partIdx]
+    TVector<TVector<TVector<THashWithPosition>>> blockPartHashes(indexViewers.size() * blocksPerTable);
+    NPar::ParallelFor(*localExecutor, 0, blockPartHashes.size(), [&](ui32 tableBlockIdx) {
+        const ui32 tableIdx = tableBlockIdx / blocksPerTable;
+        const auto buckets = indexViewers[tableIdx].GetBuckets();
+        const ui32 blockIdx = tableBlockIdx % blocksPerTable;
+        const size_t blockBegin = buckets.size() * blockIdx / blocksPerTable;
+        const size_t blockEnd = buckets.size() * (blockIdx + 1) / blocksPerTable;
+        auto& partHashes = blockPartHashes[tableBlockIdx];
+        partHashes.resize(partCount);
+        for (auto bucketIdx : xrange(blockBegin, blockEnd)) {
+            const auto hash = buckets[bucketIdx].Hash;
+            if (hash != NCatboost::TBucket::InvalidHashValue) {
+                partHashes[hash % partCount].emplace_back(tableOffsets[tableIdx] + bucketIdx, hash);
             }
         }
+    });
+    TVector<TVector<THashWithPosition>> partUniqueHashes(partCount);
+    NPar::ParallelFor(*localExecutor, 0, partCount, [&](ui32 partIdx) {
+        THashSet<NCatboost::TBucket::THashType> partHashes;
+        for (auto& blockHashes : blockPartHashes) {
+            for (const auto& hashWithPosition : blockHashes[partIdx]) {
+                if (partHashes.insert(hashWithPosition.second).second) {
+                    partUniqueHashes[partIdx].push_back(hashWithPosition);
+                }
+            }
+            TVector<THashWithPosition>().swap(blockHashes[partIdx]);
+        }
+    });
+    blockPartHashes.clear();
+    TVector<THashWithPosition> uniqueHashesWithPositions;
+    for (const auto& partHashes : partUniqueHashes) {
+        uniqueHashesWithPositions.insert(uniqueHashesWithPositions.end(), partHashes.begin(), partHashes.end());
+    }
+    partUniqueHashes.clear();
+    // positions are unique
+    Sort(uniqueHashesWithPositions);
+    TVector<NCatboost::TBucket::THashType> uniqueHashes;
+    uniqueHashes.reserve(uniqueHashesWithPositions.size());
+    for (const auto& hashWithPosition : uniqueHashesWithPositions) {
+        uniqueHashes.push_back(hashWithPosition.second);
     }
+    uniqueHashesWithPositions.clear();
 
+    // index is filled sequentially, values for different hashes are merged in parallel
     auto hashBuilder = target->GetIndexHashBuilder(uniqueHashes.size());
+    TVector<ui32> insertIndexes;
+    insertIndexes.yresize(uniqueHashes.size());
+    for (auto i : xrange(uniqueHashes.size())) {
+        insertIndexes[i] = hashBuilder.AddIndex(uniqueHashes[i]);
+    }
     switch (tables.back()->ModelCtrBase.CtrType)
     {
     case ECtrType::BinarizedTargetMeanValue:
@@ -259,7 +322,8 @@ static void MergeBuckets(const TVector<const TCtrValueTable*>& tables, TCtrValue
                 meanHistories.emplace_back(table->GetTypedArrayRefForBlobData<TCtrMeanHistory>());
             }
             auto targetBuf = target->AllocateBlobAndGetArrayRef<TCtrMeanHistory>(uniqueHashes.size());
-            for (auto hash : uniqueHashes) {
+            NPar::ParallelFor(*localExecutor, 0, uniqueHashes.size(), [&](ui32 hashIdx) {
+                const auto hash = uniqueHashes[hashIdx];
                 TCtrMeanHistory value = {0.0f, 0};
                 size_t count = 0;
                 for (const auto viewerId : xrange(indexViewers.size())) {
@@ -271,9 +335,8 @@ static void MergeBuckets(const TVector<const TCtrValueTable*>& tables, TCtrValue
                 }
                 value.Count /= count;
                 value.Sum /= count;
-                auto insertIndex = hashBuilder.AddIndex(hash);
-                targetBuf[insertIndex] = value;
-            }
+                targetBuf[insertIndexes[hashIdx]] = value;
+            });
         }
         break;
     case ECtrType::FeatureFreq:
@@ -284,7 +347,8 @@ static void MergeBuckets(const TVector<const TCtrValueTable*>& tables, TCtrValue
                 counters.emplace_back(table->GetTypedArrayRefForBlobData<int>());
             }
             auto targetBuf = target->AllocateBlobAndGetArrayRef<int>(uniqueHashes.size());
-            for (auto hash : uniqueHashes) {
+            NPar::ParallelFor(*localExecutor, 0, uniqueHashes.size(), [&](ui32 hashIdx) {
+                const auto hash = uniqueHashes[hashIdx];
                 int value = 0;
                 int count = 0;
                 for (const auto viewerId : xrange(indexViewers.size())) {
@@ -295,9 +359,8 @@ static void MergeBuckets(const TVector<const TCtrValueTable*>& tables, TCtrValue
                     }
                 }
                 Y_ASSERT(count != 0);
-                auto insertIndex = hashBuilder.AddIndex(hash);
-                targetBuf[insertIndex] = value / count;
-            }
+                targetBuf[insertIndexes[hashIdx]] = value / count;
+            });
             i64 denominatorSum = 0;
             for (const auto& table : tables) {
                 denominatorSum += table->CounterDenominator;
@@ -314,9 +377,10 @@ static void MergeBuckets(const TVector<const TCtrValueTable*>& tables, TCtrValue
                 counters.emplace_back(table->GetTypedArrayRefForBlobData<int>());
             }
             auto targetBuf = target->AllocateBlobAndGetArrayRef<int>(uniqueHashes.size() * tables.back()->TargetClassesCount);
-            for (auto hash : uniqueHashes) {
+            NPar::ParallelFor(*localExecutor, 0, uniqueHashes.size(), [&](ui32 hashIdx) {
+                const auto hash = uniqueHashes[hashIdx];
                 int count = 0;
-                const auto insertIndex = hashBuilder.AddIndex(hash);
+                const auto insertIndex = insertIndexes[hashIdx];
                 TArrayRef<int> insertArrayView(&targetBuf[insertIndex * targetClassesCount], targetClassesCount);
                 for (const auto viewerId : xrange(indexViewers.size())) {
                     auto index = indexViewers[viewerId].GetIndex(hash);
@@ -332,7 +396,7 @@ static void MergeBuckets(const TVector<const TCtrValueTable*>& tables, TCtrValue
                         value /= count;
                     }
                 }
-            }
+            });
         }
         break;
 
@@ -342,7 +406,11 @@ static void MergeBuckets(const TVector<const TCtrValueTable*>& tables, TCtrValue
     }
 }
 
-TIntrusivePtr<TStaticCtrProvider> MergeStaticCtrProvidersData(const TVector<const TStaticCtrProvider*>& providers, ECtrTableMergePolicy mergePolicy) {
+TIntrusivePtr<TStaticCtrProvider> MergeStaticCtrProvidersData(
+    const TVector<const TStaticCtrProvider*>& providers,
+    ECtrTableMergePolicy mergePolicy,
+    NPar::TLocalExecutor* localExecutor) {
+
     if (providers.empty()) {
         return TIntrusivePtr<TStaticCtrProvider>();
     }
@@ -357,17 +425,29 @@ TIntrusivePtr<TStaticCtrProvider> MergeStaticCtrProvidersData(const TVector<cons
             valuesMap[ctrBase].push_back(&ctrValueTables);
         }
     }
+    if (mergePolicy == ECtrTableMergePolicy::FailIfCtrsIntersects) {
+        for (const auto& [ctrBase, ctrValueTables] : valuesMap) {
+            Y_UNUSED(ctrBase);
+            if (ctrValueTables.size() > 1) {
+                throw TCatBoostException() << "FailIfCtrsIntersects policy forbids model ctr tables intersection";
+            }
+        }
+    }
+    // result tables are inserted beforehand, then filled for different ctr bases in parallel
+    TVector<std::pair<const TVector<const TCtrValueTable*>*, TCtrValueTable*>> mergeTasks;
     for (const auto& [ctrBase, ctrValueTables] : valuesMap) {
+        mergeTasks.emplace_back(&ctrValueTables, &result->CtrData.LearnCtrs[ctrBase]);
+    }
+    NPar::ParallelFor(*localExecutor, 0, mergeTasks.size(), [&](ui32 taskIdx) {
+        const auto& ctrValueTables = *mergeTasks[taskIdx].first;
+        auto& target = *mergeTasks[taskIdx].second;
         if (ctrValueTables.size() == 1) {
-            result->CtrData.LearnCtrs[ctrBase] = *(ctrValueTables[0]);
-            continue;
+            target = *(ctrValueTables[0]);
+            return;
         }
-        auto& target = result->CtrData.LearnCtrs[ctrBase];
-        target.ModelCtrBase = ctrBase;
+        target.ModelCtrBase = ctrValueTables[0]->ModelCtrBase;
         switch (mergePolicy)
         {
-        case ECtrTableMergePolicy::FailIfCtrsIntersects:
-            throw TCatBoostException() << "FailIfCtrsIntersects policy forbids model ctr tables intersection";
         case ECtrTableMergePolicy::LeaveMostDiversifiedTable:
             {
                 size_t maxCtrTableSize = 0;
@@ -380,15 +460,15 @@ TIntrusivePtr<TStaticCtrProvider> MergeStaticCtrProvidersData(const TVector<cons
                     }
                 }
                 Y_ASSERT(maxTable != nullptr);
-                result->CtrData.LearnCtrs[ctrBase] = *maxTable;
+                target = *maxTable;
             }
             break;
         case ECtrTableMergePolicy::IntersectingCountersAverage:
-            MergeBuckets(ctrValueTables, &target);
+            MergeBuckets(ctrValueTables, &target, localExecutor);
             break;
         default:
             Y_UNREACHABLE();
         }
-    }
+    });
     return result;
 }
@@ -5,6 +5,8 @@
 
 #include <catboost/libs/helpers/exception.h>
 
+#include <library/threading/local_executor/local_executor.h>
+
 #include <util/generic/hash.h>
 #include <util/generic/utility.h>
 
@@ -158,4 +160,5 @@ private:
 
 TIntrusivePtr<TStaticCtrProvider> MergeStaticCtrProvidersData(
     const TVector<const TStaticCtrProvider*>& providers,
-    ECtrTableMergePolicy mergePolicy);
+    ECtrTableMergePolicy mergePolicy,
+    NPar::TLocalExecutor* localExecutor);
@@ -0,0 +1,48 @@
+#include "model_test_helpers.h"
+
+#include <catboost/libs/model/cascade_evaluator.h>
+
+#include <library/unittest/registar.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+
+using namespace std;
+
+Y_UNIT_TEST_SUITE(TCascadeEvaluatorTests) {
+    Y_UNIT_TEST(TestSameDecisionsAsFullEvaluation) {
+        const TFullModel model = TrainFloatCatboostModel(50);
+
+        // not a multiple of evaluation block size
+        const size_t docCount = 300;
+        const auto features = GenerateRandomFloatFeatures(docCount);
+        const auto& featureRefs = features.FeatureRefs;
+        TVector<double> scores(docCount);
+        model.CalcFlat(featureRefs, scores);
+
+        TVector<double> sortedScores = scores;
+        Sort(sortedScores);
+        for (double quantile : {0.1, 0.5, 0.9}) {
+            const double threshold = sortedScores[(size_t)(quantile * docCount)] + 1e-7;
+            for (size_t treeChunkSize : {1, 7, 100}) {
+                TCascadeEvaluator evaluator(model, threshold, treeChunkSize);
+                const auto result = evaluator.CalcFlat(featureRefs);
+                UNIT_ASSERT_VALUES_EQUAL(result.Decisions.size(), docCount);
+                UNIT_ASSERT(result.EvaluatedTreeCount <= docCount * model.GetTreeCount());
+                for (auto docIdx : xrange(docCount)) {
+                    UNIT_ASSERT_VALUES_EQUAL(result.Decisions[docIdx], scores[docIdx] > threshold);
+                    if (!IsNan(result.Scores[docIdx])) {
+                        UNIT_ASSERT_DOUBLES_EQUAL(result.Scores[docIdx], scores[docIdx], 1e-9);
+                    }
+                }
+            }
+        }
+
+        // all objects are decided before the last chunk for unreachable threshold
+        TCascadeEvaluator evaluator(model, sortedScores.back() + 1e9, 10);
+        const auto result = evaluator.CalcFlat(featureRefs);
+        UNIT_ASSERT(result.EvaluatedTreeCount < docCount * model.GetTreeCount());
+        UNIT_ASSERT(AllOf(result.Decisions, [](bool decision) { return !decision; }));
+    }
+}
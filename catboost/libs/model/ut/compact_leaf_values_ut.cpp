@@ -0,0 +1,64 @@
+#include "model_test_helpers.h"
+
+#include <catboost/libs/model/compact_leaf_values.h>
+
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+
+using namespace std;
+
+static void CheckCompactLeafValues(NCatBoostFbs::ECompactLeafValuesType type) {
+    const TFullModel fullPrecisionModel = TrainFloatCatboostModel(20);
+    // not a multiple of evaluation block size
+    const auto randomFeatures = GenerateRandomFloatFeatures(300);
+    const auto& features = randomFeatures.Features;
+    const auto& featureRefs = randomFeatures.FeatureRefs;
+
+    TFullModel model = fullPrecisionModel;
+    const auto report = CompactLeafValues(type, featureRefs, &model);
+    UNIT_ASSERT(model.ObliviousTrees.HasCompactLeafValues());
+    UNIT_ASSERT_EQUAL(model.ObliviousTrees.LeafValues, fullPrecisionModel.ObliviousTrees.LeafValues);
+    UNIT_ASSERT(report.CompactLeafValuesBytes < report.LeafValuesBytes);
+    UNIT_ASSERT_VALUES_EQUAL(report.ControlObjectCount, features.size());
+    UNIT_ASSERT(report.MaxPredictionDiff <= report.PredictionErrorBound + 1e-12);
+    UNIT_ASSERT(report.MeanPredictionDiff <= report.MaxPredictionDiff);
+
+    TVector<double> fullPrecisionResults(features.size());
+    fullPrecisionModel.CalcFlat(featureRefs, fullPrecisionResults);
+    TVector<double> compactResults(features.size());
+    model.CalcFlat(featureRefs, compactResults);
+    double maxDiff = 0;
+    for (auto docIdx : xrange(features.size())) {
+        maxDiff = Max(maxDiff, Abs(compactResults[docIdx] - fullPrecisionResults[docIdx]));
+    }
+    UNIT_ASSERT_DOUBLES_EQUAL(maxDiff, report.MaxPredictionDiff, 1e-12);
+
+    // single object evaluation uses the same leaf values
+    for (auto docIdx : xrange(10)) {
+        TVector<double> singleResult(1);
+        model.CalcFlat(MakeArrayRef(featureRefs.data() + docIdx, 1), singleResult);
+        UNIT_ASSERT_DOUBLES_EQUAL(singleResult[0], compactResults[docIdx], 1e-12);
+    }
+
+    TStringStream strStream;
+    model.Save(&strStream);
+    TFullModel deserializedModel;
+    deserializedModel.Load(&strStream);
+    UNIT_ASSERT_EQUAL(model, deserializedModel);
+
+    CompactLeafValues(NCatBoostFbs::ECompactLeafValuesType_None, {}, &model);
+    UNIT_ASSERT(!model.ObliviousTrees.HasCompactLeafValues());
+    UNIT_ASSERT_EQUAL(model, fullPrecisionModel);
+}
+
+Y_UNIT_TEST_SUITE(TCompactLeafValues) {
+    Y_UNIT_TEST(TestInt16) {
+        CheckCompactLeafValues(NCatBoostFbs::ECompactLeafValuesType_Int16);
+    }
+
+    Y_UNIT_TEST(TestFloat16) {
+        CheckCompactLeafValues(NCatBoostFbs::ECompactLeafValuesType_Float16);
+    }
+}
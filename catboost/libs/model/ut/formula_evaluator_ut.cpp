@@ -73,6 +73,28 @@ static TFullModel MultiValueFloatModel() {
     return model;
 }
 
+static TFullModel OneHotModel() {
+    TFullModel model;
+    model.ObliviousTrees.CatFeatures = {
+        TCatFeature{false, 0, 0, ""},
+        TCatFeature{true, 1, 1, ""}
+    };
+    auto& oneHotFeature = model.ObliviousTrees.OneHotFeatures.emplace_back();
+    oneHotFeature.CatFeatureIndex = 1;
+    for (auto i : xrange(300)) {
+        oneHotFeature.Values.push_back(i - 150); // values don't fit into one bins bucket
+    }
+    {
+        TVector<int> tree = {5, 280}; // values -145 and 130
+        model.ObliviousTrees.AddBinTree(tree);
+        model.ObliviousTrees.LeafValues = {
+            {0., 1., 2., 3.}
+        };
+    }
+    model.UpdateDynamicData();
+    return model;
+}
+
 // Deterministically train model that has only 3 categoric features.
 static TFullModel TrainCatOnlyModel() {
     TTempDir trainDir;
@@ -172,6 +194,16 @@ Y_UNIT_TEST_SUITE(TObliviousTreeModel) {
         UNIT_ASSERT_EQUAL(canonVals, result);
     }
 
+    Y_UNIT_TEST(TestOneHotModel) {
+        const auto model = OneHotModel();
+        const TVector<TVector<int>> catFeatures = {{130, -145}, {-145, 130}, {0, 7}, {-145, 1000}, {0, -150}};
+        const TVector<TConstArrayRef<int>> catFeaturesRefs(catFeatures.begin(), catFeatures.end());
+        TVector<double> result(catFeatures.size());
+        model.Calc({}, catFeaturesRefs, result);
+        TVector<double> canonVals = {1., 2., 0., 0., 0.};
+        UNIT_ASSERT_EQUAL(canonVals, result);
+    }
+
     Y_UNIT_TEST(TestCatOnlyModel) {
         const auto model = TrainCatOnlyModel();
 
@@ -0,0 +1,47 @@
+#include "model_test_helpers.h"
+
+#include <catboost/libs/model/model_bundle.h>
+
+#include <library/unittest/registar.h>
+
+#include <util/generic/xrange.h>
+
+using namespace std;
+using namespace NCB;
+
+Y_UNIT_TEST_SUITE(TModelBundleTests) {
+    Y_UNIT_TEST(TestSameAsSeparateModels) {
+        TVector<TFullModel> models;
+        models.push_back(TrainFloatCatboostModel(10, 1));
+        models.push_back(TrainFloatCatboostModel(20, 2));
+        models.push_back(models[0].CopyTreeRange(2, 7));
+
+        TVector<const TFullModel*> modelPtrs;
+        for (const auto& model : models) {
+            modelPtrs.push_back(&model);
+        }
+        TModelBundle bundle(modelPtrs);
+        UNIT_ASSERT_VALUES_EQUAL(bundle.GetModelCount(), models.size());
+
+        // not a multiple of evaluation block size
+        const size_t docCount = 300;
+        const auto features = GenerateRandomFloatFeatures(docCount);
+        const auto& featureRefs = features.FeatureRefs;
+
+        const auto bundleResults = bundle.CalcFlat(featureRefs);
+        UNIT_ASSERT_VALUES_EQUAL(bundleResults.size(), models.size());
+        for (auto modelIdx : xrange(models.size())) {
+            TVector<double> modelResults(docCount);
+            models[modelIdx].CalcFlat(featureRefs, modelResults);
+            UNIT_ASSERT_VALUES_EQUAL(bundleResults[modelIdx].size(), docCount);
+            for (auto docIdx : xrange(docCount)) {
+                UNIT_ASSERT_DOUBLES_EQUAL(bundleResults[modelIdx][docIdx], modelResults[docIdx], 1e-9);
+            }
+        }
+
+        const auto singleDocResults = bundle.CalcFlat(MakeArrayRef(featureRefs.data(), 1));
+        for (auto modelIdx : xrange(models.size())) {
+            UNIT_ASSERT_DOUBLES_EQUAL(singleDocResults[modelIdx][0], bundleResults[modelIdx][0], 1e-9);
+        }
+    }
+}
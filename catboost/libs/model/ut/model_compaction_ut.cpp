@@ -0,0 +1,94 @@
+#include "model_test_helpers.h"
+
+#include <catboost/libs/model/model_compaction.h>
+
+#include <library/unittest/registar.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/xrange.h>
+#include <util/generic/ymath.h>
+
+using namespace std;
+
+Y_UNIT_TEST_SUITE(TModelCompactionTests) {
+    Y_UNIT_TEST(TestSamePredictions) {
+        const TFullModel trainedModel = TrainFloatCatboostModel(20);
+        const TFullModel firstTrees = trainedModel.CopyTreeRange(0, 5);
+        // first 5 trees are duplicated
+        const TFullModel model = SumModels(
+            {&trainedModel, &firstTrees},
+            {1.0, 0.5},
+            ECtrTableMergePolicy::FailIfCtrsIntersects
+        );
+
+        TModelCompactionReport report;
+        const TFullModel compactedModel = CompactModel(model, &report);
+        UNIT_ASSERT_VALUES_EQUAL(report.TreeCountBefore, 25);
+        UNIT_ASSERT(report.TreeCountAfter <= 20);
+        UNIT_ASSERT_VALUES_EQUAL(report.TreeCountAfter, compactedModel.GetTreeCount());
+        UNIT_ASSERT(report.BinFeatureCountAfter <= report.BinFeatureCountBefore);
+
+        // not a multiple of evaluation block size
+        const size_t docCount = 300;
+        const auto features = GenerateRandomFloatFeatures(docCount);
+        const auto& featureRefs = features.FeatureRefs;
+        TVector<double> expected(docCount);
+        model.CalcFlat(featureRefs, expected);
+        TVector<double> actual(docCount);
+        compactedModel.CalcFlat(featureRefs, actual);
+        for (auto docIdx : xrange(docCount)) {
+            UNIT_ASSERT_DOUBLES_EQUAL(actual[docIdx], expected[docIdx], 1e-9);
+        }
+
+        // compaction is idempotent
+        TModelCompactionReport secondReport;
+        CompactModel(compactedModel, &secondReport);
+        UNIT_ASSERT_VALUES_EQUAL(secondReport.TreeCountAfter, report.TreeCountAfter);
+    }
+
+    Y_UNIT_TEST(TestDifferentLeafWeightsAreNotMerged) {
+        const TFullModel trainedModel = TrainFloatCatboostModel(5);
+        TFullModel reweightedTrees = trainedModel.CopyTreeRange(0, 5);
+        for (auto& treeLeafWeights : reweightedTrees.ObliviousTrees.LeafWeights) {
+            for (auto& weight : treeLeafWeights) {
+                weight *= 2;
+            }
+        }
+        const TFullModel sameWeightsModel = SumModels(
+            {&trainedModel, &trainedModel},
+            {1.0, 1.0},
+            ECtrTableMergePolicy::FailIfCtrsIntersects
+        );
+        const TFullModel differentWeightsModel = SumModels(
+            {&trainedModel, &reweightedTrees},
+            {1.0, 1.0},
+            ECtrTableMergePolicy::FailIfCtrsIntersects
+        );
+
+        const TFullModel compactedSameWeights = CompactModel(sameWeightsModel);
+        const TFullModel compactedDifferentWeights = CompactModel(differentWeightsModel);
+        UNIT_ASSERT_VALUES_EQUAL(
+            compactedDifferentWeights.GetTreeCount(),
+            2 * compactedSameWeights.GetTreeCount()
+        );
+
+        // leaf weights of each tree still sum up to the weight of (possibly reweighted) learn data
+        auto getWeightsSum = [] (const TVector<double>& treeLeafWeights) {
+            return Accumulate(treeLeafWeights, 0.0);
+        };
+        const double learnWeight = getWeightsSum(trainedModel.ObliviousTrees.LeafWeights[0]);
+        for (const auto& treeLeafWeights : compactedSameWeights.ObliviousTrees.LeafWeights) {
+            UNIT_ASSERT_DOUBLES_EQUAL(getWeightsSum(treeLeafWeights), learnWeight, 1e-6);
+        }
+        size_t reweightedTreeCount = 0;
+        for (const auto& treeLeafWeights : compactedDifferentWeights.ObliviousTrees.LeafWeights) {
+            const double weightsSum = getWeightsSum(treeLeafWeights);
+            if (Abs(weightsSum - 2 * learnWeight) < 1e-6) {
+                ++reweightedTreeCount;
+            } else {
+                UNIT_ASSERT_DOUBLES_EQUAL(weightsSum, learnWeight, 1e-6);
+            }
+        }
+        UNIT_ASSERT_VALUES_EQUAL(2 * reweightedTreeCount, compactedDifferentWeights.GetTreeCount());
+    }
+}
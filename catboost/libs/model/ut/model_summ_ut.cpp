@@ -1,10 +1,13 @@
 #include "model_test_helpers.h"
 
 #include <catboost/libs/algo/apply.h>
+#include <catboost/libs/model/static_ctr_provider.h>
 #include <catboost/libs/train_lib/train_model.h>
 
 #include <library/unittest/registar.h>
 
+#include <util/generic/xrange.h>
+
 using namespace std;
 using namespace NCB;
 
@@ -28,6 +31,72 @@ Y_UNIT_TEST_SUITE(TModelSummTests) {
         UNIT_ASSERT_EQUAL(mergedModel.ObliviousTrees, bigModel.ObliviousTrees);
     }
 
+    Y_UNIT_TEST(FloatModelParallelMergeTest) {
+        auto bigModel = TrainFloatCatboostModel(40);
+        bigModel.ObliviousTrees.DropUnusedFeatures();
+        TVector<TFullModel> partModels;
+        TVector<const TFullModel*> modelPtrs;
+        TVector<double> modelWeights(5, 1.0);
+        for (size_t i = 0; i < 5; ++i) {
+            auto partModel = bigModel.CopyTreeRange(i * 8, (i + 1) * 8);
+            partModel.ObliviousTrees.DropUnusedFeatures();
+            partModels.emplace_back(partModel);
+        }
+        for (auto& model : partModels) {
+            modelPtrs.push_back(&model);
+        }
+        auto mergedModel = SumModels(modelPtrs, modelWeights, ECtrTableMergePolicy::IntersectingCountersAverage, 4);
+        UNIT_ASSERT_EQUAL(mergedModel.ObliviousTrees, bigModel.ObliviousTrees);
+    }
+
+    Y_UNIT_TEST(CtrModelParallelMergeTest) {
+        // models with different seeds have intersecting ctr tables, so their buckets are merged
+        TDataProviderPtr pool = GetAdultPool();
+        TVector<TFullModel> models(2);
+        for (auto modelIdx : xrange(models.size())) {
+            NJson::TJsonValue params;
+            params.InsertValue("iterations", 20);
+            params.InsertValue("random_seed", (int)modelIdx + 1);
+            TEvalResult evalResult;
+            TrainModel(
+                params,
+                nullptr,
+                Nothing(),
+                Nothing(),
+                TDataProviders{pool, {pool}},
+                "",
+                &models[modelIdx],
+                {&evalResult});
+            UNIT_ASSERT(!models[modelIdx].ObliviousTrees.GetUsedModelCtrs().empty());
+        }
+        const TVector<const TFullModel*> modelPtrs = {&models[0], &models[1]};
+        const TVector<double> modelWeights = {1.0, 0.5};
+
+        const auto sequentialModel = SumModels(
+            modelPtrs,
+            modelWeights,
+            ECtrTableMergePolicy::IntersectingCountersAverage,
+            /*threadCount*/ 1);
+        const auto parallelModel = SumModels(
+            modelPtrs,
+            modelWeights,
+            ECtrTableMergePolicy::IntersectingCountersAverage,
+            /*threadCount*/ 4);
+
+        UNIT_ASSERT_EQUAL(parallelModel.ObliviousTrees, sequentialModel.ObliviousTrees);
+        const auto* sequentialCtrProvider = dynamic_cast<const TStaticCtrProvider*>(sequentialModel.CtrProvider.Get());
+        const auto* parallelCtrProvider = dynamic_cast<const TStaticCtrProvider*>(parallelModel.CtrProvider.Get());
+        UNIT_ASSERT(sequentialCtrProvider && parallelCtrProvider);
+        UNIT_ASSERT_EQUAL(parallelCtrProvider->CtrData, sequentialCtrProvider->CtrData);
+
+        const auto sequentialResult = ApplyModel(sequentialModel, *(pool->ObjectsData));
+        const auto parallelResult = ApplyModel(parallelModel, *(pool->ObjectsData));
+        UNIT_ASSERT_VALUES_EQUAL(parallelResult.ysize(), sequentialResult.ysize());
+        for (int idx = 0; idx < sequentialResult.ysize(); ++idx) {
+            UNIT_ASSERT_VALUES_EQUAL(parallelResult[idx], sequentialResult[idx]);
+        }
+    }
+
     Y_UNIT_TEST(AdultModelMergeTest) {
         NJson::TJsonValue params;
         params.InsertValue("learning_rate", 0.01);
@@ -72,6 +72,19 @@ TFullModel TrainFloatCatboostModel(int iterations, int seed) {
     return model;
 }
 
+TRandomFloatFeatures GenerateRandomFloatFeatures(size_t docCount, size_t featureCount, ui64 seed) {
+    TFastRng64 rng(seed);
+    TRandomFloatFeatures result;
+    result.Features.resize(docCount, TVector<float>(featureCount));
+    for (auto& docFeatures : result.Features) {
+        for (auto& value : docFeatures) {
+            value = rng.GenRandReal1();
+        }
+    }
+    result.FeatureRefs.assign(result.Features.begin(), result.Features.end());
+    return result;
+}
+
 TDataProviderPtr GetAdultPool() {
     TSrcData srcData;
     srcData.DsvFileData =
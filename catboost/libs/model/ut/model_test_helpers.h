@@ -3,6 +3,19 @@
 #include <catboost/libs/data_new/data_provider.h>
 #include <catboost/libs/model/model.h>
 
+#include <util/generic/array_ref.h>
+#include <util/generic/noncopyable.h>
+#include <util/generic/vector.h>
+
 TFullModel TrainFloatCatboostModel(int iterations = 5, int seed = 123);
 
+// FeatureRefs point to Features, so it can only be moved
+struct TRandomFloatFeatures : public TMoveOnly {
+    TVector<TVector<float>> Features; // [docIdx][featureIdx]
+    TVector<TConstArrayRef<float>> FeatureRefs;
+};
+
+// features in [0, 1) for models from TrainFloatCatboostModel
+TRandomFloatFeatures GenerateRandomFloatFeatures(size_t docCount, size_t featureCount = 3, ui64 seed = 0);
+
 NCB::TDataProviderPtr GetAdultPool();
@@ -1,23 +1,80 @@
 #include "c_api.h"
 
 #include <catboost/libs/cat_feature/cat_feature.h>
+#include <catboost/libs/helpers/exception.h>
 #include <catboost/libs/model/model.h>
 
+#include <util/generic/hash_set.h>
+#include <util/generic/ptr.h>
 #include <util/generic/singleton.h>
 #include <util/stream/file.h>
 #include <util/string/builder.h>
+#include <util/system/filemap.h>
+#include <util/system/fs.h>
+#include <util/system/guard.h>
+#include <util/system/spinlock.h>
 
-#define FULL_MODEL_PTR(x) ((TFullModel*)(x))
+#define MODEL_HANDLE_PTR(x) ((TModelCalcerHandleImpl*)(x))
+#define FULL_MODEL_PTR(x) (MODEL_HANDLE_PTR(x)->GetSnapshot())
 
 
 struct TErrorMessageHolder {
     TString Message;
 };
 
+//! Immutable model shared by the handle and all evaluations started before it was replaced
+using TModelSnapshotPtr = TAtomicSharedPtr<const TFullModel>;
+
+/**
+ * Model handle: evaluations take the current snapshot and use it without any locking, loads build
+ * the new model aside and only then publish it, so a model can be reloaded under evaluation load.
+ * The old model is destroyed when the last evaluation using it finishes.
+ */
+class TModelCalcerHandleImpl {
+public:
+    TModelSnapshotPtr GetSnapshot() const {
+        with_lock (Lock) { // guards only the pointer copy, not evaluation
+            return Snapshot;
+        }
+    }
+
+    void Publish(TFullModel&& model) {
+        TModelSnapshotPtr snapshot = MakeAtomicShared<const TFullModel>(std::move(model));
+        with_lock (Lock) {
+            Snapshot.Swap(snapshot);
+        }
+        // previous snapshot is released here, out of the lock
+    }
+
+    /**
+     * C strings returned to the user must stay valid after the snapshot they came from is replaced,
+     * so the handle keeps copies of the returned values (one per distinct value) until it is deleted.
+     */
+    const char* HoldInfoValue(const TString& value) {
+        with_lock (InfoValuesLock) {
+            return InfoValues.insert(value).first->c_str(); // set nodes are not moved on insertion
+        }
+    }
+
+private:
+    TModelSnapshotPtr Snapshot = MakeAtomicShared<const TFullModel>();
+    TAdaptiveLock Lock;
+
+    THashSet<TString> InfoValues;
+    TAdaptiveLock InfoValuesLock;
+};
+
+static TFullModel ReadModelMapped(const char* filename) {
+    CB_ENSURE(NFs::Exists(filename), "Model file doesn't exist: " << filename);
+    TFileMap modelFile(filename);
+    modelFile.Map(0, modelFile.Length());
+    return ReadModel(modelFile.Ptr(), modelFile.MappedSize());
+}
+
 extern "C" {
 EXPORT ModelCalcerHandle* ModelCalcerCreate() {
     try {
-        return new TFullModel;
+        return new TModelCalcerHandleImpl;
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
     }
@@ -31,13 +88,13 @@ EXPORT const char* GetErrorString() {
 
 EXPORT void ModelCalcerDelete(ModelCalcerHandle* modelHandle) {
     if (modelHandle != nullptr) {
-        delete FULL_MODEL_PTR(modelHandle);
+        delete MODEL_HANDLE_PTR(modelHandle);
     }
 }
 
 EXPORT bool LoadFullModelFromFile(ModelCalcerHandle* modelHandle, const char* filename) {
     try {
-        *FULL_MODEL_PTR(modelHandle) = ReadModel(filename);
+        MODEL_HANDLE_PTR(modelHandle)->Publish(ReadModelMapped(filename));
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
         return false;
@@ -48,7 +105,7 @@ EXPORT bool LoadFullModelFromFile(ModelCalcerHandle* modelHandle, const char* fi
 
 EXPORT bool LoadFullModelFromBuffer(ModelCalcerHandle* modelHandle, const void* binaryBuffer, size_t binaryBufferSize) {
     try {
-        *FULL_MODEL_PTR(modelHandle) = ReadModel(binaryBuffer, binaryBufferSize);
+        MODEL_HANDLE_PTR(modelHandle)->Publish(ReadModel(binaryBuffer, binaryBufferSize));
     } catch (...) {
         Singleton<TErrorMessageHolder>()->Message = CurrentExceptionMessage();
         return false;
@@ -169,18 +226,21 @@ EXPORT bool CheckModelMetadataHasKey(ModelCalcerHandle* modelHandle, const char*
 
 EXPORT size_t GetModelInfoValueSize(ModelCalcerHandle* modelHandle, const char* keyPtr, size_t keySize) {
     TStringBuf key(keyPtr, keySize);
-    if (!FULL_MODEL_PTR(modelHandle)->ModelInfo.contains(key)) {
+    const auto model = FULL_MODEL_PTR(modelHandle);
+    if (!model->ModelInfo.contains(key)) {
         return 0;
     }
-    return FULL_MODEL_PTR(modelHandle)->ModelInfo.at(key).size();
+    return model->ModelInfo.at(key).size();
 }
 
 EXPORT const char* GetModelInfoValue(ModelCalcerHandle* modelHandle, const char* keyPtr, size_t keySize) {
     TStringBuf key(keyPtr, keySize);
-    if (!FULL_MODEL_PTR(modelHandle)->ModelInfo.contains(key)) {
+    const auto model = FULL_MODEL_PTR(modelHandle);
+    const auto valueIt = model->ModelInfo.find(key);
+    if (valueIt == model->ModelInfo.end()) {
         return nullptr;
     }
-    return FULL_MODEL_PTR(modelHandle)->ModelInfo.at(key).c_str();
+    return MODEL_HANDLE_PTR(modelHandle)->HoldInfoValue(valueIt->second);
 }
 
 }
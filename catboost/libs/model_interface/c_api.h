@@ -16,6 +16,13 @@ extern "C" {
 #define EXPORT
 #endif
 
+/**
+ * Model handle holds an immutable snapshot of the loaded model.
+ * Prediction and model info methods may be called concurrently with each other and with model loading
+ * into the same handle: a load builds the new model aside and then atomically replaces the snapshot,
+ * calls started before the replacement finish on the previous model.
+ * ModelCalcerDelete should not be called concurrently with any other method on the same handle.
+ */
 typedef void ModelCalcerHandle;
 
 /**
@@ -38,7 +45,7 @@ EXPORT void ModelCalcerDelete(ModelCalcerHandle* modelHandle);
 EXPORT const char* GetErrorString();
 
 /**
- * Load model from file into given model handle
+ * Load model from file into given model handle. Model file is memory mapped while reading.
  * @param calcer
  * @param filename
  * @return false if error occured
@@ -193,7 +200,9 @@ EXPORT bool CheckModelMetadataHasKey(ModelCalcerHandle* modelHandle, const char*
 EXPORT size_t GetModelInfoValueSize(ModelCalcerHandle* modelHandle, const char* keyPtr, size_t keySize);
 
 /**
- * Get model metainfo for some key. Returns const char* pointer to inner string. If key is missing in model metainfo storage this method will return nullptr
+ * Get model metainfo for some key. Returns const char* pointer to zero terminated string. If key is missing in model metainfo storage this method will return nullptr
+ * Pointer is valid until the handle is deleted, model loads into the handle don't invalidate it.
+ * If the model can be reloaded concurrently, use the zero terminator instead of GetModelInfoValueSize, the size may belong to another model
  * @param calcer model handle
  */
 EXPORT const char* GetModelInfoValue(ModelCalcerHandle* modelHandle, const char* keyPtr, size_t keySize);
@@ -0,0 +1,180 @@
+#include <catboost/libs/model_interface/c_api.h>
+
+#include <catboost/libs/model/model.h>
+#include <catboost/libs/model/model_build_helper.h>
+
+#include <library/threading/local_executor/local_executor.h>
+#include <library/unittest/registar.h>
+
+#include <util/generic/scope.h>
+#include <util/generic/xrange.h>
+
+#include <atomic>
+#include <cstring>
+
+
+// predicts -leafValue for feature values below 0.5 and leafValue otherwise
+static TString MakeSerializedModel(const TString& infoValue, double leafValue = 1.0) {
+    TObliviousTreeBuilder builder(
+        {TFloatFeature(/*hasNans*/ false, /*featureIndex*/ 0, /*flatFeatureIndex*/ 0, {0.5f})},
+        {},
+        /*approxDimension*/ 1
+    );
+    builder.AddTree({TModelSplit(TFloatSplit(0, 0.5f))}, {{-leafValue, leafValue}});
+
+    TFullModel model;
+    model.ObliviousTrees = builder.Build();
+    model.ModelInfo["params"] = infoValue;
+    model.UpdateDynamicData();
+    return SerializeModel(model);
+}
+
+
+Y_UNIT_TEST_SUITE(TModelCalcerCApi) {
+    Y_UNIT_TEST(GetModelInfoValueUnderConcurrentLoads) {
+        const TVector<TString> infoValues = {TString(1000, 'a'), TString(10, 'b')};
+        const TVector<TString> serializedModels = {
+            MakeSerializedModel(infoValues[0]),
+            MakeSerializedModel(infoValues[1])
+        };
+
+        ModelCalcerHandle* modelHandle = ModelCalcerCreate();
+        UNIT_ASSERT(modelHandle);
+        UNIT_ASSERT(
+            LoadFullModelFromBuffer(modelHandle, serializedModels[0].data(), serializedModels[0].size())
+        );
+
+        auto isInfoValue = [&] (const char* value) {
+            return value && ((TStringBuf(value) == infoValues[0]) || (TStringBuf(value) == infoValues[1]));
+        };
+
+        const int readerCount = 3;
+        const int loadCount = 1000;
+        std::atomic<bool> loadsFinished(false);
+        TVector<TVector<const char*>> returnedValues(readerCount); // [readerIdx]
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(readerCount);
+        localExecutor.ExecRangeWithThrow(
+            [&] (int taskIdx) {
+                if (taskIdx == readerCount) {
+                    Y_SCOPE_EXIT(&loadsFinished) {
+                        loadsFinished = true;
+                    };
+                    for (auto loadIdx : xrange(loadCount)) {
+                        const auto& serializedModel = serializedModels[loadIdx % 2];
+                        UNIT_ASSERT(
+                            LoadFullModelFromBuffer(modelHandle, serializedModel.data(), serializedModel.size())
+                        );
+                    }
+                    return;
+                }
+                auto& values = returnedValues[taskIdx];
+                while (!loadsFinished) {
+                    const char* value = GetModelInfoValue(modelHandle, "params", strlen("params"));
+                    UNIT_ASSERT(isInfoValue(value));
+                    if (values.empty() || (values.back() != value)) {
+                        values.push_back(value);
+                    }
+                }
+            },
+            0,
+            readerCount + 1,
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+
+        // the values of all replaced models are still readable
+        for (const auto& values : returnedValues) {
+            for (const char* value : values) {
+                UNIT_ASSERT(isInfoValue(value));
+            }
+        }
+
+        ModelCalcerDelete(modelHandle);
+    }
+
+    Y_UNIT_TEST(PredictionsUnderConcurrentLoads) {
+        const TVector<double> leafValues = {1.0, 2.0};
+        const TVector<TString> serializedModels = {
+            MakeSerializedModel("first", leafValues[0]),
+            MakeSerializedModel("second", leafValues[1])
+        };
+
+        const TVector<float> features = {0.1f, 0.9f, 0.3f, 0.7f, 0.2f};
+        const size_t docCount = features.size();
+        TVector<const float*> featurePtrs;
+        for (const auto& value : features) {
+            featurePtrs.push_back(&value);
+        }
+        TVector<TVector<double>> expectedPredictions(leafValues.size()); // [modelIdx][docIdx]
+        for (auto modelIdx : xrange(leafValues.size())) {
+            for (auto value : features) {
+                expectedPredictions[modelIdx].push_back(value < 0.5f ? -leafValues[modelIdx] : leafValues[modelIdx]);
+            }
+        }
+
+        ModelCalcerHandle* modelHandle = ModelCalcerCreate();
+        UNIT_ASSERT(modelHandle);
+        UNIT_ASSERT(
+            LoadFullModelFromBuffer(modelHandle, serializedModels[0].data(), serializedModels[0].size())
+        );
+
+        const int readerCount = 4;
+        const int loadCount = 1000;
+        std::atomic<bool> loadsFinished(false);
+
+        NPar::TLocalExecutor localExecutor;
+        localExecutor.RunAdditionalThreads(readerCount);
+        localExecutor.ExecRangeWithThrow(
+            [&] (int taskIdx) {
+                if (taskIdx == readerCount) {
+                    Y_SCOPE_EXIT(&loadsFinished) {
+                        loadsFinished = true;
+                    };
+                    for (auto loadIdx : xrange(loadCount)) {
+                        const auto& serializedModel = serializedModels[loadIdx % 2];
+                        UNIT_ASSERT(
+                            LoadFullModelFromBuffer(modelHandle, serializedModel.data(), serializedModel.size())
+                        );
+                    }
+                    return;
+                }
+                TVector<double> predictions(docCount);
+                while (!loadsFinished) {
+                    // all objects of one call are evaluated by the same model
+                    if (taskIdx % 2) {
+                        UNIT_ASSERT(
+                            CalcModelPredictionFlat(
+                                modelHandle,
+                                docCount,
+                                featurePtrs.data(),
+                                1,
+                                predictions.data(),
+                                predictions.size()
+                            )
+                        );
+                    } else {
+                        UNIT_ASSERT(
+                            CalcModelPrediction(
+                                modelHandle,
+                                docCount,
+                                featurePtrs.data(),
+                                1,
+                                /*catFeatures*/ nullptr,
+                                0,
+                                predictions.data(),
+                                predictions.size()
+                            )
+                        );
+                    }
+                    UNIT_ASSERT((predictions == expectedPredictions[0]) || (predictions == expectedPredictions[1]));
+                }
+            },
+            0,
+            readerCount + 1,
+            NPar::TLocalExecutor::WAIT_COMPLETE
+        );
+
+        ModelCalcerDelete(modelHandle);
+    }
+}
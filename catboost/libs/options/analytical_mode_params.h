@@ -18,6 +18,7 @@ namespace NCB {
         TString ModelFileName;
         EModelType ModelFormat = EModelType::CatboostBinary;
         NCB::TPathWithScheme OutputPath;
+        bool BinaryOutputWithDoublePrecision = false; // for "binary" OutputPath scheme
 
         int Verbose;
 
@@ -12,24 +12,33 @@ NCatboostOptions::TDataProcessingOptions::TDataProcessingOptions(ETaskType type)
       , ClassWeights("class_weights", TVector<float>())
       , ClassNames("class_names", TVector<TString>())
       , GpuCatFeaturesStorage("gpu_cat_features_storage", EGpuCatFeaturesStorage::GpuRam, type)
+      , SparseFeaturesDefaultBinFraction("sparse_features_default_bin_fraction", 1.0f, type)
+      , ExclusiveFeaturesBundling("exclusive_features_bundling", false, type)
+      , QuantizedFeaturesCompressionCodec("quantized_features_compression_codec", TString(), type)
 {
     GpuCatFeaturesStorage.ChangeLoadUnimplementedPolicy(ELoadUnimplementedPolicy::SkipWithWarning);
 }
 
 void NCatboostOptions::TDataProcessingOptions::Load(const NJson::TJsonValue& options) {
-    CheckedLoad(options, &IgnoredFeatures, &HasTimeFlag, &AllowConstLabel, &FloatFeaturesBinarization, &ClassesCount, &ClassWeights, &ClassNames, &GpuCatFeaturesStorage);
+    CheckedLoad(options, &IgnoredFeatures, &HasTimeFlag, &AllowConstLabel, &FloatFeaturesBinarization, &ClassesCount, &ClassWeights, &ClassNames, &GpuCatFeaturesStorage, &SparseFeaturesDefaultBinFraction, &ExclusiveFeaturesBundling, &QuantizedFeaturesCompressionCodec);
     CB_ENSURE(FloatFeaturesBinarization->BorderCount <= GetMaxBinCount(), "Error: catboost doesn't support binarization with >= 256 levels");
+    CB_ENSURE(
+        (SparseFeaturesDefaultBinFraction.Get() >= 0.0f) && (SparseFeaturesDefaultBinFraction.Get() <= 1.0f),
+        "sparse_features_default_bin_fraction must be in [0, 1]"
+    );
 }
 
 void NCatboostOptions::TDataProcessingOptions::Save(NJson::TJsonValue* options) const {
-    SaveFields(options, IgnoredFeatures, HasTimeFlag, AllowConstLabel, FloatFeaturesBinarization, ClassesCount, ClassWeights, ClassNames, GpuCatFeaturesStorage);
+    SaveFields(options, IgnoredFeatures, HasTimeFlag, AllowConstLabel, FloatFeaturesBinarization, ClassesCount, ClassWeights, ClassNames, GpuCatFeaturesStorage, SparseFeaturesDefaultBinFraction, ExclusiveFeaturesBundling, QuantizedFeaturesCompressionCodec);
 }
 
 bool NCatboostOptions::TDataProcessingOptions::operator==(const TDataProcessingOptions& rhs) const {
     return std::tie(IgnoredFeatures, HasTimeFlag, AllowConstLabel, FloatFeaturesBinarization, ClassesCount, ClassWeights,
-            ClassNames, GpuCatFeaturesStorage) ==
+            ClassNames, GpuCatFeaturesStorage, SparseFeaturesDefaultBinFraction, ExclusiveFeaturesBundling,
+            QuantizedFeaturesCompressionCodec) ==
         std::tie(rhs.IgnoredFeatures, rhs.HasTimeFlag, rhs.AllowConstLabel, rhs.FloatFeaturesBinarization, rhs.ClassesCount,
-                rhs.ClassWeights, rhs.ClassNames, rhs.GpuCatFeaturesStorage);
+                rhs.ClassWeights, rhs.ClassNames, rhs.GpuCatFeaturesStorage, rhs.SparseFeaturesDefaultBinFraction,
+                rhs.ExclusiveFeaturesBundling, rhs.QuantizedFeaturesCompressionCodec);
 }
 
 bool NCatboostOptions::TDataProcessingOptions::operator!=(const TDataProcessingOptions& rhs) const {
@@ -33,5 +33,18 @@ namespace NCatboostOptions {
         TOption<TVector<float>> ClassWeights;
         TOption<TVector<TString>> ClassNames;
         TGpuOnlyOption<EGpuCatFeaturesStorage> GpuCatFeaturesStorage;
+
+        /* float features where the fraction of objects in the most frequent bin is greater than this
+         * value are stored sparsely after quantization (1.0 disables sparse storage)
+         */
+        TCpuOnlyOption<float> SparseFeaturesDefaultBinFraction;
+
+        // merge float features that never have non-default values for the same objects
+        TCpuOnlyOption<bool> ExclusiveFeaturesBundling;
+
+        /* library/blockcodecs codec to keep quantized float features compressed in RAM,
+         * blocks are decompressed when features are used in training (empty disables compression)
+         */
+        TCpuOnlyOption<TString> QuantizedFeaturesCompressionCodec;
     };
 }
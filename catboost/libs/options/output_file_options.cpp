@@ -67,6 +67,7 @@ NCatboostOptions::TOutputFilesOptions::TOutputFilesOptions()
     , MetaFile("meta", "meta.tsv")
     , JsonLogPath("json_log", "catboost_training.json")
     , ProfileLogPath("profile_log", "catboost_profile.log")
+    , TraceFile("trace_file", "")
     , LearnErrorLogPath("learn_error_log", "learn_error.tsv")
     , ModelFormats("model_format", {EModelType::CatboostBinary})
     , TestErrorLogPath("test_error_log", "test_error.tsv")
@@ -150,6 +151,10 @@ const TString& NCatboostOptions::TOutputFilesOptions::GetProfileLogFilename() co
     return ProfileLogPath.Get();
 }
 
+const TString& NCatboostOptions::TOutputFilesOptions::GetTraceFilename() const {
+    return TraceFile.Get();
+}
+
 const TString& NCatboostOptions::TOutputFilesOptions::GetResultModelFilename() const {
     return ResultModelPath.Get();
 }
@@ -228,13 +233,13 @@ TString NCatboostOptions::TOutputFilesOptions::GetRocOutputPath() const {
 
 bool NCatboostOptions::TOutputFilesOptions::operator==(const TOutputFilesOptions& rhs) const {
     return std::tie(
-            TrainDir, Name, MetaFile, JsonLogPath, ProfileLogPath, LearnErrorLogPath, TestErrorLogPath,
-            TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
+            TrainDir, Name, MetaFile, JsonLogPath, ProfileLogPath, TraceFile, LearnErrorLogPath,
+            TestErrorLogPath, TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
             AllowWriteFilesFlag, FinalCtrComputationMode, UseBestModel, BestModelMinTrees,
             SnapshotSaveIntervalSeconds, EvalFileName, FstrRegularFileName, FstrInternalFileName,
             TrainingOptionsFileName, OutputBordersFileName, RocOutputPath
             ) == std::tie(
-                rhs.TrainDir, rhs.Name, rhs.MetaFile, rhs.JsonLogPath, rhs.ProfileLogPath,
+                rhs.TrainDir, rhs.Name, rhs.MetaFile, rhs.JsonLogPath, rhs.ProfileLogPath, rhs.TraceFile,
                 rhs.LearnErrorLogPath, rhs.TestErrorLogPath, rhs.TimeLeftLog, rhs.ResultModelPath,
                 rhs.SnapshotPath, rhs.ModelFormats, rhs.SaveSnapshotFlag, rhs.AllowWriteFilesFlag,
                 rhs.FinalCtrComputationMode, rhs.UseBestModel, rhs.BestModelMinTrees,
@@ -251,7 +256,7 @@ bool NCatboostOptions::TOutputFilesOptions::operator!=(const TOutputFilesOptions
 void NCatboostOptions::TOutputFilesOptions::Load(const NJson::TJsonValue& options) {
     CheckedLoad(
             options,
-            &TrainDir, &Name, &MetaFile, &JsonLogPath, &ProfileLogPath, &LearnErrorLogPath,
+            &TrainDir, &Name, &MetaFile, &JsonLogPath, &ProfileLogPath, &TraceFile, &LearnErrorLogPath,
             &TestErrorLogPath, &TimeLeftLog, &ResultModelPath, &SnapshotPath, &ModelFormats,
             &SaveSnapshotFlag, &AllowWriteFilesFlag, &FinalCtrComputationMode, &UseBestModel,
             &BestModelMinTrees, &SnapshotSaveIntervalSeconds, &EvalFileName, &OutputColumns,
@@ -267,8 +272,8 @@ void NCatboostOptions::TOutputFilesOptions::Load(const NJson::TJsonValue& option
 void NCatboostOptions::TOutputFilesOptions::Save(NJson::TJsonValue* options) const {
     SaveFields(
             options,
-            TrainDir, Name, MetaFile, JsonLogPath, ProfileLogPath, LearnErrorLogPath, TestErrorLogPath,
-            TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
+            TrainDir, Name, MetaFile, JsonLogPath, ProfileLogPath, TraceFile, LearnErrorLogPath,
+            TestErrorLogPath, TimeLeftLog, ResultModelPath, SnapshotPath, ModelFormats, SaveSnapshotFlag,
             AllowWriteFilesFlag, FinalCtrComputationMode, UseBestModel, BestModelMinTrees,
             SnapshotSaveIntervalSeconds, EvalFileName, OutputColumns, FstrRegularFileName,
             FstrInternalFileName, TrainingOptionsFileName, MetricPeriod, VerbosePeriod, PredictionTypes,
@@ -56,6 +56,9 @@ namespace NCatboostOptions {
 
         const TString& GetProfileLogFilename() const;
 
+        // empty if chromium trace of training is not requested
+        const TString& GetTraceFilename() const;
+
         const TString& GetResultModelFilename() const;
 
         const TString& GetSnapshotFilename() const;
@@ -108,6 +111,7 @@ namespace NCatboostOptions {
         TOption<TString> MetaFile;
         TOption<TString> JsonLogPath;
         TOption<TString> ProfileLogPath;
+        TOption<TString> TraceFile;
         TOption<TString> LearnErrorLogPath;
         TOption<TVector<EModelType>> ModelFormats;
         TOption<TString> TestErrorLogPath;
@@ -191,6 +191,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "meta", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "json_log", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "profile_log", &outputFilesJson, &seenKeys);
+    CopyOption(plainOptions, "trace_file", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "learn_error_log", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "test_error_log", &outputFilesJson, &seenKeys);
     CopyOption(plainOptions, "time_left_log", &outputFilesJson, &seenKeys);
@@ -224,6 +225,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "learning_rate", &boostingOptionsRef, &seenKeys);
     CopyOption(plainOptions, "fold_len_multiplier", &boostingOptionsRef, &seenKeys);
     CopyOption(plainOptions, "approx_on_full_history", &boostingOptionsRef, &seenKeys);
+    CopyOption(plainOptions, "materialize_permuted_features", &boostingOptionsRef, &seenKeys);
     CopyOption(plainOptions, "fold_permutation_block", &boostingOptionsRef, &seenKeys);
     CopyOption(plainOptions, "min_fold_size", &boostingOptionsRef, &seenKeys);
     CopyOption(plainOptions, "permutation_count", &boostingOptionsRef, &seenKeys);
@@ -303,6 +305,9 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOption(plainOptions, "class_names", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "class_weights", &dataProcessingOptions, &seenKeys);
     CopyOption(plainOptions, "gpu_cat_features_storage", &dataProcessingOptions, &seenKeys);
+    CopyOption(plainOptions, "sparse_features_default_bin_fraction", &dataProcessingOptions, &seenKeys);
+    CopyOption(plainOptions, "exclusive_features_bundling", &dataProcessingOptions, &seenKeys);
+    CopyOption(plainOptions, "quantized_features_compression_codec", &dataProcessingOptions, &seenKeys);
 
     auto& floatFeaturesBinarization = dataProcessingOptions["float_features_binarization"];
     floatFeaturesBinarization.SetType(NJson::JSON_MAP);
@@ -319,6 +324,7 @@ void NCatboostOptions::PlainJsonToOptions(
     CopyOptionWithNewKey(plainOptions, "device_config", "devices", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "devices", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "used_ram_limit", &systemOptions, &seenKeys);
+    CopyOption(plainOptions, "metric_thread_count", &systemOptions, &seenKeys);
     CopyOption(plainOptions, "gpu_ram_part", &systemOptions, &seenKeys);
     CopyOptionWithNewKey(plainOptions, "pinned_memory_size",
                             "pinned_memory_bytes", &systemOptions, &seenKeys);
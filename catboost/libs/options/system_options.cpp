@@ -11,6 +11,7 @@ using namespace NCatboostOptions;
 TSystemOptions::TSystemOptions(ETaskType taskType)
     : NumThreads("thread_count", NSystemInfo::CachedNumberOfCpus())
     , CpuUsedRamLimit("used_ram_limit", {})
+    , MetricThreadCount("metric_thread_count", 0, taskType)
     , Devices("devices", "-1", taskType)
     , GpuRamPart("gpu_ram_part", 0.95, taskType)
     , PinnedMemorySize("pinned_memory_bytes", "104857600", taskType)
@@ -24,17 +25,17 @@ TSystemOptions::TSystemOptions(ETaskType taskType)
 }
 
 void TSystemOptions::Load(const NJson::TJsonValue& options) {
-    CheckedLoad(options, &NumThreads, &CpuUsedRamLimit, &Devices, &GpuRamPart, &PinnedMemorySize, &NodeType, &FileWithHosts, &NodePort);
+    CheckedLoad(options, &NumThreads, &CpuUsedRamLimit, &MetricThreadCount, &Devices, &GpuRamPart, &PinnedMemorySize, &NodeType, &FileWithHosts, &NodePort);
 }
 
 void TSystemOptions::Save(NJson::TJsonValue* options) const {
-    SaveFields(options, NumThreads, CpuUsedRamLimit, Devices, GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort);
+    SaveFields(options, NumThreads, CpuUsedRamLimit, MetricThreadCount, Devices, GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort);
 }
 
 bool TSystemOptions::operator==(const TSystemOptions& rhs) const {
-    return std::tie(NumThreads, CpuUsedRamLimit, Devices,
+    return std::tie(NumThreads, CpuUsedRamLimit, MetricThreadCount, Devices,
                     GpuRamPart, PinnedMemorySize, NodeType, FileWithHosts, NodePort) ==
-           std::tie(rhs.NumThreads, rhs.CpuUsedRamLimit, rhs.Devices,
+           std::tie(rhs.NumThreads, rhs.CpuUsedRamLimit, rhs.MetricThreadCount, rhs.Devices,
                     rhs.GpuRamPart, rhs.PinnedMemorySize, rhs.NodeType, rhs.FileWithHosts, rhs.NodePort);
 }
 
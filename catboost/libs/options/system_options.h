@@ -22,6 +22,7 @@ namespace NCatboostOptions {
 
         TOption<ui32> NumThreads;
         TOption<TString> CpuUsedRamLimit;
+        TCpuOnlyOption<ui32> MetricThreadCount;
         TGpuOnlyOption<TString> Devices;
         TGpuOnlyOption<double> GpuRamPart;
         TGpuOnlyOption<TString> PinnedMemorySize;
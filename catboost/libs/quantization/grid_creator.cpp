@@ -27,7 +27,9 @@ namespace NCB {
                                      ui32 borderCount,
                                      ENanMode nanMode) override {
                 TVector<float> sortedFeature = CheckedCopyWithoutNans(feature, nanMode);
-                Sort(sortedFeature.begin(), sortedFeature.end());
+                if (type != EBorderSelectionType::QuantileSketch) { // does not need sorted values
+                    Sort(sortedFeature.begin(), sortedFeature.end());
+                }
                 auto borders = TGridBuilderBase<type>::BuildBorders(sortedFeature, borderCount);
                 Result.push_back(std::move(borders));
                 return *this;
@@ -72,6 +74,8 @@ namespace NCB {
                 return MakeHolder<TCpuGridBuilder<EBorderSelectionType::Median>>();
             case EBorderSelectionType::Uniform:
                 return MakeHolder<TCpuGridBuilder<EBorderSelectionType::Uniform>>();
+            case EBorderSelectionType::QuantileSketch:
+                return MakeHolder<TCpuGridBuilder<EBorderSelectionType::QuantileSketch>>();
         }
         ythrow yexception() << "Invalid grid builder type!";
     }
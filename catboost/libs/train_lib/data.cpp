@@ -110,6 +110,12 @@ namespace NCB {
             quantizationOptions.CpuRamLimit
                 = ParseMemorySizeDescription(params->SystemOptions->CpuUsedRamLimit.Get());
             quantizationOptions.AllowWriteFiles = allowWriteFiles;
+            quantizationOptions.SparseFeaturesDefaultBinFraction
+                = params->DataProcessingOptions->SparseFeaturesDefaultBinFraction.Get();
+            quantizationOptions.ExclusiveFeaturesBundling
+                = params->DataProcessingOptions->ExclusiveFeaturesBundling.Get();
+            quantizationOptions.QuantizedFeaturesCompressionCodec
+                = params->DataProcessingOptions->QuantizedFeaturesCompressionCodec.Get();
 
             if (!quantizedFeaturesInfo) {
                 quantizedFeaturesInfo = MakeIntrusive<TQuantizedFeaturesInfo>(
@@ -5,6 +5,7 @@
 #include "data.h"
 #include "preprocess.h"
 
+#include <catboost/libs/algo/async_metrics.h>
 #include <catboost/libs/algo/full_model_saver.h>
 #include <catboost/libs/algo/helpers.h>
 #include <catboost/libs/algo/learn_context.h>
@@ -32,6 +33,8 @@
 #include <catboost/libs/pairs/util.h>
 #include <catboost/libs/target/classification_target_helper.h>
 
+#include <library/chromium_trace/counter.h>
+#include <library/chromium_trace/interface.h>
 #include <library/grid_creator/binarization.h>
 #include <library/json/json_prettifier.h>
 
@@ -41,9 +44,11 @@
 #include <util/generic/xrange.h>
 #include <util/generic/ymath.h>
 #include <util/random/shuffle.h>
+#include <util/stream/format.h>
 #include <util/system/compiler.h>
 #include <util/system/hp_timer.h>
 #include <util/system/info.h>
+#include <util/system/mem_info.h>
 
 
 using namespace NCB;
@@ -70,6 +75,7 @@ static int GetThreadCount(const NCatboostOptions::TCatBoostOptions& options) {
 
 static TDataProviders LoadPools(
     const NCatboostOptions::TPoolLoadParams& loadOptions,
+    const NCatboostOptions::TBinarizationOptions& floatFeaturesBinarization,
     EObjectsOrder objectsOrder,
     NPar::TLocalExecutor* const executor,
     TProfileInfo* profile
@@ -81,7 +87,19 @@ static TDataProviders LoadPools(
         "Test files are not supported in cross-validation mode"
     );
 
-    auto pools = NCB::ReadTrainDatasets(loadOptions, objectsOrder, !cvMode, executor, profile);
+    // sketches are built for the whole learn file, so they are useless for cv folds
+    TDataProviderBuilderOptions learnDataBuilderOptions;
+    learnDataBuilderOptions.BuildFloatFeaturesQuantileSketches =
+        !cvMode && (floatFeaturesBinarization.BorderSelectionType == EBorderSelectionType::QuantileSketch);
+
+    auto pools = NCB::ReadTrainDatasets(
+        loadOptions,
+        objectsOrder,
+        !cvMode,
+        learnDataBuilderOptions,
+        executor,
+        profile
+    );
 
     if (cvMode) {
         if (cvParams.Shuffle && (pools.Learn->ObjectsData->GetOrder() != EObjectsOrder::RandomShuffled)) {
@@ -124,6 +142,18 @@ static bool HasInvalidValues(const TVector<TVector<TVector<double>>>& leafValues
     return false;
 }
 
+static void PublishMemoryCounters(const TLearnContext& ctx) {
+    NChromiumTrace::TCounter counter("Memory pools", "memory");
+    counter.Sample("ProcessRSS", TMaybe<i64>(NMemInfo::GetMemInfo().RSS));
+    for (auto consumerIdx : xrange(static_cast<int>(ETrainingMemoryConsumer::ConsumerCount))) {
+        const auto consumer = static_cast<ETrainingMemoryConsumer>(consumerIdx);
+        counter.Sample(
+            GetTrainingMemoryConsumerName(consumer),
+            TMaybe<i64>(ctx.MemoryAccountant.GetUsage(consumer)));
+    }
+    counter.Publish(*NChromiumTrace::GetGlobalTracer());
+}
+
 static void Train(
     const TTrainingForCPUDataProviders& data,
     const TMaybe<TOnEndIterationCallback>& onEndIterationCallback,
@@ -132,6 +162,17 @@ static void Train(
 ) {
     TProfileInfo& profile = ctx->Profile;
 
+    THolder<NChromiumTrace::TGlobalJsonFileSink> traceSink;
+    if (ctx->OutputOptions.AllowWriteFiles() && !ctx->OutputOptions.GetTraceFilename().empty()) {
+        traceSink = MakeHolder<NChromiumTrace::TGlobalJsonFileSink>(
+            TOutputFiles::AlignFilePathAndCreateDir(
+                ctx->OutputOptions.GetTrainDir(),
+                ctx->OutputOptions.GetTraceFilename()
+            )
+        );
+        NChromiumTrace::GetGlobalTracer()->AddCurrentProcessName("catboost");
+    }
+
     const int approxDimension = ctx->LearnProgress.ApproxDimension;
     const bool hasTest = data.GetTestSampleCount() > 0;
     TVector<THolder<IMetric>> metrics = CreateMetrics(
@@ -269,37 +310,24 @@ static void Train(
         ); // TODO(espetrov): create only if sample rate < 1
     }
 
-    THPTimer timer;
-    for (ui32 iter = ctx->LearnProgress.TreeStruct.ysize();
-         continueTraining && (iter < ctx->Params.BoostingOptions->IterationCount);
-         ++iter)
+    ctx->UpdateMemoryUsage();
     {
-        if (errorTracker && errorTracker->GetIsNeedStop()) {
-            CATBOOST_NOTICE_LOG << "Stopped by overfitting detector "
-                << " (" << errorTracker->GetOverfittingDetectorIterationsWait() << " iterations wait)" << Endl;
-            break;
-        }
-
-        profile.StartNextIteration();
-
-        if (timer.Passed() > ctx->OutputOptions.GetSnapshotSaveInterval()) {
-            profile.AddOperation("Save snapshot");
-            ctx->SaveProgress();
-            timer.Reset();
-        }
-
-        TrainOneIteration(data, ctx);
-
-        bool calcAllMetrics = DivisibleOrLastIteration(
-            iter,
-            ctx->Params.BoostingOptions->IterationCount,
-            ctx->OutputOptions.GetMetricPeriod()
-        );
-        const bool calcErrorTrackerMetric = calcAllMetrics || (errorTracker && errorTracker->IsActive());
-
-        CalcErrors(data, metrics, calcAllMetrics, calcErrorTrackerMetric, ctx);
+        // everything that is resident before the first iteration and not owned by the training buffers
+        const ui64 processUsage = NMemInfo::GetMemInfo().RSS;
+        const ui64 buffersUsage = ctx->MemoryAccountant.GetTotalUsage();
+        ctx->MemoryAccountant.SetUsage(
+            ETrainingMemoryConsumer::Dataset,
+            processUsage > buffersUsage ? processUsage - buffersUsage : 0);
+    }
 
-        profile.AddOperation("Calc errors");
+    // error tracking and logging of an iteration whose metrics are evaluated
+    const auto processIterationMetrics = [&] (
+        ui32 iter,
+        bool calcAllMetrics,
+        bool calcErrorTrackerMetric,
+        const TVector<TVector<TVector<double>>>& testApprox, // approxes metrics were evaluated on
+        const TProfileResults& profileResults
+    ) {
         if (hasTest && calcErrorTrackerMetric && errorTracker) {
             const auto testErrors = ctx->LearnProgress.MetricsAndTimeHistory.TestMetricsHistory.back();
             const TString& errorTrackerMetricDescription = metrics[errorTrackerMetricIdx]->GetDescription();
@@ -311,7 +339,7 @@ static void Train(
                 if (error) {
                     errorTracker->AddError(*error, iter);
                     if (useBestModel && iter == static_cast<ui32>(errorTracker->GetBestIteration())) {
-                        ctx->LearnProgress.BestTestApprox = ctx->LearnProgress.TestApprox.back();
+                        ctx->LearnProgress.BestTestApprox = testApprox.back();
                     }
                     if (useBestModel && static_cast<int>(iter + 1) >= ctx->OutputOptions.BestModelMinTrees) {
                         bestModelMinTreesTracker->AddError(*error, iter);
@@ -320,9 +348,6 @@ static void Train(
             }
         }
 
-        profile.FinishIteration();
-
-        TProfileResults profileResults = profile.GetProfileResults();
         ctx->LearnProgress.MetricsAndTimeHistory.TimeHistory.push_back(TTimeInfo(profileResults));
 
         Log(
@@ -338,6 +363,142 @@ static void Train(
             calcAllMetrics,
             &logger
         );
+    };
+
+    /* With metric_thread_count > 0 metrics of iteration N are evaluated while iteration N + 1 is trained.
+     * Overfitting detector and callback decisions for N are made after N + 1 is trained, so if training
+     * has to stop at N the tree of N + 1 is rolled back and the final snapshot is not saved.
+     */
+    THolder<TAsyncMetricEvaluator> asyncMetricEvaluator;
+    if (ctx->Params.SystemOptions->MetricThreadCount > 0) {
+        if (!ctx->Params.SystemOptions->IsSingleHost()) {
+            CATBOOST_WARNING_LOG << "Asynchronous metric evaluation is not supported in distributed training, "
+                << "metrics are evaluated synchronously" << Endl;
+        } else if (ctx->EvalMetricDescriptor) {
+            CATBOOST_WARNING_LOG << "Asynchronous metric evaluation is not supported for user-defined eval metric, "
+                << "metrics are evaluated synchronously" << Endl;
+        } else {
+            asyncMetricEvaluator = MakeHolder<TAsyncMetricEvaluator>(
+                data,
+                metrics,
+                static_cast<int>(ctx->Params.SystemOptions->MetricThreadCount),
+                &ctx->LearnProgress.MetricsAndTimeHistory
+            );
+        }
+    }
+    TMaybe<TProfileResults> asyncMetricsProfileResults; // of the iteration being evaluated
+    const auto finishAsyncMetrics = [&] () {
+        const ui32 metricsIter = asyncMetricEvaluator->Finish();
+        processIterationMetrics(
+            metricsIter,
+            asyncMetricEvaluator->GetCalcAllMetrics(),
+            asyncMetricEvaluator->GetCalcErrorTrackerMetric(),
+            asyncMetricEvaluator->GetTestApprox(),
+            *asyncMetricsProfileResults
+        );
+        if (onEndIterationCallback) {
+            continueTraining = (*onEndIterationCallback)(ctx->LearnProgress.MetricsAndTimeHistory);
+        }
+    };
+
+    // approxes of folds and random generator state still include the rolled back iteration
+    bool rolledBackIteration = false;
+
+    THPTimer timer;
+    for (ui32 iter = ctx->LearnProgress.TreeStruct.ysize();
+         continueTraining && (iter < ctx->Params.BoostingOptions->IterationCount);
+         ++iter)
+    {
+        const bool needSnapshot = timer.Passed() > ctx->OutputOptions.GetSnapshotSaveInterval();
+        if (needSnapshot && asyncMetricEvaluator && asyncMetricEvaluator->IsRunning()) {
+            // snapshot must contain metrics of all its trees
+            finishAsyncMetrics();
+            if (!continueTraining) {
+                break;
+            }
+        }
+
+        if (errorTracker && errorTracker->GetIsNeedStop()) {
+            CATBOOST_NOTICE_LOG << "Stopped by overfitting detector "
+                << " (" << errorTracker->GetOverfittingDetectorIterationsWait() << " iterations wait)" << Endl;
+            break;
+        }
+
+        profile.StartNextIteration();
+        CHROMIUM_TRACE_SCOPE("Iteration");
+
+        if (needSnapshot) {
+            profile.AddOperation("Save snapshot");
+            ctx->SaveProgress();
+            timer.Reset();
+        }
+
+        TrainOneIteration(data, ctx);
+
+        const auto scratchArenaStats = ctx->ScratchArena.Reset();
+        CATBOOST_DEBUG_LOG << "Scratch arena: " << HumanReadableSize(scratchArenaStats.ArenaBytes, SF_BYTES)
+            << " of temporary buffers, " << HumanReadableSize(scratchArenaStats.HeapBytes, SF_BYTES)
+            << " allocated from heap" << Endl;
+        if (traceSink) {
+            NChromiumTrace::TCounter("Scratch arena", "memory")
+                .Sample("ArenaBytes", TMaybe<i64>(scratchArenaStats.ArenaBytes))
+                .Sample("HeapBytes", TMaybe<i64>(scratchArenaStats.HeapBytes))
+                .Publish(*NChromiumTrace::GetGlobalTracer());
+        }
+
+        bool calcAllMetrics = DivisibleOrLastIteration(
+            iter,
+            ctx->Params.BoostingOptions->IterationCount,
+            ctx->OutputOptions.GetMetricPeriod()
+        );
+        const bool calcErrorTrackerMetric = calcAllMetrics || (errorTracker && errorTracker->IsActive());
+
+        if (asyncMetricEvaluator) {
+            if (asyncMetricEvaluator->IsRunning()) {
+                finishAsyncMetrics();
+                profile.AddOperation("Wait for metrics");
+            }
+            profile.FinishIteration();
+            if (traceSink) {
+                PublishMemoryCounters(*ctx);
+            }
+
+            if (!continueTraining || (errorTracker && errorTracker->GetIsNeedStop())) {
+                // training stops at the previous iteration, this one would not have been trained synchronously
+                ShrinkModel(ctx->LearnProgress.TreeStruct.ysize() - 1, ctx->CtrsHelper, &ctx->LearnProgress);
+                rolledBackIteration = true;
+                ctx->LearnProgress.AvrgApprox = asyncMetricEvaluator->GetLearnApprox();
+                ctx->LearnProgress.TestApprox = asyncMetricEvaluator->GetTestApprox();
+                continue;
+            }
+            if (HasInvalidValues(ctx->LearnProgress.LeafValues)) {
+                ctx->LearnProgress.LeafValues.pop_back();
+                ctx->LearnProgress.TreeStruct.pop_back();
+                CATBOOST_WARNING_LOG << "Training has stopped (degenerate solution on iteration "
+                    << iter << ", probably too small l2-regularization, try to increase it)" << Endl;
+                break;
+            }
+
+            asyncMetricsProfileResults = profile.GetProfileResults();
+            asyncMetricEvaluator->Start(iter, ctx->LearnProgress, calcAllMetrics, calcErrorTrackerMetric);
+            continue;
+        }
+
+        CalcErrors(data, metrics, calcAllMetrics, calcErrorTrackerMetric, ctx);
+
+        profile.AddOperation("Calc errors");
+        profile.FinishIteration();
+        if (traceSink) {
+            PublishMemoryCounters(*ctx);
+        }
+
+        processIterationMetrics(
+            iter,
+            calcAllMetrics,
+            calcErrorTrackerMetric,
+            ctx->LearnProgress.TestApprox,
+            profile.GetProfileResults()
+        );
 
         if (HasInvalidValues(ctx->LearnProgress.LeafValues)) {
             ctx->LearnProgress.LeafValues.pop_back();
@@ -352,7 +513,20 @@ static void Train(
         }
     }
 
-    ctx->SaveProgress();
+    if (asyncMetricEvaluator && asyncMetricEvaluator->IsRunning()) {
+        // no tree has been trained after the last evaluated iteration, so nothing to roll back
+        finishAsyncMetrics();
+    }
+
+    if (rolledBackIteration) {
+        // such a snapshot would resume training from an inconsistent state, keep the previous one
+        CATBOOST_DEBUG_LOG << "Snapshot is not saved after the rolled back iteration" << Endl;
+    } else {
+        ctx->SaveProgress();
+    }
+
+    ctx->UpdateMemoryUsage();
+    ctx->MemoryAccountant.LogPeakUsage();
 
     if (hasTest) {
         (*testMultiApprox) = ctx->LearnProgress.TestApprox;
@@ -731,6 +905,7 @@ void TrainModel(
 
     TDataProviders pools = LoadPools(
         loadOptions,
+        catBoostOptions.DataProcessingOptions->FloatFeaturesBinarization.Get(),
         catBoostOptions.DataProcessingOptions->HasTimeFlag.Get() ?
             EObjectsOrder::Ordered : EObjectsOrder::Undefined,
         &executor,
@@ -1,6 +1,12 @@
+#include <catboost/libs/algo/helpers.h>
+#include <catboost/libs/algo/learn_context.h>
 #include <catboost/libs/data_new/data_provider_builders.h>
 #include <catboost/libs/helpers/vector_helpers.h>
+#include <catboost/libs/labels/label_converter.h>
 #include <catboost/libs/model/model.h>
+#include <catboost/libs/options/load_options.h>
+#include <catboost/libs/options/plain_options_helper.h>
+#include <catboost/libs/train_lib/data.h>
 #include <catboost/libs/train_lib/train_model.h>
 #include <catboost/libs/ut_helpers/data_provider.h>
 
@@ -33,6 +39,79 @@ static void FillWithRandom(TArrayRef<float> array, Prng& prng) {
     }
 }
 
+template <typename Prng>
+static TDataProviderPtr CreateRandomDataProvider(ui32 objectCount, ui32 numericFeatureCount, Prng& prng) {
+    TVector<TVector<float>> factors;
+    ResizeRank2(numericFeatureCount, objectCount, factors);
+    TVector<float> target(objectCount);
+    FillWithRandom(factors, prng);
+    FillWithRandom(target, prng);
+
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.HasTarget = true;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                numericFeatureCount,
+                TVector<ui32>{},
+                TVector<TString>{}
+            );
+
+            visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+
+            for (auto featureIdx : xrange(numericFeatureCount)) {
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    TMaybeOwningConstArrayHolder<float>::CreateOwning(std::move(factors[featureIdx]))
+                );
+            }
+            visitor->AddTarget(target);
+
+            visitor->Finish();
+        }
+    );
+}
+
+// each object has a nonzero value of exactly one feature, so all features can be bundled together
+template <typename Prng>
+static TDataProviderPtr CreateRandomExclusiveFeaturesDataProvider(
+    ui32 objectCount,
+    ui32 numericFeatureCount,
+    Prng& prng
+) {
+    TVector<TVector<float>> factors;
+    ResizeRank2(numericFeatureCount, objectCount, factors);
+    for (auto objectIdx : xrange(objectCount)) {
+        factors[prng.Uniform(numericFeatureCount)][objectIdx] = prng.GenRandReal1();
+    }
+    TVector<float> target(objectCount);
+    FillWithRandom(target, prng);
+
+    return CreateDataProvider(
+        [&] (IRawFeaturesOrderDataVisitor* visitor) {
+            TDataMetaInfo metaInfo;
+            metaInfo.HasTarget = true;
+            metaInfo.FeaturesLayout = MakeIntrusive<TFeaturesLayout>(
+                numericFeatureCount,
+                TVector<ui32>{},
+                TVector<TString>{}
+            );
+
+            visitor->Start(metaInfo, objectCount, EObjectsOrder::Undefined, {});
+
+            for (auto featureIdx : xrange(numericFeatureCount)) {
+                visitor->AddFloatFeature(
+                    featureIdx,
+                    TMaybeOwningConstArrayHolder<float>::CreateOwning(std::move(factors[featureIdx]))
+                );
+            }
+            visitor->AddTarget(target);
+
+            visitor->Finish();
+        }
+    );
+}
+
 Y_UNIT_TEST_SUITE(TrainModelTests) {
     Y_UNIT_TEST(TrainWithoutNansTestWithNans) {
         // Train doesn't have NaNs, so TrainModel implicitly forbids them (during quantization), but
@@ -212,4 +291,329 @@ Y_UNIT_TEST_SUITE(TrainModelTests) {
 
         UNIT_ASSERT_VALUES_UNEQUAL(predictions[0][0], predictions[1][0]);
     }
+
+    Y_UNIT_TEST(MaterializePermutedFeaturesDoesNotChangeModel) {
+        // Permuted feature copies only change the memory access pattern of indices calculation
+
+        const ui64 seed = 20181029;
+        const ui32 objectCount = 500;
+        const ui32 numericFeatureCount = 4;
+
+        TFullModel models[2];
+        for (size_t i = 0; i < 2; ++i) {
+            TTempDir trainDir;
+
+            TFastRng<ui64> prng(seed);
+            TDataProviders dataProviders;
+            dataProviders.Learn = CreateRandomDataProvider(objectCount, numericFeatureCount, prng);
+
+            TEvalResult evalResult;
+            NJson::TJsonValue params;
+            params.InsertValue("iterations", 20);
+            params.InsertValue("random_seed", 1);
+            params.InsertValue("train_dir", trainDir.Name());
+            params.InsertValue("boosting_type", "Ordered");
+            params.InsertValue("materialize_permuted_features", i == 1);
+            TrainModel(
+                params,
+                nullptr,
+                {},
+                {},
+                std::move(dataProviders),
+                "",
+                &models[i],
+                {&evalResult}
+            );
+        }
+
+        UNIT_ASSERT(models[0] == models[1]);
+    }
+
+    Y_UNIT_TEST(AsyncMetricsWithOverfittingDetector) {
+        // Metrics evaluated asynchronously lag training by one iteration, the tree trained after
+        // the overfitting detector fires must be rolled back, so the model is the same as with
+        // synchronous evaluation.
+
+        const ui64 seed = 20181029;
+        const ui32 objectCount = 200;
+        const ui32 numericFeatureCount = 3;
+        const ui32 metricThreadCount[2] = {0, 1};
+
+        TFullModel models[2];
+        for (size_t i = 0; i < 2; ++i) {
+            TTempDir trainDir;
+
+            // learn and test targets are independent, so test error stops improving quickly
+            TFastRng<ui64> prng(seed);
+            TDataProviders dataProviders;
+            dataProviders.Learn = CreateRandomDataProvider(objectCount, numericFeatureCount, prng);
+            dataProviders.Test.push_back(CreateRandomDataProvider(objectCount, numericFeatureCount, prng));
+
+            TEvalResult evalResult;
+            NJson::TJsonValue params;
+            params.InsertValue("iterations", 200);
+            params.InsertValue("random_seed", 1);
+            params.InsertValue("train_dir", trainDir.Name());
+            params.InsertValue("od_type", "Iter");
+            params.InsertValue("od_wait", 5);
+            params.InsertValue("use_best_model", false);
+            params.InsertValue("metric_thread_count", metricThreadCount[i]);
+            TrainModel(
+                params,
+                nullptr,
+                {},
+                {},
+                std::move(dataProviders),
+                "",
+                &models[i],
+                {&evalResult}
+            );
+        }
+
+        UNIT_ASSERT(models[0].GetTreeCount() < 200);
+        UNIT_ASSERT_VALUES_EQUAL(models[0].GetTreeCount(), models[1].GetTreeCount());
+
+        TVector<float> object(numericFeatureCount, 0.5f);
+        double predictions[2][1];
+        models[0].Calc(object, {}, predictions[0]);
+        models[1].Calc(object, {}, predictions[1]);
+        UNIT_ASSERT_DOUBLES_EQUAL(predictions[0][0], predictions[1][0], 1e-9);
+    }
+
+    Y_UNIT_TEST(AsyncMetricsResumeFromSnapshot) {
+        // Training resumed from a snapshot saved with asynchronous metrics continues the same way as
+        // uninterrupted training
+
+        const ui64 seed = 20181029;
+        const ui32 objectCount = 200;
+        const ui32 numericFeatureCount = 3;
+
+        const auto train = [&] (const TString& trainDir, ui32 iterations, bool saveSnapshot, TFullModel* model) {
+            TFastRng<ui64> prng(seed);
+            TDataProviders dataProviders;
+            dataProviders.Learn = CreateRandomDataProvider(objectCount, numericFeatureCount, prng);
+            dataProviders.Test.push_back(CreateRandomDataProvider(objectCount, numericFeatureCount, prng));
+
+            TEvalResult evalResult;
+            NJson::TJsonValue params;
+            params.InsertValue("iterations", iterations);
+            params.InsertValue("learning_rate", 0.1); // otherwise it depends on the iteration count
+            params.InsertValue("random_seed", 1);
+            params.InsertValue("train_dir", trainDir);
+            params.InsertValue("metric_thread_count", 1);
+            if (saveSnapshot) {
+                params.InsertValue("save_snapshot", true);
+                params.InsertValue("snapshot_file", "snapshot");
+            }
+            TrainModel(
+                params,
+                nullptr,
+                {},
+                {},
+                std::move(dataProviders),
+                "",
+                model,
+                {&evalResult}
+            );
+        };
+
+        TFullModel models[2];
+        {
+            TTempDir trainDir;
+            train(trainDir.Name(), 30, /*saveSnapshot*/ false, &models[0]);
+        }
+        {
+            TTempDir trainDir;
+            TFullModel interruptedModel;
+            train(trainDir.Name(), 20, /*saveSnapshot*/ true, &interruptedModel);
+            UNIT_ASSERT_VALUES_EQUAL(interruptedModel.GetTreeCount(), 20);
+            train(trainDir.Name(), 30, /*saveSnapshot*/ true, &models[1]);
+        }
+
+        UNIT_ASSERT_VALUES_EQUAL(models[1].GetTreeCount(), 30);
+        UNIT_ASSERT(models[0] == models[1]);
+    }
+
+    Y_UNIT_TEST(BlockCompressedFeaturesDoNotChangeModel) {
+        // Block compression only changes how bins are stored, both consecutive (plain) and permuted (ordered)
+        // reads of the bins are checked
+
+        const ui64 seed = 20181029;
+        const ui32 objectCount = 1000;
+        const ui32 numericFeatureCount = 4;
+
+        for (TStringBuf boostingType : {AsStringBuf("Plain"), AsStringBuf("Ordered")}) {
+            TFullModel models[2];
+            for (size_t i = 0; i < 2; ++i) {
+                TTempDir trainDir;
+
+                TFastRng<ui64> prng(seed);
+                TDataProviders dataProviders;
+                dataProviders.Learn = CreateRandomDataProvider(objectCount, numericFeatureCount, prng);
+
+                TEvalResult evalResult;
+                NJson::TJsonValue params;
+                params.InsertValue("iterations", 20);
+                params.InsertValue("random_seed", 1);
+                params.InsertValue("train_dir", trainDir.Name());
+                params.InsertValue("boosting_type", boostingType);
+                if (i == 1) {
+                    params.InsertValue("quantized_features_compression_codec", "lz4");
+                }
+                TrainModel(
+                    params,
+                    nullptr,
+                    {},
+                    {},
+                    std::move(dataProviders),
+                    "",
+                    &models[i],
+                    {&evalResult}
+                );
+            }
+
+            UNIT_ASSERT(models[0] == models[1]);
+        }
+    }
+
+    Y_UNIT_TEST(SmallUsedRamLimitDropsTrainingCaches) {
+        // Tree-level caching only saves recalculation of bucket stats and materialized permuted features only
+        // save indexed access, dropping them when training buffers exceed used_ram_limit must not change the model
+
+        const ui64 seed = 20181029;
+        const ui32 objectCount = 1000;
+        const ui32 numericFeatureCount = 4;
+        const TString usedRamLimit[2] = {"inf", "1KB"}; // folds of 1000 objects take more than 1KB
+
+        const auto createPlainParams = [&] (const TString& trainDir, const TString& ramLimit) {
+            NJson::TJsonValue params;
+            params.InsertValue("iterations", 20);
+            params.InsertValue("random_seed", 1);
+            params.InsertValue("train_dir", trainDir);
+            params.InsertValue("boosting_type", "Plain");
+            params.InsertValue("depth", 4);
+            params.InsertValue("sampling_frequency", "PerTree"); // tree-level caching requires it
+            params.InsertValue("materialize_permuted_features", true);
+            params.InsertValue("used_ram_limit", ramLimit);
+            return params;
+        };
+
+        for (size_t i = 0; i < 2; ++i) {
+            TTempDir trainDir;
+
+            TFastRng<ui64> prng(seed);
+            TDataProviders dataProviders;
+            dataProviders.Learn = CreateRandomDataProvider(objectCount, numericFeatureCount, prng);
+
+            NJson::TJsonValue trainOptionsJson;
+            NJson::TJsonValue outputOptionsJson;
+            NCatboostOptions::PlainJsonToOptions(
+                createPlainParams(trainDir.Name(), usedRamLimit[i]),
+                &trainOptionsJson,
+                &outputOptionsJson
+            );
+            auto catBoostOptions = NCatboostOptions::LoadOptions(trainOptionsJson);
+            NCatboostOptions::TOutputFilesOptions outputOptions;
+            outputOptions.Load(outputOptionsJson);
+
+            NPar::TLocalExecutor localExecutor;
+            TRestorableFastRng64 rand(catBoostOptions.RandomSeed);
+            TLabelConverter labelConverter;
+            const auto trainingData = GetTrainingData(
+                std::move(dataProviders),
+                /*bordersFile*/ Nothing(),
+                /*ensureConsecutiveLearnFeaturesDataForCpu*/ true,
+                /*allowWriteFiles*/ false,
+                /*quantizedFeaturesInfo*/ nullptr,
+                &catBoostOptions,
+                &labelConverter,
+                &localExecutor,
+                &rand
+            ).Cast<TQuantizedForCPUObjectsDataProvider>();
+
+            TLearnContext ctx(
+                catBoostOptions,
+                /*objectiveDescriptor*/ Nothing(),
+                /*evalMetricDescriptor*/ Nothing(),
+                outputOptions,
+                trainingData.Learn->MetaInfo.FeaturesLayout,
+                /*initRand*/ Nothing(),
+                &localExecutor
+            );
+            ctx.LearnProgress.ApproxDimension = 1;
+            const auto& quantizedFeaturesInfo = *trainingData.Learn->ObjectsData->GetQuantizedFeaturesInfo();
+            ctx.LearnProgress.FloatFeatures = CreateFloatFeatures(quantizedFeaturesInfo);
+            ctx.LearnProgress.CatFeatures = CreateCatFeatures(quantizedFeaturesInfo);
+            ctx.InitContext(trainingData);
+            UNIT_ASSERT(ctx.UseTreeLevelCaching());
+            UNIT_ASSERT(ctx.UseMaterializedPermutedFeatures());
+
+            ctx.EnforceMemoryBudget();
+            UNIT_ASSERT_VALUES_EQUAL(ctx.UseTreeLevelCaching(), i == 0);
+            UNIT_ASSERT_VALUES_EQUAL(ctx.UseMaterializedPermutedFeatures(), i == 0);
+        }
+
+        TFullModel models[2];
+        for (size_t i = 0; i < 2; ++i) {
+            TTempDir trainDir;
+
+            TFastRng<ui64> prng(seed);
+            TDataProviders dataProviders;
+            dataProviders.Learn = CreateRandomDataProvider(objectCount, numericFeatureCount, prng);
+
+            TEvalResult evalResult;
+            TrainModel(
+                createPlainParams(trainDir.Name(), usedRamLimit[i]),
+                nullptr,
+                {},
+                {},
+                std::move(dataProviders),
+                "",
+                &models[i],
+                {&evalResult}
+            );
+        }
+
+        UNIT_ASSERT(models[0] == models[1]);
+    }
+
+    Y_UNIT_TEST(ExclusiveFeaturesBundlingWithTreeLevelCaching) {
+        // With tree-level caching bundled features are scored one by one with stats from the previous level,
+        // the model must be the same as without bundles
+
+        const ui64 seed = 20181029;
+        const ui32 objectCount = 1000;
+        const ui32 numericFeatureCount = 6;
+
+        TFullModel models[2];
+        for (size_t i = 0; i < 2; ++i) {
+            TTempDir trainDir;
+
+            TFastRng<ui64> prng(seed);
+            TDataProviders dataProviders;
+            dataProviders.Learn = CreateRandomExclusiveFeaturesDataProvider(objectCount, numericFeatureCount, prng);
+
+            TEvalResult evalResult;
+            NJson::TJsonValue params;
+            params.InsertValue("iterations", 20);
+            params.InsertValue("random_seed", 1);
+            params.InsertValue("train_dir", trainDir.Name());
+            params.InsertValue("boosting_type", "Plain");
+            params.InsertValue("depth", 4);
+            params.InsertValue("sampling_frequency", "PerTree"); // tree-level caching requires it
+            params.InsertValue("exclusive_features_bundling", i == 1);
+            TrainModel(
+                params,
+                nullptr,
+                {},
+                {},
+                std::move(dataProviders),
+                "",
+                &models[i],
+                {&evalResult}
+            );
+        }
+
+        UNIT_ASSERT(models[0] == models[1]);
+    }
 }
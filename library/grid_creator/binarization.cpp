@@ -1,4 +1,5 @@
 #include "binarization.h"
+#include "quantile_sketch.h"
 
 #include <util/generic/algorithm.h>
 #include <util/generic/array_ref.h>
@@ -55,6 +56,14 @@ namespace {
                                     int maxBordersCount,
                                     bool isSorted) const override;
     };
+
+    // Approximate median borders in O(n * log(binCount)) without sorting, see TQuantileSketch.
+    class TQuantileSketchBinarizer: public IBinarizer {
+    public:
+        THashSet<float> BestSplit(TVector<float>& featureValues,
+                                    int maxBordersCount,
+                                    bool isSorted) const override;
+    };
 }
 
 namespace NSplitSelection {
@@ -72,6 +81,8 @@ namespace NSplitSelection {
                 return MakeHolder<TMedianBinarizer>();
             case EBorderSelectionType::Uniform:
                 return MakeHolder<TUniformBinarizer>();
+            case EBorderSelectionType::QuantileSketch:
+                return MakeHolder<TQuantileSketchBinarizer>();
         }
 
         ythrow yexception() << "got invalid enum value: " << static_cast<int>(type);
@@ -80,6 +91,9 @@ namespace NSplitSelection {
 
 // TODO(yazevnul): fix memory use estimation
 size_t CalcMemoryForFindBestSplit(int maxBordersCount, size_t docsCount, EBorderSelectionType type) {
+    if (type == EBorderSelectionType::QuantileSketch) {
+        return NSplitSelection::TQuantileSketch::CalcMaxMemoryUsage(docsCount);
+    }
     size_t bestSplitSize = docsCount * ((maxBordersCount + 2) * sizeof(size_t) + 4 * sizeof(double));
     if (type == EBorderSelectionType::MinEntropy || type == EBorderSelectionType::MaxLogSum) {
         bestSplitSize += docsCount * 3 * sizeof(float);
@@ -100,12 +114,9 @@ THashSet<float> BestSplit(TVector<float>& features,
         return {};
     }
 
-    if (!featuresAreSorted) {
-        Sort(features.begin(), features.end());
-    }
-
+    // binarizers sort features themselves if they need it
     const auto binarizer = NSplitSelection::MakeBinarizer(type);
-    return binarizer->BestSplit(features, maxBordersCount, true);
+    return binarizer->BestSplit(features, maxBordersCount, featuresAreSorted);
 }
 
 namespace {
@@ -769,6 +780,16 @@ THashSet<float> TUniformBinarizer::BestSplit(TVector<float>& featureValues,
     return borders;
 }
 
+THashSet<float> TQuantileSketchBinarizer::BestSplit(TVector<float>& featureValues,
+                                                   int maxBordersCount,
+                                                   bool /*isSorted*/) const {
+    NSplitSelection::TQuantileSketch sketch;
+    for (float value : featureValues) {
+        sketch.Add(value);
+    }
+    return sketch.GetBorders(maxBordersCount);
+}
+
 namespace {
     class TFeatureBin {
     private:
@@ -8,7 +8,8 @@ enum class EBorderSelectionType {
     UniformAndQuantiles = 3,
     MinEntropy = 4,
     MaxLogSum = 5,
-    Uniform = 6
+    Uniform = 6,
+    QuantileSketch = 7
 };
 
 THashSet<float> BestSplit(
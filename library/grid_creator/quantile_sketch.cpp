@@ -0,0 +1,146 @@
+#include "quantile_sketch.h"
+
+#include <util/generic/algorithm.h>
+#include <util/generic/utility.h>
+#include <util/generic/ymath.h>
+#include <util/generic/yexception.h>
+
+#include <cmath>
+
+namespace NSplitSelection {
+    TQuantileSketch::TQuantileSketch(ui32 compactorSize)
+        : CompactorSize(compactorSize)
+        , Levels(1)
+        , OddCompactions(1, false)
+        , Count(0)
+        , NanCount(0)
+    {
+        Y_ENSURE(CompactorSize >= 2, "TQuantileSketch: compactorSize must be at least 2");
+    }
+
+    void TQuantileSketch::Add(float value) {
+        if (std::isnan(value)) {
+            ++NanCount;
+            return;
+        }
+        Levels[0].push_back(value);
+        ++Count;
+        if (Levels[0].size() >= CompactorSize) {
+            Compact(0);
+        }
+    }
+
+    void TQuantileSketch::Merge(const TQuantileSketch& rhs) {
+        Y_ENSURE(
+            CompactorSize == rhs.CompactorSize,
+            "TQuantileSketch: merged sketches must have the same compactorSize"
+        );
+        if (rhs.Levels.size() > Levels.size()) {
+            Levels.resize(rhs.Levels.size());
+            OddCompactions.resize(rhs.Levels.size(), false);
+        }
+        for (size_t level = 0; level < rhs.Levels.size(); ++level) {
+            Levels[level].insert(Levels[level].end(), rhs.Levels[level].begin(), rhs.Levels[level].end());
+        }
+        Count += rhs.Count;
+        NanCount += rhs.NanCount;
+
+        // Compact can add a new level so Levels.size() must be rechecked on each iteration
+        for (size_t level = 0; level < Levels.size(); ++level) {
+            if (Levels[level].size() >= CompactorSize) {
+                Compact(level);
+            }
+        }
+    }
+
+    void TQuantileSketch::Compact(size_t level) {
+        if (level + 1 == Levels.size()) {
+            Levels.emplace_back();
+            OddCompactions.push_back(false);
+        }
+
+        auto& values = Levels[level];
+        Sort(values.begin(), values.end());
+
+        // keep the largest value at this level if the count is odd so that total weight is preserved
+        const size_t compactedSize = values.size() - values.size() % 2;
+        auto& nextLevelValues = Levels[level + 1];
+        for (size_t i = OddCompactions[level] ? 1 : 0; i < compactedSize; i += 2) {
+            nextLevelValues.push_back(values[i]);
+        }
+        OddCompactions[level] = !OddCompactions[level];
+        values.erase(values.begin(), values.begin() + compactedSize);
+
+        if (nextLevelValues.size() >= CompactorSize) {
+            Compact(level + 1);
+        }
+    }
+
+    TVector<std::pair<float, ui64>> TQuantileSketch::GetWeightedValues() const {
+        TVector<std::pair<float, ui64>> result;
+        for (size_t level = 0; level < Levels.size(); ++level) {
+            for (float value : Levels[level]) {
+                result.emplace_back(value, ui64(1) << level);
+            }
+        }
+        Sort(result.begin(), result.end());
+
+        // merge equal values
+        size_t dstIdx = 0;
+        for (size_t srcIdx = 0; srcIdx < result.size(); ++srcIdx) {
+            if (dstIdx && (result[dstIdx - 1].first == result[srcIdx].first)) {
+                result[dstIdx - 1].second += result[srcIdx].second;
+            } else {
+                result[dstIdx++] = result[srcIdx];
+            }
+        }
+        result.resize(dstIdx);
+        return result;
+    }
+
+    THashSet<float> TQuantileSketch::GetBorders(int maxBordersCount) const {
+        THashSet<float> result;
+
+        const TVector<std::pair<float, ui64>> weightedValues = GetWeightedValues();
+        if (weightedValues.size() < 2) {
+            return result;
+        }
+
+        TVector<ui64> rankEnds; // [valueIdx], rank of the next value after this one
+        rankEnds.reserve(weightedValues.size());
+        ui64 rankEnd = 0;
+        for (const auto& weightedValue : weightedValues) {
+            rankEnd += weightedValue.second;
+            rankEnds.push_back(rankEnd);
+        }
+        const ui64 total = rankEnd;
+
+        for (int i = 0; i < maxBordersCount; ++i) {
+            const ui64 rank = Min<ui64>((i + 1) * total / (maxBordersCount + 1), total - 1);
+            const size_t valueIdx = UpperBound(rankEnds.begin(), rankEnds.end(), rank) - rankEnds.begin();
+            if (valueIdx == 0) {
+                continue;
+            }
+
+            // border before the value, as in the exact median borders
+            const float prevValue = weightedValues[valueIdx - 1].first;
+            const float value = weightedValues[valueIdx].first;
+            float border = (prevValue + value) * .5f;
+            if (border == value) { // wrong side rounding
+                border = prevValue;
+            }
+            result.insert(border);
+        }
+        return result;
+    }
+
+    size_t TQuantileSketch::CalcMaxMemoryUsage(ui64 valueCount, ui32 compactorSize) {
+        size_t levelCount = 2;
+        for (ui64 levelCapacity = compactorSize; levelCapacity < valueCount; levelCapacity *= 2) {
+            ++levelCount;
+        }
+
+        // merge can temporarily double level sizes
+        return levelCount * 2 * compactorSize * sizeof(float);
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <util/generic/hash_set.h>
+#include <util/generic/vector.h>
+#include <util/system/types.h>
+
+#include <utility>
+
+namespace NSplitSelection {
+    /* Mergeable quantile summary with bounded memory.
+     *
+     * Values are accumulated in a hierarchy of compactors: values at level h have weight 2^h.
+     * When a level is full it is sorted and every other value is promoted to the next level,
+     * so memory is O(compactorSize * log(n / compactorSize)) and no full sort of data is needed.
+     * Rank error of the summary is at most (level count) / compactorSize of the total count.
+     * If less than compactorSize values have been added the summary is exact.
+     *
+     * Sketches built on separate parts of data (blocks, threads) can be merged. Results are
+     * deterministic for the same sequence of Add and Merge calls.
+     */
+    class TQuantileSketch {
+    public:
+        static constexpr ui32 DEFAULT_COMPACTOR_SIZE = 8192;
+
+    public:
+        explicit TQuantileSketch(ui32 compactorSize = DEFAULT_COMPACTOR_SIZE);
+
+        // NaNs are not added to the summary, only counted
+        void Add(float value);
+
+        void Merge(const TQuantileSketch& rhs);
+
+        // not including NaNs
+        ui64 GetCount() const {
+            return Count;
+        }
+
+        ui64 GetNanCount() const {
+            return NanCount;
+        }
+
+        // sorted distinct values with their approximate counts, counts sum up to GetCount()
+        TVector<std::pair<float, ui64>> GetWeightedValues() const;
+
+        /* borders are selected between approximate quantiles in the same way as for
+         * EBorderSelectionType::Median (the result is the same if the summary is exact)
+         */
+        THashSet<float> GetBorders(int maxBordersCount) const;
+
+        // upper bound of memory used by a sketch with valueCount added values
+        static size_t CalcMaxMemoryUsage(ui64 valueCount, ui32 compactorSize = DEFAULT_COMPACTOR_SIZE);
+
+    private:
+        void Compact(size_t level);
+
+    private:
+        ui32 CompactorSize;
+        TVector<TVector<float>> Levels; // [level], values at level have weight 2^level
+        TVector<bool> OddCompactions; // [level], alternated to make compaction errors cancel out
+        ui64 Count;
+        ui64 NanCount;
+    };
+}
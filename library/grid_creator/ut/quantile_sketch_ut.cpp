@@ -0,0 +1,95 @@
+#include <library/unittest/registar.h>
+
+#include <library/grid_creator/binarization.h>
+#include <library/grid_creator/quantile_sketch.h>
+
+#include <util/generic/algorithm.h>
+#include <util/generic/hash_set.h>
+#include <util/generic/vector.h>
+#include <util/generic/xrange.h>
+#include <util/random/fast.h>
+
+#include <limits>
+
+using NSplitSelection::TQuantileSketch;
+
+static TVector<float> GenerateValues(size_t count, ui64 seed, bool addRepeatedValues) {
+    TFastRng64 rng(seed);
+    TVector<float> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back((addRepeatedValues && (i % 5 == 0)) ? 0.0f : float(rng.GenRandReal1() * 100.0));
+    }
+    return values;
+}
+
+static TVector<float> GetSortedBorders(const THashSet<float>& borderSet) {
+    TVector<float> borders(borderSet.begin(), borderSet.end());
+    Sort(borders.begin(), borders.end());
+    return borders;
+}
+
+Y_UNIT_TEST_SUITE(QuantileSketchTests) {
+    Y_UNIT_TEST(TestExactIsSameAsMedian) {
+        TVector<float> values = GenerateValues(1000, 0, /*addRepeatedValues*/ true);
+
+        TQuantileSketch sketch(/*compactorSize*/ 2048);
+        for (auto value : values) {
+            sketch.Add(value);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetCount(), values.size());
+
+        const auto sketchBorders = GetSortedBorders(sketch.GetBorders(32));
+        const auto medianBorders = GetSortedBorders(BestSplit(values, 32, EBorderSelectionType::Median));
+        UNIT_ASSERT_VALUES_EQUAL(sketchBorders, medianBorders);
+    }
+
+    Y_UNIT_TEST(TestNans) {
+        TQuantileSketch sketch;
+        sketch.Add(1.0f);
+        sketch.Add(std::numeric_limits<float>::quiet_NaN());
+        sketch.Add(2.0f);
+
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetCount(), 2);
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetNanCount(), 1);
+        UNIT_ASSERT_VALUES_EQUAL(GetSortedBorders(sketch.GetBorders(1)), TVector<float>{1.5f});
+    }
+
+    Y_UNIT_TEST(TestMergeApproximation) {
+        const size_t valueCount = 200000;
+        const ui32 compactorSize = 1024;
+        TVector<float> values = GenerateValues(valueCount, 1, /*addRepeatedValues*/ false);
+
+        const size_t blockSize = 10000;
+        TQuantileSketch sketch(compactorSize);
+        for (size_t blockBegin = 0; blockBegin < valueCount; blockBegin += blockSize) {
+            TQuantileSketch blockSketch(compactorSize);
+            for (size_t i = blockBegin; i < Min(blockBegin + blockSize, valueCount); ++i) {
+                blockSketch.Add(values[i]);
+            }
+            sketch.Merge(blockSketch);
+        }
+        UNIT_ASSERT_VALUES_EQUAL(sketch.GetCount(), valueCount);
+
+        const auto weightedValues = sketch.GetWeightedValues();
+        UNIT_ASSERT(weightedValues.size() < valueCount / 10);
+        ui64 totalWeight = 0;
+        for (const auto& weightedValue : weightedValues) {
+            totalWeight += weightedValue.second;
+        }
+        UNIT_ASSERT_VALUES_EQUAL(totalWeight, valueCount);
+
+        // borders must be close to quantiles k / (borderCount + 1)
+        const int borderCount = 15;
+        const auto borders = GetSortedBorders(sketch.GetBorders(borderCount));
+        UNIT_ASSERT_VALUES_EQUAL(borders.size(), (size_t)borderCount);
+
+        Sort(values.begin(), values.end());
+        const double maxRankError = 0.01;
+        for (auto i : xrange(borders.size())) {
+            const double rank =
+                double(LowerBound(values.begin(), values.end(), borders[i]) - values.begin()) / valueCount;
+            UNIT_ASSERT_DOUBLES_EQUAL(rank, double(i + 1) / (borderCount + 1), maxRankError);
+        }
+    }
+}